@@ -0,0 +1,134 @@
+/*
+ * Benchmark da arena da partida
+ * 
+ * Monta e desmonta muitas partidas (jogadores com missão sorteada e
+ * territórios cadastrados) de dois jeitos: como o cadastro fazia antes,
+ * com um malloc por jogador, outro por missão copiada e os vetores do
+ * mapa no heap; e com a arena, zerada entre as partidas, e as missões
+ * apontando para a tabela compartilhada.
+ * 
+ * Uso: bench_arena [partidas] [jogadores] [territorios]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "nucleo/aleatorio.h"
+#include "nucleo/arena.h"
+#include "nucleo/missao.h"
+
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Impede que o compilador descarte as partidas montadas
+static volatile long long sumidouro;
+
+// Cores e territórios de uma partida, sobre o mapa já reservado
+static int preencherMapa(Mapa* mapa, Jogador* jogadores, int numJogadores, int territorios) {
+    for (int j = 0; j < numJogadores; j++) {
+        snprintf(jogadores[j].nome, TAM_NOME, "Jogador%u", (unsigned) j % MAX_CORES);
+        snprintf(jogadores[j].cor, TAM_COR, "cor%u", (unsigned) j % MAX_CORES);
+        jogadores[j].idCor = mapaInternarCor(mapa, jogadores[j].cor);
+        jogadores[j].bot = 1;
+    }
+    for (int i = 0; i < territorios; i++) {
+        if (mapaAdicionar(mapa, "T", (IdCor) (i % numJogadores), 1) < 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Um malloc por jogador e por missão (copiada), mapa no heap; libera um a um
+static double medirHeap(int partidas, int numJogadores, int territorios, Aleatorio* rng) {
+    double inicio = agora();
+    for (int p = 0; p < partidas; p++) {
+        Mapa mapa;
+        Jogador* jogadores = (Jogador*) malloc(numJogadores * sizeof(Jogador));
+        if (jogadores == NULL || !mapaIniciar(&mapa, 0)) {
+            fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+            exit(1);
+        }
+        for (int j = 0; j < numJogadores; j++) {
+            Missao* missao = (Missao*) malloc(sizeof(Missao));
+            if (missao == NULL) {
+                fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+                exit(1);
+            }
+            *missao = *sortearMissao(MISSOES_PADRAO, NUM_MISSOES_PADRAO, rng);
+            jogadores[j].missao = missao;
+        }
+        if (!mapaReservar(&mapa, territorios) ||
+            !preencherMapa(&mapa, jogadores, numJogadores, territorios)) {
+            fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+            exit(1);
+        }
+        sumidouro += mapa.tropas[territorios - 1] + jogadores[0].missao->parametro;
+        for (int j = 0; j < numJogadores; j++) {
+            free((Missao*) jogadores[j].missao);
+        }
+        free(jogadores);
+        mapaLiberar(&mapa);
+    }
+    return (agora() - inicio) * 1e9 / partidas;
+}
+
+// Tudo na arena, zerada entre as partidas; missões apontam para a tabela
+static double medirArena(int partidas, int numJogadores, int territorios, Aleatorio* rng) {
+    Arena arena;
+    if (!arenaIniciar(&arena, 0)) {
+        fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+        exit(1);
+    }
+    double inicio = agora();
+    for (int p = 0; p < partidas; p++) {
+        Mapa mapa;
+        arenaZerar(&arena);
+        Jogador* jogadores = (Jogador*) arenaAlocar(&arena, numJogadores * sizeof(Jogador));
+        if (jogadores == NULL || !mapaIniciar(&mapa, 0)) {
+            fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+            exit(1);
+        }
+        for (int j = 0; j < numJogadores; j++) {
+            jogadores[j].missao = sortearMissao(MISSOES_PADRAO, NUM_MISSOES_PADRAO, rng);
+        }
+        if (!mapaReservarEm(&mapa, &arena, territorios) ||
+            !preencherMapa(&mapa, jogadores, numJogadores, territorios)) {
+            fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+            exit(1);
+        }
+        sumidouro += mapa.tropas[territorios - 1] + jogadores[0].missao->parametro;
+        mapaLiberar(&mapa);
+    }
+    double segundos = agora() - inicio;
+    arenaLiberar(&arena);
+    return segundos * 1e9 / partidas;
+}
+
+int main(int argc, char* argv[]) {
+    int partidas = (argc > 1) ? atoi(argv[1]) : 200000;
+    int jogadores = (argc > 2) ? atoi(argv[2]) : 6;
+    int territorios = (argc > 3) ? atoi(argv[3]) : 42;
+    if (partidas < 1 || jogadores < 1 || jogadores > MAX_CORES || territorios < 1) {
+        fprintf(stderr, "Uso: %s [partidas>=1] [jogadores 1..%d] [territorios>=1]\n",
+                argv[0], MAX_CORES);
+        return 1;
+    }
+
+    Aleatorio rng;
+    aleatorioSemear(&rng, 2025);
+    // Uma rodada de aquecimento de cada, para os dois partirem do heap já usado
+    medirHeap(partidas / 10 + 1, jogadores, territorios, &rng);
+    medirArena(partidas / 10 + 1, jogadores, territorios, &rng);
+
+    double heap = medirHeap(partidas, jogadores, territorios, &rng);
+    double arena = medirArena(partidas, jogadores, territorios, &rng);
+    printf("%d partidas, %d jogadores, %d territorios\n", partidas, jogadores, territorios);
+    printf("  malloc por jogador e missao: %8.1f ns/partida\n", heap);
+    printf("  arena zerada por partida:    %8.1f ns/partida (%.2fx)\n", arena, heap / arena);
+    return 0;
+}
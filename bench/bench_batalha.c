@@ -0,0 +1,160 @@
+/*
+ * Benchmark do motor de batalha
+ * 
+ * Mede quantos ataques por segundo executarLote consegue resolver sem
+ * saída, em cada regra de batalha, usando um mapa sintético com duas
+ * cores alternadas. Cada lote ataca pares disjuntos de vizinhos (cada
+ * território aparece em uma única ordem), então uma conquista nunca
+ * invalida uma ordem seguinte, e o mapa é restaurado entre os lotes.
+ * Na regra clássica executarLote rola por resolverRolagensLote, em
+ * blocos de ordens com territórios distintos. Depois compara só as
+ * rolagens: um dado de cada lado, três de cada lado ataque a ataque e
+ * três de cada lado por resolverRolagensLote.
+ * 
+ * Uso: bench_batalha [ataques] [territorios] [semente]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "nucleo/aleatorio.h"
+#include "nucleo/batalha.h"
+
+#define TAM_LOTE 4096
+#define TROPAS_INICIAIS 1000
+
+/*
+ * Função: agora
+ * 
+ * Retorno: tempo monotônico atual em segundos
+ */
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Impede que o compilador descarte as perdas calculadas
+static volatile long long sumidouro;
+
+static void medirLote(Mapa* mapa, RegraBatalha regra, const OrdemAtaque* ordens, int numOrdens,
+                      const IdCor* cores, long long totalAtaques, Aleatorio* rng) {
+    ResumoLote resumo = {0, 0, 0, 0};
+    double inicio = agora();
+
+    for (long long feitos = 0; feitos < totalAtaques; feitos += numOrdens) {
+        for (int i = 0; i < mapa->quantidade; i++) {
+            mapa->donos[i] = cores[i % 2];
+            mapa->tropas[i] = TROPAS_INICIAIS;
+        }
+        executarLote(mapa, regra, ordens, numOrdens, rng, &resumo, NULL);
+    }
+
+    double decorrido = agora() - inicio;
+
+    printf("regra %s\n", nomeRegra(regra));
+    printf("  ordens processadas : %lld\n", resumo.ordens);
+    printf("  ataques resolvidos : %lld (%lld conquistas, %lld invalidos)\n",
+           resumo.resolvidos, resumo.conquistas, resumo.invalidos);
+    printf("  tempo              : %.3f s\n", decorrido);
+    printf("  ataques/s          : %.2f M\n", resumo.resolvidos / decorrido / 1e6);
+    printf("  ns por ordem       : %.2f\n", decorrido * 1e9 / resumo.ordens);
+}
+
+// Só as rolagens: 1x1 e 3x3 dados ataque a ataque, e 3x3 em lote
+static void medirRolagens(long long totalAtaques, Aleatorio* rng) {
+    static uint8_t tres[TAM_LOTE], perdasA[TAM_LOTE], perdasD[TAM_LOTE];
+    ResultadoAtaque resultado;
+    long long soma = 0;
+    for (int i = 0; i < TAM_LOTE; i++) {
+        tres[i] = MAX_DADOS;
+    }
+
+    double inicio = agora();
+    for (long long k = 0; k < totalAtaques; k++) {
+        aplicarRegraAtaque(10, 10, rolarDado(rng), rolarDado(rng), &resultado);
+        soma += resultado.tropasAtacante;
+    }
+    double simples = agora() - inicio;
+
+    inicio = agora();
+    for (long long k = 0; k < totalAtaques; k++) {
+        uint8_t dados[2 * MAX_DADOS];
+        for (int j = 0; j < 2 * MAX_DADOS; j++) {
+            dados[j] = (uint8_t) rolarDado(rng);
+        }
+        aplicarRegraClassica(10, 10, dados, MAX_DADOS, dados + MAX_DADOS, MAX_DADOS, &resultado);
+        soma += resultado.perdasDefensor;
+    }
+    double escalar = agora() - inicio;
+
+    inicio = agora();
+    for (long long feitos = 0; feitos < totalAtaques; feitos += TAM_LOTE) {
+        resolverRolagensLote(rng, tres, tres, TAM_LOTE, perdasA, perdasD);
+        soma += perdasD[0];
+    }
+    double lote = agora() - inicio;
+    sumidouro += soma;
+
+    printf("rolagens\n");
+    printf("  1x1 dado, um a um  : %.2f ns/ataque\n", simples * 1e9 / totalAtaques);
+    printf("  3x3 dados, um a um : %.2f ns/ataque\n", escalar * 1e9 / totalAtaques);
+    printf("  3x3 dados, em lote : %.2f ns/ataque\n", lote * 1e9 / totalAtaques);
+}
+
+int main(int argc, char* argv[]) {
+    long long totalAtaques = (argc > 1) ? atoll(argv[1]) : 50000000LL;
+    int tamanho = (argc > 2) ? atoi(argv[2]) : 1024;
+    uint64_t semente = (argc > 3) ? strtoull(argv[3], NULL, 10) : 12345;
+
+    if (totalAtaques <= 0 || tamanho < 2) {
+        fprintf(stderr, "Uso: %s [ataques] [territorios>=2] [semente]\n", argv[0]);
+        return 1;
+    }
+
+    Aleatorio rng;
+    aleatorioSemear(&rng, semente);
+
+    Mapa mapa;
+    OrdemAtaque* ordens = (OrdemAtaque*) malloc(TAM_LOTE * sizeof(OrdemAtaque));
+    if (!mapaIniciar(&mapa, tamanho) || ordens == NULL) {
+        fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+        return 1;
+    }
+
+    // Mapa com cores alternadas: todo par (i, i+1) é um ataque válido
+    IdCor cores[2] = {mapaInternarCor(&mapa, "azul"), mapaInternarCor(&mapa, "verde")};
+    char nome[TAM_NOME];
+    for (int i = 0; i < tamanho; i++) {
+        snprintf(nome, TAM_NOME, "T%d", i);
+        mapaAdicionar(&mapa, nome, cores[i % 2], TROPAS_INICIAIS);
+    }
+
+    // Pares (2p, 2p+1) em ordem embaralhada e sentido sorteado: todos válidos até o fim do lote
+    int numOrdens = (tamanho / 2 < TAM_LOTE) ? tamanho / 2 : TAM_LOTE;
+    for (int i = 0; i < numOrdens; i++) {
+        ordens[i].atacante = 2 * i;
+    }
+    for (int i = numOrdens - 1; i > 0; i--) {
+        int j = (int) aleatorioLimitado(&rng, (uint32_t) (i + 1));
+        int par = ordens[i].atacante;
+        ordens[i].atacante = ordens[j].atacante;
+        ordens[j].atacante = par;
+    }
+    for (int i = 0; i < numOrdens; i++) {
+        int par = ordens[i].atacante;
+        int invertido = (int) aleatorioLimitado(&rng, 2);
+        ordens[i].atacante = par + invertido;
+        ordens[i].defensor = par + 1 - invertido;
+    }
+
+    for (int r = 0; r < NUM_REGRAS; r++) {
+        medirLote(&mapa, (RegraBatalha) r, ordens, numOrdens, cores, totalAtaques, &rng);
+    }
+    medirRolagens(totalAtaques, &rng);
+
+    free(ordens);
+    mapaLiberar(&mapa);
+    return 0;
+}
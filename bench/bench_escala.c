@@ -0,0 +1,508 @@
+/*
+ * Curvas de escala das jogadas
+ * 
+ * Gera mapas sintéticos (gerador.h) de 10 territórios até o maior
+ * tamanho pedido, multiplicando por 10, e mede em cada um o custo do que
+ * o jogo faz a cada jogada: verificarMissao de cada tipo, a verificação
+ * de vitória de todos os jogadores (jogadorVencedor, o laço de
+ * verificarVitoria), a contagem por cor no layout original
+ * (contarTerritoriosPorCor, com strcmp) e no Mapa, o resumo de todas as
+ * cores de uma vez (mapaResumirCores, sem e com o pool) contra uma
+ * varredura por cor, e lotes de ataques entre vizinhos, também como um
+ * turno em lote (executarTurno) com uma única verificação de vitória. As missões são medidas com o mapa varrido a cada
+ * verificação e com as estatísticas incrementais.
+ * 
+ * Cada medição repete a operação até somar um tempo mínimo, então
+ * varreduras de mapas grandes não dominam a execução. No fim, cada caso
+ * recebe o expoente da curva (inclinação de log(custo) x log(tamanho)
+ * entre os dois maiores mapas): perto de 0 o custo por operação não
+ * depende do tamanho, perto de 1 ele cresce com o mapa. "jogada" soma
+ * um ataque e a verificação de vitória incremental de jogadores com as
+ * missões mais caras (nenhuma cumprida), e é comparada com o orçamento
+ * por jogada; a saída é 3 se algum tamanho passar do orçamento. O
+ * turno em lote mostra o mesmo custo por ataque quando a vitória é
+ * conferida uma vez por turno.
+ * 
+ * Uso: bench_escala [opções]
+ *   --maior N           maior mapa (padrão 1000000; 10000000 precisa de ~1,5 GB)
+ *   --cores N           cores e jogadores (padrão 4)
+ *   --tropas D          uniforme, geometrica ou concentrada
+ *   --bloco N           comprimento médio das sequências de mesma cor (padrão 4)
+ *   --grau G            fronteiras por território (padrão 4)
+ *   --orcamento-us U    orçamento por jogada em microssegundos (padrão 100)
+ *   --csv ARQ           uma linha por medição (secao,caso,tamanho,valor,unidade)
+ *   --rapido            tempo mínimo por medição de 20 ms em vez de 200 ms
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "nucleo/aleatorio.h"
+#include "nucleo/batalha.h"
+#include "nucleo/estatisticas.h"
+#include "nucleo/gerador.h"
+#include "nucleo/grafo.h"
+#include "nucleo/missao.h"
+#include "nucleo/pool.h"
+#include "nucleo/territorio.h"
+#include "nucleo/turno.h"
+#include "nucleo/varredura.h"
+
+// Tempo mínimo de cada medição, em segundos, no modo normal e no rápido
+#define TEMPO_POR_MEDICAO 0.2
+#define TEMPO_POR_MEDICAO_RAPIDO 0.02
+
+// Ataques por lote e tamanhos medidos (10^1 .. 10^8)
+#define ATAQUES_POR_LOTE 1024
+#define MAX_TAMANHOS 8
+
+// Casos com curva (as linhas da tabela final)
+#define MAX_CASOS 24
+
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Impede que o compilador descarte os resultados medidos
+static volatile long long sumidouro;
+
+/*
+ * Struct Curva
+ * 
+ * Custo de um caso em cada tamanho medido.
+ */
+typedef struct {
+    char secao[16];
+    char caso[40];
+    const char* unidade;
+    double valores[MAX_TAMANHOS];
+} Curva;
+
+static Curva curvas[MAX_CASOS];
+static int numCurvas;
+static int numTamanhos;
+static int tamanhos[MAX_TAMANHOS];
+static FILE* csv;
+
+// Registra uma medição no tamanho atual (numTamanhos - 1)
+static double registrar(const char* secao, const char* caso, double valor, const char* unidade) {
+    int tamanho = tamanhos[numTamanhos - 1];
+    printf("%-10s %-30s %10d %14.2f %s\n", secao, caso, tamanho, valor, unidade);
+    if (csv != NULL) {
+        fprintf(csv, "%s,%s,%d,%.3f,%s\n", secao, caso, tamanho, valor, unidade);
+    }
+    Curva* curva = NULL;
+    for (int c = 0; c < numCurvas; c++) {
+        if (strcmp(curvas[c].secao, secao) == 0 && strcmp(curvas[c].caso, caso) == 0) {
+            curva = &curvas[c];
+        }
+    }
+    if (curva == NULL && numCurvas < MAX_CASOS) {
+        curva = &curvas[numCurvas++];
+        snprintf(curva->secao, sizeof(curva->secao), "%s", secao);
+        snprintf(curva->caso, sizeof(curva->caso), "%s", caso);
+        curva->unidade = unidade;
+    }
+    if (curva != NULL) {
+        curva->valores[numTamanhos - 1] = valor;
+    }
+    return valor;
+}
+
+static double tempoMinimo = TEMPO_POR_MEDICAO;
+
+/*
+ * Struct Contexto
+ * 
+ * Argumentos das operações medidas; a repetição r usa a cor r % numJogadores.
+ */
+typedef struct {
+    const Mapa* mapa;
+    const Jogador* jogadores;
+    int numJogadores;
+    const Missao* missao;
+    const Territorio* territorios;
+    Pool* pool;
+} Contexto;
+
+typedef long long (*Operacao)(const Contexto* ctx, long long r);
+
+static long long opMissao(const Contexto* ctx, long long r) {
+    return verificarMissao(ctx->missao, ctx->mapa, ctx->jogadores[r % ctx->numJogadores].idCor);
+}
+
+static long long opVitoria(const Contexto* ctx, long long r) {
+    (void) r;
+    return jogadorVencedor(ctx->jogadores, ctx->numJogadores, ctx->mapa);
+}
+
+static long long opContarTerritorios(const Contexto* ctx, long long r) {
+    return contarTerritoriosPorCor(ctx->territorios, ctx->mapa->quantidade,
+                                   ctx->jogadores[r % ctx->numJogadores].cor);
+}
+
+static long long opContarPorDono(const Contexto* ctx, long long r) {
+    return mapaContarPorDono(ctx->mapa, ctx->jogadores[r % ctx->numJogadores].idCor);
+}
+
+// Territórios e tropas de todas as cores, uma varredura por cor (o menu antes do resumo)
+static long long opVarrerPorCor(const Contexto* ctx, long long r) {
+    (void) r;
+    long long total = 0;
+    for (int j = 0; j < ctx->numJogadores; j++) {
+        total += mapaContarPorDono(ctx->mapa, ctx->jogadores[j].idCor);
+        total += mapaSomarTropas(ctx->mapa, ctx->jogadores[j].idCor);
+    }
+    return total;
+}
+
+static long long opResumirCores(const Contexto* ctx, long long r) {
+    ResumoCores resumo;
+    mapaResumirCores(ctx->mapa, ctx->pool, &resumo);
+    IdCor cor = ctx->jogadores[r % ctx->numJogadores].idCor;
+    return resumo.territorios[cor] + resumo.tropas[cor];
+}
+
+// Repete a operação em lotes que dobram até passar do tempo mínimo; devolve ns por operação
+static double cronometrar(Operacao operacao, const Contexto* ctx) {
+    long long repeticoes = 0;
+    double inicio = agora(), segundos;
+    for (long long lote = 1;; lote *= 2) {
+        for (long long r = 0; r < lote; r++, repeticoes++) {
+            sumidouro += operacao(ctx, repeticoes);
+        }
+        segundos = agora() - inicio;
+        if (segundos >= tempoMinimo) {
+            break;
+        }
+    }
+    return segundos * 1e9 / repeticoes;
+}
+
+// Uma missão de cada tipo, calibrada para não ser cumprida (a verificação vai até o fim)
+static void medirMissoes(const Contexto* base, int incremental) {
+    int tamanho = base->mapa->quantidade;
+    Contexto ctx = *base;
+    for (int t = 0; t < NUM_TIPOS_MISSAO; t++) {
+        int parametro = (t == MISSAO_PERCENTUAL) ? 90 : (t == MISSAO_TROPAS) ? 1000000000 : tamanho;
+        Missao missao = {(TipoMissao) t, parametro, ""};
+        ctx.missao = &missao;
+        char caso[40];
+        snprintf(caso, sizeof(caso), "%s (%s)", nomeTipoMissao((TipoMissao) t),
+                 incremental ? "incremental" : "varredura");
+        registrar("missao", caso, cronometrar(opMissao, &ctx), "ns/verificacao");
+    }
+}
+
+// Vitória de todos os jogadores, com nenhuma missão cumprida
+static double medirVitoria(const Contexto* ctx, int incremental) {
+    return registrar("vitoria", incremental ? "jogadorVencedor (incremental)"
+                                            : "jogadorVencedor (varredura)",
+                     cronometrar(opVitoria, ctx), "ns/verificacao");
+}
+
+// Contagem de uma cor no vetor de Territorio (strcmp) e no Mapa (IdCor)
+static int medirContagem(const Contexto* base) {
+    const Mapa* mapa = base->mapa;
+    Territorio* territorios = (Territorio*) malloc((size_t) mapa->quantidade * sizeof(Territorio));
+    if (territorios == NULL) {
+        return 0;
+    }
+    for (int i = 0; i < mapa->quantidade; i++) {
+        mapaObterTerritorio(mapa, i, &territorios[i]);
+    }
+    Contexto ctx = *base;
+    ctx.territorios = territorios;
+    registrar("contagem", "contarTerritoriosPorCor", cronometrar(opContarTerritorios, &ctx),
+              "ns/contagem");
+    free(territorios);
+    registrar("contagem", "mapaContarPorDono", cronometrar(opContarPorDono, base), "ns/contagem");
+
+    // Todas as cores: uma varredura por cor contra o resumo de uma varredura só
+    registrar("resumo", "contar + somar por cor", cronometrar(opVarrerPorCor, base), "ns/resumo");
+    ctx = *base;
+    ctx.pool = NULL;
+    registrar("resumo", "mapaResumirCores", cronometrar(opResumirCores, &ctx), "ns/resumo");
+    if (base->pool != NULL) {
+        registrar("resumo", "mapaResumirCores (pool)", cronometrar(opResumirCores, base),
+                  "ns/resumo");
+    }
+    return 1;
+}
+
+// Ordens de ataque de um vizinho sorteado contra outro de cor diferente
+static int sortearOrdens(Mapa* mapa, Aleatorio* rng, OrdemAtaque* ordens) {
+    const Grafo* grafo = mapa->grafo;
+    int numOrdens = 0;
+    for (int tentativa = 0; numOrdens < ATAQUES_POR_LOTE && tentativa < 8 * ATAQUES_POR_LOTE;
+         tentativa++) {
+        int a = (int) aleatorioLimitado(rng, (uint32_t) mapa->quantidade);
+        int grau = grafo->inicio[a + 1] - grafo->inicio[a];
+        if (grau == 0) {
+            continue;
+        }
+        int d = grafo->vizinhos[grafo->inicio[a] + (int) aleatorioLimitado(rng, (uint32_t) grau)];
+        if (mapa->donos[a] == mapa->donos[d]) {
+            continue;
+        }
+        // Reabastece o atacante para que o mapa não se esgote entre os lotes
+        if (mapa->tropas[a] < 2) {
+            mapaDefinirTropas(mapa, a, 10);
+        }
+        ordens[numOrdens].atacante = a;
+        ordens[numOrdens].defensor = d;
+        numOrdens++;
+    }
+    return numOrdens;
+}
+
+// Devolve aos donos originais os territórios conquistados no lote, para o mapa não se uniformizar
+static void restaurarDonos(Mapa* mapa, const IdCor* originais, const OrdemAtaque* ordens,
+                           int numOrdens) {
+    for (int k = 0; k < numOrdens; k++) {
+        int d = ordens[k].defensor;
+        if (mapa->donos[d] != originais[d]) {
+            mapaDefinirDono(mapa, d, originais[d]);
+        }
+    }
+}
+
+// Lotes de ataques resolvidos um a um (como atacar) e por executarLote
+static double medirAtaques(Mapa* mapa, Aleatorio* rng) {
+    OrdemAtaque ordens[ATAQUES_POR_LOTE];
+    IdCor* originais = (IdCor*) malloc((size_t) mapa->quantidade * sizeof(IdCor));
+    if (originais == NULL) {
+        return 0.0;
+    }
+    memcpy(originais, mapa->donos, (size_t) mapa->quantidade * sizeof(IdCor));
+
+    double segundos = 0.0;
+    long long resolvidos = 0;
+    while (segundos < tempoMinimo) {
+        int numOrdens = sortearOrdens(mapa, rng, ordens);
+        double inicio = agora();
+        for (int k = 0; k < numOrdens; k++) {
+            ResultadoAtaque resultado;
+            if (rolarAtaque(mapa, REGRA_SIMPLES, ordens[k].atacante, ordens[k].defensor, rng,
+                            &resultado) == ATAQUE_OK) {
+                resolvidos++;
+            }
+        }
+        segundos += agora() - inicio;
+        restaurarDonos(mapa, originais, ordens, numOrdens);
+    }
+    double porAtaque = registrar("batalha", "rolarAtaque (lote)",
+                                 segundos * 1e9 / (resolvidos > 0 ? resolvidos : 1), "ns/ataque");
+
+    ResumoLote resumo;
+    memset(&resumo, 0, sizeof(resumo));
+    segundos = 0.0;
+    while (segundos < tempoMinimo) {
+        int numOrdens = sortearOrdens(mapa, rng, ordens);
+        double inicio = agora();
+        executarLote(mapa, REGRA_SIMPLES, ordens, numOrdens, rng, &resumo, NULL);
+        segundos += agora() - inicio;
+        restaurarDonos(mapa, originais, ordens, numOrdens);
+    }
+    registrar("batalha", "executarLote", segundos * 1e9 / (resumo.ordens > 0 ? resumo.ordens : 1),
+              "ns/ordem");
+    free(originais);
+    return porAtaque;
+}
+
+/*
+ * Função: medirTurno
+ * 
+ * Ataques de uma cor por turno: as ordens sorteadas do atacante da
+ * primeira ordem viram um lote de executarTurno, seguido de uma única
+ * verificação de vitória de todos os jogadores.
+ * 
+ * Retorno: custo por ataque resolvido, em ns, com a vitória incluída
+ */
+static double medirTurno(const Contexto* ctx, Mapa* mapa, Aleatorio* rng) {
+    OrdemAtaque sorteadas[ATAQUES_POR_LOTE];
+    OrdemTurno ordens[MAX_ORDENS_TURNO];
+    ResultadoOrdem resultados[MAX_ORDENS_TURNO];
+    IdCor* originais = (IdCor*) malloc((size_t) mapa->quantidade * sizeof(IdCor));
+    if (originais == NULL) {
+        return 0.0;
+    }
+    memcpy(originais, mapa->donos, (size_t) mapa->quantidade * sizeof(IdCor));
+
+    double segundos = 0.0;
+    long long resolvidos = 0;
+    while (segundos < tempoMinimo) {
+        int numSorteadas = sortearOrdens(mapa, rng, sorteadas);
+        if (numSorteadas == 0) {
+            break;
+        }
+        IdCor cor = mapa->donos[sorteadas[0].atacante];
+        int numOrdens = 0;
+        for (int k = 0; k < numSorteadas && numOrdens < MAX_ORDENS_TURNO; k++) {
+            if (mapa->donos[sorteadas[k].atacante] == cor) {
+                OrdemTurno ordem = {sorteadas[k].atacante, sorteadas[k].defensor,
+                                    POLITICA_UMA_VEZ, 1};
+                ordens[numOrdens++] = ordem;
+            }
+        }
+        double inicio = agora();
+        executarTurno(mapa, REGRA_SIMPLES, cor, ordens, numOrdens, rng, resultados, NULL, NULL);
+        sumidouro += jogadorVencedor(ctx->jogadores, ctx->numJogadores, mapa);
+        segundos += agora() - inicio;
+        for (int k = 0; k < numOrdens; k++) {
+            resolvidos += resultados[k].rolagens;
+        }
+        restaurarDonos(mapa, originais, sorteadas, numSorteadas);
+    }
+    free(originais);
+    return segundos * 1e9 / (resolvidos > 0 ? resolvidos : 1);
+}
+
+static int uso(const char* programa) {
+    fprintf(stderr,
+            "Uso: %s [--maior N] [--cores N] [--tropas D] [--bloco N] [--grau G]\n"
+            "       [--orcamento-us U] [--csv ARQ] [--rapido]\n"
+            "D: uniforme, geometrica ou concentrada\n",
+            programa);
+    return 2;
+}
+
+int main(int argc, char* argv[]) {
+    int maior = 1000000;
+    ConfigGerador base;
+    geradorPadrao(&base, 0);
+    double orcamentoUs = 100.0;
+    const char* caminhoCsv = NULL;
+    for (int i = 1; i < argc; i++) {
+        int temValor = i + 1 < argc;
+        if (strcmp(argv[i], "--rapido") == 0) {
+            tempoMinimo = TEMPO_POR_MEDICAO_RAPIDO;
+        } else if (strcmp(argv[i], "--maior") == 0 && temValor) {
+            maior = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--cores") == 0 && temValor) {
+            base.cores = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--tropas") == 0 && temValor) {
+            if (!distribuicaoPorNome(argv[++i], &base.distribuicao)) {
+                return uso(argv[0]);
+            }
+        } else if (strcmp(argv[i], "--bloco") == 0 && temValor) {
+            base.bloco = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--grau") == 0 && temValor) {
+            base.grau = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--orcamento-us") == 0 && temValor) {
+            orcamentoUs = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--csv") == 0 && temValor) {
+            caminhoCsv = argv[++i];
+        } else {
+            return uso(argv[0]);
+        }
+    }
+    if (maior < 10 || base.cores < 2 || base.cores > MAX_CORES || base.bloco < 1 ||
+        base.grau < 0.0 || orcamentoUs <= 0.0) {
+        return uso(argv[0]);
+    }
+    if (caminhoCsv != NULL) {
+        csv = fopen(caminhoCsv, "w");
+        if (csv == NULL) {
+            fprintf(stderr, "%s: nao foi possivel criar o arquivo\n", caminhoCsv);
+            return 1;
+        }
+        fprintf(csv, "secao,caso,tamanho,valor,unidade\n");
+    }
+
+    printf("Mapas: %d cores, tropas %s ate %d, blocos de %d, grau %.1f\n", base.cores,
+           nomeDistribuicao(base.distribuicao), base.tropasMaximas, base.bloco, base.grau);
+    printf("%-10s %-30s %10s %14s %s\n", "secao", "caso", "tamanho", "valor", "unidade");
+
+    Aleatorio rng;
+    aleatorioSemear(&rng, base.semente);
+    // Sem pool, o resumo paralelo só não é medido
+    Pool* pool = poolCriar(0);
+    double jogadas[MAX_TAMANHOS];
+    for (long long tamanho = 10; tamanho <= maior && numTamanhos < MAX_TAMANHOS; tamanho *= 10) {
+        tamanhos[numTamanhos++] = (int) tamanho;
+        ConfigGerador config;
+        geradorPadrao(&config, (int) tamanho);
+        config.cores = base.cores;
+        config.distribuicao = base.distribuicao;
+        config.bloco = base.bloco;
+        config.grau = base.grau;
+
+        Mapa mapa;
+        Arena arena;
+        Jogador* jogadores = NULL;
+        int numJogadores = 0;
+        double inicio = agora();
+        if (!arenaIniciar(&arena, 4096) || !mapaIniciar(&mapa, 0) ||
+            !geradorCriar(&config, &mapa, &arena, &jogadores, &numJogadores) ||
+            !mapaAtivarPosse(&mapa)) {
+            fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+            return 1;
+        }
+        registrar("gerador", "geradorCriar", (agora() - inicio) * 1e9 / tamanho, "ns/territorio");
+
+        // Missões que o mapa sintético não cumpre: a verificação de vitória passa por todas
+        Missao dificeis[] = {
+            {MISSAO_CONSECUTIVOS, (int) tamanho, ""}, {MISSAO_PERCENTUAL, 90, ""},
+            {MISSAO_ELIMINAR, 0, ""}, {MISSAO_TROPAS, 1000000000, ""}
+        };
+        for (int j = 0; j < numJogadores; j++) {
+            jogadores[j].missao = &dificeis[j % 4];
+        }
+
+        Contexto ctx = {&mapa, jogadores, numJogadores, NULL, NULL, pool};
+        if (!medirContagem(&ctx)) {
+            fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+            return 1;
+        }
+        medirMissoes(&ctx, 0);
+        medirVitoria(&ctx, 0);
+        mapa.estatisticas = estatisticasCriar(&mapa);
+        if (mapa.estatisticas == NULL) {
+            fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+            return 1;
+        }
+        medirMissoes(&ctx, 1);
+        double vitoria = medirVitoria(&ctx, 1);
+        double ataque = medirAtaques(&mapa, &rng);
+        jogadas[numTamanhos - 1] = registrar("jogada", "ataque + vitoria", (ataque + vitoria) / 1e3,
+                                             "us/jogada");
+        registrar("jogada", "turno em lote (por ataque)", medirTurno(&ctx, &mapa, &rng) / 1e3,
+                  "us/ataque");
+        mapaLiberar(&mapa);
+        arenaLiberar(&arena);
+    }
+
+    printf("\n%-10s %-30s %9s  (custo por operacao: 0 = constante, 1 = linear)\n", "secao", "caso",
+           "expoente");
+    for (int c = 0; c < numCurvas && numTamanhos > 1; c++) {
+        const Curva* curva = &curvas[c];
+        double antes = curva->valores[numTamanhos - 2], depois = curva->valores[numTamanhos - 1];
+        double escala = (double) tamanhos[numTamanhos - 1] / tamanhos[numTamanhos - 2];
+        // Custos por território já estão divididos pelo tamanho: volta ao custo total
+        double ajuste = (strcmp(curva->unidade, "ns/territorio") == 0) ? 1.0 : 0.0;
+        double expoente = (antes > 0.0 && depois > 0.0) ? log(depois / antes) / log(escala) + ajuste
+                                                        : 0.0;
+        printf("%-10s %-30s %9.2f\n", curva->secao, curva->caso, expoente);
+    }
+
+    printf("\nOrcamento por jogada: %.1f us\n", orcamentoUs);
+    int estourou = 0;
+    for (int t = 0; t < numTamanhos; t++) {
+        int dentro = jogadas[t] <= orcamentoUs;
+        printf("  %10d territorios: %8.3f us  %s\n", tamanhos[t], jogadas[t],
+               dentro ? "dentro" : "ACIMA");
+        estourou |= !dentro;
+    }
+    poolDestruir(pool);
+    if (csv != NULL && fclose(csv) != 0) {
+        fprintf(stderr, "ERRO: falha na escrita do CSV\n");
+        return 1;
+    }
+    return estourou ? 3 : 0;
+}
@@ -0,0 +1,59 @@
+/*
+ * Benchmark do estimador de Monte Carlo
+ * 
+ * Roda a mesma estimativa com 1, 2, 4 e 8 threads, em cada regra de
+ * batalha, e mostra o tempo e o ganho (speedup) em relação à execução
+ * com uma thread.
+ * 
+ * Uso: bench_estimador [simulacoes] [tropasAtacante] [tropasDefensor]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "nucleo/estimador.h"
+#include "nucleo/pool.h"
+
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char* argv[]) {
+    long long simulacoes = (argc > 1) ? atoll(argv[1]) : 20000000LL;
+    int tropasAtacante = (argc > 2) ? atoi(argv[2]) : 10;
+    int tropasDefensor = (argc > 3) ? atoi(argv[3]) : 5;
+    const int threads[] = {1, 2, 4, 8};
+
+    printf("nucleos disponiveis: %d\n", numeroNucleos());
+    printf("%-9s %8s %10s %12s %10s %10s\n", "regra", "threads", "tempo(s)", "batalhas/s",
+           "speedup", "P(conq)");
+
+    for (int r = 0; r < NUM_REGRAS; r++) {
+        double base = 0.0;
+        for (int i = 0; i < 4; i++) {
+            Pool* pool = poolCriar(threads[i]);
+            if (pool == NULL) {
+                fprintf(stderr, "ERRO: Falha ao criar o pool de threads!\n");
+                return 1;
+            }
+
+            Estimativa e;
+            double inicio = agora();
+            estimarConquista((RegraBatalha) r, tropasAtacante, tropasDefensor, simulacoes, 42,
+                             pool, &e);
+            double decorrido = agora() - inicio;
+            if (i == 0) {
+                base = decorrido;
+            }
+
+            printf("%-9s %8d %10.3f %11.2fM %9.2fx %10.4f\n", nomeRegra((RegraBatalha) r),
+                   threads[i], decorrido, simulacoes / decorrido / 1e6, base / decorrido,
+                   e.probabilidade);
+            poolDestruir(pool);
+        }
+    }
+    return 0;
+}
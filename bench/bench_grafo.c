@@ -0,0 +1,139 @@
+/*
+ * Benchmark do grafo de fronteiras
+ * 
+ * Monta um mapa com fronteiras aleatórias (uma cadeia mais arestas
+ * extras sorteadas, grau médio perto de 6), ativa os conjuntos de bits
+ * de posse e mede: teste de fronteira, troca de dono e consulta de
+ * "N territórios conectados" para alguns valores de N, comparando com a
+ * varredura por strcmp do vetor de Territorio.
+ * 
+ * Uso: bench_grafo [territorios] [cores]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "nucleo/aleatorio.h"
+#include "nucleo/grafo.h"
+#include "nucleo/mapa.h"
+#include "nucleo/territorio.h"
+
+// Quantidade de repetições de cada consulta
+#define CONSULTAS 100000
+#define CONSULTAS_BFS 2000
+
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Impede que o compilador descarte os resultados das consultas
+static volatile long long sumidouro;
+
+int main(int argc, char* argv[]) {
+    int n = (argc > 1) ? atoi(argv[1]) : 100000;
+    int numCores = (argc > 2) ? atoi(argv[2]) : 4;
+    if (n < 10 || numCores < 2 || numCores > MAX_CORES) {
+        fprintf(stderr, "Uso: %s [territorios>=10] [cores 2..%d]\n", argv[0], MAX_CORES);
+        return 1;
+    }
+
+    Aleatorio rng;
+    aleatorioSemear(&rng, 2025);
+
+    Mapa mapa;
+    Territorio* vetor = (Territorio*) calloc(n, sizeof(Territorio));
+    long numArestas = (long) n * 3;
+    int32_t (*arestas)[2] = malloc(numArestas * sizeof(*arestas));
+    Grafo* grafo = (Grafo*) malloc(sizeof(Grafo));
+    if (vetor == NULL || arestas == NULL || grafo == NULL || !mapaIniciar(&mapa, n)) {
+        fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+        return 1;
+    }
+
+    char cor[TAM_COR], nome[TAM_NOME];
+    for (int c = 0; c < numCores; c++) {
+        snprintf(cor, TAM_COR, "cor%d", c);
+        mapaInternarCor(&mapa, cor);
+    }
+    for (int i = 0; i < n; i++) {
+        IdCor dono = (IdCor) aleatorioLimitado(&rng, (uint32_t) numCores);
+        snprintf(nome, TAM_NOME, "T%d", i);
+        mapaAdicionar(&mapa, nome, dono, 1);
+        mapaObterTerritorio(&mapa, i, &vetor[i]);
+    }
+
+    // Cadeia i -- i+1 mais arestas aleatórias entre territórios próximos
+    long e = 0;
+    for (int i = 0; i + 1 < n; i++, e++) {
+        arestas[e][0] = i;
+        arestas[e][1] = i + 1;
+    }
+    for (; e < numArestas; e++) {
+        int a = (int) aleatorioLimitado(&rng, (uint32_t) n);
+        int b = a + 2 + (int) aleatorioLimitado(&rng, 64);
+        arestas[e][0] = a;
+        arestas[e][1] = (b < n) ? b : n - 1;
+    }
+
+    double inicio = agora();
+    if (!grafoCriarDeArestas(grafo, n, (const int32_t (*)[2]) arestas, numArestas) ||
+        !mapaDefinirGrafo(&mapa, grafo) || !mapaAtivarPosse(&mapa)) {
+        fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+        return 1;
+    }
+    double tempoCriacao = agora() - inicio;
+    free(arestas);
+
+    printf("Territorios: %d, fronteiras: %d, cores: %d\n", n, grafo->numEntradas / 2, numCores);
+    printf("%-34s %12.3f ms\n", "montagem do CSR", tempoCriacao * 1e3);
+
+    // Teste de fronteira
+    long long soma = 0;
+    inicio = agora();
+    for (int k = 0; k < CONSULTAS; k++) {
+        int a = (int) aleatorioLimitado(&rng, (uint32_t) n);
+        int b = a + (int) aleatorioLimitado(&rng, 66) - 33;
+        soma += (b >= 0 && b < n) ? grafoAdjacentes(grafo, a, b) : 0;
+    }
+    printf("%-34s %12.1f ns\n", "grafoAdjacentes", (agora() - inicio) / CONSULTAS * 1e9);
+
+    // Troca de dono mantendo os conjuntos de bits
+    inicio = agora();
+    for (int k = 0; k < CONSULTAS; k++) {
+        int i = (int) aleatorioLimitado(&rng, (uint32_t) n);
+        mapaDefinirDono(&mapa, i, (IdCor) aleatorioLimitado(&rng, (uint32_t) numCores));
+    }
+    printf("%-34s %12.1f ns\n", "mapaDefinirDono com posse", (agora() - inicio) / CONSULTAS * 1e9);
+
+    for (int i = 0; i < n; i++) {
+        mapaObterTerritorio(&mapa, i, &vetor[i]);
+    }
+
+    // Consultas de N territórios conectados
+    int alvos[] = {3, 10, 100};
+    for (size_t t = 0; t < sizeof(alvos) / sizeof(alvos[0]); t++) {
+        char rotulo[64];
+        inicio = agora();
+        for (int k = 0; k < CONSULTAS_BFS; k++) {
+            soma += mapaConectados(&mapa, (IdCor) (k % numCores), alvos[t]);
+        }
+        snprintf(rotulo, sizeof(rotulo), "conectados N=%d (BFS por cor)", alvos[t]);
+        printf("%-34s %12.2f us\n", rotulo, (agora() - inicio) / CONSULTAS_BFS * 1e6);
+    }
+
+    // Referência: varredura por strcmp do vetor (só índices vizinhos, N=100)
+    inicio = agora();
+    for (int k = 0; k < 100; k++) {
+        soma += verificarTerritoriosConsecutivos(vetor, n, mapa.cores[k % numCores], 100);
+    }
+    printf("%-34s %12.2f us\n", "varredura strcmp do vetor N=100", (agora() - inicio) / 100 * 1e6);
+
+    sumidouro = soma;
+    mapaLiberar(&mapa);
+    free(vetor);
+    return 0;
+}
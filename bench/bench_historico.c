@@ -0,0 +1,170 @@
+/*
+ * Benchmark do histórico de versões
+ * 
+ * Em um mapa grande (fronteiras lineares, duas cores alternadas), compara
+ * o custo de abrir e descartar um ramo "e se?" pelo histórico com o de
+ * copiar o mapa inteiro, e mede desfazer/refazer e a sincronização das
+ * cópias da IA com e sem a lista de alterados do histórico.
+ * 
+ * Uso: bench_historico [territorios] [ramos] [ataquesPorRamo]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "nucleo/aleatorio.h"
+#include "nucleo/batalha.h"
+#include "nucleo/estatisticas.h"
+#include "nucleo/grafo.h"
+#include "nucleo/historico.h"
+#include "nucleo/ia.h"
+#include "nucleo/missao.h"
+
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Um ataque válido entre vizinhos sorteados (tenta até achar um)
+static void atacarAoAcaso(Mapa* mapa, Aleatorio* rng) {
+    for (;;) {
+        int a = (int) aleatorioLimitado(rng, (uint32_t) (mapa->quantidade - 1));
+        int d = a + 1;
+        if (aleatorioLimitado(rng, 2)) {
+            d = a;
+            a = a + 1;
+        }
+        if (mapa->donos[a] != mapa->donos[d] && mapa->tropas[a] >= 2) {
+            ResultadoAtaque resultado;
+            if (mapa->historico != NULL) {
+                historicoIniciarJogada(mapa->historico);
+            }
+            resolverAtaque(mapa, a, d, rolarDado(rng), rolarDado(rng), &resultado);
+            return;
+        }
+    }
+}
+
+// Tempo médio de uma escolha da IA depois de um ataque, em microssegundos
+static double medirIA(Mapa* mapa, IA* ia, const Missao* missao, Aleatorio* rng, int jogadas) {
+    JogadaIA jogada;
+    double total = 0.0;
+    for (int k = 0; k < jogadas; k++) {
+        atacarAoAcaso(mapa, rng);
+        double inicio = agora();
+        if (!iaEscolherAtaque(ia, mapa, missao, 0, REGRA_SIMPLES, 0, &jogada)) {
+            fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+            exit(1);
+        }
+        total += agora() - inicio;
+    }
+    return total * 1e6 / jogadas;
+}
+
+int main(int argc, char* argv[]) {
+    int tamanho = (argc > 1) ? atoi(argv[1]) : 1000000;
+    int ramos = (argc > 2) ? atoi(argv[2]) : 200;
+    int ataques = (argc > 3) ? atoi(argv[3]) : 20;
+    if (tamanho < 2 || ramos < 1 || ataques < 1) {
+        fprintf(stderr, "Uso: %s [territorios>=2] [ramos>=1] [ataquesPorRamo>=1]\n", argv[0]);
+        return 1;
+    }
+
+    Mapa mapa, copia;
+    Grafo* grafo = (Grafo*) malloc(sizeof(Grafo));
+    if (grafo == NULL || !mapaIniciar(&mapa, tamanho) || !mapaIniciar(&copia, 0)) {
+        fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+        return 1;
+    }
+    mapaInternarCor(&mapa, "azul");
+    mapaInternarCor(&mapa, "verde");
+    for (int i = 0; i < tamanho; i++) {
+        mapaAdicionar(&mapa, "T", (IdCor) (i % 2), 1000000);
+    }
+    if (!grafoCriarLinear(grafo, tamanho) || !mapaDefinirGrafo(&mapa, grafo) ||
+        !mapaAtivarPosse(&mapa) || !mapaAtivarPosse(&copia) ||
+        (mapa.estatisticas = estatisticasCriar(&mapa)) == NULL ||
+        (copia.estatisticas = estatisticasCriar(&copia)) == NULL ||
+        (mapa.historico = historicoCriar()) == NULL) {
+        fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+        return 1;
+    }
+    Aleatorio rng;
+    aleatorioSemear(&rng, 11);
+
+    // Ramo por cópia completa: copiar, jogar na cópia e descartá-la
+    double inicio = agora();
+    for (int r = 0; r < ramos; r++) {
+        if (!mapaCopiarEstado(&copia, &mapa)) {
+            fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+            return 1;
+        }
+        for (int k = 0; k < ataques; k++) {
+            atacarAoAcaso(&copia, &rng);
+        }
+    }
+    double porCopia = (agora() - inicio) / ramos;
+
+    // Ramo pelo histórico: marcar, jogar no próprio mapa e voltar
+    inicio = agora();
+    for (int r = 0; r < ramos; r++) {
+        PontoHistorico ponto = historicoPonto(mapa.historico);
+        for (int k = 0; k < ataques; k++) {
+            atacarAoAcaso(&mapa, &rng);
+        }
+        if (!historicoVoltar(mapa.historico, &mapa, ponto)) {
+            fprintf(stderr, "ERRO: ramo perdido\n");
+            return 1;
+        }
+    }
+    double porHistorico = (agora() - inicio) / ramos;
+    if (!estatisticasConferir(mapa.estatisticas, &mapa)) {
+        fprintf(stderr, "ERRO: estatisticas divergentes depois dos ramos\n");
+        return 1;
+    }
+
+    // Desfazer e refazer uma jogada
+    for (int k = 0; k < ataques; k++) {
+        atacarAoAcaso(&mapa, &rng);
+    }
+    inicio = agora();
+    long voltas = 0;
+    for (int r = 0; r < ramos; r++) {
+        while (historicoDesfazer(mapa.historico, &mapa)) {
+            voltas++;
+        }
+        while (historicoRefazer(mapa.historico, &mapa)) {
+            voltas++;
+        }
+    }
+    double porVolta = (agora() - inicio) / voltas;
+
+    printf("territorios          : %d (%d ramos de %d ataques)\n", tamanho, ramos, ataques);
+    printf("ramo por copia       : %10.1f us\n", porCopia * 1e6);
+    printf("ramo pelo historico  : %10.1f us (%.0fx mais rapido)\n",
+           porHistorico * 1e6, porCopia / porHistorico);
+    printf("desfazer ou refazer  : %10.1f ns por jogada\n", porVolta * 1e9);
+
+    // Sincronização da IA: cópia completa a cada jogada ou só os alterados
+    Missao missao = {MISSAO_TERRITORIOS, tamanho, "Conquistar o mapa"};
+    IA* ia = iaCriar(NULL, 1 << 16);
+    if (ia == NULL) {
+        fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+        return 1;
+    }
+    int jogadas = (ramos < 50) ? ramos : 50;
+    Historico* historico = mapa.historico;
+    mapa.historico = NULL;
+    double semHistorico = medirIA(&mapa, ia, &missao, &rng, jogadas);
+    mapa.historico = historico;
+    double comHistorico = medirIA(&mapa, ia, &missao, &rng, jogadas);
+    printf("jogada da IA         : %10.1f us copiando o mapa, %.1f us pelos alterados\n",
+           semHistorico, comHistorico);
+
+    iaDestruir(ia);
+    mapaLiberar(&copia);
+    mapaLiberar(&mapa);
+    return 0;
+}
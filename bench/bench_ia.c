@@ -0,0 +1,87 @@
+/*
+ * Benchmark dos jogadores do computador
+ * 
+ * Para mapas de tamanhos crescentes (fronteiras lineares, cores
+ * sorteadas), mede o tempo de uma escolha de ataque com o orçamento
+ * pedido, a profundidade alcançada e as posições visitadas por segundo,
+ * com 1 thread e com todos os núcleos.
+ * 
+ * Uso: bench_ia [maiorTamanho] [orcamentoMs]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "nucleo/aleatorio.h"
+#include "nucleo/grafo.h"
+#include "nucleo/ia.h"
+#include "nucleo/mapa.h"
+#include "nucleo/missao.h"
+#include "nucleo/pool.h"
+
+// Cores do mapa de teste
+#define CORES_TESTE 4
+
+int main(int argc, char* argv[]) {
+    int maior = (argc > 1) ? atoi(argv[1]) : 1000000;
+    int orcamento = (argc > 2) ? atoi(argv[2]) : ORCAMENTO_IA_PADRAO;
+    if (maior < 10 || orcamento < 0) {
+        fprintf(stderr, "Uso: %s [maiorTamanho>=10] [orcamentoMs>=0]\n", argv[0]);
+        return 1;
+    }
+
+    Aleatorio rng;
+    aleatorioSemear(&rng, 2025);
+    Missao missao = {MISSAO_TERRITORIOS, 2000000, "Conquistar 2000000 territorios"};
+
+    printf("%10s %8s %10s %6s %12s %12s\n",
+           "tamanho", "threads", "tempo(ms)", "prof", "posicoes", "pos/s");
+
+    for (int tamanho = 1000; tamanho <= maior; tamanho *= 10) {
+        Mapa mapa;
+        Grafo* grafo = (Grafo*) malloc(sizeof(Grafo));
+        if (grafo == NULL || !mapaIniciar(&mapa, tamanho)) {
+            fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+            return 1;
+        }
+        char cor[TAM_COR];
+        for (int c = 0; c < CORES_TESTE; c++) {
+            snprintf(cor, TAM_COR, "cor%d", c);
+            mapaInternarCor(&mapa, cor);
+        }
+        for (int i = 0; i < tamanho; i++) {
+            mapaAdicionar(&mapa, "T", (IdCor) aleatorioLimitado(&rng, CORES_TESTE),
+                          1 + (int) aleatorioLimitado(&rng, 9));
+        }
+        if (!grafoCriarLinear(grafo, tamanho) || !mapaDefinirGrafo(&mapa, grafo) ||
+            !mapaAtivarPosse(&mapa)) {
+            fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+            return 1;
+        }
+
+        int configuracoes[2] = {1, numeroNucleos()};
+        for (int k = 0; k < 2; k++) {
+            if (k == 1 && configuracoes[1] == 1) {
+                break;
+            }
+            Pool* pool = poolCriar(configuracoes[k]);
+            IA* ia = iaCriar(pool, ENTRADAS_TRANSPOSICAO);
+            if (pool == NULL || ia == NULL) {
+                fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+                return 1;
+            }
+            JogadaIA jogada;
+            if (!iaEscolherAtaque(ia, &mapa, &missao, 0, REGRA_SIMPLES, orcamento, &jogada)) {
+                fprintf(stderr, "ERRO: Falha na busca!\n");
+                return 1;
+            }
+            printf("%10d %8d %10.1f %6d %12lld %12.0f\n", tamanho, configuracoes[k],
+                   jogada.segundos * 1e3, jogada.profundidade, jogada.nos,
+                   jogada.nos / (jogada.segundos > 0 ? jogada.segundos : 1e-9));
+            iaDestruir(ia);
+            poolDestruir(pool);
+        }
+        mapaLiberar(&mapa);
+    }
+    return 0;
+}
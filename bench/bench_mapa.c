@@ -0,0 +1,107 @@
+/*
+ * Benchmark de layout do mapa: vetor de Territorio x Mapa (SoA)
+ * 
+ * Para vários tamanhos de mapa, mede as varreduras usadas pelas missões
+ * (contagem por cor, soma de tropas e sequência consecutiva) nos dois
+ * layouts: o original, com strcmp por território, e o Mapa com cores
+ * internadas em vetores contíguos.
+ * 
+ * Uso: bench_mapa [maiorTamanho] [cores]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "nucleo/aleatorio.h"
+#include "nucleo/mapa.h"
+#include "nucleo/territorio.h"
+
+// Quantidade de elementos varridos por medição (aprox.)
+#define ELEMENTOS_POR_MEDICAO 100000000LL
+
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Impede que o compilador descarte os resultados das varreduras
+static volatile long long sumidouro;
+
+int main(int argc, char* argv[]) {
+    int maior = (argc > 1) ? atoi(argv[1]) : 1000000;
+    int numCores = (argc > 2) ? atoi(argv[2]) : 4;
+    if (maior < 10 || numCores < 2 || numCores > MAX_CORES) {
+        fprintf(stderr, "Uso: %s [maiorTamanho>=10] [cores 2..%d]\n", argv[0], MAX_CORES);
+        return 1;
+    }
+
+    Aleatorio rng;
+    aleatorioSemear(&rng, 2025);
+
+    printf("%10s %8s %14s %14s %9s\n", "tamanho", "varredura", "vetor(ns/t)", "SoA(ns/t)", "ganho");
+
+    for (int tamanho = 10; tamanho <= maior; tamanho *= 10) {
+        Territorio* vetor = (Territorio*) calloc(tamanho, sizeof(Territorio));
+        Mapa mapa;
+        if (vetor == NULL || !mapaIniciar(&mapa, tamanho)) {
+            fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+            return 1;
+        }
+
+        char cor[TAM_COR], nome[TAM_NOME];
+        for (int c = 0; c < numCores; c++) {
+            snprintf(cor, TAM_COR, "cor%d", c);
+            mapaInternarCor(&mapa, cor);
+        }
+        for (int i = 0; i < tamanho; i++) {
+            IdCor dono = (IdCor) aleatorioLimitado(&rng, (uint32_t) numCores);
+            int tropas = 1 + (int) aleatorioLimitado(&rng, 10);
+            snprintf(nome, TAM_NOME, "T%d", i);
+            mapaAdicionar(&mapa, nome, dono, tropas);
+            mapaObterTerritorio(&mapa, i, &vetor[i]);
+        }
+
+        const char* alvo = mapaNomeCor(&mapa, 0);
+        long long repeticoes = ELEMENTOS_POR_MEDICAO / tamanho;
+        if (repeticoes < 1) {
+            repeticoes = 1;
+        }
+
+        for (int tipo = 0; tipo < 3; tipo++) {
+            const char* nomes[] = {"contagem", "tropas", "sequencia"};
+            double t0 = agora();
+            for (long long r = 0; r < repeticoes; r++) {
+                if (tipo == 0) {
+                    sumidouro += contarTerritoriosPorCor(vetor, tamanho, alvo);
+                } else if (tipo == 1) {
+                    sumidouro += somarTropasPorCor(vetor, tamanho, alvo);
+                } else {
+                    sumidouro += verificarTerritoriosConsecutivos(vetor, tamanho, alvo, tamanho);
+                }
+            }
+            double t1 = agora();
+            for (long long r = 0; r < repeticoes; r++) {
+                if (tipo == 0) {
+                    sumidouro += mapaContarPorDono(&mapa, 0);
+                } else if (tipo == 1) {
+                    sumidouro += mapaSomarTropas(&mapa, 0);
+                } else {
+                    sumidouro += mapaVerificarConsecutivos(&mapa, 0, tamanho);
+                }
+            }
+            double t2 = agora();
+
+            double nsVetor = (t1 - t0) * 1e9 / ((double) repeticoes * tamanho);
+            double nsMapa = (t2 - t1) * 1e9 / ((double) repeticoes * tamanho);
+            printf("%10d %8s %14.3f %14.3f %8.1fx\n", tamanho, nomes[tipo],
+                   nsVetor, nsMapa, nsVetor / nsMapa);
+        }
+
+        mapaLiberar(&mapa);
+        free(vetor);
+    }
+    return 0;
+}
@@ -0,0 +1,141 @@
+/*
+ * Benchmark do registro de eventos
+ *
+ * Resolve a mesma sequência de ataques sobre um mapa sintético sem e com
+ * o registro de eventos ligado e compara o custo por ataque. O registro
+ * gravado fica no disco para testar o replay (ferramentas/replay.c).
+ *
+ * Uso: bench_registro [ataques] [territorios] [registro] [intervalo]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "nucleo/aleatorio.h"
+#include "nucleo/batalha.h"
+#include "nucleo/grafo.h"
+#include "nucleo/missao.h"
+#include "nucleo/registro.h"
+
+#define TROPAS_INICIAIS 1000000000
+
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Mapa com cores alternadas e fronteiras lineares
+static void montarMapa(Mapa* mapa, int tamanho) {
+    for (int i = 0; i < tamanho; i++) {
+        mapa->donos[i] = (IdCor) (i % 2);
+        mapa->tropas[i] = TROPAS_INICIAIS;
+    }
+}
+
+/*
+ * Função: jogar
+ *
+ * Sorteia pares vizinhos e resolve os ataques válidos, registrando-os se
+ * houver registro. Como o gerador é reiniciado, as duas rodadas do
+ * benchmark fazem exatamente os mesmos ataques.
+ *
+ * Retorno: ataques resolvidos
+ */
+static long long jogar(Mapa* mapa, long long ataques, Registro* registro) {
+    Aleatorio rng;
+    aleatorioSemear(&rng, 7);
+    ResultadoAtaque resultado;
+    long long resolvidos = 0;
+    for (long long k = 0; k < ataques; k++) {
+        int a = (int) aleatorioLimitado(&rng, (uint32_t) (mapa->quantidade - 1));
+        int d = a + 1;
+        if (aleatorioLimitado(&rng, 2)) {
+            d = a;
+            a = a + 1;
+        }
+        if (mapa->donos[a] == mapa->donos[d] || mapa->tropas[a] < 2) {
+            continue;
+        }
+        resolverAtaque(mapa, a, d, rolarDado(&rng), rolarDado(&rng), &resultado);
+        resolvidos++;
+        if (registro != NULL && registroAtaque(registro, mapa, a, d, &resultado) != REGISTRO_OK) {
+            fprintf(stderr, "ERRO: falha ao gravar o registro\n");
+            exit(1);
+        }
+    }
+    return resolvidos;
+}
+
+int main(int argc, char* argv[]) {
+    long long ataques = (argc > 1) ? atoll(argv[1]) : 2000000;
+    int tamanho = (argc > 2) ? atoi(argv[2]) : 100000;
+    const char* caminho = (argc > 3) ? argv[3] : "bench_registro.log";
+    int intervalo = (argc > 4) ? atoi(argv[4]) : INTERVALO_CHECKPOINT_PADRAO;
+    if (ataques <= 0 || tamanho < 2 || intervalo < 1) {
+        fprintf(stderr, "Uso: %s [ataques] [territorios>=2] [registro] [intervalo>=1]\n", argv[0]);
+        return 1;
+    }
+
+    Mapa mapa;
+    Grafo* grafo = (Grafo*) malloc(sizeof(Grafo));
+    if (grafo == NULL || !mapaIniciar(&mapa, tamanho)) {
+        fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+        return 1;
+    }
+    mapaInternarCor(&mapa, "azul");
+    mapaInternarCor(&mapa, "verde");
+    for (int i = 0; i < tamanho; i++) {
+        mapaAdicionar(&mapa, "T", (IdCor) (i % 2), TROPAS_INICIAIS);
+    }
+    if (!grafoCriarLinear(grafo, tamanho) || !mapaDefinirGrafo(&mapa, grafo)) {
+        fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+        return 1;
+    }
+
+    Missao missao = MISSOES_PADRAO[1];
+    Jogador jogadores[2] = {
+        {"Ana", "azul", 0, &missao, 1},
+        {"Bia", "verde", 1, &missao, 1}
+    };
+
+    double inicio = agora();
+    long long resolvidos = jogar(&mapa, ataques, NULL);
+    double semRegistro = agora() - inicio;
+
+    // Registro novo: remove o anterior e os checkpoints que ele possa ter deixado
+    montarMapa(&mapa, tamanho);
+    char nome[4096];
+    unlink(caminho);
+    for (long long t = 0; t <= resolvidos; t += intervalo) {
+        nomeCheckpoint(nome, sizeof(nome), caminho, t);
+        unlink(nome);
+    }
+    Registro* registro;
+    CodigoRegistro codigo = registroCriar(&registro, caminho, intervalo, REGRA_SIMPLES, &mapa,
+                                          jogadores, 2);
+    if (codigo != REGISTRO_OK) {
+        fprintf(stderr, "%s: %s\n", caminho, registroMensagem(codigo));
+        return 1;
+    }
+    inicio = agora();
+    jogar(&mapa, ataques, registro);
+    codigo = registroFechar(registro);
+    double comRegistro = agora() - inicio;
+    if (codigo != REGISTRO_OK) {
+        fprintf(stderr, "%s: %s\n", caminho, registroMensagem(codigo));
+        return 1;
+    }
+
+    printf("ataques resolvidos : %lld em %d territorios\n", resolvidos, tamanho);
+    printf("sem registro       : %8.1f ns/ataque\n", semRegistro * 1e9 / resolvidos);
+    printf("com registro       : %8.1f ns/ataque (checkpoint a cada %d eventos)\n",
+           comRegistro * 1e9 / resolvidos, intervalo);
+    printf("registro gravado em %s (%lld bytes de eventos)\n",
+           caminho, resolvidos * (long long) sizeof(Evento));
+
+    mapaLiberar(&mapa);
+    return 0;
+}
@@ -0,0 +1,486 @@
+/*
+ * Benchmark do servidor de partidas
+ * 
+ * Sobe o servidor no próprio processo (TCP em 127.0.0.1 com porta
+ * escolhida pelo sistema, ou socket Unix com --unix) e abre uma conexão
+ * por partida. Cada conexão cria a sua partida e ocupa todos os lugares;
+ * as threads clientes então jogam todas as partidas em rodízio, uma
+ * jogada por vez, com uma política gulosa sobre o estado acompanhado
+ * pelas respostas. Ao fim de uma partida a conexão cria outra.
+ * 
+ * Mede a latência de cada jogada (do envio do comando à resposta) e a
+ * vazão total com todas as partidas abertas ao mesmo tempo.
+ * 
+ * Uso: bench_servidor [partidas] [clientes] [lacos] [jogadas] [--unix]
+ */
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "nucleo/partida.h"
+#include "nucleo/servidor.h"
+
+// Mapa gerado para todas as partidas
+#define TERRITORIOS_TESTE 42
+#define JOGADORES_TESTE 4
+
+// Ataques de um jogador antes de passar a vez
+#define ATAQUES_POR_VEZ 32
+
+// Missões na escala do mapa gerado (as padrão se cumprem já no começo)
+static const Missao MISSOES_TESTE[] = {
+    {MISSAO_PERCENTUAL, 60, "Dominar 60% do mapa"},
+    {MISSAO_CONSECUTIVOS, 16, "Conquistar 16 territorios consecutivos no mapa"},
+    {MISSAO_ELIMINAR, 0, "Eliminar todas as tropas de pelo menos uma cor inimiga"}
+};
+
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+ * Struct Cliente
+ * 
+ * Uma conexão e o estado da partida dela, acompanhado pelas respostas.
+ */
+typedef struct {
+    int fd;
+    char buffer[4096];
+    int inicio;
+    int fim;
+    int vez;                     // Jogadores e territórios a partir de 0
+    int fase;                    // 0: reforço, 1: ataque, 2: fim
+    int reforco;
+    int ataques;                 // Ataques na vez atual
+    uint8_t donos[TERRITORIOS_TESTE];
+    int tropas[TERRITORIOS_TESTE];
+} Cliente;
+
+typedef struct {
+    const char* endereco;        // Caminho do socket Unix, ou NULL para TCP
+    int porta;
+    Cliente* clientes;
+    int numClientes;
+    long long jogadas;           // Jogadas a medir
+    uint32_t* latencias;         // Nanossegundos por jogada
+    long long partidasConcluidas;
+    long long erros;
+} Trabalho;
+
+static int conectar(const char* caminho, int porta) {
+    int fd;
+    if (caminho != NULL) {
+        struct sockaddr_un endereco;
+        memset(&endereco, 0, sizeof(endereco));
+        endereco.sun_family = AF_UNIX;
+        strncpy(endereco.sun_path, caminho, sizeof(endereco.sun_path) - 1);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, (struct sockaddr*) &endereco, sizeof(endereco)) != 0) {
+            close(fd);
+            fd = -1;
+        }
+    } else {
+        struct sockaddr_in endereco;
+        memset(&endereco, 0, sizeof(endereco));
+        endereco.sin_family = AF_INET;
+        endereco.sin_port = htons((uint16_t) porta);
+        endereco.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        int um = 1;
+        if (fd >= 0) {
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &um, sizeof(um));
+        }
+        if (fd >= 0 && connect(fd, (struct sockaddr*) &endereco, sizeof(endereco)) != 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    return fd;
+}
+
+static int enviarLinha(Cliente* cliente, const char* linha, size_t tamanho) {
+    while (tamanho > 0) {
+        ssize_t n = send(cliente->fd, linha, tamanho, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return 0;
+        }
+        linha += n;
+        tamanho -= (size_t) n;
+    }
+    return 1;
+}
+
+// Próxima linha de resposta (os avisos '*' são pulados); NULL se a conexão cair
+static char* lerLinha(Cliente* cliente) {
+    for (;;) {
+        char* quebra = memchr(cliente->buffer + cliente->inicio, '\n',
+                              (size_t) (cliente->fim - cliente->inicio));
+        if (quebra != NULL) {
+            char* linha = cliente->buffer + cliente->inicio;
+            *quebra = '\0';
+            cliente->inicio = (int) (quebra - cliente->buffer) + 1;
+            if (linha[0] == '*') {
+                continue;
+            }
+            return linha;
+        }
+        if (cliente->inicio > 0) {
+            memmove(cliente->buffer, cliente->buffer + cliente->inicio,
+                    (size_t) (cliente->fim - cliente->inicio));
+            cliente->fim -= cliente->inicio;
+            cliente->inicio = 0;
+        }
+        if (cliente->fim == (int) sizeof(cliente->buffer)) {
+            return NULL;
+        }
+        ssize_t n = recv(cliente->fd, cliente->buffer + cliente->fim,
+                         sizeof(cliente->buffer) - (size_t) cliente->fim, 0);
+        if (n <= 0) {
+            return NULL;
+        }
+        cliente->fim += (int) n;
+    }
+}
+
+static char* pedir(Cliente* cliente, const char* linha) {
+    if (!enviarLinha(cliente, linha, strlen(linha))) {
+        return NULL;
+    }
+    return lerLinha(cliente);
+}
+
+// Lê a resposta de ESTADO para o estado acompanhado
+static int lerEstado(Cliente* cliente, const char* linha) {
+    unsigned long long id;
+    char fase[16];
+    int vencedor, rodada, lidos;
+    if (sscanf(linha, "ESTADO %llu %d %15s %d %d %d%n", &id, &cliente->vez, fase,
+               &cliente->reforco, &rodada, &vencedor, &lidos) != 6) {
+        return 0;
+    }
+    cliente->vez--;
+    cliente->fase = (strcmp(fase, "reforco") == 0) ? 0 : (strcmp(fase, "ataque") == 0) ? 1 : 2;
+    cliente->ataques = 0;
+    const char* p = linha + lidos;
+    for (int i = 0; i < TERRITORIOS_TESTE; i++) {
+        int dono, tropas;
+        if (sscanf(p, " %d:%d%n", &dono, &tropas, &lidos) != 2) {
+            return 0;
+        }
+        cliente->donos[i] = (uint8_t) (dono - 1);
+        cliente->tropas[i] = tropas;
+        p += lidos;
+    }
+    return 1;
+}
+
+// Cria uma partida, ocupa todos os lugares e lê o estado inicial
+static int novaPartida(Cliente* cliente) {
+    char* linha = pedir(cliente, "CRIAR\n");
+    unsigned long long id;
+    if (linha == NULL || sscanf(linha, "OK %llu", &id) != 1) {
+        return 0;
+    }
+    char comando[64];
+    snprintf(comando, sizeof(comando), "ENTRAR %llu\n", id);
+    for (int j = 1; j < JOGADORES_TESTE; j++) {
+        linha = pedir(cliente, comando);
+        if (linha == NULL || strncmp(linha, "OK", 2) != 0) {
+            return 0;
+        }
+    }
+    linha = pedir(cliente, "ESTADO\n");
+    return linha != NULL && lerEstado(cliente, linha);
+}
+
+// Território de `jogador` vizinho de um inimigo (com pelo menos `tropas`), ou -1
+static int fronteira(const Cliente* cliente, int jogador, int tropas, int* alvo) {
+    for (int i = 0; i < TERRITORIOS_TESTE; i++) {
+        if (cliente->donos[i] != jogador || cliente->tropas[i] < tropas) {
+            continue;
+        }
+        if (i > 0 && cliente->donos[i - 1] != jogador) {
+            *alvo = i - 1;
+            return i;
+        }
+        if (i + 1 < TERRITORIOS_TESTE && cliente->donos[i + 1] != jogador) {
+            *alvo = i + 1;
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Monta a próxima jogada do jogador da vez
+static int proximaJogada(Cliente* cliente, char* comando, size_t tamanho) {
+    int alvo = -1;
+    if (cliente->fase == 0) {
+        int t = fronteira(cliente, cliente->vez, 0, &alvo);
+        if (t < 0) {
+            for (t = 0; cliente->donos[t] != cliente->vez; t++) {
+            }
+        }
+        return snprintf(comando, tamanho, "REFORCAR %d %d\n", t + 1, cliente->reforco);
+    }
+    int t = (cliente->ataques < ATAQUES_POR_VEZ) ? fronteira(cliente, cliente->vez, 2, &alvo) : -1;
+    if (t < 0) {
+        return snprintf(comando, tamanho, "PASSAR\n");
+    }
+    return snprintf(comando, tamanho, "ATACAR %d %d\n", t + 1, alvo + 1);
+}
+
+// Aplica a resposta de uma jogada ao estado acompanhado; devolve 0 em ERRO
+static int aplicarResposta(Cliente* cliente, const char* linha) {
+    int j, t, a, d, tropas, restante, perdasA, perdasD, conquista, tropasA, tropasD, vencedor;
+    int reforco, rodada;
+    if (sscanf(linha, "REFORCO %d %d %d %d %d", &j, &t, &tropas, &restante, &vencedor) == 5) {
+        cliente->tropas[t - 1] = tropas;
+        cliente->reforco = restante;
+        cliente->fase = (vencedor > 0) ? 2 : (restante == 0) ? 1 : 0;
+        return 1;
+    }
+    if (sscanf(linha, "ATAQUE %d %d %d %d %d %d %d %d %d", &j, &a, &d, &perdasA, &perdasD,
+               &conquista, &tropasA, &tropasD, &vencedor) == 9) {
+        cliente->tropas[a - 1] = tropasA;
+        cliente->tropas[d - 1] = tropasD;
+        if (conquista) {
+            cliente->donos[d - 1] = (uint8_t) (j - 1);
+        }
+        cliente->ataques++;
+        if (vencedor > 0) {
+            cliente->fase = 2;
+        }
+        return 1;
+    }
+    if (sscanf(linha, "VEZ %d %d %d", &j, &reforco, &rodada) == 3) {
+        cliente->vez = j - 1;
+        cliente->reforco = reforco;
+        cliente->fase = 0;
+        cliente->ataques = 0;
+        return 1;
+    }
+    return 0;
+}
+
+static void* jogar(void* argumento) {
+    Trabalho* trabalho = (Trabalho*) argumento;
+    char comando[64];
+    long long feitas = 0;
+    while (feitas < trabalho->jogadas) {
+        for (int k = 0; k < trabalho->numClientes && feitas < trabalho->jogadas; k++) {
+            Cliente* cliente = &trabalho->clientes[k];
+            if (cliente->fd < 0) {
+                continue;
+            }
+            if (cliente->fase == 2) {
+                trabalho->partidasConcluidas++;
+                char* linha = pedir(cliente, "DEIXAR\n");
+                if (linha == NULL || !novaPartida(cliente)) {
+                    close(cliente->fd);
+                    cliente->fd = -1;
+                    trabalho->erros++;
+                }
+                continue;
+            }
+            int tamanho = proximaJogada(cliente, comando, sizeof(comando));
+            struct timespec antes, depois;
+            clock_gettime(CLOCK_MONOTONIC, &antes);
+            char* linha = NULL;
+            if (enviarLinha(cliente, comando, (size_t) tamanho)) {
+                linha = lerLinha(cliente);
+            }
+            clock_gettime(CLOCK_MONOTONIC, &depois);
+            if (linha == NULL) {
+                close(cliente->fd);
+                cliente->fd = -1;
+                trabalho->erros++;
+                continue;
+            }
+            long long ns = (depois.tv_sec - antes.tv_sec) * 1000000000LL +
+                           (depois.tv_nsec - antes.tv_nsec);
+            trabalho->latencias[feitas++] = (ns > UINT32_MAX) ? UINT32_MAX : (uint32_t) ns;
+            if (!aplicarResposta(cliente, linha)) {
+                // Estado divergiu: relê do servidor
+                trabalho->erros++;
+                linha = pedir(cliente, "ESTADO\n");
+                if (linha == NULL || !lerEstado(cliente, linha)) {
+                    close(cliente->fd);
+                    cliente->fd = -1;
+                }
+            }
+        }
+        // Sem nenhuma conexão viva não há mais o que medir
+        int vivos = 0;
+        for (int k = 0; k < trabalho->numClientes; k++) {
+            vivos += (trabalho->clientes[k].fd >= 0);
+        }
+        if (vivos == 0) {
+            trabalho->jogadas = feitas;
+        }
+    }
+    return NULL;
+}
+
+static void* rodarServidor(void* servidor) {
+    servidorExecutar((Servidor*) servidor);
+    return NULL;
+}
+
+static int compararLatencias(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*) a, y = *(const uint32_t*) b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char* argv[]) {
+    int partidas = 2000, clientes = 4, lacos = 2;
+    long long jogadas = 400000;
+    int unixSocket = 0;
+    int posicional = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--unix") == 0) {
+            unixSocket = 1;
+        } else if (posicional == 0) {
+            partidas = atoi(argv[i]);
+            posicional++;
+        } else if (posicional == 1) {
+            clientes = atoi(argv[i]);
+            posicional++;
+        } else if (posicional == 2) {
+            lacos = atoi(argv[i]);
+            posicional++;
+        } else {
+            jogadas = atoll(argv[i]);
+        }
+    }
+    if (partidas < 1 || clientes < 1 || clientes > partidas || lacos < 1 || lacos > MAX_LACOS ||
+        jogadas < clientes) {
+        fprintf(stderr, "Uso: %s [partidas] [clientes<=partidas] [lacos] [jogadas] [--unix]\n",
+                argv[0]);
+        return 1;
+    }
+
+    // Duas pontas de socket por partida
+    struct rlimit limite;
+    if (getrlimit(RLIMIT_NOFILE, &limite) == 0 && limite.rlim_cur < limite.rlim_max) {
+        limite.rlim_cur = limite.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limite);
+    }
+
+    ModeloPartida modelo;
+    if (!modeloGerar(&modelo, TERRITORIOS_TESTE, JOGADORES_TESTE, 2025)) {
+        fprintf(stderr, "ERRO: falha ao gerar o mapa\n");
+        return 1;
+    }
+    modelo.missoes = MISSOES_TESTE;
+    modelo.numMissoes = (int) (sizeof(MISSOES_TESTE) / sizeof(MISSOES_TESTE[0]));
+    char endereco[128];
+    char caminho[96];
+    snprintf(caminho, sizeof(caminho), "/tmp/bench_servidor.%d.sock", (int) getpid());
+    if (unixSocket) {
+        snprintf(endereco, sizeof(endereco), "unix:%s", caminho);
+    } else {
+        snprintf(endereco, sizeof(endereco), "127.0.0.1:0");
+    }
+    ConfigServidor config = {endereco, lacos, REGRA_SIMPLES, 2025};
+    Servidor* servidor = servidorCriar(&modelo, &config, stderr);
+    if (servidor == NULL) {
+        modeloLiberar(&modelo);
+        return 1;
+    }
+    pthread_t threadServidor;
+    pthread_create(&threadServidor, NULL, rodarServidor, servidor);
+
+    Cliente* todos = (Cliente*) calloc((size_t) partidas, sizeof(Cliente));
+    Trabalho* trabalhos = (Trabalho*) calloc((size_t) clientes, sizeof(Trabalho));
+    uint32_t* latencias = (uint32_t*) malloc((size_t) jogadas * sizeof(uint32_t));
+    if (todos == NULL || trabalhos == NULL || latencias == NULL) {
+        fprintf(stderr, "ERRO: falha de memoria\n");
+        return 1;
+    }
+
+    printf("Abrindo %d partidas (%d territorios, %d jogadores) em %s com %d lacos...\n",
+           partidas, TERRITORIOS_TESTE, JOGADORES_TESTE, unixSocket ? "socket Unix" : "TCP",
+           lacos);
+    double inicio = agora();
+    for (int k = 0; k < partidas; k++) {
+        todos[k].fd = conectar(unixSocket ? caminho : NULL, servidorPorta(servidor));
+        if (todos[k].fd < 0 || !novaPartida(&todos[k])) {
+            fprintf(stderr, "ERRO: falha ao abrir a partida %d\n", k);
+            return 1;
+        }
+    }
+    printf("Partidas abertas em %.2f s\n", agora() - inicio);
+
+    long long distribuidas = 0;
+    int distribuidos = 0;
+    for (int c = 0; c < clientes; c++) {
+        Trabalho* trabalho = &trabalhos[c];
+        trabalho->clientes = &todos[distribuidos];
+        trabalho->numClientes = partidas / clientes + (c < partidas % clientes);
+        trabalho->jogadas = jogadas / clientes + (c < jogadas % clientes);
+        trabalho->latencias = &latencias[distribuidas];
+        distribuidos += trabalho->numClientes;
+        distribuidas += trabalho->jogadas;
+    }
+
+    pthread_t* threads = (pthread_t*) malloc(sizeof(pthread_t) * clientes);
+    inicio = agora();
+    for (int c = 0; c < clientes; c++) {
+        pthread_create(&threads[c], NULL, jogar, &trabalhos[c]);
+    }
+    long long medidas = 0, concluidas = 0, erros = 0;
+    for (int c = 0; c < clientes; c++) {
+        pthread_join(threads[c], NULL);
+    }
+    double segundos = agora() - inicio;
+
+    // Junta as latências medidas (cada thread pode ter parado antes da cota)
+    for (int c = 0; c < clientes; c++) {
+        memmove(&latencias[medidas], trabalhos[c].latencias,
+                (size_t) trabalhos[c].jogadas * sizeof(uint32_t));
+        medidas += trabalhos[c].jogadas;
+        concluidas += trabalhos[c].partidasConcluidas;
+        erros += trabalhos[c].erros;
+    }
+    qsort(latencias, (size_t) medidas, sizeof(uint32_t), compararLatencias);
+
+    printf("%lld jogadas em %.2f s: %.0f jogadas/s, %lld partidas concluidas, %lld erros\n",
+           medidas, segundos, medidas / segundos, concluidas, erros);
+    if (medidas > 0) {
+        printf("Latencia por jogada (us): p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f\n",
+               latencias[medidas / 2] / 1e3, latencias[medidas * 9 / 10] / 1e3,
+               latencias[medidas * 99 / 100] / 1e3, latencias[medidas * 999 / 1000] / 1e3,
+               latencias[medidas - 1] / 1e3);
+    }
+
+    for (int k = 0; k < partidas; k++) {
+        if (todos[k].fd >= 0) {
+            close(todos[k].fd);
+        }
+    }
+    servidorParar(servidor);
+    pthread_join(threadServidor, NULL);
+    ResumoServidor resumo;
+    servidorResumo(servidor, &resumo);
+    printf("Servidor: %lld conexoes, %lld partidas criadas, %lld comandos\n",
+           resumo.conexoes, resumo.partidas, resumo.comandos);
+
+    servidorDestruir(servidor);
+    modeloLiberar(&modelo);
+    free(threads);
+    free(latencias);
+    free(trabalhos);
+    free(todos);
+    return erros == 0 ? 0 : 1;
+}
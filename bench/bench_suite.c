@@ -0,0 +1,222 @@
+/*
+ * Suíte de benchmarks do núcleo
+ * 
+ * Mede, em mapas de tamanhos crescentes (fronteiras lineares, cores
+ * sorteadas), os caminhos quentes do jogo: resolução de ataques,
+ * verificação de cada tipo de missão (com e sem estatísticas
+ * incrementais) e as varreduras do mapa. Serve para comparar as
+ * configurações do build (Release, LTO, PGO) e como carga de treino do
+ * PGO. Com --conferir, em vez de medir, faz alterações sorteadas de dono
+ * e de tropas e compara as estatísticas incrementais com a varredura
+ * completa do mapa (estatisticasConferir).
+ * 
+ * Uso: bench_suite [--rapido] [--conferir] [maiorTamanho]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "nucleo/aleatorio.h"
+#include "nucleo/batalha.h"
+#include "nucleo/estatisticas.h"
+#include "nucleo/grafo.h"
+#include "nucleo/missao.h"
+
+// Cores do mapa de teste
+#define CORES_TESTE 4
+
+// Territórios varridos (ou ataques resolvidos) por medição, no modo normal
+#define TRABALHO_POR_MEDICAO 50000000LL
+
+// Alterações sorteadas por tamanho de mapa, com --conferir
+#define ALTERACOES_CONFERIDAS 20000
+
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Impede que o compilador descarte os resultados medidos
+static volatile long long sumidouro;
+
+static void linha(const char* secao, const char* caso, int tamanho, double valor, const char* unidade) {
+    printf("%-10s %-28s %10d %12.2f %s\n", secao, caso, tamanho, valor, unidade);
+}
+
+// Ataques entre vizinhos sorteados; o mapa é reabastecido para não esgotar
+static void medirBatalha(Mapa* mapa, Aleatorio* rng, long long trabalho) {
+    int tamanho = mapa->quantidade;
+    long long resolvidos = 0;
+    double inicio = agora();
+    for (long long k = 0; k < trabalho; k++) {
+        int a = (int) aleatorioLimitado(rng, (uint32_t) (tamanho - 1));
+        int d = a + 1;
+        if (aleatorioLimitado(rng, 2)) {
+            d = a;
+            a = a + 1;
+        }
+        if (mapa->donos[a] == mapa->donos[d]) {
+            continue;
+        }
+        if (mapa->tropas[a] < 2) {
+            mapaDefinirTropas(mapa, a, 1000);
+        }
+        resolverAtaque(mapa, a, d, rolarDado(rng), rolarDado(rng), NULL);
+        resolvidos++;
+    }
+    double segundos = agora() - inicio;
+    linha("batalha", "resolverAtaque", tamanho, segundos * 1e9 / resolvidos, "ns/ataque");
+}
+
+// Uma missão de cada tipo, verificada para todas as cores
+static void medirMissoes(Mapa* mapa, long long trabalho, int comEstatisticas) {
+    int tamanho = mapa->quantidade;
+    for (int t = 0; t < NUM_TIPOS_MISSAO; t++) {
+        Missao missao = {(TipoMissao) t, (t == MISSAO_PERCENTUAL) ? 50 : tamanho / 2, ""};
+        // Sem estatísticas cada verificação varre o mapa: menos repetições
+        long long repeticoes = comEstatisticas ? trabalho / 10 : trabalho / tamanho;
+        if (repeticoes < CORES_TESTE) {
+            repeticoes = CORES_TESTE;
+        }
+        double inicio = agora();
+        for (long long r = 0; r < repeticoes; r++) {
+            sumidouro += verificarMissao(&missao, mapa, (IdCor) (r % CORES_TESTE));
+        }
+        double segundos = agora() - inicio;
+        char caso[32];
+        snprintf(caso, sizeof(caso), "%s%s", nomeTipoMissao((TipoMissao) t),
+                 comEstatisticas ? " (incremental)" : " (varredura)");
+        linha("missao", caso, tamanho, segundos * 1e9 / repeticoes, "ns/verificacao");
+    }
+}
+
+static void medirVarreduras(const Mapa* mapa, long long trabalho) {
+    int tamanho = mapa->quantidade;
+    long long repeticoes = trabalho / tamanho;
+    if (repeticoes < 1) {
+        repeticoes = 1;
+    }
+    const char* nomes[] = {"mapaContarPorDono", "mapaSomarTropas", "mapaMaiorSequencia"};
+    for (int tipo = 0; tipo < 3; tipo++) {
+        double inicio = agora();
+        for (long long r = 0; r < repeticoes; r++) {
+            IdCor cor = (IdCor) (r % CORES_TESTE);
+            if (tipo == 0) {
+                sumidouro += mapaContarPorDono(mapa, cor);
+            } else if (tipo == 1) {
+                sumidouro += mapaSomarTropas(mapa, cor);
+            } else {
+                sumidouro += mapaMaiorSequencia(mapa, cor);
+            }
+        }
+        double segundos = agora() - inicio;
+        linha("varredura", nomes[tipo], tamanho, segundos * 1e9 / ((double) repeticoes * tamanho),
+              "ns/territorio");
+    }
+}
+
+/*
+ * Função: conferirEstatisticas
+ * 
+ * Sorteia alterações de tropas, de dono e de dono copiado do vizinho
+ * (que junta sequências e exercita a compactação dos heaps) e compara as
+ * estatísticas com a varredura completa a cada tamanho / 100 alterações.
+ * 
+ * Retorno: 1 se tudo conferiu, 0 na primeira divergência
+ */
+static int conferirEstatisticas(Mapa* mapa, Aleatorio* rng) {
+    int tamanho = mapa->quantidade;
+    int intervalo = (tamanho / 100 > 1) ? tamanho / 100 : 1;
+    for (int k = 1; k <= ALTERACOES_CONFERIDAS; k++) {
+        int i = (int) aleatorioLimitado(rng, (uint32_t) tamanho);
+        switch (aleatorioLimitado(rng, 3)) {
+            case 0:
+                mapaDefinirTropas(mapa, i, 1 + (int) aleatorioLimitado(rng, 1000));
+                break;
+            case 1:
+                mapaDefinirDono(mapa, i, (IdCor) aleatorioLimitado(rng, CORES_TESTE));
+                break;
+            default:
+                mapaDefinirDono(mapa, i, mapa->donos[(i > 0) ? i - 1 : tamanho - 1]);
+                break;
+        }
+        if (k % intervalo == 0 && !estatisticasConferir(mapa->estatisticas, mapa)) {
+            fprintf(stderr, "ERRO: estatisticas divergem da varredura (tamanho %d, alteracao %d)\n",
+                    tamanho, k);
+            return 0;
+        }
+    }
+    linha("conferir", "estatisticas", tamanho, ALTERACOES_CONFERIDAS, "alteracoes");
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    long long trabalho = TRABALHO_POR_MEDICAO;
+    int maior = 1000000;
+    int conferir = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--rapido") == 0) {
+            trabalho /= 50;
+        } else if (strcmp(argv[i], "--conferir") == 0) {
+            conferir = 1;
+        } else {
+            maior = atoi(argv[i]);
+        }
+    }
+    if (maior < 100) {
+        fprintf(stderr, "Uso: %s [--rapido] [--conferir] [maiorTamanho>=100]\n", argv[0]);
+        return 1;
+    }
+
+    Aleatorio rng;
+    aleatorioSemear(&rng, 2025);
+    printf("%-10s %-28s %10s %12s %s\n", "secao", "caso", "tamanho", "valor", "unidade");
+
+    for (int tamanho = 100; tamanho <= maior; tamanho *= 10) {
+        Mapa mapa;
+        Grafo* grafo = (Grafo*) malloc(sizeof(Grafo));
+        if (grafo == NULL || !mapaIniciar(&mapa, tamanho)) {
+            fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+            return 1;
+        }
+        char cor[TAM_COR];
+        for (int c = 0; c < CORES_TESTE; c++) {
+            snprintf(cor, TAM_COR, "cor%d", c);
+            mapaInternarCor(&mapa, cor);
+        }
+        for (int i = 0; i < tamanho; i++) {
+            mapaAdicionar(&mapa, "T", (IdCor) aleatorioLimitado(&rng, CORES_TESTE),
+                          1 + (int) aleatorioLimitado(&rng, 9));
+        }
+        if (!grafoCriarLinear(grafo, tamanho) || !mapaDefinirGrafo(&mapa, grafo) ||
+            !mapaAtivarPosse(&mapa)) {
+            fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+            return 1;
+        }
+
+        if (!conferir) {
+            medirVarreduras(&mapa, trabalho);
+            medirMissoes(&mapa, trabalho, 0);
+        }
+        mapa.estatisticas = estatisticasCriar(&mapa);
+        if (mapa.estatisticas == NULL) {
+            fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+            return 1;
+        }
+        if (conferir) {
+            int ok = conferirEstatisticas(&mapa, &rng);
+            mapaLiberar(&mapa);
+            if (!ok) {
+                return 1;
+            }
+            continue;
+        }
+        medirMissoes(&mapa, trabalho, 1);
+        medirBatalha(&mapa, &rng, trabalho / 10);
+        mapaLiberar(&mapa);
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+/*
+ * Gerador de cenários sintéticos do Jogo War
+ * 
+ * Grava um mapa sintético (ver nucleo/gerador.h) como snapshot binário,
+ * que o jogo e as ferramentas carregam de uma vez, ou no formato de
+ * cenário (--texto). Cada cor vira um jogador do computador com uma
+ * missão sorteada.
+ * 
+ * Uso: gerador [opções] <saida>      (com --texto, "-" escreve em stdout)
+ *   --territorios N     territórios (padrão 1000)
+ *   --cores N           cores e jogadores (padrão 4)
+ *   --tropas D          uniforme (padrão), geometrica ou concentrada
+ *   --maximo N          tropas máximas por território (padrão 10)
+ *   --bloco N           comprimento médio das sequências de mesma cor (padrão 4)
+ *   --grau G            fronteiras por território, em média (padrão 4)
+ *   --alcance N         distância máxima das fronteiras extras (padrão 32; 0: qualquer)
+ *   --continente N      territórios por continente (padrão ~sqrt(territórios); 0: nenhum)
+ *   --missoes ARQ       missões sorteadas do arquivo de dados ARQ (ver missao.h)
+ *   --semente S         semente do mapa e das missões (padrão 2025)
+ *   --texto             grava no formato de cenário em vez de snapshot
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nucleo/aleatorio.h"
+#include "nucleo/continente.h"
+#include "nucleo/gerador.h"
+#include "nucleo/grafo.h"
+#include "nucleo/missao.h"
+#include "nucleo/snapshot.h"
+
+static int uso(const char* programa) {
+    fprintf(stderr,
+            "Uso: %s [--territorios N] [--cores N] [--tropas D] [--maximo N] [--bloco N]\n"
+            "       [--grau G] [--alcance N] [--continente N] [--missoes ARQ] [--semente S]\n"
+            "       [--texto] <saida>\n"
+            "D: uniforme, geometrica ou concentrada\n",
+            programa);
+    return 2;
+}
+
+int main(int argc, char* argv[]) {
+    ConfigGerador config;
+    geradorPadrao(&config, 1000);
+    int continenteInformado = 0;
+    const char* arquivoMissoes = NULL;
+    const char* saida = NULL;
+    int texto = 0;
+    for (int i = 1; i < argc; i++) {
+        int temValor = i + 1 < argc;
+        if (strcmp(argv[i], "--territorios") == 0 && temValor) {
+            config.territorios = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--cores") == 0 && temValor) {
+            config.cores = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--tropas") == 0 && temValor) {
+            if (!distribuicaoPorNome(argv[++i], &config.distribuicao)) {
+                return uso(argv[0]);
+            }
+        } else if (strcmp(argv[i], "--maximo") == 0 && temValor) {
+            config.tropasMaximas = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--bloco") == 0 && temValor) {
+            config.bloco = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--grau") == 0 && temValor) {
+            config.grau = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--alcance") == 0 && temValor) {
+            config.alcance = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--continente") == 0 && temValor) {
+            config.territoriosPorContinente = atoi(argv[++i]);
+            continenteInformado = 1;
+        } else if (strcmp(argv[i], "--missoes") == 0 && temValor) {
+            arquivoMissoes = argv[++i];
+        } else if (strcmp(argv[i], "--semente") == 0 && temValor) {
+            config.semente = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--texto") == 0) {
+            texto = 1;
+        } else if (argv[i][0] != '-' || strcmp(argv[i], "-") == 0) {
+            saida = argv[i];
+        } else {
+            return uso(argv[0]);
+        }
+    }
+    if (saida == NULL || config.territorios < 1 || config.alcance < 0) {
+        return uso(argv[0]);
+    }
+    if (!continenteInformado) {
+        ConfigGerador padrao;
+        geradorPadrao(&padrao, config.territorios);
+        config.territoriosPorContinente = padrao.territoriosPorContinente;
+    }
+
+    Missao missoes[MAX_MISSOES];
+    const Missao* tabela = MISSOES_PADRAO;
+    int numMissoes = NUM_MISSOES_PADRAO;
+    if (arquivoMissoes != NULL) {
+        numMissoes = carregarMissoes(arquivoMissoes, missoes, MAX_MISSOES, stderr);
+        if (numMissoes <= 0) {
+            fprintf(stderr, "ERRO: Arquivo de missoes invalido!\n");
+            return 1;
+        }
+        tabela = missoes;
+    }
+
+    Mapa mapa;
+    Arena arena;
+    Jogador* jogadores = NULL;
+    int numJogadores = 0;
+    arenaIniciar(&arena, 0);
+    if (!mapaIniciar(&mapa, 0) ||
+        !geradorCriar(&config, &mapa, &arena, &jogadores, &numJogadores)) {
+        fprintf(stderr, "ERRO: configuracao invalida ou memoria insuficiente\n");
+        mapaLiberar(&mapa);
+        arenaLiberar(&arena);
+        return 1;
+    }
+    Aleatorio rng;
+    aleatorioFluxo(&rng, config.semente, 1);
+    for (int j = 0; j < numJogadores; j++) {
+        jogadores[j].missao = sortearMissao(tabela, numMissoes, &rng);
+    }
+
+    int ok;
+    if (texto) {
+        FILE* arquivo = (strcmp(saida, "-") == 0) ? stdout : fopen(saida, "w");
+        ok = arquivo != NULL && snapshotExportarTexto(arquivo, &mapa, jogadores, numJogadores);
+        if (arquivo != NULL && arquivo != stdout && fclose(arquivo) != 0) {
+            ok = 0;
+        }
+        if (!ok) {
+            fprintf(stderr, "%s: falha na escrita\n", saida);
+        }
+    } else {
+        CodigoSnapshot codigo = snapshotSalvar(saida, &mapa, jogadores, numJogadores);
+        ok = codigo == SNAPSHOT_OK;
+        if (!ok) {
+            fprintf(stderr, "%s: %s\n", saida, snapshotMensagem(codigo));
+        }
+    }
+    if (ok && !(texto && strcmp(saida, "-") == 0)) {
+        printf("%s: %d territorios, %d cores, %d fronteiras, %d continentes\n", saida,
+               mapa.quantidade, numJogadores, mapa.grafo->numEntradas / 2,
+               (mapa.continentes != NULL) ? mapa.continentes->numContinentes : 0);
+    }
+
+    mapaLiberar(&mapa);
+    arenaLiberar(&arena);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,282 @@
+/*
+ * Replay de partidas registradas do Jogo War
+ * 
+ * Lê um registro de eventos (registro.h) e reconstrói o estado da partida
+ * em qualquer turno, a partir do checkpoint mais próximo.
+ * 
+ * Uso:
+ *   replay info     <registro>                         resumo do registro
+ *   replay eventos  <registro> [inicio] [quantidade]   lista os eventos
+ *   replay turno    <registro> <turno> [saida.txt]     estado como cenário
+ *   replay snapshot <registro> <turno> <saida.snp>     estado como snapshot
+ *   replay conferir <registro>                         auditoria completa
+ * 
+ * O turno t é o estado depois dos primeiros t eventos. O snapshot gerado
+ * pode ser continuado com "war --carregar".
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "nucleo/registro.h"
+#include "nucleo/snapshot.h"
+
+static int uso(const char* programa) {
+    fprintf(stderr,
+            "Uso:\n"
+            "  %s info     <registro>\n"
+            "  %s eventos  <registro> [inicio] [quantidade]\n"
+            "  %s turno    <registro> <turno> [saida.txt]\n"
+            "  %s snapshot <registro> <turno> <saida.snp>\n"
+            "  %s conferir <registro>\n",
+            programa, programa, programa, programa, programa);
+    return 2;
+}
+
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int lerTurno(const char* texto, const LeitorRegistro* leitor, long long* turno) {
+    char* fim;
+    *turno = strtoll(texto, &fim, 10);
+    if (fim == texto || *fim != '\0' || *turno < 0 || *turno > leitor->numEventos) {
+        fprintf(stderr, "Turno invalido: o registro vai de 0 a %lld\n", leitor->numEventos);
+        return 0;
+    }
+    return 1;
+}
+
+static int info(const LeitorRegistro* leitor) {
+    const CabecalhoRegistro* cab = &leitor->cabecalho;
+    printf("%s: versao %u, regra %s\n", leitor->caminho, cab->versao,
+           nomeRegra((RegraBatalha) cab->regra));
+    printf("  territorios: %u\n  eventos: %lld\n  intervalo de checkpoints: %u\n",
+           cab->numTerritorios, leitor->numEventos, cab->intervalo);
+
+    size_t tamanho = strlen(leitor->caminho) + 32;
+    char* nome = (char*) malloc(tamanho);
+    if (nome == NULL) {
+        fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+        return 1;
+    }
+    long long presentes = 0, ausentes = 0;
+    for (long long t = 0; t <= leitor->numEventos; t += cab->intervalo) {
+        nomeCheckpoint(nome, tamanho, leitor->caminho, t);
+        if (access(nome, R_OK) == 0) {
+            presentes++;
+        } else {
+            ausentes++;
+        }
+    }
+    free(nome);
+    printf("  checkpoints: %lld presentes, %lld ausentes\n", presentes, ausentes);
+    return 0;
+}
+
+// Dados de um lado, decodificados do evento, como "6-5-3"
+static void formatarDados(char* destino, size_t tamanho, uint8_t codigo) {
+    uint8_t dados[MAX_DADOS];
+    int quantidade = decodificarDados(codigo, dados);
+    int usado = 0;
+    destino[0] = '\0';
+    for (int k = 0; k < quantidade && usado < (int) tamanho; k++) {
+        usado += snprintf(destino + usado, tamanho - (size_t) usado, "%s%d", k ? "-" : "", dados[k]);
+    }
+}
+
+static int listarEventos(const LeitorRegistro* leitor, long long inicio, long long quantidade) {
+    if (inicio < 0 || quantidade < 0) {
+        return 1;
+    }
+    long long fim = inicio + quantidade;
+    if (fim > leitor->numEventos) {
+        fim = leitor->numEventos;
+    }
+    printf("%10s %10s %10s %13s %12s %12s %s\n",
+           "evento", "atacante", "defensor", "dados", "trop.atac.", "trop.def.", "resultado");
+    for (long long t = inicio; t < fim; t++) {
+        const Evento* e = &leitor->eventos[t];
+        if (e->tipo == EVENTO_RESTAURAR) {
+            printf("%10lld %10d %10s %13s %12d %12s restaurado (cor %d)\n", t, e->atacante + 1,
+                   "-", "-", e->tropasAtacante, "-", e->tropasDefensor);
+            continue;
+        }
+        char atacante[8], defensor[8];
+        formatarDados(atacante, sizeof(atacante), e->dadoAtacante);
+        formatarDados(defensor, sizeof(defensor), e->dadoDefensor);
+        printf("%10lld %10d %10d %5s x %-5s %12d %12d %s\n", t, e->atacante + 1, e->defensor + 1,
+               atacante, defensor, e->tropasAtacante, e->tropasDefensor,
+               e->conquista ? "conquista" : "repelido");
+    }
+    return 0;
+}
+
+// Estado em um turno, gravado como cenário (texto) ou snapshot
+static int exportarTurno(const LeitorRegistro* leitor, long long turno,
+                         const char* saida, int comoSnapshot) {
+    Mapa mapa;
+    Arena arena;
+    Jogador* jogadores = NULL;
+    int numJogadores = 0;
+    long long checkpoint = 0;
+    double inicio = agora();
+    arenaIniciar(&arena, 0);
+    CodigoRegistro codigo = reconstruirTurno(leitor, turno, 0, &mapa, &arena, &jogadores,
+                                             &numJogadores, &checkpoint);
+    if (codigo != REGISTRO_OK) {
+        fprintf(stderr, "%s: %s\n", leitor->caminho, registroMensagem(codigo));
+        arenaLiberar(&arena);
+        return 1;
+    }
+    fprintf(stderr, "Turno %lld reconstruido a partir do checkpoint %lld "
+                    "(%lld eventos aplicados, %.1f ms)\n",
+            turno, checkpoint, turno - checkpoint, (agora() - inicio) * 1e3);
+
+    int ok = 1;
+    if (comoSnapshot) {
+        CodigoSnapshot gravacao = snapshotSalvar(saida, &mapa, jogadores, numJogadores);
+        if (gravacao != SNAPSHOT_OK) {
+            fprintf(stderr, "%s: %s\n", saida, snapshotMensagem(gravacao));
+            ok = 0;
+        }
+    } else {
+        FILE* arquivo = (saida != NULL) ? fopen(saida, "w") : stdout;
+        if (arquivo == NULL) {
+            fprintf(stderr, "%s: nao foi possivel criar o arquivo\n", saida);
+            ok = 0;
+        } else {
+            ok = snapshotExportarTexto(arquivo, &mapa, jogadores, numJogadores);
+            if (arquivo != stdout && fclose(arquivo) != 0) {
+                ok = 0;
+            }
+            if (!ok) {
+                fprintf(stderr, "%s: falha na escrita\n", saida ? saida : "stdout");
+            }
+        }
+    }
+    mapaLiberar(&mapa);
+    arenaLiberar(&arena);
+    return ok ? 0 : 1;
+}
+
+/*
+ * Função: conferir
+ * 
+ * Refaz a partida inteira a partir do turno 0, conferindo cada evento com
+ * a regra de batalha e cada checkpoint com o estado reconstruído.
+ */
+static int conferir(const LeitorRegistro* leitor) {
+    Mapa mapa;
+    Arena arena, arenaCheckpoint;
+    Jogador* jogadores = NULL;
+    int numJogadores = 0;
+    double inicio = agora();
+    arenaIniciar(&arena, 0);
+    arenaIniciar(&arenaCheckpoint, 0);
+    CodigoRegistro codigo = reconstruirTurno(leitor, 0, 1, &mapa, &arena, &jogadores,
+                                             &numJogadores, NULL);
+    if (codigo != REGISTRO_OK) {
+        fprintf(stderr, "%s: turno 0: %s\n", leitor->caminho, registroMensagem(codigo));
+        arenaLiberar(&arena);
+        return 1;
+    }
+
+    size_t tamanho = strlen(leitor->caminho) + 32;
+    char* nome = (char*) malloc(tamanho);
+    int ok = (nome != NULL);
+    long long conferidos = 0;
+    long long intervalo = leitor->cabecalho.intervalo;
+    for (long long t = 0; ok && t < leitor->numEventos; t++) {
+        const Evento* evento = &leitor->eventos[t];
+        if (conferirEvento(&mapa, (RegraBatalha) leitor->cabecalho.regra, evento) != REGISTRO_OK) {
+            printf("Evento %lld: %s %d -> %d incoerente com a regra ou com o mapa\n", t,
+                   evento->tipo == EVENTO_RESTAURAR ? "restauracao" : "ataque",
+                   evento->atacante + 1, evento->defensor + 1);
+            ok = 0;
+            break;
+        }
+        aplicarEvento(&mapa, evento);
+
+        // Compara com o checkpoint gravado no fim de cada intervalo
+        if ((t + 1) % intervalo != 0) {
+            continue;
+        }
+        Mapa gravado;
+        Jogador* lidos = NULL;
+        int numLidos = 0;
+        nomeCheckpoint(nome, tamanho, leitor->caminho, t + 1);
+        // Os jogadores de cada checkpoint reaproveitam a mesma arena
+        arenaZerar(&arenaCheckpoint);
+        CodigoSnapshot carga = snapshotCarregar(nome, &gravado, &arenaCheckpoint, &lidos, &numLidos);
+        if (carga == SNAPSHOT_ERRO_ARQUIVO) {
+            continue;
+        }
+        if (carga != SNAPSHOT_OK) {
+            printf("Checkpoint %lld: %s\n", t + 1, snapshotMensagem(carga));
+            ok = 0;
+            break;
+        }
+        size_t n = (size_t) mapa.quantidade;
+        if (gravado.quantidade != mapa.quantidade ||
+            memcmp(gravado.donos, mapa.donos, n * sizeof(IdCor)) != 0 ||
+            memcmp(gravado.tropas, mapa.tropas, n * sizeof(int32_t)) != 0) {
+            printf("Checkpoint %lld: difere do estado reconstruido pelos eventos\n", t + 1);
+            ok = 0;
+        }
+        conferidos++;
+        mapaLiberar(&gravado);
+    }
+
+    if (nome == NULL) {
+        fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+    } else if (ok) {
+        printf("%s: %lld eventos e %lld checkpoints conferidos em %.2f s\n", leitor->caminho,
+               leitor->numEventos, conferidos + 1, agora() - inicio);
+    }
+    free(nome);
+    mapaLiberar(&mapa);
+    arenaLiberar(&arenaCheckpoint);
+    arenaLiberar(&arena);
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        return uso(argv[0]);
+    }
+    const char* comando = argv[1];
+    LeitorRegistro leitor;
+    CodigoRegistro codigo = leitorAbrir(&leitor, argv[2]);
+    if (codigo != REGISTRO_OK) {
+        fprintf(stderr, "%s: %s\n", argv[2], registroMensagem(codigo));
+        return 1;
+    }
+
+    int retorno;
+    long long turno;
+    if (strcmp(comando, "info") == 0 && argc == 3) {
+        retorno = info(&leitor);
+    } else if (strcmp(comando, "eventos") == 0 && argc <= 5) {
+        long long inicio = (argc > 3) ? atoll(argv[3]) : 0;
+        long long quantidade = (argc > 4) ? atoll(argv[4]) : 20;
+        retorno = listarEventos(&leitor, inicio, quantidade);
+    } else if (strcmp(comando, "turno") == 0 && (argc == 4 || argc == 5)) {
+        retorno = lerTurno(argv[3], &leitor, &turno)
+                      ? exportarTurno(&leitor, turno, (argc == 5) ? argv[4] : NULL, 0) : 1;
+    } else if (strcmp(comando, "snapshot") == 0 && argc == 5) {
+        retorno = lerTurno(argv[3], &leitor, &turno)
+                      ? exportarTurno(&leitor, turno, argv[4], 1) : 1;
+    } else if (strcmp(comando, "conferir") == 0 && argc == 3) {
+        retorno = conferir(&leitor);
+    } else {
+        retorno = uso(argv[0]);
+    }
+    leitorFechar(&leitor);
+    return retorno;
+}
@@ -0,0 +1,141 @@
+/*
+ * Servidor de partidas do Jogo War
+ *
+ * Hospeda muitas partidas simultâneas em rede (ver nucleo/servidor.h
+ * para o protocolo). Todas as partidas começam do mesmo cenário, ou de
+ * um mapa gerado em que todos os territórios fazem fronteira entre si.
+ * Ctrl+C encerra o servidor e mostra os totais.
+ *
+ * Uso: servidor [opções]
+ *   --endereco E        host:porta ou unix:caminho (padrão 127.0.0.1:7070)
+ *   --lacos N           laços de eventos, um por thread (padrão 1)
+ *   --cenario ARQ       jogadores e territórios do cenário ARQ
+ *   --territorios N     territórios do mapa gerado, sem cenário (padrão 42)
+ *   --jogadores N       jogadores do mapa gerado, sem cenário (padrão 4)
+ *   --missoes ARQ       missões do arquivo de dados ARQ (ver missao.h)
+ *   --regra R           regra de batalha: simples (padrão) ou classica
+ *   --semente S         semente das partidas (padrão: do sistema)
+ *
+ * Exemplo com um cliente de linha de comando:
+ *   ./servidor --cenario cenario.txt &
+ *   nc 127.0.0.1 7070        (CRIAR, ENTRAR <partida>, ESTADO, ...)
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nucleo/aleatorio.h"
+#include "nucleo/partida.h"
+#include "nucleo/servidor.h"
+
+static Servidor* servidorAtivo;
+
+static void tratarSinal(int sinal) {
+    (void) sinal;
+    servidorParar(servidorAtivo);
+}
+
+static int uso(const char* programa) {
+    fprintf(stderr,
+            "Uso: %s [--endereco E] [--lacos N] [--cenario ARQ] [--territorios N]\n"
+            "       [--jogadores N] [--missoes ARQ] [--regra R] [--semente S]\n"
+            "E: host:porta ou unix:caminho\n"
+            "R: simples ou classica\n",
+            programa);
+    return 2;
+}
+
+int main(int argc, char* argv[]) {
+    ConfigServidor config;
+    config.endereco = "127.0.0.1:7070";
+    config.lacos = 1;
+    config.regra = REGRA_SIMPLES;
+    config.semente = aleatorioSementeSistema();
+    const char* arquivoCenario = NULL;
+    const char* arquivoMissoes = NULL;
+    int territorios = 42;
+    int jogadores = 4;
+
+    for (int i = 1; i < argc; i++) {
+        int temValor = i + 1 < argc;
+        if (strcmp(argv[i], "--endereco") == 0 && temValor) {
+            config.endereco = argv[++i];
+        } else if (strcmp(argv[i], "--lacos") == 0 && temValor) {
+            config.lacos = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--cenario") == 0 && temValor) {
+            arquivoCenario = argv[++i];
+        } else if (strcmp(argv[i], "--territorios") == 0 && temValor) {
+            territorios = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--jogadores") == 0 && temValor) {
+            jogadores = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--missoes") == 0 && temValor) {
+            arquivoMissoes = argv[++i];
+        } else if (strcmp(argv[i], "--regra") == 0 && temValor) {
+            if (!regraPorNome(argv[++i], &config.regra)) {
+                return uso(argv[0]);
+            }
+        } else if (strcmp(argv[i], "--semente") == 0 && temValor) {
+            config.semente = strtoull(argv[++i], NULL, 10);
+        } else {
+            return uso(argv[0]);
+        }
+    }
+    if (config.lacos < 1 || config.lacos > MAX_LACOS) {
+        return uso(argv[0]);
+    }
+
+    ModeloPartida modelo;
+    if (arquivoCenario != NULL) {
+        if (!modeloCarregarCenario(&modelo, arquivoCenario, stderr)) {
+            fprintf(stderr, "ERRO: cenario invalido (precisa de 2 a %d jogadores e territorios)\n",
+                    MAX_JOGADORES_PARTIDA);
+            return 1;
+        }
+    } else if (!modeloGerar(&modelo, territorios, jogadores, config.semente)) {
+        fprintf(stderr, "ERRO: mapa invalido (%d territorios, %d jogadores)\n",
+                territorios, jogadores);
+        return 1;
+    }
+    if (arquivoMissoes != NULL && !modeloCarregarMissoes(&modelo, arquivoMissoes, stderr)) {
+        fprintf(stderr, "ERRO: Arquivo de missoes invalido!\n");
+        modeloLiberar(&modelo);
+        return 1;
+    }
+
+    Servidor* servidor = servidorCriar(&modelo, &config, stderr);
+    if (servidor == NULL) {
+        modeloLiberar(&modelo);
+        return 1;
+    }
+    servidorAtivo = servidor;
+    struct sigaction acao;
+    memset(&acao, 0, sizeof(acao));
+    acao.sa_handler = tratarSinal;
+    sigaction(SIGINT, &acao, NULL);
+    sigaction(SIGTERM, &acao, NULL);
+
+    printf("Servidor em %s", config.endereco);
+    if (servidorPorta(servidor) != 0) {
+        printf(" (porta %d)", servidorPorta(servidor));
+    }
+    printf(": %d lacos, %d territorios, %d jogadores por partida, regra %s\n",
+           config.lacos, modelo.mapa.quantidade, modelo.numJogadores, nomeRegra(config.regra));
+    fflush(stdout);
+
+    int ok = servidorExecutar(servidor);
+    ResumoServidor resumo;
+    servidorResumo(servidor, &resumo);
+    printf("\nConexoes: %lld  Partidas: %lld (%lld com vencedor)  Comandos: %lld"
+           "  Transferencias: %lld\n",
+           resumo.conexoes, resumo.partidas, resumo.encerradas, resumo.comandos,
+           resumo.transferencias);
+    if (!ok) {
+        fprintf(stderr, "ERRO: nao foi possivel criar as threads dos lacos\n");
+    }
+
+    servidorDestruir(servidor);
+    modeloLiberar(&modelo);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,228 @@
+/*
+ * Conversor de snapshots do Jogo War
+ * 
+ * Converte entre o snapshot binário (snapshot.h) e o formato de cenário
+ * (cenario.h), e mostra o resumo de um snapshot conferindo sua soma de
+ * verificação.
+ * 
+ * Uso:
+ *   snapshot texto   <entrada.snp> [saida.txt]   binário -> texto (padrão: stdout)
+ *   snapshot binario <entrada.txt|-> <saida.snp> texto -> binário
+ *   snapshot info    <entrada.snp>               resumo e verificação
+ *   snapshot conferir <entrada.snp>              grava de novo, recarrega e compara
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nucleo/cenario.h"
+#include "nucleo/continente.h"
+#include "nucleo/grafo.h"
+#include "nucleo/mapa.h"
+#include "nucleo/snapshot.h"
+
+static int uso(const char* programa) {
+    fprintf(stderr,
+            "Uso:\n"
+            "  %s texto   <entrada.snp> [saida.txt]\n"
+            "  %s binario <entrada.txt|-> <saida.snp>\n"
+            "  %s info    <entrada.snp>\n"
+            "  %s conferir <entrada.snp>\n",
+            programa, programa, programa, programa);
+    return 2;
+}
+
+// Binário -> texto, ou apenas o resumo se `saida` for NULL e `resumo` for 1
+static int paraTexto(const char* entrada, const char* saida, int resumo) {
+    Mapa mapa;
+    Arena arena;
+    Jogador* jogadores = NULL;
+    int numJogadores = 0;
+    arenaIniciar(&arena, 0);
+    CodigoSnapshot codigo = snapshotCarregar(entrada, &mapa, &arena, &jogadores, &numJogadores);
+    if (codigo != SNAPSHOT_OK) {
+        fprintf(stderr, "%s: %s\n", entrada, snapshotMensagem(codigo));
+        arenaLiberar(&arena);
+        return 1;
+    }
+
+    int ok = 1;
+    if (resumo) {
+        printf("%s: versao %d, soma conferida\n", entrada, VERSAO_SNAPSHOT);
+        printf("  territorios: %d\n  cores: %d\n  jogadores: %d\n",
+               mapa.quantidade, mapa.numCores, numJogadores);
+        if (mapa.grafo == NULL) {
+            printf("  fronteiras: nenhuma gravada\n");
+        } else if (mapa.grafo->linear) {
+            printf("  fronteiras: lineares\n");
+        } else {
+            printf("  fronteiras: %d\n", mapa.grafo->numEntradas / 2);
+        }
+        printf("  continentes: %d\n",
+               (mapa.continentes != NULL) ? mapa.continentes->numContinentes : 0);
+    } else {
+        FILE* arquivo = (saida != NULL) ? fopen(saida, "w") : stdout;
+        if (arquivo == NULL) {
+            fprintf(stderr, "%s: nao foi possivel criar o arquivo\n", saida);
+            ok = 0;
+        } else {
+            ok = snapshotExportarTexto(arquivo, &mapa, jogadores, numJogadores);
+            if (arquivo != stdout && fclose(arquivo) != 0) {
+                ok = 0;
+            }
+            if (!ok) {
+                fprintf(stderr, "%s: falha na escrita\n", saida ? saida : "stdout");
+            }
+        }
+    }
+
+    mapaLiberar(&mapa);
+    arenaLiberar(&arena);
+    return ok ? 0 : 1;
+}
+
+// Texto -> binário
+static int paraBinario(const char* entrada, const char* saida) {
+    Mapa mapa;
+    Arena arena;
+    Jogador* jogadores = NULL;
+    int numJogadores = 0;
+    if (!mapaIniciar(&mapa, 0)) {
+        fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+        return 1;
+    }
+    arenaIniciar(&arena, 0);
+    int ok = cenarioCarregar(entrada, &mapa, &arena, &jogadores, &numJogadores, stderr);
+
+    // O snapshot guarda a missão de cada jogador
+    for (int i = 0; ok && i < numJogadores; i++) {
+        if (jogadores[i].missao == NULL) {
+            fprintf(stderr, "%s: jogador %s sem missao\n", entrada, jogadores[i].nome);
+            ok = 0;
+        }
+    }
+    if (ok) {
+        CodigoSnapshot codigo = snapshotSalvar(saida, &mapa, jogadores, numJogadores);
+        if (codigo != SNAPSHOT_OK) {
+            fprintf(stderr, "%s: %s\n", saida, snapshotMensagem(codigo));
+            ok = 0;
+        }
+    }
+    mapaLiberar(&mapa);
+    arenaLiberar(&arena);
+    return ok ? 0 : 1;
+}
+
+// Compara tudo o que o snapshot grava; imprime a primeira diferença
+static int mapasIguais(const Mapa* a, const Jogador* jogA, int numA,
+                       const Mapa* b, const Jogador* jogB, int numB) {
+    if (a->quantidade != b->quantidade || a->numCores != b->numCores || numA != numB) {
+        fprintf(stderr, "tamanhos diferentes\n");
+        return 0;
+    }
+    size_t n = (size_t) a->quantidade;
+    if (memcmp(a->cores, b->cores, sizeof(a->cores[0]) * (size_t) a->numCores) != 0 ||
+        memcmp(a->donos, b->donos, n * sizeof(IdCor)) != 0 ||
+        memcmp(a->tropas, b->tropas, n * sizeof(int32_t)) != 0 ||
+        memcmp(a->nomes, b->nomes, n * TAM_NOME) != 0) {
+        fprintf(stderr, "cores ou territorios diferentes\n");
+        return 0;
+    }
+    for (int i = 0; i < numA; i++) {
+        if (strcmp(jogA[i].nome, jogB[i].nome) != 0 || strcmp(jogA[i].cor, jogB[i].cor) != 0 ||
+            jogA[i].idCor != jogB[i].idCor || jogA[i].bot != jogB[i].bot ||
+            (jogA[i].missao == NULL) != (jogB[i].missao == NULL) ||
+            (jogA[i].missao != NULL &&
+             (jogA[i].missao->tipo != jogB[i].missao->tipo ||
+              jogA[i].missao->parametro != jogB[i].missao->parametro ||
+              strcmp(jogA[i].missao->texto, jogB[i].missao->texto) != 0))) {
+            fprintf(stderr, "jogador %d diferente\n", i + 1);
+            return 0;
+        }
+    }
+
+    const Grafo* ga = a->grafo;
+    const Grafo* gb = b->grafo;
+    if ((ga == NULL) != (gb == NULL) ||
+        (ga != NULL && (ga->linear != gb->linear || ga->completo != gb->completo ||
+                        ga->numEntradas != gb->numEntradas ||
+                        (!ga->completo &&
+                         (memcmp(ga->inicio, gb->inicio, (n + 1) * sizeof(int32_t)) != 0 ||
+                          memcmp(ga->vizinhos, gb->vizinhos,
+                                 (size_t) ga->numEntradas * sizeof(int32_t)) != 0))))) {
+        fprintf(stderr, "fronteiras diferentes\n");
+        return 0;
+    }
+
+    const Continentes* ca = a->continentes;
+    const Continentes* cb = b->continentes;
+    if ((ca == NULL) != (cb == NULL) ||
+        (ca != NULL && (ca->numContinentes != cb->numContinentes ||
+                        memcmp(ca->lista, cb->lista,
+                               (size_t) ca->numContinentes * sizeof(Continente)) != 0 ||
+                        memcmp(ca->continenteDe, cb->continenteDe, n * sizeof(int32_t)) != 0))) {
+        fprintf(stderr, "continentes diferentes\n");
+        return 0;
+    }
+    return 1;
+}
+
+// Ida e volta: grava o snapshot carregado em <entrada>.volta, carrega a cópia e compara
+static int conferir(const char* entrada) {
+    Mapa mapa, copia;
+    Arena arena, arenaCopia;
+    Jogador* jogadores = NULL;
+    Jogador* jogadoresCopia = NULL;
+    int numJogadores = 0, numCopia = 0;
+    arenaIniciar(&arena, 0);
+    arenaIniciar(&arenaCopia, 0);
+
+    CodigoSnapshot codigo = snapshotCarregar(entrada, &mapa, &arena, &jogadores, &numJogadores);
+    if (codigo != SNAPSHOT_OK) {
+        fprintf(stderr, "%s: %s\n", entrada, snapshotMensagem(codigo));
+        arenaLiberar(&arena);
+        arenaLiberar(&arenaCopia);
+        return 1;
+    }
+
+    char volta[1024];
+    snprintf(volta, sizeof(volta), "%s.volta", entrada);
+    int ok = 0;
+    codigo = snapshotSalvar(volta, &mapa, jogadores, numJogadores);
+    if (codigo == SNAPSHOT_OK) {
+        codigo = snapshotCarregar(volta, &copia, &arenaCopia, &jogadoresCopia, &numCopia);
+        remove(volta);
+    }
+    if (codigo != SNAPSHOT_OK) {
+        fprintf(stderr, "%s: %s\n", volta, snapshotMensagem(codigo));
+    } else {
+        ok = mapasIguais(&mapa, jogadores, numJogadores, &copia, jogadoresCopia, numCopia);
+        mapaLiberar(&copia);
+        if (ok) {
+            printf("%s: %d territorios gravados, recarregados e iguais\n",
+                   entrada, mapa.quantidade);
+        }
+    }
+
+    mapaLiberar(&mapa);
+    arenaLiberar(&arena);
+    arenaLiberar(&arenaCopia);
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc >= 3 && strcmp(argv[1], "texto") == 0) {
+        return paraTexto(argv[2], (argc > 3) ? argv[3] : NULL, 0);
+    }
+    if (argc == 4 && strcmp(argv[1], "binario") == 0) {
+        return paraBinario(argv[2], argv[3]);
+    }
+    if (argc == 3 && strcmp(argv[1], "info") == 0) {
+        return paraTexto(argv[2], NULL, 1);
+    }
+    if (argc == 3 && strcmp(argv[1], "conferir") == 0) {
+        return conferir(argv[2]);
+    }
+    return uso(argv[0]);
+}
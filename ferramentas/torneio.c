@@ -0,0 +1,256 @@
+/*
+ * Torneio de partidas automáticas do Jogo War
+ * 
+ * Joga muitas partidas completas em paralelo com a política embutida de
+ * torneio.h e mostra as taxas de vitória por missão e por ordem de
+ * jogada. Os resultados podem ser gravados em CSV para análise.
+ * 
+ * Uso: torneio [opções]
+ *   --partidas N        partidas por configuração (padrão 10000)
+ *   --territorios L     tamanhos do mapa, separados por vírgula (padrão 42)
+ *   --jogadores L       jogadores por partida, separados por vírgula (padrão 4)
+ *   --rodadas N         rodadas até o empate (padrão 500)
+ *   --semente S         semente do torneio (padrão 2025)
+ *   --threads N         trabalhadores do pool (padrão: todos os núcleos)
+ *   --sem-reforco       os jogadores não recebem tropas novas
+ *   --regra R           regra de batalha: simples (padrão) ou classica
+ *   --missoes ARQ       missões do arquivo de dados ARQ (ver missao.h)
+ *   --cenario ARQ       usa os territórios, fronteiras e continentes do cenário ARQ
+ *   --csv ARQ           uma linha por partida
+ *   --resumo ARQ        uma linha por missão e configuração
+ *   --curvas ARQ        tropas médias por rodada e configuração
+ * 
+ * Com listas em --territorios e --jogadores, todas as combinações são
+ * jogadas e os CSVs acumulam as linhas de todas elas.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nucleo/cenario.h"
+#include "nucleo/missao.h"
+#include "nucleo/pool.h"
+#include "nucleo/torneio.h"
+
+// Valores distintos aceitos em cada lista da varredura
+#define MAX_VARREDURA 16
+
+static int uso(const char* programa) {
+    fprintf(stderr,
+            "Uso: %s [--partidas N] [--territorios L] [--jogadores L] [--rodadas N]\n"
+            "       [--semente S] [--threads N] [--sem-reforco] [--regra R]\n"
+            "       [--missoes ARQ] [--cenario ARQ] [--csv ARQ] [--resumo ARQ]\n"
+            "       [--curvas ARQ]\n"
+            "R: simples ou classica\n"
+            "L: lista de inteiros separados por virgula (ex.: 20,42,100)\n",
+            programa);
+    return 2;
+}
+
+// Lê uma lista "a,b,c" de inteiros positivos; devolve a quantidade ou 0 se inválida
+static int lerLista(const char* texto, int* valores) {
+    int quantidade = 0;
+    const char* p = texto;
+    while (*p != '\0') {
+        char* fim;
+        long valor = strtol(p, &fim, 10);
+        if (fim == p || valor <= 0 || valor > 100000000 || quantidade == MAX_VARREDURA) {
+            return 0;
+        }
+        valores[quantidade++] = (int) valor;
+        if (*fim == ',') {
+            fim++;
+        } else if (*fim != '\0') {
+            return 0;
+        }
+        p = fim;
+    }
+    return quantidade;
+}
+
+static FILE* abrirSaida(const char* caminho) {
+    if (caminho == NULL) {
+        return NULL;
+    }
+    FILE* arquivo = fopen(caminho, "w");
+    if (arquivo == NULL) {
+        fprintf(stderr, "%s: nao foi possivel criar o arquivo\n", caminho);
+    }
+    return arquivo;
+}
+
+static void exibirResumo(const RegrasTorneio* regras, const ResumoTorneio* resumo) {
+    printf("\n=== %d territorios, %d jogadores, regra %s: %lld partidas em %.2f s"
+           " (%.0f partidas/s) ===\n",
+           regras->territorios, regras->jogadores, nomeRegra(regras->regra),
+           resumo->partidas, resumo->segundos,
+           resumo->partidas / (resumo->segundos > 0 ? resumo->segundos : 1e-9));
+    printf("Empates: %lld (%.1f%%)  Rodadas por partida: %.1f  Ataques por partida: %.1f\n",
+           resumo->empates, 100.0 * resumo->empates / resumo->partidas,
+           (double) resumo->rodadas / resumo->partidas,
+           (double) resumo->ataques / resumo->partidas);
+
+    printf("%-14s %6s %10s %10s %8s %10s\n",
+           "missao", "param", "sorteada", "vitorias", "taxa", "rodadas");
+    for (int m = 0; m < regras->numMissoes; m++) {
+        long long sorteada = resumo->atribuidas[m];
+        long long vitorias = resumo->vitorias[m];
+        printf("%-14s %6d %10lld %10lld %7.1f%% %10.1f\n",
+               nomeTipoMissao(regras->missoes[m].tipo), regras->missoes[m].parametro,
+               sorteada, vitorias, sorteada > 0 ? 100.0 * vitorias / sorteada : 0.0,
+               vitorias > 0 ? (double) resumo->rodadasVitoria[m] / vitorias : 0.0);
+    }
+
+    printf("Vitorias por ordem de jogada:");
+    for (int j = 0; j < regras->jogadores; j++) {
+        printf(" %d:%.1f%%", j + 1, 100.0 * resumo->vitoriasPosicao[j] / resumo->partidas);
+    }
+    printf("\n");
+}
+
+int main(int argc, char* argv[]) {
+    RegrasTorneio base;
+    regrasPadrao(&base);
+
+    long long numPartidas = 10000;
+    int territorios[MAX_VARREDURA] = {base.territorios};
+    int numTerritorios = 1;
+    int jogadores[MAX_VARREDURA] = {base.jogadores};
+    int numJogadores = 1;
+    int threads = numeroNucleos();
+    const char* arquivoMissoes = NULL;
+    const char* arquivoCenario = NULL;
+    const char* caminhoCsv = NULL;
+    const char* caminhoResumo = NULL;
+    const char* caminhoCurvas = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        int temValor = i + 1 < argc;
+        if (strcmp(argv[i], "--partidas") == 0 && temValor) {
+            numPartidas = atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--territorios") == 0 && temValor) {
+            numTerritorios = lerLista(argv[++i], territorios);
+        } else if (strcmp(argv[i], "--jogadores") == 0 && temValor) {
+            numJogadores = lerLista(argv[++i], jogadores);
+        } else if (strcmp(argv[i], "--rodadas") == 0 && temValor) {
+            base.maxRodadas = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--semente") == 0 && temValor) {
+            base.semente = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--threads") == 0 && temValor) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--sem-reforco") == 0) {
+            base.reforco = 0;
+        } else if (strcmp(argv[i], "--regra") == 0 && temValor) {
+            if (!regraPorNome(argv[++i], &base.regra)) {
+                return uso(argv[0]);
+            }
+        } else if (strcmp(argv[i], "--missoes") == 0 && temValor) {
+            arquivoMissoes = argv[++i];
+        } else if (strcmp(argv[i], "--cenario") == 0 && temValor) {
+            arquivoCenario = argv[++i];
+        } else if (strcmp(argv[i], "--csv") == 0 && temValor) {
+            caminhoCsv = argv[++i];
+        } else if (strcmp(argv[i], "--resumo") == 0 && temValor) {
+            caminhoResumo = argv[++i];
+        } else if (strcmp(argv[i], "--curvas") == 0 && temValor) {
+            caminhoCurvas = argv[++i];
+        } else {
+            return uso(argv[0]);
+        }
+    }
+    if (numPartidas <= 0 || numPartidas > 0x7FFFFFFF || numTerritorios == 0 ||
+        numJogadores == 0 || base.maxRodadas < 1 || threads < 1) {
+        return uso(argv[0]);
+    }
+
+    Missao missoes[MAX_MISSOES];
+    if (arquivoMissoes != NULL) {
+        base.numMissoes = carregarMissoes(arquivoMissoes, missoes, MAX_MISSOES, stderr);
+        if (base.numMissoes <= 0) {
+            fprintf(stderr, "ERRO: Arquivo de missoes invalido!\n");
+            return 1;
+        }
+        base.missoes = missoes;
+    }
+
+    // Tabuleiro de um cenário: só o tamanho, as fronteiras e os continentes são usados
+    Mapa tabuleiro;
+    int temTabuleiro = 0;
+    if (arquivoCenario != NULL) {
+        Arena arena;
+        Jogador* lidos = NULL;
+        int numLidos = 0;
+        if (!mapaIniciar(&tabuleiro, 0)) {
+            fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+            return 1;
+        }
+        temTabuleiro = 1;
+        arenaIniciar(&arena, 0);
+        int ok = cenarioCarregar(arquivoCenario, &tabuleiro, &arena, &lidos, &numLidos, stderr);
+        arenaLiberar(&arena);
+        if (!ok) {
+            mapaLiberar(&tabuleiro);
+            return 1;
+        }
+        territorios[0] = tabuleiro.quantidade;
+        numTerritorios = 1;
+        base.grafo = tabuleiro.grafo;
+        base.continentes = tabuleiro.continentes;
+    }
+
+    FILE* csv = abrirSaida(caminhoCsv);
+    FILE* resumoCsv = abrirSaida(caminhoResumo);
+    FILE* curvas = abrirSaida(caminhoCurvas);
+    Pool* pool = poolCriar(threads);
+    ResultadoPartida* resultados = (ResultadoPartida*) malloc(sizeof(ResultadoPartida) * numPartidas);
+    int ok = (caminhoCsv == NULL || csv != NULL) && (caminhoResumo == NULL || resumoCsv != NULL) &&
+             (caminhoCurvas == NULL || curvas != NULL);
+    if (ok && (pool == NULL || resultados == NULL)) {
+        fprintf(stderr, "ERRO: Falha na alocacao de memoria!\n");
+        ok = 0;
+    }
+
+    int primeira = 1;
+    for (int t = 0; ok && t < numTerritorios; t++) {
+        for (int j = 0; ok && j < numJogadores; j++) {
+            RegrasTorneio regras = base;
+            regras.territorios = territorios[t];
+            regras.jogadores = jogadores[j];
+
+            ResumoTorneio resumo;
+            if (!executarTorneio(&regras, numPartidas, pool, resultados, &resumo)) {
+                fprintf(stderr, "ERRO: configuracao invalida (%d territorios, %d jogadores)"
+                                " ou falta de memoria\n", regras.territorios, regras.jogadores);
+                ok = 0;
+                break;
+            }
+            exibirResumo(&regras, &resumo);
+            if (csv != NULL) {
+                escreverCsvPartidas(csv, &regras, resultados, numPartidas, primeira);
+            }
+            if (resumoCsv != NULL) {
+                escreverCsvMissoes(resumoCsv, &regras, &resumo, primeira);
+            }
+            if (curvas != NULL) {
+                escreverCsvCurvas(curvas, &regras, &resumo, primeira);
+            }
+            primeira = 0;
+            liberarResumo(&resumo);
+        }
+    }
+
+    FILE* arquivos[3] = {csv, resumoCsv, curvas};
+    for (int i = 0; i < 3; i++) {
+        if (arquivos[i] != NULL && fclose(arquivos[i]) != 0) {
+            fprintf(stderr, "ERRO: falha na escrita dos CSVs\n");
+            ok = 0;
+        }
+    }
+    free(resultados);
+    poolDestruir(pool);
+    if (temTabuleiro) {
+        mapaLiberar(&tabuleiro);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+/*
+ * Gerador de números aleatórios do Jogo War
+ * 
+ * xoshiro256** (Blackman e Vigna) semeado por splitmix64. Fluxos
+ * independentes são obtidos com a função de salto de 2^128 passos, o que
+ * garante sequências sem sobreposição entre threads.
+ */
+
+#include <time.h>
+#include <unistd.h>
+#include "aleatorio.h"
+
+/*
+ * Função: splitmix64
+ * 
+ * Expande uma semente de 64 bits em valores bem distribuídos para
+ * preencher o estado do xoshiro.
+ */
+static uint64_t splitmix64(uint64_t* x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/*
+ * Função: aleatorioSemear
+ * 
+ * Inicializa o gerador a partir de uma semente. A mesma semente sempre
+ * produz a mesma sequência.
+ * 
+ * Parâmetros:
+ *   rng - gerador a ser inicializado
+ *   semente - valor de 64 bits
+ */
+void aleatorioSemear(Aleatorio* rng, uint64_t semente) {
+    for (int i = 0; i < 4; i++) {
+        rng->s[i] = splitmix64(&semente);
+    }
+}
+
+/*
+ * Função: aleatorioSaltar
+ * 
+ * Avança o gerador 2^128 passos de uma vez.
+ */
+void aleatorioSaltar(Aleatorio* rng) {
+    static const uint64_t SALTO[] = {
+        0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+        0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL
+    };
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (SALTO[i] & (1ULL << b)) {
+                s0 ^= rng->s[0];
+                s1 ^= rng->s[1];
+                s2 ^= rng->s[2];
+                s3 ^= rng->s[3];
+            }
+            aleatorioProximo(rng);
+        }
+    }
+
+    rng->s[0] = s0;
+    rng->s[1] = s1;
+    rng->s[2] = s2;
+    rng->s[3] = s3;
+}
+
+/*
+ * Função: aleatorioFluxo
+ * 
+ * Inicializa o gerador no fluxo de número `fluxo` derivado da semente.
+ * Fluxos diferentes da mesma semente nunca se sobrepõem (cada um fica
+ * 2^128 passos à frente do anterior), então cada thread pode usar o seu.
+ * 
+ * Parâmetros:
+ *   rng - gerador a ser inicializado
+ *   semente - semente comum a todos os fluxos
+ *   fluxo - índice do fluxo (por exemplo, o número da thread)
+ */
+void aleatorioFluxo(Aleatorio* rng, uint64_t semente, unsigned fluxo) {
+    aleatorioSemear(rng, semente);
+    for (unsigned i = 0; i < fluxo; i++) {
+        aleatorioSaltar(rng);
+    }
+}
+
+/*
+ * Função: aleatorioSementeSistema
+ * 
+ * Gera uma semente a partir do relógio e do processo, para partidas
+ * em que não foi pedida uma semente fixa.
+ */
+uint64_t aleatorioSementeSistema(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    uint64_t x = ((uint64_t) ts.tv_sec << 32) ^ (uint64_t) ts.tv_nsec ^ ((uint64_t) getpid() << 16);
+    return splitmix64(&x);
+}
+
+/*
+ * Função: aleatorioPreencherDados
+ * 
+ * Preenche um vetor com rolagens de dados de 6 faces (valores 1 a 6).
+ * Cada número de 64 bits rende até 8 dados: bytes >= 252 são descartados
+ * para que todas as faces tenham exatamente a mesma probabilidade.
+ * 
+ * Parâmetros:
+ *   rng - gerador a ser usado
+ *   dados - vetor de destino
+ *   quantidade - número de dados a rolar
+ */
+void aleatorioPreencherDados(Aleatorio* rng, uint8_t* dados, size_t quantidade) {
+    size_t i = 0;
+
+    while (i < quantidade) {
+        uint64_t bits = aleatorioProximo(rng);
+        for (int b = 0; b < 8 && i < quantidade; b++, bits >>= 8) {
+            uint32_t byte = (uint32_t) (bits & 0xFF);
+            if (byte < 252) {
+                dados[i++] = (uint8_t) (byte % 6 + 1);
+            }
+        }
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ * Gerador de números aleatórios do Jogo War
+ * 
+ * Substitui rand()/srand() por um xoshiro256** com estado explícito:
+ * cada simulação (ou thread) mantém o seu próprio gerador, semeado de
+ * forma determinística, e os sorteios limitados não têm viés de módulo.
+ */
+
+#ifndef WAR_ALEATORIO_H
+#define WAR_ALEATORIO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Struct Aleatorio
+ * 
+ * Estado de um gerador xoshiro256** (32 bytes).
+ */
+typedef struct {
+    uint64_t s[4];
+} Aleatorio;
+
+void aleatorioSemear(Aleatorio* rng, uint64_t semente);
+void aleatorioFluxo(Aleatorio* rng, uint64_t semente, unsigned fluxo);
+void aleatorioSaltar(Aleatorio* rng);
+uint64_t aleatorioSementeSistema(void);
+void aleatorioPreencherDados(Aleatorio* rng, uint8_t* dados, size_t quantidade);
+
+/*
+ * Função: aleatorioProximo
+ * 
+ * Avança o gerador e devolve 64 bits pseudoaleatórios.
+ */
+static inline uint64_t aleatorioProximo(Aleatorio* rng) {
+    uint64_t* s = rng->s;
+    uint64_t x = s[1] * 5;
+    uint64_t resultado = ((x << 7) | (x >> 57)) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 45) | (s[3] >> 19);
+
+    return resultado;
+}
+
+/*
+ * Função: aleatorioLimitado
+ * 
+ * Sorteia um inteiro uniforme em [0, limite) sem viés de módulo
+ * (método de multiplicação com rejeição de Lemire).
+ * 
+ * Parâmetros:
+ *   rng - gerador a ser usado
+ *   limite - quantidade de valores possíveis (maior que zero)
+ */
+static inline uint32_t aleatorioLimitado(Aleatorio* rng, uint32_t limite) {
+    uint64_t m = (aleatorioProximo(rng) >> 32) * (uint64_t) limite;
+    uint32_t baixo = (uint32_t) m;
+
+    if (baixo < limite) {
+        uint32_t piso = (uint32_t) -limite % limite;
+        while (baixo < piso) {
+            m = (aleatorioProximo(rng) >> 32) * (uint64_t) limite;
+            baixo = (uint32_t) m;
+        }
+    }
+    return (uint32_t) (m >> 32);
+}
+
+#endif
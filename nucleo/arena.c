@@ -0,0 +1,160 @@
+/*
+ * Arena de alocação por partida
+ * 
+ * Blocos obtidos com malloc, cada um com um cabeçalho pequeno seguido da
+ * área servida por avanço de ponteiro.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+
+/*
+ * Struct BlocoArena
+ * 
+ * Cabeçalho de um bloco; os dados começam em CABECALHO_BLOCO bytes.
+ */
+struct BlocoArena {
+    BlocoArena* anterior;        // Bloco cheio encadeado antes deste
+    size_t capacidade;           // Bytes de dados do bloco
+    size_t usado;                // Bytes já servidos
+};
+
+// Tamanho do cabeçalho arredondado para manter os dados alinhados
+#define CABECALHO_BLOCO \
+    ((sizeof(BlocoArena) + ALINHAMENTO_ARENA - 1) & ~(size_t) (ALINHAMENTO_ARENA - 1))
+
+// Menor bloco encadeado quando a arena enche
+#define BLOCO_MINIMO_ARENA 4096
+
+static BlocoArena* novoBloco(size_t capacidade, BlocoArena* anterior) {
+    BlocoArena* bloco = (BlocoArena*) malloc(CABECALHO_BLOCO + capacidade);
+    if (bloco == NULL) {
+        return NULL;
+    }
+    bloco->anterior = anterior;
+    bloco->capacidade = capacidade;
+    bloco->usado = 0;
+    return bloco;
+}
+
+static void liberarBlocos(BlocoArena* bloco) {
+    while (bloco != NULL) {
+        BlocoArena* anterior = bloco->anterior;
+        free(bloco);
+        bloco = anterior;
+    }
+}
+
+/*
+ * Função: arenaIniciar
+ * 
+ * Prepara uma arena com um primeiro bloco de `capacidade` bytes (0 adia
+ * a alocação para o primeiro pedido).
+ * 
+ * Retorno: 1 em caso de sucesso, 0 em caso de falha de alocação
+ */
+int arenaIniciar(Arena* arena, size_t capacidade) {
+    arena->atual = NULL;
+    arena->capacidadeTotal = 0;
+    if (capacidade == 0) {
+        return 1;
+    }
+    arena->atual = novoBloco(capacidade, NULL);
+    if (arena->atual == NULL) {
+        return 0;
+    }
+    arena->capacidadeTotal = capacidade;
+    return 1;
+}
+
+/*
+ * Função: arenaAlocar
+ * 
+ * Reserva `tamanho` bytes alinhados a ALINHAMENTO_ARENA, com conteúdo
+ * indefinido. Se o bloco atual não comporta o pedido, encadeia um bloco
+ * novo com pelo menos o dobro da capacidade acumulada.
+ * 
+ * Retorno: o endereço reservado, ou NULL em caso de falha de alocação
+ */
+void* arenaAlocar(Arena* arena, size_t tamanho) {
+    size_t arredondado = (tamanho + ALINHAMENTO_ARENA - 1) & ~(size_t) (ALINHAMENTO_ARENA - 1);
+    if (arredondado < tamanho) {
+        return NULL;
+    }
+    BlocoArena* bloco = arena->atual;
+    if (bloco == NULL || bloco->capacidade - bloco->usado < arredondado) {
+        size_t capacidade = arena->capacidadeTotal > BLOCO_MINIMO_ARENA / 2
+                            ? arena->capacidadeTotal * 2 : BLOCO_MINIMO_ARENA;
+        if (capacidade < arredondado) {
+            capacidade = arredondado;
+        }
+        if (capacidade > SIZE_MAX - CABECALHO_BLOCO) {
+            return NULL;
+        }
+        bloco = novoBloco(capacidade, arena->atual);
+        if (bloco == NULL) {
+            return NULL;
+        }
+        arena->atual = bloco;
+        arena->capacidadeTotal += capacidade;
+    }
+    void* endereco = (unsigned char*) bloco + CABECALHO_BLOCO + bloco->usado;
+    bloco->usado += arredondado;
+    return endereco;
+}
+
+/*
+ * Função: arenaAlocarZerado
+ * 
+ * Como calloc: reserva `quantidade` elementos de `tamanho` bytes zerados.
+ * 
+ * Retorno: o endereço reservado, ou NULL em caso de falha de alocação
+ */
+void* arenaAlocarZerado(Arena* arena, size_t quantidade, size_t tamanho) {
+    if (tamanho != 0 && quantidade > SIZE_MAX / tamanho) {
+        return NULL;
+    }
+    void* endereco = arenaAlocar(arena, quantidade * tamanho);
+    if (endereco != NULL) {
+        memset(endereco, 0, quantidade * tamanho);
+    }
+    return endereco;
+}
+
+/*
+ * Função: arenaZerar
+ * 
+ * Devolve de uma vez tudo o que foi alocado, mantendo a memória para a
+ * próxima partida. Com um único bloco é só zerar o contador (O(1)); com
+ * blocos encadeados eles são trocados por um bloco com a capacidade de
+ * todos juntos (se a alocação falhar, a arena fica vazia e volta a
+ * crescer sob demanda).
+ */
+void arenaZerar(Arena* arena) {
+    BlocoArena* bloco = arena->atual;
+    if (bloco == NULL) {
+        return;
+    }
+    if (bloco->anterior == NULL) {
+        bloco->usado = 0;
+        return;
+    }
+    liberarBlocos(bloco);
+    arena->atual = novoBloco(arena->capacidadeTotal, NULL);
+    if (arena->atual == NULL) {
+        arena->capacidadeTotal = 0;
+    }
+}
+
+/*
+ * Função: arenaLiberar
+ * 
+ * Libera todos os blocos; tudo o que veio da arena deixa de ser válido.
+ */
+void arenaLiberar(Arena* arena) {
+    liberarBlocos(arena->atual);
+    arena->atual = NULL;
+    arena->capacidadeTotal = 0;
+}
@@ -0,0 +1,42 @@
+/*
+ * Arena de alocação por partida
+ * 
+ * Alocador por avanço de ponteiro: cada pedido é servido do bloco atual,
+ * sem cabeçalho por objeto, e nada é liberado individualmente. Jogadores,
+ * missões próprias e vetores do mapa de uma partida saem da mesma arena
+ * e são devolvidos todos de uma vez por arenaZerar (para reaproveitar a
+ * memória na partida seguinte) ou arenaLiberar.
+ * 
+ * Se o bloco enche, a arena encadeia outro; arenaZerar junta a
+ * capacidade de todos em um bloco só, então a partir da segunda partida
+ * de mesmo tamanho tudo cabe no primeiro bloco e zerar custa O(1).
+ */
+
+#ifndef WAR_ARENA_H
+#define WAR_ARENA_H
+
+#include <stddef.h>
+
+// Alinhamento de todos os blocos devolvidos (suficiente para qualquer tipo do jogo)
+#define ALINHAMENTO_ARENA 16
+
+typedef struct BlocoArena BlocoArena;
+
+/*
+ * Struct Arena
+ * 
+ * Pode ser declarada na pilha ou dentro de outra estrutura; só precisa
+ * de arenaIniciar antes do primeiro uso.
+ */
+typedef struct {
+    BlocoArena* atual;           // Bloco em uso (os anteriores, cheios, encadeados nele)
+    size_t capacidadeTotal;      // Soma das capacidades dos blocos
+} Arena;
+
+int arenaIniciar(Arena* arena, size_t capacidade);
+void* arenaAlocar(Arena* arena, size_t tamanho);
+void* arenaAlocarZerado(Arena* arena, size_t quantidade, size_t tamanho);
+void arenaZerar(Arena* arena);
+void arenaLiberar(Arena* arena);
+
+#endif
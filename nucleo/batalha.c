@@ -0,0 +1,749 @@
+/*
+ * Motor de batalha do Jogo War
+ * 
+ * Implementa as regras de ataque usadas pela função atacar do jogo
+ * interativo e pelo simulador em lote.
+ */
+
+#include <string.h>
+#include "batalha.h"
+#include "grafo.h"
+#include "perfil.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Quantidade de dados rolados de uma vez pelo simulador em lote
+#define DADOS_POR_RECARGA 256
+
+// Ataques por rodada de resolverRolagensLote (dados rolados em 6 planos deste tamanho)
+#define ATAQUES_POR_BLOCO 256
+
+// Slots da tabela de territórios já usados no bloco de executarLote (potência de 2)
+#define SLOTS_OCUPADOS 1024
+
+static const char* const NOMES_REGRAS[NUM_REGRAS] = {"simples", "classica"};
+
+static void aplicarPerdasClassica(int tropasAtacante, int tropasDefensor, int numDadosAtacante,
+                                  int perdasAtacante, int perdasDefensor,
+                                  ResultadoAtaque* resultado);
+
+/*
+ * Função: nomeRegra
+ * 
+ * Retorno: nome da regra usado nas opções de linha de comando
+ */
+const char* nomeRegra(RegraBatalha regra) {
+    return ((unsigned) regra < NUM_REGRAS) ? NOMES_REGRAS[regra] : "?";
+}
+
+/*
+ * Função: regraPorNome
+ * 
+ * Converte "simples" ou "classica" na regra correspondente.
+ * 
+ * Retorno: 1 se o nome foi reconhecido, 0 caso contrário
+ */
+int regraPorNome(const char* nome, RegraBatalha* regra) {
+    for (int r = 0; r < NUM_REGRAS; r++) {
+        if (strcmp(nome, NOMES_REGRAS[r]) == 0) {
+            *regra = (RegraBatalha) r;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Função: dadosDoAtacante
+ * 
+ * Retorno: dados rolados por um atacante com `tropas` tropas (uma fica
+ *          sempre no território: na regra clássica, até 3 dados)
+ */
+int dadosDoAtacante(RegraBatalha regra, int tropas) {
+    if (tropas < 2) {
+        return 0;
+    }
+    if (regra == REGRA_SIMPLES) {
+        return 1;
+    }
+    return (tropas - 1 < MAX_DADOS) ? tropas - 1 : MAX_DADOS;
+}
+
+/*
+ * Função: dadosDoDefensor
+ * 
+ * Retorno: dados rolados por um defensor com `tropas` tropas (na regra
+ *          simples sempre um; na clássica até 3, e nenhum se o território
+ *          está vazio, o que o entrega sem combate)
+ */
+int dadosDoDefensor(RegraBatalha regra, int tropas) {
+    if (regra == REGRA_SIMPLES) {
+        return 1;
+    }
+    if (tropas <= 0) {
+        return 0;
+    }
+    return (tropas < MAX_DADOS) ? tropas : MAX_DADOS;
+}
+
+// Rede de ordenação de 3 elementos em ordem decrescente (3 comparações)
+static inline void ordenar3(uint8_t* a, uint8_t* b, uint8_t* c) {
+    uint8_t t;
+    if (*a < *b) { t = *a; *a = *b; *b = t; }
+    if (*b < *c) { t = *b; *b = *c; *c = t; }
+    if (*a < *b) { t = *a; *a = *b; *b = t; }
+}
+
+// Copia até 3 dados (faltantes valem 0) e os ordena em ordem decrescente
+static void ordenarDados(const uint8_t* dados, int quantidade, uint8_t* destino) {
+    for (int k = 0; k < MAX_DADOS; k++) {
+        destino[k] = (k < quantidade) ? dados[k] : 0;
+    }
+    ordenar3(&destino[0], &destino[1], &destino[2]);
+}
+
+/*
+ * Função: codificarDados
+ * 
+ * Codifica até 3 dados em um byte (usado no registro de eventos). A
+ * ordem dos dados não importa: o código é o do multiconjunto ordenado,
+ * um dado sozinho é codificado pelo próprio valor (1 a 6) e nenhum dado
+ * (defensor vazio na regra clássica) vale 0.
+ * 
+ * Retorno: código entre 0 e 83
+ */
+uint8_t codificarDados(const uint8_t* dados, int quantidade) {
+    if (quantidade <= 0 || quantidade > MAX_DADOS) {
+        return 0;
+    }
+    uint8_t d[MAX_DADOS];
+    ordenarDados(dados, quantidade, d);
+    // Posição de (d1 >= d2 >= d3) entre as sequências não crescentes do mesmo tamanho
+    int a = d[0], b = d[1], c = d[2];
+    if (quantidade == 1) {
+        return (uint8_t) a;
+    }
+    if (quantidade == 2) {
+        return (uint8_t) (6 + (a - 1) * a / 2 + b);
+    }
+    return (uint8_t) (27 + (a - 1) * a * (a + 1) / 6 + (b - 1) * b / 2 + c);
+}
+
+/*
+ * Função: decodificarDados
+ * 
+ * Inverte codificarDados, devolvendo os dados em ordem decrescente.
+ * 
+ * Retorno: quantidade de dados (0 a 3), ou -1 se o código for inválido
+ */
+int decodificarDados(uint8_t codigo, uint8_t* dados) {
+    if (codigo == 0) {
+        return 0;
+    }
+    int quantidade = (codigo <= 6) ? 1 : (codigo <= 27) ? 2 : 3;
+    uint8_t d[MAX_DADOS];
+    for (d[0] = 1; d[0] <= 6; d[0]++) {
+        for (d[1] = (quantidade > 1); d[1] <= (quantidade > 1 ? d[0] : 0); d[1]++) {
+            for (d[2] = (quantidade > 2); d[2] <= (quantidade > 2 ? d[1] : 0); d[2]++) {
+                if (codificarDados(d, quantidade) == codigo) {
+                    memcpy(dados, d, (size_t) quantidade);
+                    return quantidade;
+                }
+            }
+        }
+    }
+    return -1;
+}
+
+/*
+ * Função: rolarDado
+ * 
+ * Simula a rolagem de um dado de 6 faces.
+ * 
+ * Parâmetros:
+ *   rng - gerador de números aleatórios da partida ou da thread
+ * 
+ * Retorno: número inteiro entre 1 e 6
+ */
+int rolarDado(Aleatorio* rng) {
+    return (int) aleatorioLimitado(rng, 6) + 1;
+}
+
+/*
+ * Função: aplicarRegraAtaque
+ * 
+ * Aplica as regras de batalha a partir de dois dados já rolados, apenas
+ * sobre as quantidades de tropas. Se o dado do atacante for maior, o
+ * defensor é conquistado e recebe metade das tropas do atacante. Caso
+ * contrário (empate favorece o defensor) o atacante perde uma tropa.
+ * 
+ * Parâmetros:
+ *   tropasAtacante - tropas do atacante antes do ataque (pelo menos 2)
+ *   tropasDefensor - tropas do defensor antes do ataque
+ *   dadoAtacante - valor rolado pelo atacante
+ *   dadoDefensor - valor rolado pelo defensor
+ *   resultado - onde o resultado é gravado
+ */
+void aplicarRegraAtaque(int tropasAtacante, int tropasDefensor,
+                        int dadoAtacante, int dadoDefensor,
+                        ResultadoAtaque* resultado) {
+    resultado->dadoAtacante = dadoAtacante;
+    resultado->dadoDefensor = dadoDefensor;
+    resultado->numDadosAtacante = 1;
+    resultado->numDadosDefensor = 1;
+    memset(resultado->dadosAtacante, 0, MAX_DADOS);
+    memset(resultado->dadosDefensor, 0, MAX_DADOS);
+    resultado->dadosAtacante[0] = (uint8_t) dadoAtacante;
+    resultado->dadosDefensor[0] = (uint8_t) dadoDefensor;
+
+    if (dadoAtacante > dadoDefensor) {
+        // Conquista: o defensor passa a ter as tropas transferidas
+        int tropasTransferidas = tropasAtacante / 2;
+        resultado->conquista = 1;
+        resultado->perdasAtacante = 0;
+        resultado->perdasDefensor = tropasDefensor;
+        resultado->tropasTransferidas = tropasTransferidas;
+        resultado->tropasAtacante = tropasAtacante - tropasTransferidas;
+        resultado->tropasDefensor = tropasTransferidas;
+    } else {
+        // Atacante perde uma tropa
+        resultado->conquista = 0;
+        resultado->perdasAtacante = 1;
+        resultado->perdasDefensor = 0;
+        resultado->tropasTransferidas = 0;
+        resultado->tropasAtacante = tropasAtacante - 1;
+        resultado->tropasDefensor = tropasDefensor;
+    }
+}
+
+/*
+ * Função: aplicarRegraClassica
+ * 
+ * Regra clássica do War: os dados de cada lado são ordenados e
+ * comparados aos pares (maior com maior, e assim por diante, até o
+ * menor número de dados); em cada par o maior vence e o empate favorece
+ * o defensor, e quem perde o par perde uma tropa. Se o defensor fica sem
+ * tropas, o território é conquistado e recebe uma tropa por dado do
+ * atacante (deixando pelo menos uma na origem).
+ * 
+ * Parâmetros:
+ *   tropasAtacante - tropas do atacante antes do ataque (pelo menos 2)
+ *   tropasDefensor - tropas do defensor antes do ataque
+ *   dadosAtacante - dados rolados pelo atacante, em qualquer ordem
+ *   numDadosAtacante - quantidade de dados do atacante (1 a 3)
+ *   dadosDefensor - dados rolados pelo defensor, em qualquer ordem
+ *   numDadosDefensor - quantidade de dados do defensor (0 a 3)
+ *   resultado - onde o resultado é gravado
+ */
+void aplicarRegraClassica(int tropasAtacante, int tropasDefensor,
+                          const uint8_t* dadosAtacante, int numDadosAtacante,
+                          const uint8_t* dadosDefensor, int numDadosDefensor,
+                          ResultadoAtaque* resultado) {
+    ordenarDados(dadosAtacante, numDadosAtacante, resultado->dadosAtacante);
+    ordenarDados(dadosDefensor, numDadosDefensor, resultado->dadosDefensor);
+    resultado->numDadosAtacante = numDadosAtacante;
+    resultado->numDadosDefensor = numDadosDefensor;
+    resultado->dadoAtacante = resultado->dadosAtacante[0];
+    resultado->dadoDefensor = resultado->dadosDefensor[0];
+
+    int pares = (numDadosAtacante < numDadosDefensor) ? numDadosAtacante : numDadosDefensor;
+    int perdasAtacante = 0, perdasDefensor = 0;
+    for (int k = 0; k < pares; k++) {
+        if (resultado->dadosAtacante[k] > resultado->dadosDefensor[k]) {
+            perdasDefensor++;
+        } else {
+            perdasAtacante++;
+        }
+    }
+    aplicarPerdasClassica(tropasAtacante, tropasDefensor, numDadosAtacante,
+                          perdasAtacante, perdasDefensor, resultado);
+}
+
+/*
+ * Função: aplicarPerdasClassica
+ * 
+ * Conclui um ataque na regra clássica a partir das perdas da comparação
+ * dos pares: decide a conquista e a ocupação (ver aplicarRegraClassica).
+ * Não toca nos dados do resultado.
+ */
+static void aplicarPerdasClassica(int tropasAtacante, int tropasDefensor, int numDadosAtacante,
+                                  int perdasAtacante, int perdasDefensor,
+                                  ResultadoAtaque* resultado) {
+    int restantes = tropasAtacante - perdasAtacante;
+    resultado->perdasAtacante = perdasAtacante;
+    if (tropasDefensor - perdasDefensor <= 0) {
+        // Conquista: ocupa com uma tropa por dado, sem esvaziar a origem
+        int tropasTransferidas = (numDadosAtacante < restantes - 1) ? numDadosAtacante : restantes - 1;
+        resultado->conquista = 1;
+        resultado->perdasDefensor = tropasDefensor;
+        resultado->tropasTransferidas = tropasTransferidas;
+        resultado->tropasAtacante = restantes - tropasTransferidas;
+        resultado->tropasDefensor = tropasTransferidas;
+    } else {
+        resultado->conquista = 0;
+        resultado->perdasDefensor = perdasDefensor;
+        resultado->tropasTransferidas = 0;
+        resultado->tropasAtacante = restantes;
+        resultado->tropasDefensor = tropasDefensor - perdasDefensor;
+    }
+}
+
+/*
+ * Função: aplicarRegra
+ * 
+ * Aplica a regra escolhida com dados já rolados; a quantidade de dados
+ * de cada lado sai das tropas (dadosDoAtacante e dadosDoDefensor).
+ * 
+ * Parâmetros:
+ *   regra - regra da partida
+ *   tropasAtacante, tropasDefensor - tropas antes do ataque
+ *   dadosAtacante, dadosDefensor - pelo menos MAX_DADOS dados de cada
+ *                                  lado (só os primeiros são usados)
+ *   resultado - onde o resultado é gravado
+ */
+void aplicarRegra(RegraBatalha regra, int tropasAtacante, int tropasDefensor,
+                  const uint8_t* dadosAtacante, const uint8_t* dadosDefensor,
+                  ResultadoAtaque* resultado) {
+    if (regra == REGRA_SIMPLES) {
+        aplicarRegraAtaque(tropasAtacante, tropasDefensor, dadosAtacante[0], dadosDefensor[0],
+                           resultado);
+    } else {
+        aplicarRegraClassica(tropasAtacante, tropasDefensor,
+                             dadosAtacante, dadosDoAtacante(regra, tropasAtacante),
+                             dadosDefensor, dadosDoDefensor(regra, tropasDefensor), resultado);
+    }
+}
+
+/*
+ * Função: validarAtaque
+ * 
+ * Verifica se um ataque entre dois territórios do mapa é permitido. Se o
+ * mapa tiver um grafo de fronteiras, os territórios precisam ser vizinhos.
+ * 
+ * Parâmetros:
+ *   mapa - mapa de territórios
+ *   atacante - índice do território atacante (começando em 0)
+ *   defensor - índice do território defensor (começando em 0)
+ * 
+ * Retorno: ATAQUE_OK ou o código do primeiro problema encontrado
+ */
+CodigoAtaque validarAtaque(const Mapa* mapa, int atacante, int defensor) {
+    if (atacante < 0 || atacante >= mapa->quantidade ||
+        defensor < 0 || defensor >= mapa->quantidade) {
+        return ATAQUE_INDICE_INVALIDO;
+    }
+    if (atacante == defensor) {
+        return ATAQUE_MESMO_TERRITORIO;
+    }
+    if (mapa->grafo != NULL && !grafoAdjacentes(mapa->grafo, atacante, defensor)) {
+        return ATAQUE_NAO_ADJACENTE;
+    }
+    if (mapa->donos[atacante] == mapa->donos[defensor]) {
+        return ATAQUE_MESMA_COR;
+    }
+    if (mapa->tropas[atacante] < 2) {
+        return ATAQUE_TROPAS_INSUFICIENTES;
+    }
+    return ATAQUE_OK;
+}
+
+// Grava no mapa um resultado já calculado (dono antes das tropas)
+static void registrarResultado(Mapa* mapa, int atacante, int defensor,
+                               const ResultadoAtaque* resultado) {
+    PERFIL_CONTAR(PERFIL_ATAQUES);
+    if (resultado->conquista) {
+        PERFIL_CONTAR(PERFIL_CONQUISTAS);
+        mapaDefinirDono(mapa, defensor, mapa->donos[atacante]);
+    }
+    mapaDefinirTropas(mapa, atacante, resultado->tropasAtacante);
+    mapaDefinirTropas(mapa, defensor, resultado->tropasDefensor);
+}
+
+/*
+ * Função: resolverAtaque
+ * 
+ * Resolve um ataque na regra simples a partir de dois dados já rolados.
+ * Em caso de conquista o defensor passa a pertencer à cor do atacante.
+ * 
+ * Parâmetros:
+ *   mapa - mapa de territórios
+ *   atacante - índice do território atacante
+ *   defensor - índice do território defensor
+ *   dadoAtacante - valor rolado pelo atacante
+ *   dadoDefensor - valor rolado pelo defensor
+ *   resultado - onde o resultado é gravado (pode ser NULL)
+ * 
+ * Retorno: ATAQUE_OK, ou ATAQUE_TROPAS_INSUFICIENTES sem alterar o mapa
+ */
+CodigoAtaque resolverAtaque(Mapa* mapa, int atacante, int defensor,
+                            int dadoAtacante, int dadoDefensor,
+                            ResultadoAtaque* resultado) {
+    if (mapa->tropas[atacante] < 2) {
+        return ATAQUE_TROPAS_INSUFICIENTES;
+    }
+
+    ResultadoAtaque local;
+    if (resultado == NULL) {
+        resultado = &local;
+    }
+    aplicarRegraAtaque(mapa->tropas[atacante], mapa->tropas[defensor],
+                       dadoAtacante, dadoDefensor, resultado);
+    registrarResultado(mapa, atacante, defensor, resultado);
+    return ATAQUE_OK;
+}
+
+/*
+ * Função: resolverAtaqueComDados
+ * 
+ * Como resolverAtaque, na regra escolhida e com os dados de cada lado já
+ * rolados (ver aplicarRegra).
+ * 
+ * Retorno: ATAQUE_OK, ou ATAQUE_TROPAS_INSUFICIENTES sem alterar o mapa
+ */
+CodigoAtaque resolverAtaqueComDados(Mapa* mapa, RegraBatalha regra, int atacante, int defensor,
+                                    const uint8_t* dadosAtacante, const uint8_t* dadosDefensor,
+                                    ResultadoAtaque* resultado) {
+    if (mapa->tropas[atacante] < 2) {
+        return ATAQUE_TROPAS_INSUFICIENTES;
+    }
+
+    ResultadoAtaque local;
+    if (resultado == NULL) {
+        resultado = &local;
+    }
+    aplicarRegra(regra, mapa->tropas[atacante], mapa->tropas[defensor],
+                 dadosAtacante, dadosDefensor, resultado);
+    registrarResultado(mapa, atacante, defensor, resultado);
+    return ATAQUE_OK;
+}
+
+/*
+ * Função: rolarAtaque
+ * 
+ * Rola os dados que cada lado tem direito na regra escolhida e resolve
+ * o ataque no mapa.
+ * 
+ * Retorno: ATAQUE_OK, ou ATAQUE_TROPAS_INSUFICIENTES sem alterar o mapa
+ */
+CodigoAtaque rolarAtaque(Mapa* mapa, RegraBatalha regra, int atacante, int defensor,
+                         Aleatorio* rng, ResultadoAtaque* resultado) {
+    uint8_t dadosAtacante[MAX_DADOS] = {0, 0, 0}, dadosDefensor[MAX_DADOS] = {0, 0, 0};
+    int numAtacante = dadosDoAtacante(regra, mapa->tropas[atacante]);
+    int numDefensor = dadosDoDefensor(regra, mapa->tropas[defensor]);
+    for (int k = 0; k < numAtacante; k++) {
+        dadosAtacante[k] = (uint8_t) rolarDado(rng);
+    }
+    for (int k = 0; k < numDefensor; k++) {
+        dadosDefensor[k] = (uint8_t) rolarDado(rng);
+    }
+    return resolverAtaqueComDados(mapa, regra, atacante, defensor,
+                                  dadosAtacante, dadosDefensor, resultado);
+}
+
+// Compara os pares de um ataque com os dados não rolados já zerados
+static inline void compararPares(uint8_t a0, uint8_t a1, uint8_t a2,
+                                 uint8_t d0, uint8_t d1, uint8_t d2,
+                                 uint8_t* perdasAtacante, uint8_t* perdasDefensor) {
+    ordenar3(&a0, &a1, &a2);
+    ordenar3(&d0, &d1, &d2);
+    uint8_t pa = 0, pd = 0;
+    const uint8_t a[MAX_DADOS] = {a0, a1, a2}, d[MAX_DADOS] = {d0, d1, d2};
+    for (int k = 0; k < MAX_DADOS; k++) {
+        if (a[k] != 0 && d[k] != 0) {
+            pa += (a[k] <= d[k]);
+            pd += (a[k] > d[k]);
+        }
+    }
+    *perdasAtacante = pa;
+    *perdasDefensor = pd;
+}
+
+#if defined(__SSE2__)
+// Rede de ordenação decrescente nas 16 faixas de três vetores de bytes
+static inline void ordenar3Vetores(__m128i* a, __m128i* b, __m128i* c) {
+    __m128i t = _mm_max_epu8(*a, *b);
+    *b = _mm_min_epu8(*a, *b);
+    *a = t;
+    t = _mm_max_epu8(*b, *c);
+    *c = _mm_min_epu8(*b, *c);
+    *b = t;
+    t = _mm_max_epu8(*a, *b);
+    *b = _mm_min_epu8(*a, *b);
+    *a = t;
+}
+
+// Um par de dados em 16 ataques: soma 1 à perda de quem perdeu, se o par existe
+static inline void compararParVetor(__m128i a, __m128i d, __m128i* perdasAtacante,
+                                    __m128i* perdasDefensor) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i ausente = _mm_or_si128(_mm_cmpeq_epi8(a, zero), _mm_cmpeq_epi8(d, zero));
+    // a <= d  <=>  a - d (com saturação) == 0; o empate é do defensor
+    __m128i defensorVence = _mm_cmpeq_epi8(_mm_subs_epu8(a, d), zero);
+    __m128i atacantePerde = _mm_andnot_si128(ausente, defensorVence);
+    __m128i defensorPerde = _mm_andnot_si128(_mm_or_si128(ausente, defensorVence),
+                                             _mm_cmpeq_epi8(zero, zero));
+    // Máscaras valem 0xFF (-1): subtrair soma 1
+    *perdasAtacante = _mm_sub_epi8(*perdasAtacante, atacantePerde);
+    *perdasDefensor = _mm_sub_epi8(*perdasDefensor, defensorPerde);
+}
+#endif
+
+/*
+ * Função: resolverRolagensLote
+ * 
+ * Rola e compara os dados de muitos ataques independentes de uma vez,
+ * na regra clássica. Os dados são gerados em blocos (seis planos de
+ * bytes, um por posição de dado), os que não foram rolados são zerados e
+ * cada lado é ordenado por uma rede de 3 comparações; com SSE2, cada
+ * passo trata 16 ataques por instrução. Só as perdas são calculadas: o
+ * chamador decide a conquista (defensor sem tropas) e a ocupação.
+ * 
+ * Parâmetros:
+ *   rng - gerador usado para rolar os dados
+ *   numDadosAtacante - dados de cada ataque do lado atacante (1 a 3)
+ *   numDadosDefensor - dados de cada ataque do lado defensor (0 a 3)
+ *   quantidade - número de ataques
+ *   perdasAtacante - recebe as tropas perdidas pelo atacante em cada ataque
+ *   perdasDefensor - recebe as tropas perdidas pelo defensor em cada ataque
+ */
+void resolverRolagensLote(Aleatorio* rng, const uint8_t* numDadosAtacante,
+                          const uint8_t* numDadosDefensor, int quantidade,
+                          uint8_t* perdasAtacante, uint8_t* perdasDefensor) {
+    uint8_t planos[2 * MAX_DADOS][ATAQUES_POR_BLOCO];
+
+    for (int base = 0; base < quantidade; base += ATAQUES_POR_BLOCO) {
+        int bloco = (quantidade - base < ATAQUES_POR_BLOCO) ? quantidade - base : ATAQUES_POR_BLOCO;
+        for (int k = 0; k < 2 * MAX_DADOS; k++) {
+            aleatorioPreencherDados(rng, planos[k], (size_t) bloco);
+        }
+        const uint8_t* na = numDadosAtacante + base;
+        const uint8_t* nd = numDadosDefensor + base;
+        uint8_t* pa = perdasAtacante + base;
+        uint8_t* pd = perdasDefensor + base;
+        int i = 0;
+
+#if defined(__SSE2__)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i um = _mm_set1_epi8(1), dois = _mm_set1_epi8(2);
+        for (; i + 16 <= bloco; i += 16) {
+            __m128i nA = _mm_loadu_si128((const __m128i*) (na + i));
+            __m128i nD = _mm_loadu_si128((const __m128i*) (nd + i));
+            // Zera os dados não rolados (só o defensor pode não rolar nenhum)
+            __m128i a0 = _mm_loadu_si128((const __m128i*) (planos[0] + i));
+            __m128i a1 = _mm_and_si128(_mm_loadu_si128((const __m128i*) (planos[1] + i)),
+                                       _mm_cmpgt_epi8(nA, um));
+            __m128i a2 = _mm_and_si128(_mm_loadu_si128((const __m128i*) (planos[2] + i)),
+                                       _mm_cmpgt_epi8(nA, dois));
+            __m128i d0 = _mm_and_si128(_mm_loadu_si128((const __m128i*) (planos[3] + i)),
+                                       _mm_cmpgt_epi8(nD, zero));
+            __m128i d1 = _mm_and_si128(_mm_loadu_si128((const __m128i*) (planos[4] + i)),
+                                       _mm_cmpgt_epi8(nD, um));
+            __m128i d2 = _mm_and_si128(_mm_loadu_si128((const __m128i*) (planos[5] + i)),
+                                       _mm_cmpgt_epi8(nD, dois));
+            ordenar3Vetores(&a0, &a1, &a2);
+            ordenar3Vetores(&d0, &d1, &d2);
+
+            __m128i perdasA = _mm_setzero_si128(), perdasD = _mm_setzero_si128();
+            compararParVetor(a0, d0, &perdasA, &perdasD);
+            compararParVetor(a1, d1, &perdasA, &perdasD);
+            compararParVetor(a2, d2, &perdasA, &perdasD);
+            _mm_storeu_si128((__m128i*) (pa + i), perdasA);
+            _mm_storeu_si128((__m128i*) (pd + i), perdasD);
+        }
+#endif
+        // Restante do bloco (ou tudo, sem SSE2)
+        for (; i < bloco; i++) {
+            compararPares(planos[0][i], na[i] > 1 ? planos[1][i] : 0, na[i] > 2 ? planos[2][i] : 0,
+                          nd[i] > 0 ? planos[3][i] : 0, nd[i] > 1 ? planos[4][i] : 0,
+                          nd[i] > 2 ? planos[5][i] : 0,
+                          &pa[i], &pd[i]);
+        }
+    }
+}
+
+/*
+ * Struct Ocupados
+ * 
+ * Territórios já usados pelas ordens do bloco atual de
+ * executarLoteClassico: endereçamento aberto com marca de geração, para
+ * esvaziar a tabela a cada bloco sem apagá-la. Cada bloco marca no
+ * máximo 2 * ATAQUES_POR_BLOCO territórios, metade dos slots.
+ */
+typedef struct {
+    int32_t territorio[SLOTS_OCUPADOS];
+    uint32_t geracao[SLOTS_OCUPADOS];
+    uint32_t atual;
+} Ocupados;
+
+// Marca o território como usado no bloco; retorna 0 se já estava marcado
+static int ocupar(Ocupados* ocupados, int32_t territorio) {
+    uint32_t slot = ((uint32_t) territorio * 2654435761u) & (SLOTS_OCUPADOS - 1);
+    while (ocupados->geracao[slot] == ocupados->atual) {
+        if (ocupados->territorio[slot] == territorio) {
+            return 0;
+        }
+        slot = (slot + 1) & (SLOTS_OCUPADOS - 1);
+    }
+    ocupados->geracao[slot] = ocupados->atual;
+    ocupados->territorio[slot] = territorio;
+    return 1;
+}
+
+// Como ocupar, sem marcar
+static int ocupado(const Ocupados* ocupados, int32_t territorio) {
+    uint32_t slot = ((uint32_t) territorio * 2654435761u) & (SLOTS_OCUPADOS - 1);
+    while (ocupados->geracao[slot] == ocupados->atual) {
+        if (ocupados->territorio[slot] == territorio) {
+            return 1;
+        }
+        slot = (slot + 1) & (SLOTS_OCUPADOS - 1);
+    }
+    return 0;
+}
+
+/*
+ * Função: executarLoteClassico
+ * 
+ * Caminho de executarLote para a regra clássica sem saída. As ordens são
+ * juntadas em blocos de até ATAQUES_POR_BLOCO com territórios distintos
+ * (uma ordem que repete um território do bloco fecha o bloco), então
+ * validar e contar os dados de cada uma antes das rolagens dá o mesmo
+ * que fazê-lo em sequência; as rolagens do bloco saem de uma chamada a
+ * resolverRolagensLote e as perdas são aplicadas na ordem original.
+ */
+static void executarLoteClassico(Mapa* mapa, const OrdemAtaque* ordens, int numOrdens,
+                                 Aleatorio* rng, ResumoLote* resumo) {
+    long long resolvidos = 0, conquistas = 0, invalidos = 0;
+    Ocupados ocupados;
+    memset(ocupados.geracao, 0, sizeof(ocupados.geracao));
+    ocupados.atual = 0;
+    uint8_t numDadosAtacante[ATAQUES_POR_BLOCO], numDadosDefensor[ATAQUES_POR_BLOCO];
+    uint8_t perdasAtacante[ATAQUES_POR_BLOCO], perdasDefensor[ATAQUES_POR_BLOCO];
+    int pendentes[ATAQUES_POR_BLOCO];
+    ResultadoAtaque resultado;
+    memset(&resultado, 0, sizeof(resultado));
+
+    int i = 0;
+    while (i < numOrdens) {
+        // Nova geração: a tabela fica vazia (há menos blocos que gerações)
+        ocupados.atual++;
+        int n = 0;
+        for (; i < numOrdens && n < ATAQUES_POR_BLOCO; i++) {
+            int a = ordens[i].atacante;
+            int d = ordens[i].defensor;
+            int noMapa = a >= 0 && a < mapa->quantidade && d >= 0 && d < mapa->quantidade;
+            if (noMapa && (ocupado(&ocupados, a) || ocupado(&ocupados, d))) {
+                break;
+            }
+            if (validarAtaque(mapa, a, d) != ATAQUE_OK) {
+                invalidos++;
+                continue;
+            }
+            ocupar(&ocupados, a);
+            ocupar(&ocupados, d);
+            numDadosAtacante[n] = (uint8_t) dadosDoAtacante(REGRA_CLASSICA, mapa->tropas[a]);
+            numDadosDefensor[n] = (uint8_t) dadosDoDefensor(REGRA_CLASSICA, mapa->tropas[d]);
+            pendentes[n++] = i;
+        }
+
+        resolverRolagensLote(rng, numDadosAtacante, numDadosDefensor, n,
+                             perdasAtacante, perdasDefensor);
+        for (int k = 0; k < n; k++) {
+            int a = ordens[pendentes[k]].atacante;
+            int d = ordens[pendentes[k]].defensor;
+            resultado.numDadosAtacante = numDadosAtacante[k];
+            resultado.numDadosDefensor = numDadosDefensor[k];
+            aplicarPerdasClassica(mapa->tropas[a], mapa->tropas[d], numDadosAtacante[k],
+                                  perdasAtacante[k], perdasDefensor[k], &resultado);
+            registrarResultado(mapa, a, d, &resultado);
+            conquistas += resultado.conquista;
+        }
+        resolvidos += n;
+    }
+
+    if (resumo != NULL) {
+        resumo->ordens += numOrdens;
+        resumo->resolvidos += resolvidos;
+        resumo->conquistas += conquistas;
+        resumo->invalidos += invalidos;
+    }
+}
+
+/*
+ * Função: executarLote
+ * 
+ * Resolve uma lista de ataques em sequência sobre o mesmo mapa, sem
+ * interação com o usuário. A saída é opcional: com saida == NULL nada
+ * é impresso, o que permite milhões de ataques por segundo; na regra
+ * clássica, sem saída, as rolagens são feitas em SIMD por
+ * resolverRolagensLote (ver executarLoteClassico).
+ * 
+ * Parâmetros:
+ *   mapa - mapa de territórios
+ *   regra - regra de batalha
+ *   ordens - vetor com os ataques a executar
+ *   numOrdens - quantidade de ordens
+ *   rng - gerador usado para rolar os dados
+ *   resumo - totais acumulados (somados ao valor atual; pode ser NULL)
+ *   saida - arquivo para o relatório de cada ataque (pode ser NULL)
+ */
+void executarLote(Mapa* mapa, RegraBatalha regra, const OrdemAtaque* ordens, int numOrdens,
+                  Aleatorio* rng, ResumoLote* resumo, FILE* saida) {
+    if (regra == REGRA_CLASSICA && saida == NULL) {
+        executarLoteClassico(mapa, ordens, numOrdens, rng, resumo);
+        return;
+    }
+
+    long long resolvidos = 0, conquistas = 0, invalidos = 0;
+    ResultadoAtaque resultado;
+    memset(&resultado, 0, sizeof(resultado));
+    uint8_t dados[DADOS_POR_RECARGA];
+    int proximoDado = DADOS_POR_RECARGA;
+
+    for (int i = 0; i < numOrdens; i++) {
+        int a = ordens[i].atacante;
+        int d = ordens[i].defensor;
+
+        CodigoAtaque codigo = validarAtaque(mapa, a, d);
+        if (codigo != ATAQUE_OK) {
+            invalidos++;
+            if (saida != NULL) {
+                fprintf(saida, "%d: %d -> %d invalido (codigo %d)\n", i, a + 1, d + 1, codigo);
+            }
+            continue;
+        }
+
+        // Os dados são rolados em blocos para amortizar o custo do gerador
+        if (proximoDado + 2 * MAX_DADOS > DADOS_POR_RECARGA) {
+            aleatorioPreencherDados(rng, dados, DADOS_POR_RECARGA);
+            proximoDado = 0;
+        }
+        int numAtacante = dadosDoAtacante(regra, mapa->tropas[a]);
+        resolverAtaqueComDados(mapa, regra, a, d, &dados[proximoDado],
+                               &dados[proximoDado + numAtacante], &resultado);
+        proximoDado += numAtacante + resultado.numDadosDefensor;
+        resolvidos++;
+        conquistas += resultado.conquista;
+
+        if (saida != NULL) {
+            fprintf(saida, "%d: %d -> %d dados ", i, a + 1, d + 1);
+            for (int k = 0; k < resultado.numDadosAtacante; k++) {
+                fprintf(saida, "%s%d", k ? "-" : "", resultado.dadosAtacante[k]);
+            }
+            fprintf(saida, " x ");
+            for (int k = 0; k < resultado.numDadosDefensor; k++) {
+                fprintf(saida, "%s%d", k ? "-" : "", resultado.dadosDefensor[k]);
+            }
+            fprintf(saida, " %s\n", resultado.conquista ? "conquista" : "repelido");
+        }
+    }
+
+    if (resumo != NULL) {
+        resumo->ordens += numOrdens;
+        resumo->resolvidos += resolvidos;
+        resumo->conquistas += conquistas;
+        resumo->invalidos += invalidos;
+    }
+}
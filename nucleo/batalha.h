@@ -0,0 +1,125 @@
+/*
+ * Motor de batalha do Jogo War
+ * 
+ * Concentra as regras de ataque sem nenhuma entrada/saída obrigatória,
+ * para que o jogo interativo e as simulações em lote usem exatamente
+ * a mesma lógica.
+ * 
+ * Há duas regras (RegraBatalha): a simplificada, com um dado por lado,
+ * e a clássica do War, com até três dados por lado comparados aos pares.
+ * Para simulações grandes na regra clássica, resolverRolagensLote rola
+ * e ordena os dados de milhares de ataques de uma vez, em SIMD; é o que
+ * executarLote usa nessa regra quando não há saída.
+ */
+
+#ifndef WAR_BATALHA_H
+#define WAR_BATALHA_H
+
+#include <stdio.h>
+#include "aleatorio.h"
+#include "mapa.h"
+
+// Dados por lado na regra clássica
+#define MAX_DADOS 3
+
+/*
+ * Enum RegraBatalha
+ * 
+ * Regra usada para resolver cada ataque.
+ */
+typedef enum {
+    REGRA_SIMPLES = 0,   // Um dado por lado; vitória do atacante conquista com metade das tropas
+    REGRA_CLASSICA,      // Até 3 dados por lado, comparados aos pares; cada par perdido custa 1 tropa
+    NUM_REGRAS
+} RegraBatalha;
+
+/*
+ * Enum CodigoAtaque
+ * 
+ * Resultado da validação de um par atacante/defensor.
+ */
+typedef enum {
+    ATAQUE_OK = 0,
+    ATAQUE_INDICE_INVALIDO,      // Índice fora do mapa
+    ATAQUE_MESMO_TERRITORIO,     // Atacante e defensor são o mesmo território
+    ATAQUE_MESMA_COR,            // Os dois territórios pertencem à mesma cor
+    ATAQUE_TROPAS_INSUFICIENTES, // Atacante com menos de 2 tropas
+    ATAQUE_NAO_ADJACENTE         // Os territórios não fazem fronteira
+} CodigoAtaque;
+
+/*
+ * Struct ResultadoAtaque
+ * 
+ * Descreve o que aconteceu em um ataque já resolvido.
+ */
+typedef struct {
+    int dadoAtacante;        // Maior dado do atacante (o único, na regra simples)
+    int dadoDefensor;        // Maior dado do defensor
+    int numDadosAtacante;    // Dados rolados por lado (1 na regra simples)
+    int numDadosDefensor;
+    uint8_t dadosAtacante[MAX_DADOS]; // Dados rolados, em ordem decrescente
+    uint8_t dadosDefensor[MAX_DADOS];
+    int perdasAtacante;      // Tropas perdidas pelo atacante na rolagem
+    int perdasDefensor;      // Tropas perdidas pelo defensor (todas, se conquistado)
+    int conquista;           // 1 se o defensor foi conquistado
+    int tropasTransferidas;  // Tropas movidas para o território conquistado
+    int tropasAtacante;      // Tropas do atacante depois do ataque
+    int tropasDefensor;      // Tropas no território defensor depois do ataque
+} ResultadoAtaque;
+
+/*
+ * Struct OrdemAtaque
+ * 
+ * Um ataque a ser executado em lote (índices começando em 0).
+ */
+typedef struct {
+    int atacante;
+    int defensor;
+} OrdemAtaque;
+
+/*
+ * Struct ResumoLote
+ * 
+ * Totais acumulados por executarLote.
+ */
+typedef struct {
+    long long ordens;      // Ordens processadas
+    long long resolvidos;  // Ataques válidos efetivamente resolvidos
+    long long conquistas;  // Ataques que terminaram em conquista
+    long long invalidos;   // Ordens rejeitadas pela validação
+} ResumoLote;
+
+const char* nomeRegra(RegraBatalha regra);
+int regraPorNome(const char* nome, RegraBatalha* regra);
+int dadosDoAtacante(RegraBatalha regra, int tropas);
+int dadosDoDefensor(RegraBatalha regra, int tropas);
+uint8_t codificarDados(const uint8_t* dados, int quantidade);
+int decodificarDados(uint8_t codigo, uint8_t* dados);
+
+int rolarDado(Aleatorio* rng);
+void aplicarRegraAtaque(int tropasAtacante, int tropasDefensor,
+                        int dadoAtacante, int dadoDefensor,
+                        ResultadoAtaque* resultado);
+void aplicarRegraClassica(int tropasAtacante, int tropasDefensor,
+                          const uint8_t* dadosAtacante, int numDadosAtacante,
+                          const uint8_t* dadosDefensor, int numDadosDefensor,
+                          ResultadoAtaque* resultado);
+void aplicarRegra(RegraBatalha regra, int tropasAtacante, int tropasDefensor,
+                  const uint8_t* dadosAtacante, const uint8_t* dadosDefensor,
+                  ResultadoAtaque* resultado);
+CodigoAtaque validarAtaque(const Mapa* mapa, int atacante, int defensor);
+CodigoAtaque resolverAtaque(Mapa* mapa, int atacante, int defensor,
+                            int dadoAtacante, int dadoDefensor,
+                            ResultadoAtaque* resultado);
+CodigoAtaque resolverAtaqueComDados(Mapa* mapa, RegraBatalha regra, int atacante, int defensor,
+                                    const uint8_t* dadosAtacante, const uint8_t* dadosDefensor,
+                                    ResultadoAtaque* resultado);
+CodigoAtaque rolarAtaque(Mapa* mapa, RegraBatalha regra, int atacante, int defensor,
+                         Aleatorio* rng, ResultadoAtaque* resultado);
+void resolverRolagensLote(Aleatorio* rng, const uint8_t* numDadosAtacante,
+                          const uint8_t* numDadosDefensor, int quantidade,
+                          uint8_t* perdasAtacante, uint8_t* perdasDefensor);
+void executarLote(Mapa* mapa, RegraBatalha regra, const OrdemAtaque* ordens, int numOrdens,
+                  Aleatorio* rng, ResumoLote* resumo, FILE* saida);
+
+#endif
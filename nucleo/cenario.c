@@ -0,0 +1,553 @@
+/*
+ * Carga de cenários sem interação
+ * 
+ * Analisador por linhas do formato descrito em cenario.h. A mesma função
+ * trata cada linha, venha ela do arquivo mapeado ou de fgets na entrada
+ * padrão.
+ */
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "cenario.h"
+#include "continente.h"
+#include "grafo.h"
+#include "missao.h"
+
+/*
+ * Struct Carga
+ * 
+ * Estado de uma carga em andamento.
+ */
+typedef struct {
+    Mapa* mapa;
+    Arena* arena;                // Destino dos jogadores e das missões
+    const char* nomeEntrada;
+    FILE* erros;
+    int numErros;
+    int numeroLinha;
+    Jogador* jogadores;
+    int numJogadores, capacidadeJogadores;
+    int32_t (*arestas)[2];
+    long numArestas, capacidadeArestas;
+    Continente* continentes;
+    int numContinentes, capacidadeContinentes;
+    int32_t* continenteDe;       // Continente de cada território já citado em uma linha C
+    int tamanhoContinenteDe;
+    // Última cor internada: territórios vizinhos costumam repetir a cor
+    char ultimaCor[TAM_COR];
+    size_t tamanhoUltimaCor;
+    IdCor idUltimaCor;
+} Carga;
+
+/*
+ * Struct Fatia
+ * 
+ * Trecho de uma linha, sem terminador.
+ */
+typedef struct {
+    const char* inicio;
+    size_t tamanho;
+} Fatia;
+
+static int ehSeparador(char c) {
+    return c == ' ' || c == '\t' || c == ',' || c == ';';
+}
+
+// Extrai o próximo campo de [*cursor, fim) e avança o cursor
+static Fatia proximoCampo(const char** cursor, const char* fim) {
+    const char* p = *cursor;
+    while (p < fim && ehSeparador(*p)) {
+        p++;
+    }
+    const char* inicio = p;
+    while (p < fim && !ehSeparador(*p)) {
+        p++;
+    }
+    *cursor = p;
+    Fatia campo = {inicio, (size_t) (p - inicio)};
+    return campo;
+}
+
+// Converte um campo só de dígitos em um inteiro entre 0 e 1000000000
+static int campoInteiro(Fatia campo, int* valor) {
+    if (campo.tamanho == 0 || campo.tamanho > 10) {
+        return 0;
+    }
+    long long v = 0;
+    for (size_t i = 0; i < campo.tamanho; i++) {
+        unsigned digito = (unsigned char) campo.inicio[i] - '0';
+        if (digito > 9) {
+            return 0;
+        }
+        v = v * 10 + digito;
+    }
+    if (v > 1000000000LL) {
+        return 0;
+    }
+    *valor = (int) v;
+    return 1;
+}
+
+// Copia o campo para `destino` (com terminador) se couber em `capacidade`
+static int copiarCampo(Fatia campo, char* destino, size_t capacidade) {
+    if (campo.tamanho == 0 || campo.tamanho >= capacidade) {
+        return 0;
+    }
+    memcpy(destino, campo.inicio, campo.tamanho);
+    destino[campo.tamanho] = '\0';
+    return 1;
+}
+
+static void relatar(Carga* carga, const char* motivo) {
+    carga->numErros++;
+    if (carga->erros == NULL) {
+        return;
+    }
+    if (carga->numErros <= MAX_ERROS_CENARIO) {
+        fprintf(carga->erros, "%s:%d: %s\n", carga->nomeEntrada, carga->numeroLinha, motivo);
+    } else if (carga->numErros == MAX_ERROS_CENARIO + 1) {
+        // Só avisa quando há de fato um erro além do limite
+        fprintf(carga->erros, "%s: demais erros omitidos\n", carga->nomeEntrada);
+    }
+}
+
+// Interna a cor do campo, reaproveitando a última cor vista
+static IdCor internarCampoCor(Carga* carga, Fatia campo) {
+    if (campo.tamanho == carga->tamanhoUltimaCor &&
+        memcmp(campo.inicio, carga->ultimaCor, campo.tamanho) == 0) {
+        return carga->idUltimaCor;
+    }
+    char cor[TAM_COR];
+    if (!copiarCampo(campo, cor, TAM_COR)) {
+        relatar(carga, campo.tamanho == 0 ? "cor ausente" : "cor com mais de 9 caracteres");
+        return COR_INVALIDA;
+    }
+    IdCor id = mapaInternarCor(carga->mapa, cor);
+    if (id == COR_INVALIDA) {
+        relatar(carga, "limite de cores atingido");
+        return COR_INVALIDA;
+    }
+    memcpy(carga->ultimaCor, cor, campo.tamanho);
+    carga->tamanhoUltimaCor = campo.tamanho;
+    carga->idUltimaCor = id;
+    return id;
+}
+
+static void linhaJogador(Carga* carga, const char* cursor, const char* fim, int bot) {
+    Fatia nome = proximoCampo(&cursor, fim);
+    Fatia cor = proximoCampo(&cursor, fim);
+    Jogador jogador;
+    memset(&jogador, 0, sizeof(Jogador));
+    jogador.bot = bot;
+
+    if (!copiarCampo(nome, jogador.nome, TAM_NOME)) {
+        relatar(carga, nome.tamanho == 0 ? "nome do jogador ausente" : "nome com mais de 29 caracteres");
+        return;
+    }
+    jogador.idCor = internarCampoCor(carga, cor);
+    if (jogador.idCor == COR_INVALIDA) {
+        return;
+    }
+    memcpy(jogador.cor, mapaNomeCor(carga->mapa, jogador.idCor), TAM_COR);
+
+    // Missão opcional: o resto da linha no formato de missao.h
+    while (cursor < fim && ehSeparador(*cursor)) {
+        cursor++;
+    }
+    if (cursor < fim) {
+        char texto[TAM_MISSAO + 64];
+        size_t tamanho = (size_t) (fim - cursor);
+        Missao missao;
+        if (tamanho >= sizeof(texto)) {
+            relatar(carga, "missao longa demais");
+            return;
+        }
+        memcpy(texto, cursor, tamanho);
+        texto[tamanho] = '\0';
+        if (!compilarMissao(texto, &missao)) {
+            relatar(carga, "missao invalida");
+            return;
+        }
+        Missao* propria = (Missao*) arenaAlocar(carga->arena, sizeof(Missao));
+        if (propria == NULL) {
+            relatar(carga, "falha de alocacao de memoria");
+            return;
+        }
+        *propria = missao;
+        jogador.missao = propria;
+    }
+
+    if (carga->numJogadores == carga->capacidadeJogadores) {
+        int nova = carga->capacidadeJogadores ? carga->capacidadeJogadores * 2 : 4;
+        Jogador* jogadores = (Jogador*) realloc(carga->jogadores, nova * sizeof(Jogador));
+        if (jogadores == NULL) {
+            relatar(carga, "falha de alocacao de memoria");
+            return;
+        }
+        carga->jogadores = jogadores;
+        carga->capacidadeJogadores = nova;
+    }
+    carga->jogadores[carga->numJogadores++] = jogador;
+}
+
+static void linhaTerritorio(Carga* carga, const char* cursor, const char* fim) {
+    Fatia nome = proximoCampo(&cursor, fim);
+    Fatia cor = proximoCampo(&cursor, fim);
+    Fatia tropas = proximoCampo(&cursor, fim);
+    Fatia sobra = proximoCampo(&cursor, fim);
+    char texto[TAM_NOME];
+    int valor;
+
+    if (!copiarCampo(nome, texto, TAM_NOME)) {
+        relatar(carga, nome.tamanho == 0 ? "nome do territorio ausente" : "nome com mais de 29 caracteres");
+        return;
+    }
+    if (!campoInteiro(tropas, &valor) || valor < 1) {
+        relatar(carga, "tropas devem ser um numero inteiro positivo");
+        return;
+    }
+    if (sobra.tamanho != 0) {
+        relatar(carga, "campos demais no territorio");
+        return;
+    }
+    IdCor dono = internarCampoCor(carga, cor);
+    if (dono == COR_INVALIDA) {
+        return;
+    }
+    if (mapaAdicionar(carga->mapa, texto, dono, valor) < 0) {
+        relatar(carga, "falha de alocacao de memoria");
+    }
+}
+
+static void linhaFronteira(Carga* carga, const char* cursor, const char* fim) {
+    Fatia campoA = proximoCampo(&cursor, fim);
+    Fatia campoB = proximoCampo(&cursor, fim);
+    int a, b;
+
+    if (!campoInteiro(campoA, &a) || !campoInteiro(campoB, &b) || a < 1 || b < 1) {
+        relatar(carga, "fronteira invalida");
+        return;
+    }
+    if (a > carga->mapa->quantidade || b > carga->mapa->quantidade) {
+        relatar(carga, "fronteira com territorio ainda nao declarado");
+        return;
+    }
+    if (carga->numArestas == carga->capacidadeArestas) {
+        long nova = carga->capacidadeArestas ? carga->capacidadeArestas * 2 : 1024;
+        int32_t (*arestas)[2] = realloc(carga->arestas, nova * sizeof(*arestas));
+        if (arestas == NULL) {
+            relatar(carga, "falha de alocacao de memoria");
+            return;
+        }
+        carga->arestas = arestas;
+        carga->capacidadeArestas = nova;
+    }
+    carga->arestas[carga->numArestas][0] = a - 1;
+    carga->arestas[carga->numArestas][1] = b - 1;
+    carga->numArestas++;
+}
+
+static void linhaContinente(Carga* carga, const char* cursor, const char* fim) {
+    Fatia nome = proximoCampo(&cursor, fim);
+    Fatia bonus = proximoCampo(&cursor, fim);
+    Continente continente;
+    int valor;
+
+    if (!copiarCampo(nome, continente.nome, TAM_NOME)) {
+        relatar(carga, nome.tamanho == 0 ? "nome do continente ausente" : "nome com mais de 29 caracteres");
+        return;
+    }
+    if (!campoInteiro(bonus, &valor)) {
+        relatar(carga, "bonus do continente deve ser um numero inteiro");
+        return;
+    }
+    continente.bonus = valor;
+    continente.tamanho = 0;
+
+    // Os territórios citados já existem, então cabem na quantidade atual do mapa
+    int quantidade = carga->mapa->quantidade;
+    if (carga->tamanhoContinenteDe < quantidade) {
+        int32_t* continenteDe = (int32_t*) realloc(carga->continenteDe, quantidade * sizeof(int32_t));
+        if (continenteDe == NULL) {
+            relatar(carga, "falha de alocacao de memoria");
+            return;
+        }
+        for (int i = carga->tamanhoContinenteDe; i < quantidade; i++) {
+            continenteDe[i] = SEM_CONTINENTE;
+        }
+        carga->continenteDe = continenteDe;
+        carga->tamanhoContinenteDe = quantidade;
+    }
+    if (carga->numContinentes == carga->capacidadeContinentes) {
+        int nova = carga->capacidadeContinentes ? carga->capacidadeContinentes * 2 : 8;
+        Continente* continentes = (Continente*) realloc(carga->continentes, nova * sizeof(Continente));
+        if (continentes == NULL) {
+            relatar(carga, "falha de alocacao de memoria");
+            return;
+        }
+        carga->continentes = continentes;
+        carga->capacidadeContinentes = nova;
+    }
+
+    int indice = carga->numContinentes;
+    for (Fatia campo = proximoCampo(&cursor, fim); campo.tamanho != 0;
+         campo = proximoCampo(&cursor, fim)) {
+        int t;
+        if (!campoInteiro(campo, &t) || t < 1) {
+            relatar(carga, "territorio do continente invalido");
+        } else if (t > quantidade) {
+            relatar(carga, "continente com territorio ainda nao declarado");
+        } else if (carga->continenteDe[t - 1] != SEM_CONTINENTE) {
+            relatar(carga, "territorio ja pertence a outro continente");
+        } else {
+            carga->continenteDe[t - 1] = indice;
+            continente.tamanho++;
+            continue;
+        }
+        return;
+    }
+    if (continente.tamanho == 0) {
+        relatar(carga, "continente sem territorios");
+        return;
+    }
+    carga->continentes[carga->numContinentes++] = continente;
+}
+
+/*
+ * Função: processarLinha
+ * 
+ * Trata uma linha [inicio, fim) sem o '\n'.
+ * 
+ * Retorno: 0 se a linha for FIM, 1 caso contrário
+ */
+static int processarLinha(Carga* carga, const char* inicio, const char* fim) {
+    carga->numeroLinha++;
+    if (fim > inicio && fim[-1] == '\r') {
+        fim--;
+    }
+    const char* cursor = inicio;
+    Fatia tipo = proximoCampo(&cursor, fim);
+    if (tipo.tamanho == 0 || tipo.inicio[0] == '#') {
+        return 1;
+    }
+    if (tipo.tamanho == 1) {
+        switch (tipo.inicio[0]) {
+            case 'T':
+                linhaTerritorio(carga, cursor, fim);
+                return 1;
+            case 'J':
+            case 'B':
+                linhaJogador(carga, cursor, fim, tipo.inicio[0] == 'B');
+                return 1;
+            case 'A':
+                linhaFronteira(carga, cursor, fim);
+                return 1;
+            case 'C':
+                linhaContinente(carga, cursor, fim);
+                return 1;
+        }
+    } else if (tipo.tamanho == 3 && memcmp(tipo.inicio, "FIM", 3) == 0) {
+        return 0;
+    }
+    relatar(carga, "tipo de linha desconhecido (use J, B, T, A, C ou FIM)");
+    return 1;
+}
+
+// Falha de alocação no fim da carga (não pertence a nenhuma linha)
+static void relatarFalhaMemoria(Carga* carga) {
+    carga->numErros++;
+    if (carga->erros != NULL) {
+        fprintf(carga->erros, "%s: falha de alocacao de memoria\n", carga->nomeEntrada);
+    }
+}
+
+/*
+ * Função: concluirCarga
+ * 
+ * Monta o grafo com as fronteiras lidas e os continentes e copia os
+ * jogadores para a arena, ou descarta tudo se houve algum erro (as
+ * missões já copiadas para a arena só voltam com arenaZerar ou
+ * arenaLiberar).
+ * 
+ * Retorno: 1 em caso de sucesso, 0 caso contrário
+ */
+static int concluirCarga(Carga* carga, Jogador** jogadores, int* numJogadores) {
+    if (carga->numErros == 0 && carga->numArestas > 0) {
+        Grafo* grafo = (Grafo*) malloc(sizeof(Grafo));
+        int ok = grafo != NULL &&
+                 grafoCriarDeArestas(grafo, carga->mapa->quantidade,
+                                     (const int32_t (*)[2]) carga->arestas, carga->numArestas);
+        if (!ok || !mapaDefinirGrafo(carga->mapa, grafo)) {
+            if (ok) {
+                grafoLiberar(grafo);
+            }
+            free(grafo);
+            relatarFalhaMemoria(carga);
+        }
+    }
+    free(carga->arestas);
+
+    if (carga->numErros == 0 && carga->numContinentes > 0) {
+        Continentes* continentes = (Continentes*) malloc(sizeof(Continentes));
+        int ok = continentes != NULL && continentesIniciar(continentes, carga->mapa->quantidade);
+        for (int c = 0; ok && c < carga->numContinentes; c++) {
+            ok = continentesAdicionar(continentes, carga->continentes[c].nome,
+                                      carga->continentes[c].bonus) == c;
+        }
+        for (int i = 0; ok && i < carga->tamanhoContinenteDe; i++) {
+            if (carga->continenteDe[i] != SEM_CONTINENTE) {
+                ok = continentesIncluir(continentes, carga->continenteDe[i], i);
+            }
+        }
+        if (!ok || !mapaDefinirContinentes(carga->mapa, continentes)) {
+            if (continentes != NULL) {
+                continentesLiberar(continentes);
+            }
+            free(continentes);
+            relatarFalhaMemoria(carga);
+        }
+    }
+    free(carga->continentes);
+    free(carga->continenteDe);
+
+    Jogador* lidos = NULL;
+    if (carga->numErros == 0 && carga->numJogadores > 0) {
+        lidos = (Jogador*) arenaAlocar(carga->arena, carga->numJogadores * sizeof(Jogador));
+        if (lidos == NULL) {
+            relatarFalhaMemoria(carga);
+        } else {
+            memcpy(lidos, carga->jogadores, carga->numJogadores * sizeof(Jogador));
+        }
+    }
+    free(carga->jogadores);
+    if (carga->numErros > 0) {
+        return 0;
+    }
+    *jogadores = lidos;
+    *numJogadores = carga->numJogadores;
+    return 1;
+}
+
+static void iniciarCarga(Carga* carga, Mapa* mapa, Arena* arena, const char* nomeEntrada,
+                         FILE* erros) {
+    memset(carga, 0, sizeof(Carga));
+    carga->mapa = mapa;
+    carga->arena = arena;
+    carga->nomeEntrada = nomeEntrada;
+    carga->erros = erros;
+    carga->tamanhoUltimaCor = (size_t) -1;
+}
+
+/*
+ * Função: cenarioLer
+ * 
+ * Lê um cenário de um arquivo já aberto, linha a linha, até o fim do
+ * arquivo ou até a linha FIM. O que vier depois de FIM continua
+ * disponível em `entrada` (útil na entrada padrão, que segue para o menu).
+ * 
+ * Parâmetros:
+ *   entrada - arquivo aberto para leitura
+ *   nomeEntrada - nome usado nas mensagens de erro
+ *   mapa - mapa iniciado que recebe territórios, cores e fronteiras
+ *   arena - arena da partida, de onde saem os jogadores e as missões
+ *   jogadores - recebe o vetor de jogadores (na arena)
+ *   numJogadores - recebe a quantidade de jogadores
+ *   erros - destino das mensagens "<entrada>:<linha>: <motivo>" (pode ser NULL)
+ * 
+ * Retorno: 1 em caso de sucesso, 0 se houve algum erro
+ */
+int cenarioLer(FILE* entrada, const char* nomeEntrada, Mapa* mapa, Arena* arena,
+               Jogador** jogadores, int* numJogadores, FILE* erros) {
+    Carga carga;
+    iniciarCarga(&carga, mapa, arena, nomeEntrada, erros);
+
+    char linha[TAM_MISSAO + 128];
+    while (fgets(linha, sizeof(linha), entrada) != NULL) {
+        size_t tamanho = strlen(linha);
+        if (tamanho > 0 && linha[tamanho - 1] == '\n') {
+            tamanho--;
+        } else if (!feof(entrada)) {
+            // Linha maior que o buffer: descarta o resto e relata
+            int c;
+            while ((c = fgetc(entrada)) != '\n' && c != EOF);
+            carga.numeroLinha++;
+            relatar(&carga, "linha longa demais");
+            continue;
+        }
+        if (!processarLinha(&carga, linha, linha + tamanho)) {
+            break;
+        }
+    }
+    return concluirCarga(&carga, jogadores, numJogadores);
+}
+
+/*
+ * Função: cenarioCarregar
+ * 
+ * Carrega um cenário de um arquivo, percorrendo-o direto no mapeamento
+ * em memória, ou da entrada padrão se o caminho for "-".
+ * 
+ * Parâmetros:
+ *   caminho - arquivo do cenário, ou "-" para a entrada padrão
+ *   mapa, arena, jogadores, numJogadores, erros - como em cenarioLer
+ * 
+ * Retorno: 1 em caso de sucesso, 0 se houve algum erro
+ */
+int cenarioCarregar(const char* caminho, Mapa* mapa, Arena* arena, Jogador** jogadores,
+                    int* numJogadores, FILE* erros) {
+    if (strcmp(caminho, "-") == 0) {
+        return cenarioLer(stdin, "stdin", mapa, arena, jogadores, numJogadores, erros);
+    }
+
+    int fd = open(caminho, O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        if (erros != NULL) {
+            fprintf(erros, "%s: nao foi possivel abrir o arquivo\n", caminho);
+        }
+        return 0;
+    }
+
+    size_t tamanho = (size_t) info.st_size;
+    const char* dados = NULL;
+    if (tamanho > 0) {
+        dados = mmap(NULL, tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (dados == MAP_FAILED) {
+            // Não mapeável (pipe, dispositivo): lê como fluxo
+            FILE* arquivo = fdopen(fd, "r");
+            if (arquivo == NULL) {
+                close(fd);
+                return 0;
+            }
+            int ok = cenarioLer(arquivo, caminho, mapa, arena, jogadores, numJogadores, erros);
+            fclose(arquivo);
+            return ok;
+        }
+        madvise((void*) dados, tamanho, MADV_SEQUENTIAL);
+    }
+    close(fd);
+
+    Carga carga;
+    iniciarCarga(&carga, mapa, arena, caminho, erros);
+    const char* cursor = dados;
+    const char* fim = dados + tamanho;
+    while (cursor < fim) {
+        const char* quebra = memchr(cursor, '\n', (size_t) (fim - cursor));
+        const char* fimLinha = (quebra != NULL) ? quebra : fim;
+        if (!processarLinha(&carga, cursor, fimLinha)) {
+            break;
+        }
+        cursor = fimLinha + 1;
+    }
+    if (dados != NULL) {
+        munmap((void*) dados, tamanho);
+    }
+    return concluirCarga(&carga, jogadores, numJogadores);
+}
@@ -0,0 +1,40 @@
+/*
+ * Carga de cenários sem interação
+ * 
+ * Lê jogadores, territórios e fronteiras de um arquivo de texto (ou da
+ * entrada padrão) direto para o Mapa, sem scanf. Arquivos são mapeados
+ * em memória e percorridos linha a linha no próprio mapeamento; os
+ * campos são fatias da linha, copiadas uma única vez para o destino.
+ * 
+ * Formato (uma entrada por linha, '#' inicia comentário; os campos são
+ * separados por espaços, tabulações, vírgulas ou ponto e vírgula):
+ *   J <nome> <cor> [<tipo> <parametro> <texto da missao>]
+ *   B <nome> <cor> [<tipo> <parametro> <texto da missao>]   (jogador do computador)
+ *   T <nome> <cor> <tropas>
+ *   A <territorio> <territorio>     (fronteira, índices a partir de 1)
+ *   C <nome> <bonus> <territorio> [<territorio> ...]   (continente)
+ *   FIM                             (opcional: encerra o cenário)
+ * Nomes têm até TAM_NOME - 1 caracteres e cores até TAM_COR - 1. Um
+ * jogador sem missão fica com missao == NULL; os jogadores e as missões
+ * lidas ficam na arena passada pelo chamador. Sem linhas A, o mapa não
+ * recebe grafo (no jogo, todos os territórios fazem fronteira). Cada território
+ * pertence a no máximo um continente; quem ocupa todos os territórios de
+ * um continente recebe o bônus no reforço (continente.h). Sem linhas C,
+ * o mapa não recebe continentes.
+ */
+
+#ifndef WAR_CENARIO_H
+#define WAR_CENARIO_H
+
+#include <stdio.h>
+#include "mapa.h"
+
+// Erros relatados antes de a carga desistir de listar os demais
+#define MAX_ERROS_CENARIO 20
+
+int cenarioCarregar(const char* caminho, Mapa* mapa, Arena* arena, Jogador** jogadores,
+                    int* numJogadores, FILE* erros);
+int cenarioLer(FILE* entrada, const char* nomeEntrada, Mapa* mapa, Arena* arena,
+               Jogador** jogadores, int* numJogadores, FILE* erros);
+
+#endif
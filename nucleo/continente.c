@@ -0,0 +1,260 @@
+/*
+ * Continentes e reforços
+ * 
+ * Cada troca de dono mexe em um único continente: a contagem da cor
+ * antiga desce, a da nova sobe, e a posse inteira só pode mudar quando
+ * uma das duas cruza o tamanho do continente.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "continente.h"
+#include "estatisticas.h"
+
+/*
+ * Função: continentesIniciar
+ * 
+ * Prepara um conjunto vazio de continentes para um mapa de
+ * `numTerritorios` territórios, todos fora de qualquer continente.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 em caso de falha de alocação
+ */
+int continentesIniciar(Continentes* cont, int numTerritorios) {
+    memset(cont, 0, sizeof(Continentes));
+    cont->continenteDe = (int32_t*) malloc((numTerritorios > 0 ? numTerritorios : 1) * sizeof(int32_t));
+    if (cont->continenteDe == NULL) {
+        return 0;
+    }
+    for (int i = 0; i < numTerritorios; i++) {
+        cont->continenteDe[i] = SEM_CONTINENTE;
+    }
+    cont->numTerritorios = numTerritorios;
+    return 1;
+}
+
+/*
+ * Função: continentesLiberar
+ * 
+ * Libera os vetores e deixa o conjunto vazio.
+ */
+void continentesLiberar(Continentes* cont) {
+    free(cont->lista);
+    free(cont->continenteDe);
+    free(cont->ocupados);
+    free(cont->dono);
+    memset(cont, 0, sizeof(Continentes));
+}
+
+// Garante espaço para mais um continente
+static int crescer(Continentes* cont) {
+    if (cont->numContinentes < cont->capacidade) {
+        return 1;
+    }
+    int nova = (cont->capacidade > 0) ? cont->capacidade * 2 : 8;
+    Continente* lista = (Continente*) realloc(cont->lista, nova * sizeof(Continente));
+    if (lista == NULL) {
+        return 0;
+    }
+    cont->lista = lista;
+    int32_t (*ocupados)[MAX_CORES] = realloc(cont->ocupados, nova * sizeof(*ocupados));
+    if (ocupados == NULL) {
+        return 0;
+    }
+    cont->ocupados = ocupados;
+    IdCor* dono = (IdCor*) realloc(cont->dono, nova * sizeof(IdCor));
+    if (dono == NULL) {
+        return 0;
+    }
+    cont->dono = dono;
+    cont->capacidade = nova;
+    return 1;
+}
+
+/*
+ * Função: continentesAdicionar
+ * 
+ * Cadastra um continente vazio. A posse só passa a valer depois de
+ * continentesRecalcular (ou de mapaDefinirContinentes).
+ * 
+ * Parâmetros:
+ *   cont - continentes do mapa
+ *   nome - nome do continente (truncado em TAM_NOME - 1 caracteres)
+ *   bonus - tropas extras por turno para quem ocupar o continente inteiro
+ * 
+ * Retorno: índice do novo continente, ou -1 em caso de falha
+ */
+int continentesAdicionar(Continentes* cont, const char* nome, int bonus) {
+    if (bonus < 0 || !crescer(cont)) {
+        return -1;
+    }
+    int c = cont->numContinentes++;
+    Continente* novo = &cont->lista[c];
+    strncpy(novo->nome, nome, TAM_NOME - 1);
+    novo->nome[TAM_NOME - 1] = '\0';
+    novo->bonus = bonus;
+    novo->tamanho = 0;
+    memset(cont->ocupados[c], 0, sizeof(cont->ocupados[c]));
+    cont->dono[c] = COR_INVALIDA;
+    return c;
+}
+
+/*
+ * Função: continentesIncluir
+ * 
+ * Coloca um território em um continente.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 se algum índice for inválido ou se o
+ *          território já pertencer a um continente
+ */
+int continentesIncluir(Continentes* cont, int continente, int territorio) {
+    if (continente < 0 || continente >= cont->numContinentes ||
+        territorio < 0 || territorio >= cont->numTerritorios ||
+        cont->continenteDe[territorio] != SEM_CONTINENTE) {
+        return 0;
+    }
+    cont->continenteDe[territorio] = continente;
+    cont->lista[continente].tamanho++;
+    return 1;
+}
+
+/*
+ * Função: continentesCopiar
+ * 
+ * Copia definições e posse de `origem` para `destino` (não iniciado ou
+ * já liberado), como na mesa de cada trabalhador do torneio.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 em caso de falha de alocação
+ */
+int continentesCopiar(Continentes* destino, const Continentes* origem) {
+    if (!continentesIniciar(destino, origem->numTerritorios)) {
+        return 0;
+    }
+    while (destino->capacidade < origem->numContinentes) {
+        if (!crescer(destino)) {
+            continentesLiberar(destino);
+            return 0;
+        }
+    }
+    int n = origem->numContinentes;
+    if (n > 0) {
+        memcpy(destino->lista, origem->lista, n * sizeof(Continente));
+        memcpy(destino->ocupados, origem->ocupados, n * sizeof(*origem->ocupados));
+        memcpy(destino->dono, origem->dono, n * sizeof(IdCor));
+    }
+    memcpy(destino->continenteDe, origem->continenteDe, origem->numTerritorios * sizeof(int32_t));
+    memcpy(destino->bonus, origem->bonus, sizeof(origem->bonus));
+    destino->numContinentes = n;
+    return 1;
+}
+
+/*
+ * Função: continentesRecalcular
+ * 
+ * Refaz a posse de todos os continentes a partir de uma varredura
+ * completa do mapa.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 se os continentes não cobrirem o mapa
+ */
+int continentesRecalcular(Continentes* cont, const Mapa* mapa) {
+    if (cont->numTerritorios != mapa->quantidade) {
+        return 0;
+    }
+    memset(cont->bonus, 0, sizeof(cont->bonus));
+    for (int c = 0; c < cont->numContinentes; c++) {
+        memset(cont->ocupados[c], 0, sizeof(cont->ocupados[c]));
+    }
+    for (int i = 0; i < mapa->quantidade; i++) {
+        int c = cont->continenteDe[i];
+        if (c != SEM_CONTINENTE) {
+            cont->ocupados[c][mapa->donos[i]]++;
+        }
+    }
+    for (int c = 0; c < cont->numContinentes; c++) {
+        const Continente* continente = &cont->lista[c];
+        cont->dono[c] = COR_INVALIDA;
+        if (continente->tamanho == 0) {
+            continue;
+        }
+        // Continente inteiro: a cor de qualquer território dele tem todos
+        for (int cor = 0; cor < mapa->numCores; cor++) {
+            if (cont->ocupados[c][cor] == continente->tamanho) {
+                cont->dono[c] = (IdCor) cor;
+                cont->bonus[cor] += continente->bonus;
+                break;
+            }
+        }
+    }
+    return 1;
+}
+
+/*
+ * Função: continentesTrocarDono
+ * 
+ * Gancho de mapaDefinirDono: o território `indice` passou da cor
+ * `antigo` para `novo`. O(1).
+ */
+void continentesTrocarDono(Continentes* cont, int indice, IdCor antigo, IdCor novo) {
+    int c = cont->continenteDe[indice];
+    if (c == SEM_CONTINENTE) {
+        return;
+    }
+    const Continente* continente = &cont->lista[c];
+    cont->ocupados[c][antigo]--;
+    cont->ocupados[c][novo]++;
+    if (cont->dono[c] == antigo) {
+        cont->dono[c] = COR_INVALIDA;
+        cont->bonus[antigo] -= continente->bonus;
+    }
+    if (cont->ocupados[c][novo] == continente->tamanho) {
+        cont->dono[c] = novo;
+        cont->bonus[novo] += continente->bonus;
+    }
+}
+
+/*
+ * Função: continentesConferir
+ * 
+ * Compara a posse incremental com uma varredura completa do mapa.
+ * Usada nas compilações de depuração para detectar divergências.
+ * 
+ * Retorno: 1 se tudo confere, 0 caso contrário
+ */
+int continentesConferir(const Continentes* cont, const Mapa* mapa) {
+    Continentes esperado;
+    if (!continentesCopiar(&esperado, cont)) {
+        // Sem memória para conferir: não acusa divergência
+        return 1;
+    }
+    int ok = continentesRecalcular(&esperado, mapa) &&
+             memcmp(esperado.bonus, cont->bonus, sizeof(cont->bonus)) == 0;
+    for (int c = 0; ok && c < cont->numContinentes; c++) {
+        ok = esperado.dono[c] == cont->dono[c] &&
+             memcmp(esperado.ocupados[c], cont->ocupados[c], sizeof(cont->ocupados[c])) == 0;
+    }
+    continentesLiberar(&esperado);
+    return ok;
+}
+
+/*
+ * Função: reforcoDaCor
+ * 
+ * Tropas que a cor recebe no início do turno: um terço dos territórios
+ * (pelo menos REFORCO_MINIMO) mais o bônus dos continentes que ela ocupa
+ * inteiros. Com estatísticas e continentes anexados ao mapa, O(1).
+ * 
+ * Retorno: tropas de reforço (0 se a cor não tem territórios)
+ */
+int reforcoDaCor(const Mapa* mapa, IdCor cor) {
+    int territorios = contarTerritoriosDaCor(mapa, cor);
+    if (territorios == 0) {
+        return 0;
+    }
+    int reforco = territorios / TERRITORIOS_POR_REFORCO;
+    if (reforco < REFORCO_MINIMO) {
+        reforco = REFORCO_MINIMO;
+    }
+    if (mapa->continentes != NULL) {
+        reforco += continentesBonus(mapa->continentes, cor);
+    }
+    return reforco;
+}
@@ -0,0 +1,71 @@
+/*
+ * Continentes e reforços
+ * 
+ * Um continente é um grupo de territórios que vale um bônus de tropas a
+ * quem ocupar todos eles. Para cada continente são mantidos os
+ * territórios de cada cor e a cor que o ocupa inteiro (se houver), e
+ * para cada cor a soma dos bônus dos continentes inteiros. Os valores
+ * são atualizados pelo gancho de mapaDefinirDono, então calcular o
+ * reforço de um jogador é O(1), sem varrer o mapa nem os continentes.
+ */
+
+#ifndef WAR_CONTINENTE_H
+#define WAR_CONTINENTE_H
+
+#include <stdint.h>
+#include "mapa.h"
+
+// Reforço mínimo por turno e territórios por tropa de reforço
+#define REFORCO_MINIMO 3
+#define TERRITORIOS_POR_REFORCO 3
+
+// Territórios fora de qualquer continente
+#define SEM_CONTINENTE (-1)
+
+/*
+ * Struct Continente
+ * 
+ * Definição de um continente.
+ */
+typedef struct {
+    char nome[TAM_NOME];
+    int32_t bonus;          // Tropas extras por turno para quem ocupa todos os territórios
+    int32_t tamanho;        // Territórios do continente
+} Continente;
+
+/*
+ * Struct Continentes
+ * 
+ * Continentes de um mapa: as definições e a posse de cada um.
+ */
+struct Continentes {
+    int numContinentes;
+    int capacidade;
+    int numTerritorios;               // Territórios cobertos por continenteDe
+    Continente* lista;
+    int32_t* continenteDe;            // Continente de cada território (ou SEM_CONTINENTE)
+    int32_t (*ocupados)[MAX_CORES];   // Territórios de cada cor, por continente
+    IdCor* dono;                      // Cor que ocupa o continente inteiro, ou COR_INVALIDA
+    int bonus[MAX_CORES];             // Bônus somado dos continentes inteiros de cada cor
+};
+
+int continentesIniciar(Continentes* cont, int numTerritorios);
+void continentesLiberar(Continentes* cont);
+int continentesAdicionar(Continentes* cont, const char* nome, int bonus);
+int continentesIncluir(Continentes* cont, int continente, int territorio);
+int continentesCopiar(Continentes* destino, const Continentes* origem);
+int continentesRecalcular(Continentes* cont, const Mapa* mapa);
+int continentesConferir(const Continentes* cont, const Mapa* mapa);
+
+int reforcoDaCor(const Mapa* mapa, IdCor cor);
+
+/*
+ * Função: continentesBonus
+ * 
+ * Retorno: bônus dos continentes ocupados inteiros pela cor, em O(1)
+ */
+static inline int continentesBonus(const Continentes* cont, IdCor cor) {
+    return cont->bonus[cor];
+}
+
+#endif
@@ -0,0 +1,581 @@
+/*
+ * Estatísticas incrementais por cor
+ * 
+ * Contagem de territórios e soma de tropas são contadores simples.
+ * Para a maior sequência consecutiva, o mapa é visto como uma lista de
+ * "sequências" (trechos máximos de territórios da mesma cor):
+ * 
+ * - um conjunto de bits hierárquico marca os índices onde cada sequência
+ *   começa, permitindo achar o início e o fim da sequência de qualquer
+ *   território em O(log64 n);
+ * - cada cor tem uma heap de máximo com (tamanho, início) das suas
+ *   sequências. Uma troca de dono só altera até três sequências, que são
+ *   inseridas de novo; entradas antigas são descartadas quando chegam ao
+ *   topo e já não descrevem uma sequência atual. Quando uma heap passa a
+ *   ter mais que o dobro das sequências atuais da cor, só ela é
+ *   compactada, então o custo continua amortizado sobre as inserções
+ *   daquela cor e nunca varre o mapa.
+ * 
+ * Se uma inserção falhar por falta de memória, as estruturas de
+ * sequências ficam marcadas como desatualizadas e são refeitas na
+ * próxima consulta (ou trocadas por uma varredura, se a memória ainda
+ * faltar).
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "estatisticas.h"
+
+// Níveis do conjunto hierárquico (64^6 bits cobrem qualquer índice int)
+#define MAX_NIVEIS 6
+
+// Entradas toleradas em uma heap além do dobro das sequências da cor
+#define FOLGA_HEAP 64
+
+/*
+ * Struct Sequencia
+ * 
+ * Entrada da heap de uma cor.
+ */
+typedef struct {
+    int32_t tamanho;
+    int32_t inicio;
+} Sequencia;
+
+/*
+ * Struct Heap
+ * 
+ * Heap de máximo (por tamanho) com as sequências de uma cor.
+ */
+typedef struct {
+    Sequencia* itens;
+    int quantidade;
+    int capacidade;
+} Heap;
+
+struct Estatisticas {
+    int tamanho;                        // Territórios cobertos
+    int territorios[MAX_CORES];         // Territórios por cor
+    long long tropas[MAX_CORES];        // Tropas por cor
+
+    int niveis;                         // Níveis do conjunto de inícios
+    uint64_t* inicios[MAX_NIVEIS];      // Nível 0: um bit por território
+    size_t palavras[MAX_NIVEIS];        // Palavras de 64 bits por nível
+    int numSequencias;                  // Bits ligados no nível 0
+    int sequencias[MAX_CORES];          // Sequências atuais de cada cor
+
+    Heap heaps[MAX_CORES];
+    int desatualizada;                  // 1 se uma inserção falhou: refazer antes de consultar
+};
+
+/* ---- Conjunto hierárquico de inícios de sequência ---- */
+
+static int bitLigado(const Estatisticas* est, int i) {
+    return (int) ((est->inicios[0][i >> 6] >> (i & 63)) & 1);
+}
+
+// Marca o início de uma sequência da cor `cor` em i
+static void ligarBit(Estatisticas* est, int i, IdCor cor) {
+    if (bitLigado(est, i)) {
+        return;
+    }
+    est->numSequencias++;
+    est->sequencias[cor]++;
+    size_t pos = (size_t) i;
+    for (int n = 0; n < est->niveis; n++) {
+        uint64_t* palavra = &est->inicios[n][pos >> 6];
+        int estavaVazia = (*palavra == 0);
+        *palavra |= 1ULL << (pos & 63);
+        if (!estavaVazia) {
+            break;
+        }
+        pos >>= 6;
+    }
+}
+
+// Desfaz o início de uma sequência da cor `cor` em i
+static void desligarBit(Estatisticas* est, int i, IdCor cor) {
+    if (!bitLigado(est, i)) {
+        return;
+    }
+    est->numSequencias--;
+    est->sequencias[cor]--;
+    size_t pos = (size_t) i;
+    for (int n = 0; n < est->niveis; n++) {
+        uint64_t* palavra = &est->inicios[n][pos >> 6];
+        *palavra &= ~(1ULL << (pos & 63));
+        if (*palavra != 0) {
+            break;
+        }
+        pos >>= 6;
+    }
+}
+
+/*
+ * Função: anteriorNoNivel
+ * 
+ * Retorno: maior índice ligado <= i no nível `nivel`, ou -1
+ */
+static long anteriorNoNivel(const Estatisticas* est, int nivel, long i) {
+    if (i < 0) {
+        return -1;
+    }
+    const uint64_t* pal = est->inicios[nivel];
+    long w = i >> 6;
+    uint64_t m = pal[w] & (~0ULL >> (63 - (i & 63)));
+    if (m != 0) {
+        return w * 64 + 63 - __builtin_clzll(m);
+    }
+    if (nivel + 1 == est->niveis || nivel + 1 == MAX_NIVEIS) {
+        // Nível mais alto: no máximo uma palavra (o limite fixo só informa o compilador)
+        return -1;
+    }
+    long j = anteriorNoNivel(est, nivel + 1, w - 1);
+    if (j < 0) {
+        return -1;
+    }
+    return j * 64 + 63 - __builtin_clzll(pal[j]);
+}
+
+/*
+ * Função: proximoNoNivel
+ * 
+ * Retorno: menor índice ligado >= i no nível `nivel`, ou -1
+ */
+static long proximoNoNivel(const Estatisticas* est, int nivel, long i) {
+    long w = i >> 6;
+    if ((size_t) w >= est->palavras[nivel]) {
+        return -1;
+    }
+    const uint64_t* pal = est->inicios[nivel];
+    uint64_t m = pal[w] & (~0ULL << (i & 63));
+    if (m != 0) {
+        return w * 64 + __builtin_ctzll(m);
+    }
+    if (nivel + 1 == est->niveis || nivel + 1 == MAX_NIVEIS) {
+        return -1;
+    }
+    long j = proximoNoNivel(est, nivel + 1, w + 1);
+    if (j < 0) {
+        return -1;
+    }
+    return j * 64 + __builtin_ctzll(pal[j]);
+}
+
+/*
+ * Função: inicioDaSequencia
+ * 
+ * Retorno: índice onde começa a sequência que contém o território i
+ */
+static int inicioDaSequencia(const Estatisticas* est, int i) {
+    return (int) anteriorNoNivel(est, 0, i);
+}
+
+/*
+ * Função: fimDaSequencia
+ * 
+ * Retorno: índice do último território da sequência que contém i
+ */
+static int fimDaSequencia(const Estatisticas* est, int i) {
+    long proximo = (i + 1 < est->tamanho) ? proximoNoNivel(est, 0, i + 1) : -1;
+    return (proximo < 0) ? est->tamanho - 1 : (int) proximo - 1;
+}
+
+/* ---- Heaps de sequências por cor ---- */
+
+static int heapInserir(Heap* heap, Sequencia item) {
+    if (heap->quantidade == heap->capacidade) {
+        int nova = (heap->capacidade > 0) ? heap->capacidade * 2 : 16;
+        Sequencia* itens = (Sequencia*) realloc(heap->itens, nova * sizeof(Sequencia));
+        if (itens == NULL) {
+            return 0;
+        }
+        heap->itens = itens;
+        heap->capacidade = nova;
+    }
+
+    int i = heap->quantidade++;
+    while (i > 0) {
+        int pai = (i - 1) / 2;
+        if (heap->itens[pai].tamanho >= item.tamanho) {
+            break;
+        }
+        heap->itens[i] = heap->itens[pai];
+        i = pai;
+    }
+    heap->itens[i] = item;
+    return 1;
+}
+
+static void heapRemoverTopo(Heap* heap) {
+    Sequencia ultimo = heap->itens[--heap->quantidade];
+    int i = 0;
+    for (;;) {
+        int filho = 2 * i + 1;
+        if (filho >= heap->quantidade) {
+            break;
+        }
+        if (filho + 1 < heap->quantidade &&
+            heap->itens[filho + 1].tamanho > heap->itens[filho].tamanho) {
+            filho++;
+        }
+        if (heap->itens[filho].tamanho <= ultimo.tamanho) {
+            break;
+        }
+        heap->itens[i] = heap->itens[filho];
+        i = filho;
+    }
+    if (heap->quantidade > 0) {
+        heap->itens[i] = ultimo;
+    }
+}
+
+/*
+ * Função: sequenciaValida
+ * 
+ * Verifica se uma entrada da heap da cor ainda descreve uma sequência
+ * atual do mapa.
+ */
+static int sequenciaValida(const Estatisticas* est, const Mapa* mapa, IdCor cor, Sequencia s) {
+    if (s.inicio >= est->tamanho || mapa->donos[s.inicio] != cor || !bitLigado(est, s.inicio)) {
+        return 0;
+    }
+    return fimDaSequencia(est, s.inicio) - s.inicio + 1 == s.tamanho;
+}
+
+static int compararInicio(const void* a, const void* b) {
+    int32_t x = ((const Sequencia*) a)->inicio, y = ((const Sequencia*) b)->inicio;
+    return (x > y) - (x < y);
+}
+
+/*
+ * Função: compactarHeap
+ * 
+ * Deixa na heap da cor só as entradas válidas, uma por sequência (a
+ * mesma sequência pode ter sido registrada mais de uma vez), e refaz a
+ * ordem de heap. Custa O(k log n) para uma heap de k entradas.
+ */
+static void compactarHeap(Estatisticas* est, const Mapa* mapa, IdCor cor) {
+    Heap* heap = &est->heaps[cor];
+    int validas = 0;
+    for (int k = 0; k < heap->quantidade; k++) {
+        if (sequenciaValida(est, mapa, cor, heap->itens[k])) {
+            heap->itens[validas++] = heap->itens[k];
+        }
+    }
+    // Entradas válidas com o mesmo início descrevem a mesma sequência
+    qsort(heap->itens, validas, sizeof(Sequencia), compararInicio);
+    int unicas = 0;
+    for (int k = 0; k < validas; k++) {
+        if (unicas == 0 || heap->itens[unicas - 1].inicio != heap->itens[k].inicio) {
+            heap->itens[unicas++] = heap->itens[k];
+        }
+    }
+    // Reinsere no próprio vetor: a inserção k só escreve nas posições 0 .. k
+    heap->quantidade = 0;
+    for (int k = 0; k < unicas; k++) {
+        heapInserir(heap, heap->itens[k]);
+    }
+}
+
+/*
+ * Função: registrarSequencia
+ * 
+ * Insere na heap da cor dona a sequência que contém o território i e
+ * compacta essa heap se ela tiver entradas obsoletas demais.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 em caso de falha de alocação
+ */
+static int registrarSequencia(Estatisticas* est, const Mapa* mapa, int i) {
+    int inicio = inicioDaSequencia(est, i);
+    int fim = fimDaSequencia(est, i);
+    Sequencia s = {fim - inicio + 1, inicio};
+    IdCor cor = mapa->donos[inicio];
+    if (!heapInserir(&est->heaps[cor], s)) {
+        return 0;
+    }
+    if (est->heaps[cor].quantidade > 2 * est->sequencias[cor] + FOLGA_HEAP) {
+        compactarHeap(est, mapa, cor);
+    }
+    return 1;
+}
+
+/* ---- Interface pública ---- */
+
+/*
+ * Função: estatisticasRecalcular
+ * 
+ * Refaz todas as estatísticas a partir de uma varredura completa do mapa.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 em caso de falha de alocação
+ */
+int estatisticasRecalcular(Estatisticas* est, const Mapa* mapa) {
+    int n = mapa->quantidade;
+    est->desatualizada = 1;   // Até o fim: uma falha no meio deixa as sequências por refazer
+
+    // Realoca o conjunto de inícios se o mapa mudou de tamanho
+    if (n != est->tamanho || est->inicios[0] == NULL) {
+        for (int k = 0; k < est->niveis; k++) {
+            free(est->inicios[k]);
+            est->inicios[k] = NULL;
+        }
+        est->niveis = 0;
+        size_t bits = (n > 0) ? (size_t) n : 1;
+        do {
+            size_t palavras = (bits + 63) / 64;
+            est->inicios[est->niveis] = (uint64_t*) calloc(palavras, sizeof(uint64_t));
+            if (est->inicios[est->niveis] == NULL) {
+                return 0;
+            }
+            est->palavras[est->niveis] = palavras;
+            est->niveis++;
+            bits = palavras;
+        } while (bits > 1 && est->niveis < MAX_NIVEIS);
+        est->tamanho = n;
+    } else {
+        for (int k = 0; k < est->niveis; k++) {
+            memset(est->inicios[k], 0, est->palavras[k] * sizeof(uint64_t));
+        }
+    }
+
+    memset(est->territorios, 0, sizeof(est->territorios));
+    memset(est->tropas, 0, sizeof(est->tropas));
+    memset(est->sequencias, 0, sizeof(est->sequencias));
+    for (int c = 0; c < MAX_CORES; c++) {
+        est->heaps[c].quantidade = 0;
+    }
+    est->numSequencias = 0;
+
+    for (int i = 0; i < n; i++) {
+        IdCor dono = mapa->donos[i];
+        est->territorios[dono]++;
+        est->tropas[dono] += mapa->tropas[i];
+        if (i == 0 || dono != mapa->donos[i - 1]) {
+            ligarBit(est, i, dono);
+        }
+    }
+
+    // Uma entrada por sequência
+    for (int i = 0; i < n; i = fimDaSequencia(est, i) + 1) {
+        if (!registrarSequencia(est, mapa, i)) {
+            return 0;
+        }
+    }
+    est->desatualizada = 0;
+    return 1;
+}
+
+/*
+ * Função: estatisticasCriar
+ * 
+ * Cria as estatísticas de um mapa já cadastrado. Para que sejam mantidas
+ * automaticamente, atribua o resultado a mapa->estatisticas.
+ * 
+ * Retorno: ponteiro para as estatísticas, ou NULL em caso de falha
+ */
+Estatisticas* estatisticasCriar(const Mapa* mapa) {
+    Estatisticas* est = (Estatisticas*) calloc(1, sizeof(Estatisticas));
+    if (est == NULL) {
+        return NULL;
+    }
+    est->tamanho = -1;
+    if (!estatisticasRecalcular(est, mapa)) {
+        estatisticasDestruir(est);
+        return NULL;
+    }
+    return est;
+}
+
+/*
+ * Função: estatisticasDestruir
+ * 
+ * Libera as estatísticas (aceita NULL).
+ */
+void estatisticasDestruir(Estatisticas* est) {
+    if (est == NULL) {
+        return;
+    }
+    for (int k = 0; k < MAX_NIVEIS; k++) {
+        free(est->inicios[k]);
+    }
+    for (int c = 0; c < MAX_CORES; c++) {
+        free(est->heaps[c].itens);
+    }
+    free(est);
+}
+
+/*
+ * Função: estatisticasTrocarDono
+ * 
+ * Gancho de mapaDefinirDono: o território `indice` acabou de passar da
+ * cor `antigo` para mapa->donos[indice]. Contagem e tropas são sempre
+ * atualizadas; se uma inserção em heap falhar, as sequências ficam
+ * desatualizadas até a próxima consulta.
+ * 
+ * Retorno: 1 se as sequências estão atualizadas, 0 em caso de falha de
+ * alocação (agora ou em uma troca anterior ainda não refeita)
+ */
+int estatisticasTrocarDono(Estatisticas* est, const Mapa* mapa, int indice, IdCor antigo) {
+    IdCor novo = mapa->donos[indice];
+    int tropas = mapa->tropas[indice];
+
+    est->territorios[antigo]--;
+    est->territorios[novo]++;
+    est->tropas[antigo] -= tropas;
+    est->tropas[novo] += tropas;
+    if (est->desatualizada) {
+        return 0;   // Tudo será refeito por estatisticasRecalcular
+    }
+
+    // A sequência que começava em indice (se havia) passa a ser da cor nova
+    if (bitLigado(est, indice)) {
+        est->sequencias[antigo]--;
+        est->sequencias[novo]++;
+    }
+
+    // Só as fronteiras em indice e indice+1 podem mudar
+    if (indice > 0) {
+        if (mapa->donos[indice - 1] != novo) {
+            ligarBit(est, indice, novo);
+        } else {
+            desligarBit(est, indice, novo);
+        }
+    }
+    if (indice + 1 < est->tamanho) {
+        IdCor seguinte = mapa->donos[indice + 1];
+        if (seguinte != novo) {
+            ligarBit(est, indice + 1, seguinte);
+        } else {
+            desligarBit(est, indice + 1, seguinte);
+        }
+    }
+
+    // Registra as sequências resultantes; as antigas ficam obsoletas na heap
+    int ok = registrarSequencia(est, mapa, indice);
+    if (ok && indice > 0 && mapa->donos[indice - 1] != novo) {
+        ok = registrarSequencia(est, mapa, indice - 1);
+    }
+    if (ok && indice + 1 < est->tamanho && mapa->donos[indice + 1] != novo) {
+        ok = registrarSequencia(est, mapa, indice + 1);
+    }
+    if (!ok) {
+        est->desatualizada = 1;
+    }
+    return ok;
+}
+
+/*
+ * Função: estatisticasAjustarTropas
+ * 
+ * Gancho de mapaDefinirTropas: soma `diferenca` ao total da cor.
+ */
+void estatisticasAjustarTropas(Estatisticas* est, IdCor dono, int diferenca) {
+    est->tropas[dono] += diferenca;
+}
+
+/*
+ * Função: estatisticasTerritorios
+ * 
+ * Retorno: quantidade de territórios da cor, em O(1)
+ */
+int estatisticasTerritorios(const Estatisticas* est, IdCor cor) {
+    return est->territorios[cor];
+}
+
+/*
+ * Função: estatisticasTropas
+ * 
+ * Retorno: total de tropas da cor, em O(1)
+ */
+long long estatisticasTropas(const Estatisticas* est, IdCor cor) {
+    return est->tropas[cor];
+}
+
+/*
+ * Função: estatisticasMaiorSequencia
+ * 
+ * Descarta as entradas obsoletas do topo da heap da cor e devolve o
+ * tamanho da maior sequência atual. Sequências desatualizadas por uma
+ * falha de alocação são refeitas antes; se ainda faltar memória, a
+ * resposta vem de uma varredura do mapa.
+ * 
+ * Retorno: tamanho da maior sequência consecutiva da cor
+ */
+int estatisticasMaiorSequencia(Estatisticas* est, const Mapa* mapa, IdCor cor) {
+    if (est->desatualizada && !estatisticasRecalcular(est, mapa)) {
+        return mapaMaiorSequencia(mapa, cor);
+    }
+    Heap* heap = &est->heaps[cor];
+    while (heap->quantidade > 0 && !sequenciaValida(est, mapa, cor, heap->itens[0])) {
+        heapRemoverTopo(heap);
+    }
+    return (heap->quantidade > 0) ? heap->itens[0].tamanho : 0;
+}
+
+/*
+ * Função: estatisticasConferir
+ * 
+ * Compara os valores incrementais com uma varredura completa do mapa.
+ * Usada nas compilações de depuração para detectar divergências.
+ * 
+ * Retorno: 1 se tudo confere, 0 caso contrário
+ */
+int estatisticasConferir(Estatisticas* est, const Mapa* mapa) {
+    if (est->tamanho != mapa->quantidade) {
+        return 0;
+    }
+    for (int c = 0; c < mapa->numCores; c++) {
+        if (est->territorios[c] != mapaContarPorDono(mapa, (IdCor) c) ||
+            est->tropas[c] != mapaSomarTropas(mapa, (IdCor) c) ||
+            estatisticasMaiorSequencia(est, mapa, (IdCor) c) != mapaMaiorSequencia(mapa, (IdCor) c)) {
+            return 0;
+        }
+    }
+    if (est->desatualizada) {
+        return 0;
+    }
+    for (int i = 0; i < mapa->quantidade; i++) {
+        int esperado = (i == 0 || mapa->donos[i] != mapa->donos[i - 1]);
+        if (bitLigado(est, i) != esperado) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/*
+ * Função: contarTerritoriosDaCor
+ * 
+ * Retorno: territórios da cor (O(1) com estatísticas anexadas, O(n) sem)
+ */
+int contarTerritoriosDaCor(const Mapa* mapa, IdCor cor) {
+    if (mapa->estatisticas != NULL) {
+        return estatisticasTerritorios(mapa->estatisticas, cor);
+    }
+    return mapaContarPorDono(mapa, cor);
+}
+
+/*
+ * Função: somarTropasDaCor
+ * 
+ * Retorno: tropas da cor (O(1) com estatísticas anexadas, O(n) sem)
+ */
+long long somarTropasDaCor(const Mapa* mapa, IdCor cor) {
+    if (mapa->estatisticas != NULL) {
+        return estatisticasTropas(mapa->estatisticas, cor);
+    }
+    return mapaSomarTropas(mapa, cor);
+}
+
+/*
+ * Função: maiorSequenciaDaCor
+ * 
+ * Retorno: maior sequência consecutiva da cor (O(log n) amortizado com
+ * estatísticas anexadas, O(n) sem)
+ */
+int maiorSequenciaDaCor(const Mapa* mapa, IdCor cor) {
+    if (mapa->estatisticas != NULL) {
+        return estatisticasMaiorSequencia(mapa->estatisticas, mapa, cor);
+    }
+    return mapaMaiorSequencia(mapa, cor);
+}
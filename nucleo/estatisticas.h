@@ -0,0 +1,32 @@
+/*
+ * Estatísticas incrementais por cor
+ * 
+ * Mantém, para cada cor do mapa, a quantidade de territórios, o total de
+ * tropas e a maior sequência de territórios consecutivos. Os valores são
+ * atualizados pelos ganchos de mapaDefinirDono e mapaDefinirTropas, de
+ * modo que verificar uma missão não exige varrer o mapa.
+ * 
+ * Custos: contagem e tropas O(1); troca de dono O(log n) (conjunto
+ * hierárquico de inícios de sequência e heaps preguiçosas por cor).
+ */
+
+#ifndef WAR_ESTATISTICAS_H
+#define WAR_ESTATISTICAS_H
+
+#include "mapa.h"
+
+Estatisticas* estatisticasCriar(const Mapa* mapa);
+void estatisticasDestruir(Estatisticas* est);
+int estatisticasRecalcular(Estatisticas* est, const Mapa* mapa);
+
+int estatisticasTerritorios(const Estatisticas* est, IdCor cor);
+long long estatisticasTropas(const Estatisticas* est, IdCor cor);
+int estatisticasMaiorSequencia(Estatisticas* est, const Mapa* mapa, IdCor cor);
+int estatisticasConferir(Estatisticas* est, const Mapa* mapa);
+
+// Consultas que usam as estatísticas anexadas ao mapa ou, sem elas, varrem o mapa
+int contarTerritoriosDaCor(const Mapa* mapa, IdCor cor);
+long long somarTropasDaCor(const Mapa* mapa, IdCor cor);
+int maiorSequenciaDaCor(const Mapa* mapa, IdCor cor);
+
+#endif
@@ -0,0 +1,221 @@
+/*
+ * Estimador de Monte Carlo das chances de conquista
+ * 
+ * As simulações são divididas em blocos (tarefas do Pool). Cada
+ * trabalhador tem o seu próprio gerador, ressemeado no início de cada
+ * bloco com a semente derivada de (semente, bloco): o resultado não
+ * depende de qual trabalhador roubou qual bloco. Os totais ficam em uma
+ * estrutura exclusiva por trabalhador, somada apenas no final.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "aleatorio.h"
+#include "batalha.h"
+#include "estimador.h"
+
+// Batalhas simuladas por tarefa do pool
+#define SIMULACOES_POR_TAREFA 4096
+
+// Passo entre as sementes de blocos vizinhos (como entre as partidas do torneio)
+#define PASSO_SEMENTE 0x9E3779B97F4A7C15ULL
+
+/*
+ * Struct Acumulador
+ * 
+ * Totais parciais de um trabalhador, em linha de cache própria.
+ */
+typedef struct {
+    Aleatorio rng;
+    long long simulacoes;
+    long long conquistas;
+    long long tropasAtacante;
+    long long tropasDefensor;
+    long long ataques;
+} __attribute__((aligned(64))) Acumulador;
+
+typedef struct {
+    RegraBatalha regra;
+    int tropasAtacante;
+    int tropasDefensor;
+    long long simulacoes;
+    uint64_t semente;
+    Acumulador* acumuladores;
+} ContextoEstimativa;
+
+/*
+ * Função: simularBlocoClassico
+ * 
+ * Batalhas na regra clássica, todas do bloco em passo único: a cada
+ * rodada, um ataque de cada batalha ainda em andamento é resolvido por
+ * resolverRolagensLote, e as que terminam saem do vetor (a última ocupa
+ * o lugar delas), então os vetores ficam sempre compactos.
+ */
+static void simularBlocoClassico(ContextoEstimativa* ctx, Acumulador* acc, int quantidade) {
+    int atacantes[SIMULACOES_POR_TAREFA], defensores[SIMULACOES_POR_TAREFA];
+    uint8_t dadosA[SIMULACOES_POR_TAREFA], dadosD[SIMULACOES_POR_TAREFA];
+    uint8_t perdasA[SIMULACOES_POR_TAREFA], perdasD[SIMULACOES_POR_TAREFA];
+
+    acc->simulacoes += quantidade;
+    if (ctx->tropasAtacante < 2) {
+        acc->tropasAtacante += (long long) quantidade * ctx->tropasAtacante;
+        acc->tropasDefensor += (long long) quantidade * ctx->tropasDefensor;
+        return;
+    }
+    for (int i = 0; i < quantidade; i++) {
+        atacantes[i] = ctx->tropasAtacante;
+        defensores[i] = ctx->tropasDefensor;
+    }
+
+    int ativas = quantidade;
+    while (ativas > 0) {
+        for (int i = 0; i < ativas; i++) {
+            dadosA[i] = (uint8_t) dadosDoAtacante(REGRA_CLASSICA, atacantes[i]);
+            dadosD[i] = (uint8_t) dadosDoDefensor(REGRA_CLASSICA, defensores[i]);
+        }
+        resolverRolagensLote(&acc->rng, dadosA, dadosD, ativas, perdasA, perdasD);
+        acc->ataques += ativas;
+
+        int restantes = 0;
+        for (int i = 0; i < ativas; i++) {
+            int atacante = atacantes[i] - perdasA[i];
+            int defensor = defensores[i] - perdasD[i];
+            if (defensor <= 0) {
+                // Conquista: origem e ocupação somam as tropas que restaram
+                acc->conquistas++;
+                acc->tropasAtacante += atacante;
+            } else if (atacante < 2) {
+                acc->tropasAtacante += atacante;
+                acc->tropasDefensor += defensor;
+            } else {
+                atacantes[restantes] = atacante;
+                defensores[restantes] = defensor;
+                restantes++;
+            }
+        }
+        ativas = restantes;
+    }
+}
+
+/*
+ * Função: simularBloco
+ * 
+ * Tarefa do pool: simula um bloco de batalhas completas usando
+ * aplicarRegraAtaque, as mesmas regras do jogo interativo (ou, na regra
+ * clássica, simularBlocoClassico).
+ */
+static void simularBloco(void* contexto, int tarefa, int trabalhador) {
+    ContextoEstimativa* ctx = (ContextoEstimativa*) contexto;
+    Acumulador* acc = &ctx->acumuladores[trabalhador];
+
+    long long inicio = (long long) tarefa * SIMULACOES_POR_TAREFA;
+    long long fim = inicio + SIMULACOES_POR_TAREFA;
+    if (fim > ctx->simulacoes) {
+        fim = ctx->simulacoes;
+    }
+    aleatorioSemear(&acc->rng, ctx->semente + (uint64_t) tarefa * PASSO_SEMENTE);
+    if (ctx->regra == REGRA_CLASSICA) {
+        simularBlocoClassico(ctx, acc, (int) (fim - inicio));
+        return;
+    }
+
+    ResultadoAtaque resultado;
+    for (long long s = inicio; s < fim; s++) {
+        int atacante = ctx->tropasAtacante;
+        int defensor = ctx->tropasDefensor;
+
+        resultado.conquista = 0;
+        while (atacante >= 2) {
+            aplicarRegraAtaque(atacante, defensor, rolarDado(&acc->rng), rolarDado(&acc->rng), &resultado);
+            atacante = resultado.tropasAtacante;
+            defensor = resultado.tropasDefensor;
+            acc->ataques++;
+            if (resultado.conquista) {
+                break;
+            }
+        }
+
+        acc->simulacoes++;
+        if (resultado.conquista) {
+            acc->conquistas++;
+            acc->tropasAtacante += atacante + defensor;
+        } else {
+            acc->tropasAtacante += atacante;
+            acc->tropasDefensor += defensor;
+        }
+    }
+}
+
+/*
+ * Função: estimarConquista
+ * 
+ * Estima a chance de o atacante conquistar o defensor atacando
+ * repetidamente até vencer ou ficar sem tropas para atacar.
+ * 
+ * Parâmetros:
+ *   regra - regra de batalha
+ *   tropasAtacante - tropas atuais do território atacante
+ *   tropasDefensor - tropas atuais do território defensor
+ *   simulacoes - quantidade de batalhas a simular
+ *   semente - semente base; o bloco i usa a semente derivada de (semente, i),
+ *             então o resultado só depende dela, não do escalonamento
+ *   pool - pool de threads (NULL executa tudo na thread atual)
+ *   estimativa - onde o resultado é gravado
+ * 
+ * Retorno: 1 em caso de sucesso, 0 se os parâmetros forem inválidos
+ */
+int estimarConquista(RegraBatalha regra, int tropasAtacante, int tropasDefensor,
+                     long long simulacoes, uint64_t semente, Pool* pool, Estimativa* estimativa) {
+    if (simulacoes <= 0 || tropasAtacante < 0 || tropasDefensor < 0) {
+        return 0;
+    }
+
+    int trabalhadores = (pool != NULL) ? poolTamanho(pool) : 1;
+    Acumulador* acumuladores = (Acumulador*) aligned_alloc(64, trabalhadores * sizeof(Acumulador));
+    if (acumuladores == NULL) {
+        return 0;
+    }
+    memset(acumuladores, 0, trabalhadores * sizeof(Acumulador));
+
+    ContextoEstimativa ctx = {regra, tropasAtacante, tropasDefensor, simulacoes, semente,
+                              acumuladores};
+    int numTarefas = (int) ((simulacoes + SIMULACOES_POR_TAREFA - 1) / SIMULACOES_POR_TAREFA);
+
+    if (pool != NULL) {
+        poolExecutar(pool, numTarefas, simularBloco, &ctx);
+    } else {
+        for (int t = 0; t < numTarefas; t++) {
+            simularBloco(&ctx, t, 0);
+        }
+    }
+
+    // Redução dos totais parciais
+    Acumulador total;
+    memset(&total, 0, sizeof(total));
+    for (int i = 0; i < trabalhadores; i++) {
+        total.simulacoes += acumuladores[i].simulacoes;
+        total.conquistas += acumuladores[i].conquistas;
+        total.tropasAtacante += acumuladores[i].tropasAtacante;
+        total.tropasDefensor += acumuladores[i].tropasDefensor;
+        total.ataques += acumuladores[i].ataques;
+    }
+    free(acumuladores);
+
+    double n = (double) total.simulacoes;
+    double p = total.conquistas / n;
+    double z = 1.96;
+    double denominador = 1.0 + z * z / n;
+    double centro = (p + z * z / (2.0 * n)) / denominador;
+    double margem = z * sqrt(p * (1.0 - p) / n + z * z / (4.0 * n * n)) / denominador;
+
+    estimativa->simulacoes = total.simulacoes;
+    estimativa->conquistas = total.conquistas;
+    estimativa->probabilidade = p;
+    estimativa->limiteInferior = centro - margem;
+    estimativa->limiteSuperior = centro + margem;
+    estimativa->tropasAtacante = total.tropasAtacante / n;
+    estimativa->tropasDefensor = total.tropasDefensor / n;
+    estimativa->ataquesPorBatalha = total.ataques / n;
+    return 1;
+}
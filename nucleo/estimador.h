@@ -0,0 +1,37 @@
+/*
+ * Estimador de Monte Carlo das chances de conquista
+ * 
+ * Simula muitas batalhas completas entre um atacante e um defensor com
+ * as regras de batalha.c (simples ou clássica) e devolve a probabilidade de conquista com
+ * intervalo de confiança, distribuindo as simulações em um Pool.
+ */
+
+#ifndef WAR_ESTIMADOR_H
+#define WAR_ESTIMADOR_H
+
+#include <stdint.h>
+#include "batalha.h"
+#include "pool.h"
+
+/*
+ * Struct Estimativa
+ * 
+ * Resultado de estimarConquista. Uma "batalha" é uma sequência de ataques
+ * do mesmo atacante contra o mesmo defensor, até a conquista ou até o
+ * atacante ficar com menos de 2 tropas.
+ */
+typedef struct {
+    long long simulacoes;       // Batalhas simuladas
+    long long conquistas;       // Batalhas que terminaram em conquista
+    double probabilidade;       // Fração estimada de conquistas
+    double limiteInferior;      // Intervalo de confiança de 95% (Wilson)
+    double limiteSuperior;
+    double tropasAtacante;      // Média de tropas do atacante ao final (origem + ocupação)
+    double tropasDefensor;      // Média de tropas do defensor ao final (0 se conquistado)
+    double ataquesPorBatalha;   // Média de rolagens até o fim da batalha
+} Estimativa;
+
+int estimarConquista(RegraBatalha regra, int tropasAtacante, int tropasDefensor,
+                     long long simulacoes, uint64_t semente, Pool* pool, Estimativa* estimativa);
+
+#endif
@@ -0,0 +1,220 @@
+/*
+ * Gerador de mapas sintéticos
+ * 
+ * Cores, tropas e fronteiras saem todos do mesmo gerador semeado, na
+ * ordem dos territórios, então o mapa depende só da configuração.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "aleatorio.h"
+#include "continente.h"
+#include "gerador.h"
+#include "grafo.h"
+
+// Nomes das distribuições, na ordem de DistribuicaoTropas
+static const char* const NOMES_DISTRIBUICOES[NUM_DISTRIBUICOES_TROPAS] = {
+    "uniforme", "geometrica", "concentrada"
+};
+
+/*
+ * Função: geradorPadrao
+ * 
+ * Preenche a configuração de um mapa de `territorios` territórios com
+ * 4 cores, 1 a 10 tropas uniformes, blocos de 4 territórios, grau médio
+ * 4 com fronteiras a até 32 posições e continentes de cerca de
+ * sqrt(territorios) territórios (pelo menos 4), para que o número de
+ * continentes também cresça devagar.
+ */
+void geradorPadrao(ConfigGerador* config, int territorios) {
+    memset(config, 0, sizeof(*config));
+    config->territorios = territorios;
+    config->cores = 4;
+    config->distribuicao = TROPAS_UNIFORME;
+    config->tropasMaximas = 10;
+    config->bloco = 4;
+    config->grau = 4.0;
+    config->alcance = 32;
+    int lado = 4;
+    while ((long long) lado * lado < territorios) {
+        lado++;
+    }
+    config->territoriosPorContinente = lado;
+    config->semente = 2025;
+}
+
+const char* nomeDistribuicao(DistribuicaoTropas distribuicao) {
+    return ((unsigned) distribuicao < NUM_DISTRIBUICOES_TROPAS)
+        ? NOMES_DISTRIBUICOES[distribuicao] : "?";
+}
+
+/*
+ * Função: distribuicaoPorNome
+ * 
+ * Retorno: 1 se o nome corresponde a uma distribuição, 0 caso contrário
+ */
+int distribuicaoPorNome(const char* nome, DistribuicaoTropas* distribuicao) {
+    for (int d = 0; d < NUM_DISTRIBUICOES_TROPAS; d++) {
+        if (strcmp(nome, NOMES_DISTRIBUICOES[d]) == 0) {
+            *distribuicao = (DistribuicaoTropas) d;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int sortearTropas(const ConfigGerador* config, Aleatorio* rng) {
+    switch (config->distribuicao) {
+        case TROPAS_GEOMETRICA: {
+            // Um bit por "cara": P(t) = 2^-t, com o excesso acumulado no máximo
+            uint64_t bits = aleatorioProximo(rng);
+            int tropas = 1;
+            while (tropas < config->tropasMaximas && (bits & 1)) {
+                tropas++;
+                bits >>= 1;
+            }
+            return tropas;
+        }
+        case TROPAS_CONCENTRADA:
+            return (aleatorioLimitado(rng, 16) == 0) ? config->tropasMaximas : 1;
+        default:
+            return 1 + (int) aleatorioLimitado(rng, (uint32_t) config->tropasMaximas);
+    }
+}
+
+// Fronteiras: a cadeia linear mais as sorteadas até o grau médio pedido
+static Grafo* gerarFronteiras(const ConfigGerador* config, Aleatorio* rng) {
+    long n = config->territorios;
+    long total = (long) (config->grau * n / 2.0 + 0.5);
+    if (total < n - 1) {
+        total = n - 1;
+    }
+    int32_t (*arestas)[2] = malloc((size_t) (total > 0 ? total : 1) * sizeof(*arestas));
+    Grafo* grafo = (Grafo*) malloc(sizeof(Grafo));
+    if (arestas == NULL || grafo == NULL) {
+        free(arestas);
+        free(grafo);
+        return NULL;
+    }
+    long e = 0;
+    for (; e < n - 1; e++) {
+        arestas[e][0] = (int32_t) e;
+        arestas[e][1] = (int32_t) e + 1;
+    }
+    int alcance = (config->alcance > 0 && config->alcance < n) ? config->alcance : (int) n - 1;
+    for (; e < total; e++) {
+        int32_t a = (int32_t) aleatorioLimitado(rng, (uint32_t) n);
+        int32_t distancia = 1 + (int32_t) aleatorioLimitado(rng, (uint32_t) alcance);
+        int32_t b = (a + distancia < n) ? a + distancia : a - distancia;
+        if (b < 0) {
+            b = (a + distancia) % (int32_t) n;
+        }
+        arestas[e][0] = a;
+        arestas[e][1] = b;
+    }
+    int ok = grafoCriarDeArestas(grafo, (int) n, (const int32_t (*)[2]) arestas, total);
+    free(arestas);
+    if (!ok) {
+        free(grafo);
+        return NULL;
+    }
+    return grafo;
+}
+
+// Continentes de territórios consecutivos, com bônus de metade do tamanho
+static int gerarContinentes(const ConfigGerador* config, Mapa* mapa) {
+    Continentes* continentes = (Continentes*) malloc(sizeof(Continentes));
+    int ok = continentes != NULL && continentesIniciar(continentes, mapa->quantidade);
+    char nome[TAM_NOME];
+    for (int inicio = 0, c = 0; ok && inicio < mapa->quantidade; c++) {
+        int tamanho = config->territoriosPorContinente;
+        if (tamanho > mapa->quantidade - inicio) {
+            tamanho = mapa->quantidade - inicio;
+        }
+        snprintf(nome, sizeof(nome), "C%d", c + 1);
+        ok = continentesAdicionar(continentes, nome, (tamanho > 1) ? tamanho / 2 : 1) == c;
+        for (int i = 0; ok && i < tamanho; i++) {
+            ok = continentesIncluir(continentes, c, inicio + i);
+        }
+        inicio += tamanho;
+    }
+    if (!ok || !mapaDefinirContinentes(mapa, continentes)) {
+        if (continentes != NULL) {
+            continentesLiberar(continentes);
+        }
+        free(continentes);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * Função: geradorCriar
+ * 
+ * Preenche um mapa vazio (recém-iniciado com mapaIniciar) com o mapa
+ * sintético da configuração, com grafo e, se pedidos, continentes.
+ * 
+ * Parâmetros:
+ *   config - parâmetros do mapa
+ *   mapa - mapa de destino, vazio
+ *   arena - de onde sai o vetor de jogadores
+ *   jogadores - recebe um jogador do computador por cor, sem missão
+ *   numJogadores - recebe a quantidade de jogadores (config->cores)
+ * 
+ * Retorno: 1 em caso de sucesso, 0 se a configuração for inválida ou
+ * faltar memória (o mapa pode ter ficado parcialmente preenchido)
+ */
+int geradorCriar(const ConfigGerador* config, Mapa* mapa, Arena* arena, Jogador** jogadores,
+                 int* numJogadores) {
+    if (config->territorios < 1 || config->cores < 2 || config->cores > MAX_CORES ||
+        config->tropasMaximas < 1 || config->bloco < 1 || config->grau < 0.0 ||
+        config->territoriosPorContinente < 0 || mapa->quantidade != 0 ||
+        (unsigned) config->distribuicao >= NUM_DISTRIBUICOES_TROPAS) {
+        return 0;
+    }
+    Jogador* lista = (Jogador*) arenaAlocarZerado(arena, (size_t) config->cores, sizeof(Jogador));
+    if (lista == NULL || !mapaReservar(mapa, config->territorios)) {
+        return 0;
+    }
+    for (int c = 0; c < config->cores; c++) {
+        snprintf(lista[c].nome, TAM_NOME, "Computador%d", c + 1);
+        snprintf(lista[c].cor, TAM_COR, "c%d", (uint8_t) (c + 1));
+        lista[c].idCor = mapaInternarCor(mapa, lista[c].cor);
+        lista[c].bot = 1;
+        if (lista[c].idCor == COR_INVALIDA) {
+            return 0;
+        }
+    }
+
+    // Posse em sequências de comprimento médio `bloco`: troca de cor com chance 1/bloco
+    Aleatorio rng;
+    aleatorioSemear(&rng, config->semente);
+    IdCor cor = lista[aleatorioLimitado(&rng, (uint32_t) config->cores)].idCor;
+    for (int i = 0; i < config->territorios; i++) {
+        if (aleatorioLimitado(&rng, (uint32_t) config->bloco) == 0) {
+            cor = lista[aleatorioLimitado(&rng, (uint32_t) config->cores)].idCor;
+        }
+        snprintf(mapa->nomes[i], TAM_NOME, "T%d", i + 1);
+        mapa->donos[i] = cor;
+        mapa->tropas[i] = sortearTropas(config, &rng);
+    }
+    mapa->quantidade = config->territorios;
+
+    Grafo* grafo = gerarFronteiras(config, &rng);
+    if (grafo == NULL) {
+        return 0;
+    }
+    if (!mapaDefinirGrafo(mapa, grafo)) {
+        grafoLiberar(grafo);
+        free(grafo);
+        return 0;
+    }
+    if (config->territoriosPorContinente > 0 && !gerarContinentes(config, mapa)) {
+        return 0;
+    }
+
+    *jogadores = lista;
+    *numJogadores = config->cores;
+    return 1;
+}
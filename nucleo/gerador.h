@@ -0,0 +1,60 @@
+/*
+ * Gerador de mapas sintéticos
+ * 
+ * Monta mapas de qualquer tamanho (de dezenas a dezenas de milhões de
+ * territórios) para medir como as jogadas escalam: quantidade de cores,
+ * distribuição das tropas, agrupamento da posse em blocos e densidade
+ * das fronteiras são configuráveis, e a mesma semente sempre gera o
+ * mesmo mapa.
+ * 
+ * Fronteiras: a cadeia linear (i, i + 1) garante um mapa conexo; as
+ * demais ligam cada território a vizinhos sorteados a até `alcance`
+ * posições, até o grau médio pedido. Cada cor ganha um jogador do
+ * computador sem missão, como os lidos de um cenário (cenario.h); o
+ * mapa gerado pode ser gravado com snapshotSalvar ou
+ * snapshotExportarTexto depois de sorteadas as missões.
+ */
+
+#ifndef WAR_GERADOR_H
+#define WAR_GERADOR_H
+
+#include <stdint.h>
+#include "mapa.h"
+
+/*
+ * Enum DistribuicaoTropas
+ * 
+ * Como as tropas de cada território são sorteadas em 1..tropasMaximas.
+ */
+typedef enum {
+    TROPAS_UNIFORME = 0,      // Qualquer valor com a mesma chance
+    TROPAS_GEOMETRICA,        // Metade dos territórios com 1, um quarto com 2, ...
+    TROPAS_CONCENTRADA,       // 1 tropa, exceto 1 território em 16 com o máximo
+    NUM_DISTRIBUICOES_TROPAS
+} DistribuicaoTropas;
+
+/*
+ * Struct ConfigGerador
+ * 
+ * Parâmetros de um mapa sintético. geradorPadrao preenche valores
+ * razoáveis para um tamanho.
+ */
+typedef struct {
+    int territorios;
+    int cores;                        // Cores (e jogadores), 2..MAX_CORES
+    DistribuicaoTropas distribuicao;
+    int tropasMaximas;
+    int bloco;                        // Comprimento médio das sequências de mesma cor (1: sem agrupamento)
+    double grau;                      // Fronteiras por território, em média (>= 2; 2: só a cadeia linear)
+    int alcance;                      // Distância máxima das fronteiras extras (0: qualquer território)
+    int territoriosPorContinente;     // 0: mapa sem continentes
+    uint64_t semente;
+} ConfigGerador;
+
+void geradorPadrao(ConfigGerador* config, int territorios);
+const char* nomeDistribuicao(DistribuicaoTropas distribuicao);
+int distribuicaoPorNome(const char* nome, DistribuicaoTropas* distribuicao);
+int geradorCriar(const ConfigGerador* config, Mapa* mapa, Arena* arena, Jogador** jogadores,
+                 int* numJogadores);
+
+#endif
@@ -0,0 +1,280 @@
+/*
+ * Grafo de adjacência entre territórios
+ * 
+ * Construção do CSR a partir de uma lista de fronteiras e busca em
+ * largura restrita aos territórios de uma cor.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "grafo.h"
+
+static int compararInt32(const void* a, const void* b) {
+    int32_t x = *(const int32_t*) a, y = *(const int32_t*) b;
+    return (x > y) - (x < y);
+}
+
+/*
+ * Função: grafoCriarLinear
+ * 
+ * Cria o grafo em que o território i faz fronteira apenas com i-1 e i+1,
+ * a noção de vizinhança usada pelo jogo antes da topologia real.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 em caso de falha de alocação
+ */
+int grafoCriarLinear(Grafo* grafo, int numVertices) {
+    long numArestas = (numVertices > 1) ? numVertices - 1 : 0;
+    int32_t (*arestas)[2] = malloc((numArestas > 0 ? numArestas : 1) * sizeof(*arestas));
+    if (arestas == NULL) {
+        return 0;
+    }
+    for (long i = 0; i < numArestas; i++) {
+        arestas[i][0] = (int32_t) i;
+        arestas[i][1] = (int32_t) (i + 1);
+    }
+    int ok = grafoCriarDeArestas(grafo, numVertices, (const int32_t (*)[2]) arestas, numArestas);
+    free(arestas);
+    grafo->linear = ok;
+    return ok;
+}
+
+/*
+ * Função: grafoCriarCompleto
+ * 
+ * Cria o grafo em que todo território faz fronteira com todos os outros,
+ * usado quando o mapa não declara fronteiras. Só a marca `completo` o
+ * representa (sem inicio nem vizinhos), então vale para qualquer
+ * tamanho; percorra os vizinhos com grafoGrau e grafoVizinho.
+ * 
+ * Retorno: sempre 1 (não aloca nada)
+ */
+int grafoCriarCompleto(Grafo* grafo, int numVertices) {
+    memset(grafo, 0, sizeof(Grafo));
+    grafo->numVertices = numVertices;
+    grafo->completo = 1;
+    return 1;
+}
+
+/*
+ * Função: grafoCriarDeArestas
+ * 
+ * Monta o CSR a partir de uma lista de fronteiras não dirigidas.
+ * Fronteiras repetidas e laços (a == b) são descartados.
+ * 
+ * Parâmetros:
+ *   grafo - grafo de destino
+ *   numVertices - quantidade de territórios
+ *   arestas - pares (a, b) de territórios vizinhos, índices a partir de 0
+ *   numArestas - quantidade de pares
+ * 
+ * Retorno: 1 em caso de sucesso, 0 se algum índice for inválido ou faltar memória
+ */
+int grafoCriarDeArestas(Grafo* grafo, int numVertices, const int32_t (*arestas)[2], long numArestas) {
+    memset(grafo, 0, sizeof(Grafo));
+
+    int32_t* inicio = (int32_t*) calloc((size_t) numVertices + 1, sizeof(int32_t));
+    int32_t* vizinhos = (int32_t*) malloc((numArestas > 0 ? 2 * numArestas : 1) * sizeof(int32_t));
+    if (inicio == NULL || vizinhos == NULL) {
+        free(inicio);
+        free(vizinhos);
+        return 0;
+    }
+
+    // Conta o grau de cada território
+    for (long e = 0; e < numArestas; e++) {
+        int32_t a = arestas[e][0], b = arestas[e][1];
+        if (a < 0 || a >= numVertices || b < 0 || b >= numVertices) {
+            free(inicio);
+            free(vizinhos);
+            return 0;
+        }
+        if (a != b) {
+            inicio[a + 1]++;
+            inicio[b + 1]++;
+        }
+    }
+    for (int v = 0; v < numVertices; v++) {
+        inicio[v + 1] += inicio[v];
+    }
+
+    // Distribui as entradas usando um cursor por território
+    int32_t* cursor = (int32_t*) malloc(((size_t) numVertices + 1) * sizeof(int32_t));
+    if (cursor == NULL) {
+        free(inicio);
+        free(vizinhos);
+        return 0;
+    }
+    memcpy(cursor, inicio, ((size_t) numVertices + 1) * sizeof(int32_t));
+    for (long e = 0; e < numArestas; e++) {
+        int32_t a = arestas[e][0], b = arestas[e][1];
+        if (a != b) {
+            vizinhos[cursor[a]++] = b;
+            vizinhos[cursor[b]++] = a;
+        }
+    }
+
+    // Ordena cada lista e remove duplicatas, compactando no lugar
+    int32_t escrita = 0;
+    for (int v = 0; v < numVertices; v++) {
+        int32_t de = inicio[v], ate = cursor[v];
+        qsort(vizinhos + de, (size_t) (ate - de), sizeof(int32_t), compararInt32);
+        inicio[v] = escrita;
+        for (int32_t k = de; k < ate; k++) {
+            if (k == de || vizinhos[k] != vizinhos[k - 1]) {
+                vizinhos[escrita++] = vizinhos[k];
+            }
+        }
+    }
+    inicio[numVertices] = escrita;
+    free(cursor);
+
+    grafo->numVertices = numVertices;
+    grafo->numEntradas = escrita;
+    grafo->inicio = inicio;
+    grafo->vizinhos = vizinhos;
+    grafo->linear = 0;
+    return 1;
+}
+
+/*
+ * Função: grafoLiberar
+ * 
+ * Libera os vetores do grafo (exceto os de um snapshot mapeado, que são
+ * liberados junto com o mapa).
+ */
+void grafoLiberar(Grafo* grafo) {
+    if (!grafo->externo) {
+        free(grafo->inicio);
+        free(grafo->vizinhos);
+    }
+    memset(grafo, 0, sizeof(Grafo));
+}
+
+/*
+ * Função: grafoAdjacentes
+ * 
+ * Verifica se dois territórios fazem fronteira (busca binária na lista
+ * ordenada de vizinhos de `a`).
+ * 
+ * Retorno: 1 se são vizinhos, 0 caso contrário
+ */
+int grafoAdjacentes(const Grafo* grafo, int a, int b) {
+    if (grafo->completo) {
+        return a != b;
+    }
+    int32_t baixo = grafo->inicio[a], alto = grafo->inicio[a + 1] - 1;
+    while (baixo <= alto) {
+        int32_t meio = baixo + (alto - baixo) / 2;
+        int32_t v = grafo->vizinhos[meio];
+        if (v == b) {
+            return 1;
+        }
+        if (v < b) {
+            baixo = meio + 1;
+        } else {
+            alto = meio - 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Função: maiorComponenteAte
+ * 
+ * Procura, entre os territórios de uma cor, o maior grupo conectado pelas
+ * fronteiras do grafo, parando assim que encontrar um com `limite`
+ * territórios. Os pontos de partida vêm do conjunto de bits de posse
+ * (ou de uma varredura dos donos, se a posse não estiver ativa).
+ * 
+ * Parâmetros:
+ *   mapa - mapa com grafo anexado
+ *   cor - cor analisada
+ *   limite - tamanho a partir do qual a busca pode parar
+ * 
+ * Retorno: tamanho do maior grupo encontrado (no máximo `limite`),
+ *          ou -1 em caso de falha de alocação
+ */
+int maiorComponenteAte(const Mapa* mapa, IdCor cor, int limite) {
+    const Grafo* grafo = mapa->grafo;
+    int n = mapa->quantidade;
+    if (limite <= 0) {
+        return 0;
+    }
+    if (limite > n) {
+        limite = n;
+    }
+    if (grafo->completo) {
+        // Todos os territórios da cor formam um único grupo
+        int territorios = mapaContarPorDono(mapa, cor);
+        return (territorios < limite) ? territorios : limite;
+    }
+
+    size_t palavras = ((size_t) n + 63) / 64;
+    uint64_t* visitados = (uint64_t*) calloc(palavras ? palavras : 1, sizeof(uint64_t));
+    int32_t* fila = (int32_t*) malloc((size_t) (limite > 0 ? limite : 1) * sizeof(int32_t));
+    if (visitados == NULL || fila == NULL) {
+        free(visitados);
+        free(fila);
+        return -1;
+    }
+
+    const uint64_t* posse = mapa->posse[cor];
+    int maior = 0;
+
+    for (size_t w = 0; w < palavras && maior < limite; w++) {
+        // Territórios da cor nesta palavra ainda não visitados
+        uint64_t candidatos;
+        if (posse != NULL) {
+            candidatos = posse[w];
+        } else {
+            candidatos = 0;
+            for (int b = 0; b < 64 && w * 64 + b < (size_t) n; b++) {
+                candidatos |= (uint64_t) (mapa->donos[w * 64 + b] == cor) << b;
+            }
+        }
+        candidatos &= ~visitados[w];
+
+        while (candidatos != 0 && maior < limite) {
+            int origem = (int) (w * 64 + __builtin_ctzll(candidatos));
+            candidatos &= candidatos - 1;
+            if (visitados[origem >> 6] & (1ULL << (origem & 63))) {
+                continue;
+            }
+
+            // Busca em largura restrita à cor, até `limite` territórios
+            int cabeca = 0, cauda = 0;
+            fila[cauda++] = origem;
+            visitados[origem >> 6] |= 1ULL << (origem & 63);
+            while (cabeca < cauda && cauda < limite) {
+                int v = fila[cabeca++];
+                for (int32_t k = grafo->inicio[v]; k < grafo->inicio[v + 1] && cauda < limite; k++) {
+                    int u = grafo->vizinhos[k];
+                    if (mapa->donos[u] == cor && !(visitados[u >> 6] & (1ULL << (u & 63)))) {
+                        visitados[u >> 6] |= 1ULL << (u & 63);
+                        fila[cauda++] = u;
+                    }
+                }
+            }
+            if (cauda > maior) {
+                maior = cauda;
+            }
+            candidatos &= ~visitados[w];
+        }
+    }
+
+    free(visitados);
+    free(fila);
+    return maior;
+}
+
+/*
+ * Função: mapaConectados
+ * 
+ * Verifica se uma cor ocupa `quantidade` territórios conectados entre si
+ * pelas fronteiras do mapa.
+ * 
+ * Retorno: 1 se encontrou o grupo, 0 caso contrário
+ */
+int mapaConectados(const Mapa* mapa, IdCor cor, int quantidade) {
+    return maiorComponenteAte(mapa, cor, quantidade) >= quantidade;
+}
@@ -0,0 +1,63 @@
+/*
+ * Grafo de adjacência entre territórios
+ * 
+ * Fronteiras guardadas em formato CSR (compressed sparse row): os
+ * vizinhos do território v ficam, ordenados, em
+ * vizinhos[inicio[v] .. inicio[v + 1] - 1]. O grafo completo (mapas
+ * sem fronteiras declaradas) não tem vetores: grafoGrau e grafoVizinho
+ * percorrem os dois formatos. As consultas de conexão por cor usam os
+ * conjuntos de bits de posse do Mapa (mapaAtivarPosse).
+ */
+
+#ifndef WAR_GRAFO_H
+#define WAR_GRAFO_H
+
+#include <stdint.h>
+#include "mapa.h"
+
+/*
+ * Struct Grafo
+ * 
+ * Grafo não dirigido: cada fronteira aparece nas listas dos dois lados.
+ */
+struct Grafo {
+    int numVertices;     // Territórios
+    int numEntradas;     // Tamanho de vizinhos (2x o número de fronteiras; 0 se completo)
+    int32_t* inicio;     // numVertices + 1 posições (NULL se completo)
+    int32_t* vizinhos;   // Listas de vizinhos concatenadas e ordenadas (NULL se completo)
+    int linear;          // 1 se cada território só faz fronteira com i-1 e i+1
+    int completo;        // 1 se todos fazem fronteira com todos (nenhuma fronteira declarada)
+    int externo;         // 1 se os vetores pertencem a um snapshot mapeado
+};
+
+int grafoCriarLinear(Grafo* grafo, int numVertices);
+int grafoCriarCompleto(Grafo* grafo, int numVertices);
+int grafoCriarDeArestas(Grafo* grafo, int numVertices, const int32_t (*arestas)[2], long numArestas);
+void grafoLiberar(Grafo* grafo);
+int grafoAdjacentes(const Grafo* grafo, int a, int b);
+
+/*
+ * Função: grafoGrau
+ * 
+ * Retorno: quantidade de vizinhos do território v
+ */
+static inline int grafoGrau(const Grafo* grafo, int v) {
+    return grafo->completo ? grafo->numVertices - 1 : grafo->inicio[v + 1] - grafo->inicio[v];
+}
+
+/*
+ * Função: grafoVizinho
+ * 
+ * Retorno: k-ésimo vizinho (0 <= k < grafoGrau) do território v, em ordem crescente
+ */
+static inline int grafoVizinho(const Grafo* grafo, int v, int k) {
+    if (grafo->completo) {
+        return (k < v) ? k : k + 1;
+    }
+    return grafo->vizinhos[grafo->inicio[v] + k];
+}
+
+int maiorComponenteAte(const Mapa* mapa, IdCor cor, int limite);
+int mapaConectados(const Mapa* mapa, IdCor cor, int quantidade);
+
+#endif
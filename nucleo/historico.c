@@ -0,0 +1,301 @@
+/*
+ * Histórico de versões do mapa: desfazer, refazer e ramos "e se?"
+ * 
+ * O diário guarda o estado anterior de cada alteração, e a pilha de
+ * refazer o estado que cada alteração desfeita tinha deixado. As duas
+ * são divididas em jogadas por vetores de marcas (início de cada jogada).
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "historico.h"
+
+/*
+ * Struct Historico
+ * 
+ * Diário, pilha de refazer e lista de alterados de um mapa.
+ */
+struct Historico {
+    Alteracao* diario;
+    long numDiario, capDiario;
+    long* jogadas;               // Início de cada jogada no diário
+    int numJogadas, capJogadas;
+
+    Alteracao* refazer;          // Estado desfeito, em ordem inversa
+    long numRefazer, capRefazer;
+    long* jogadasRefazer;
+    int numJogadasRefazer, capJogadasRefazer;
+
+    int gravando;                // 0 enquanto o diário está sendo desfeito
+    long long versao;            // Alterações já feitas no mapa
+    long long baseAlterados;     // Versão de alterados[0]
+    int32_t* alterados;
+    long numAlterados;
+};
+
+/*
+ * Função: historicoCriar
+ * 
+ * Retorno: histórico vazio, ou NULL em caso de falha de alocação. Para
+ *          ativá-lo, atribua-o a mapa->historico (o mapa passa a ser o dono).
+ */
+Historico* historicoCriar(void) {
+    Historico* hist = (Historico*) calloc(1, sizeof(Historico));
+    if (hist == NULL) {
+        return NULL;
+    }
+    hist->alterados = (int32_t*) malloc(sizeof(int32_t) * LIMITE_ALTERADOS);
+    if (hist->alterados == NULL) {
+        free(hist);
+        return NULL;
+    }
+    hist->gravando = 1;
+    return hist;
+}
+
+/*
+ * Função: historicoDestruir
+ * 
+ * Libera o histórico (NULL é aceito).
+ */
+void historicoDestruir(Historico* hist) {
+    if (hist == NULL) {
+        return;
+    }
+    free(hist->diario);
+    free(hist->jogadas);
+    free(hist->refazer);
+    free(hist->jogadasRefazer);
+    free(hist->alterados);
+    free(hist);
+}
+
+// Garante espaço para mais um elemento em um vetor que cresce em dobro
+static int crescer(void** vetor, long quantidade, long* capacidade, size_t tamanho) {
+    if (quantidade < *capacidade) {
+        return 1;
+    }
+    long nova = (*capacidade > 0) ? *capacidade * 2 : 256;
+    void* maior = realloc(*vetor, (size_t) nova * tamanho);
+    if (maior == NULL) {
+        return 0;
+    }
+    *vetor = maior;
+    *capacidade = nova;
+    return 1;
+}
+
+static int empilharMarca(long** marcas, int* quantidade, int* capacidade, long valor) {
+    long cap = *capacidade;
+    if (!crescer((void**) marcas, *quantidade, &cap, sizeof(long))) {
+        return 0;
+    }
+    *capacidade = (int) cap;
+    (*marcas)[(*quantidade)++] = valor;
+    return 1;
+}
+
+// Sem memória, o histórico é esquecido inteiro: nunca se desfaz uma jogada pela metade
+static void esquecer(Historico* hist) {
+    hist->numDiario = 0;
+    hist->numJogadas = 0;
+    hist->numRefazer = 0;
+    hist->numJogadasRefazer = 0;
+}
+
+/*
+ * Função: historicoAnotar
+ * 
+ * Gancho de mapaDefinirDono e mapaDefinirTropas, chamado antes da
+ * alteração: guarda o estado atual do território no diário (se houver
+ * jogada aberta) e o índice na lista de alterados.
+ */
+void historicoAnotar(Historico* hist, const Mapa* mapa, int indice) {
+    hist->versao++;
+    if (hist->numAlterados == LIMITE_ALTERADOS) {
+        // Cópias mais antigas que isto precisam de uma cópia completa
+        hist->baseAlterados += hist->numAlterados;
+        hist->numAlterados = 0;
+    }
+    hist->alterados[hist->numAlterados++] = indice;
+
+    if (!hist->gravando || hist->numJogadas == 0) {
+        return;
+    }
+    if (!crescer((void**) &hist->diario, hist->numDiario, &hist->capDiario, sizeof(Alteracao))) {
+        esquecer(hist);
+        return;
+    }
+    Alteracao* a = &hist->diario[hist->numDiario++];
+    a->indice = indice;
+    a->tropas = mapa->tropas[indice];
+    a->dono = mapa->donos[indice];
+}
+
+/*
+ * Função: historicoIniciarJogada
+ * 
+ * Abre uma jogada nova: as alterações seguintes serão desfeitas juntas.
+ * Uma jogada nova descarta o que podia ser refeito.
+ */
+void historicoIniciarJogada(Historico* hist) {
+    hist->numRefazer = 0;
+    hist->numJogadasRefazer = 0;
+    if (!empilharMarca(&hist->jogadas, &hist->numJogadas, &hist->capJogadas, hist->numDiario)) {
+        esquecer(hist);
+    }
+}
+
+/*
+ * Função: historicoJogadas
+ * 
+ * Retorno: jogadas que ainda podem ser desfeitas
+ */
+int historicoJogadas(const Historico* hist) {
+    return hist->numJogadas;
+}
+
+/*
+ * Função: historicoRefazerDisponiveis
+ * 
+ * Retorno: jogadas desfeitas que ainda podem ser refeitas
+ */
+int historicoRefazerDisponiveis(const Historico* hist) {
+    return hist->numJogadasRefazer;
+}
+
+// Tropas antes do dono, para que as estatísticas movam as tropas certas
+static void restaurar(Mapa* mapa, const Alteracao* a) {
+    mapaDefinirTropas(mapa, a->indice, a->tropas);
+    mapaDefinirDono(mapa, a->indice, a->dono);
+}
+
+// Desfaz o diário até `inicio`, guardando o estado desfeito se `guardar` for 1
+static void desfazerAte(Historico* hist, Mapa* mapa, long inicio, int guardar) {
+    hist->gravando = 0;
+    for (long k = hist->numDiario - 1; k >= inicio; k--) {
+        const Alteracao* a = &hist->diario[k];
+        if (guardar) {
+            if (crescer((void**) &hist->refazer, hist->numRefazer, &hist->capRefazer,
+                        sizeof(Alteracao))) {
+                Alteracao* r = &hist->refazer[hist->numRefazer++];
+                r->indice = a->indice;
+                r->tropas = mapa->tropas[a->indice];
+                r->dono = mapa->donos[a->indice];
+            } else {
+                // Sem memória para refazer: a jogada só pode ser desfeita
+                guardar = 0;
+                hist->numRefazer = 0;
+                hist->numJogadasRefazer = 0;
+            }
+        }
+        restaurar(mapa, a);
+    }
+    hist->numDiario = inicio;
+    hist->gravando = 1;
+}
+
+/*
+ * Função: historicoDesfazer
+ * 
+ * Desfaz a última jogada, que passa a poder ser refeita.
+ * 
+ * Retorno: 1 se uma jogada foi desfeita, 0 se não havia o que desfazer
+ */
+int historicoDesfazer(Historico* hist, Mapa* mapa) {
+    if (hist->numJogadas == 0) {
+        return 0;
+    }
+    long inicio = hist->jogadas[--hist->numJogadas];
+    int guardar = empilharMarca(&hist->jogadasRefazer, &hist->numJogadasRefazer,
+                                &hist->capJogadasRefazer, hist->numRefazer);
+    desfazerAte(hist, mapa, inicio, guardar);
+    return 1;
+}
+
+/*
+ * Função: historicoRefazer
+ * 
+ * Refaz a última jogada desfeita, que volta ao diário.
+ * 
+ * Retorno: 1 se uma jogada foi refeita, 0 se não havia o que refazer
+ */
+int historicoRefazer(Historico* hist, Mapa* mapa) {
+    if (hist->numJogadasRefazer == 0) {
+        return 0;
+    }
+    long inicio = hist->jogadasRefazer[--hist->numJogadasRefazer];
+    if (!empilharMarca(&hist->jogadas, &hist->numJogadas, &hist->capJogadas, hist->numDiario)) {
+        esquecer(hist);
+    }
+    // A pilha guarda a jogada de trás para frente: o topo é a primeira alteração
+    for (long k = hist->numRefazer - 1; k >= inicio; k--) {
+        restaurar(mapa, &hist->refazer[k]);
+    }
+    hist->numRefazer = inicio;
+    return 1;
+}
+
+/*
+ * Função: historicoPonto
+ * 
+ * Retorno: o estado atual do histórico, para voltar a ele com historicoVoltar
+ */
+PontoHistorico historicoPonto(const Historico* hist) {
+    PontoHistorico ponto = {hist->numDiario, hist->numJogadas};
+    return ponto;
+}
+
+/*
+ * Função: historicoVoltar
+ * 
+ * Descarta um ramo "e se?": desfaz todas as jogadas feitas depois do
+ * ponto, sem guardá-las para refazer.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 se o ramo não pode mais ser desfeito
+ *          (jogadas desfeitas além do ponto ou histórico esquecido)
+ */
+int historicoVoltar(Historico* hist, Mapa* mapa, PontoHistorico ponto) {
+    if (hist->numJogadas < ponto.jogadas || hist->numDiario < ponto.diario ||
+        (ponto.jogadas > 0 && hist->jogadas[ponto.jogadas - 1] > ponto.diario)) {
+        return 0;
+    }
+    desfazerAte(hist, mapa, ponto.diario, 0);
+    hist->numJogadas = ponto.jogadas;
+    hist->numRefazer = 0;
+    hist->numJogadasRefazer = 0;
+    return 1;
+}
+
+/*
+ * Função: historicoVersao
+ * 
+ * Retorno: número de alterações feitas no mapa desde que o histórico foi
+ *          anexado (cresce também ao desfazer e refazer)
+ */
+long long historicoVersao(const Historico* hist) {
+    return hist->versao;
+}
+
+/*
+ * Função: historicoAlteradosDesde
+ * 
+ * Lista os territórios alterados depois da versão `versao` (com
+ * repetições, na ordem das alterações).
+ * 
+ * Parâmetros:
+ *   hist - histórico do mapa
+ *   versao - versão obtida antes com historicoVersao
+ *   indices - recebe o início da lista (válida até a próxima alteração)
+ * 
+ * Retorno: tamanho da lista, ou -1 se ela já foi descartada (a cópia
+ *          precisa ser refeita por inteiro)
+ */
+long historicoAlteradosDesde(const Historico* hist, long long versao, const int32_t** indices) {
+    if (versao < hist->baseAlterados || versao > hist->versao) {
+        return -1;
+    }
+    long inicio = (long) (versao - hist->baseAlterados);
+    *indices = hist->alterados + inicio;
+    return hist->numAlterados - inicio;
+}
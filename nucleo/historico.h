@@ -0,0 +1,60 @@
+/*
+ * Histórico de versões do mapa: desfazer, refazer e ramos "e se?"
+ * 
+ * Em vez de copiar o mapa a cada versão, o histórico guarda um diário
+ * das alterações: antes de mudar um território, mapaDefinirDono e
+ * mapaDefinirTropas anotam o dono e as tropas anteriores dele. Uma
+ * jogada é o trecho do diário entre duas marcas, então desfazer, refazer
+ * ou abrir e descartar um ramo custa O(territórios alterados), mesmo em
+ * um mapa de milhões de territórios.
+ * 
+ * Além do diário, o histórico numera todas as alterações (inclusive as
+ * feitas ao desfazer e refazer) e guarda os índices das mais recentes.
+ * Cópias do mapa, como as da busca dos jogadores do computador, usam
+ * essa lista para se atualizar só nos territórios que mudaram.
+ */
+
+#ifndef WAR_HISTORICO_H
+#define WAR_HISTORICO_H
+
+#include <stdint.h>
+#include "mapa.h"
+
+// Índices de alterações recentes guardados para as cópias do mapa
+#define LIMITE_ALTERADOS (1 << 20)
+
+/*
+ * Struct Alteracao
+ * 
+ * Estado de um território antes (no diário) ou depois (na pilha de
+ * refazer) de uma alteração.
+ */
+typedef struct {
+    int32_t indice;
+    int32_t tropas;
+    IdCor dono;
+} Alteracao;
+
+/*
+ * Struct PontoHistorico
+ * 
+ * Início de um ramo "e se?", devolvido por historicoPonto.
+ */
+typedef struct {
+    long diario;   // Alterações no diário quando o ramo foi aberto
+    int jogadas;   // Jogadas no diário quando o ramo foi aberto
+} PontoHistorico;
+
+Historico* historicoCriar(void);
+void historicoDestruir(Historico* hist);
+void historicoIniciarJogada(Historico* hist);
+int historicoJogadas(const Historico* hist);
+int historicoRefazerDisponiveis(const Historico* hist);
+int historicoDesfazer(Historico* hist, Mapa* mapa);
+int historicoRefazer(Historico* hist, Mapa* mapa);
+PontoHistorico historicoPonto(const Historico* hist);
+int historicoVoltar(Historico* hist, Mapa* mapa, PontoHistorico ponto);
+long long historicoVersao(const Historico* hist);
+long historicoAlteradosDesde(const Historico* hist, long long versao, const int32_t** indices);
+
+#endif
@@ -0,0 +1,744 @@
+/*
+ * Jogadores controlados pelo computador
+ * 
+ * Expectimax com aprofundamento iterativo, paralelo na raiz, sobre cópias
+ * do mapa por trabalhador e com tabela de transposição compartilhada.
+ */
+
+#include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "batalha.h"
+#include "estatisticas.h"
+#include "grafo.h"
+#include "historico.h"
+#include "ia.h"
+#include "missao.h"
+#include "perfil.h"
+#include "tabela.h"
+
+// Chance de conquista de um ataque na regra simples (dado do atacante maior que o do defensor)
+#define CHANCE_CONQUISTA (15.0 / 36.0)
+
+// Ataques considerados na raiz e em cada nó interno da busca
+#define CANDIDATOS_RAIZ 32
+#define CANDIDATOS_INTERNOS 8
+
+// Ataques seguidos considerados pela busca, no máximo
+#define PROFUNDIDADE_MAXIMA 16
+
+// Valor de uma posição em que a missão está cumprida
+#define VALOR_VITORIA 1.0
+
+// Posições visitadas entre duas consultas ao relógio
+#define NOS_POR_CONSULTA 256
+
+/*
+ * Struct EntradaTransposicao
+ * 
+ * Entrada sem trava: `verificacao` guarda chave ^ dados, de modo que uma
+ * escrita concorrente pela metade é detectada na leitura e ignorada.
+ */
+typedef struct {
+    _Atomic uint64_t verificacao;
+    _Atomic uint64_t dados;     // Bits do valor (float) | profundidade << 32
+} EntradaTransposicao;
+
+typedef struct {
+    int32_t atacante;
+    int32_t defensor;
+} Movimento;
+
+/*
+ * Struct Trabalhador
+ * 
+ * Cópia do mapa e contadores exclusivos de uma thread.
+ */
+typedef struct {
+    Mapa copia;          // Donos e tropas, com estatísticas e posse anexadas
+    uint64_t hash;       // Hash Zobrist da cópia
+    long long nos;
+} __attribute__((aligned(64))) Trabalhador;
+
+struct IA {
+    Pool* pool;
+    int numTrabalhadores;
+    Trabalhador* trabalhadores;
+    EntradaTransposicao* tabela;
+    size_t mascara;
+    const Mapa* origem;          // Mapa copiado pela última sincronização
+    long long versao;            // Versão do histórico da origem nessa cópia
+    int sincronizada;            // 1 se as cópias refletem origem na versão acima
+    DistribuicaoPerdas perdas;   // Perdas do defensor por rolagem na regra clássica
+};
+
+/*
+ * Struct Busca
+ * 
+ * Dados de uma escolha de ataque, compartilhados pelos trabalhadores.
+ */
+typedef struct {
+    IA* ia;
+    const Missao* missao;
+    IdCor cor;
+    RegraBatalha regra;        // Regra com que os ataques serão resolvidos na partida
+    uint64_t sal;              // Distingue cor, missão e regra na tabela de transposição
+    int profundidade;          // Profundidade da iteração atual
+    Movimento raiz[CANDIDATOS_RAIZ];
+    int numRaiz;
+    double valores[CANDIDATOS_RAIZ];
+    double prazo;              // Instante limite (relógio monotônico)
+    atomic_int abortar;
+} Busca;
+
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t misturar(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Chave Zobrist do território `i` ocupado por `dono` com `tropas`
+static uint64_t chaveTerritorio(int i, IdCor dono, int32_t tropas) {
+    return misturar(misturar((uint64_t) i) ^ ((uint64_t) dono << 40) ^ (uint32_t) tropas);
+}
+
+/*
+ * Função: iaCriar
+ * 
+ * Cria o estado persistente dos jogadores do computador: uma cópia do
+ * mapa por trabalhador e a tabela de transposição.
+ * 
+ * Parâmetros:
+ *   pool - pool usado na busca (NULL: busca em uma única thread)
+ *   entradasTabela - tamanho da tabela de transposição (arredondado para
+ *                    baixo até uma potência de 2)
+ * 
+ * Retorno: ponteiro para a IA, ou NULL em caso de falha de alocação
+ */
+IA* iaCriar(Pool* pool, size_t entradasTabela) {
+    IA* ia = (IA*) calloc(1, sizeof(IA));
+    if (ia == NULL) {
+        return NULL;
+    }
+    ia->pool = pool;
+    ia->numTrabalhadores = (pool != NULL) ? poolTamanho(pool) : 1;
+
+    size_t entradas = 1;
+    while (entradas * 2 <= entradasTabela) {
+        entradas *= 2;
+    }
+    ia->mascara = entradas - 1;
+    ia->tabela = (EntradaTransposicao*) calloc(entradas, sizeof(EntradaTransposicao));
+    ia->trabalhadores = (Trabalhador*) aligned_alloc(64, sizeof(Trabalhador) * ia->numTrabalhadores);
+    if (ia->tabela == NULL || ia->trabalhadores == NULL) {
+        free(ia->tabela);
+        free(ia->trabalhadores);
+        free(ia);
+        return NULL;
+    }
+    for (int t = 0; t < ia->numTrabalhadores; t++) {
+        memset(&ia->trabalhadores[t], 0, sizeof(Trabalhador));
+        mapaIniciar(&ia->trabalhadores[t].copia, 0);
+    }
+    tabelaDistribuicaoPerdas(ia->perdas);
+    return ia;
+}
+
+/*
+ * Função: iaDestruir
+ * 
+ * Libera a IA e as cópias do mapa.
+ */
+void iaDestruir(IA* ia) {
+    if (ia == NULL) {
+        return;
+    }
+    for (int t = 0; t < ia->numTrabalhadores; t++) {
+        mapaLiberar(&ia->trabalhadores[t].copia);
+    }
+    free(ia->trabalhadores);
+    free(ia->tabela);
+    free(ia);
+}
+
+/*
+ * Função: iaAvaliar
+ * 
+ * Pontua uma posição para a cor: VALOR_VITORIA se a missão estiver
+ * cumprida; senão, o progresso na missão (peso 0.85) mais a fração de
+ * territórios (0.10) e de tropas (0.05) da cor, sempre abaixo de 1.
+ * 
+ * Retorno: valor entre 0 e VALOR_VITORIA
+ */
+double iaAvaliar(const Mapa* mapa, const Missao* missao, IdCor cor) {
+    if (mapa->quantidade == 0) {
+        return 0.0;
+    }
+    if (verificarMissao(missao, mapa, cor)) {
+        return VALOR_VITORIA;
+    }
+
+    int territorios = contarTerritoriosDaCor(mapa, cor);
+    long long tropas = somarTropasDaCor(mapa, cor);
+    long long tropasTotais = 0;
+    for (int c = 0; c < mapa->numCores; c++) {
+        tropasTotais += somarTropasDaCor(mapa, (IdCor) c);
+    }
+
+    double alvo = (missao->parametro > 0) ? missao->parametro : 1;
+    double progresso;
+    switch (missao->tipo) {
+        case MISSAO_CONSECUTIVOS:
+            if (mapa->grafo != NULL && !mapa->grafo->linear && !mapa->grafo->completo) {
+                progresso = maiorComponenteAte(mapa, cor, missao->parametro) / alvo;
+            } else {
+                progresso = maiorSequenciaDaCor(mapa, cor) / alvo;
+            }
+            break;
+        case MISSAO_TERRITORIOS:
+            progresso = territorios / alvo;
+            break;
+        case MISSAO_PERCENTUAL: {
+            long long necessario = (long long) mapa->quantidade * missao->parametro / 100;
+            progresso = (necessario > 0) ? (double) territorios / necessario : 1.0;
+            break;
+        }
+        case MISSAO_TROPAS:
+            progresso = tropas / alvo;
+            break;
+        default:
+            progresso = (double) territorios / mapa->quantidade;
+            break;
+    }
+    if (progresso > 0.99) {
+        progresso = 0.99;
+    }
+
+    double parteTropas = (tropasTotais > 0) ? (double) tropas / tropasTotais : 0.0;
+    return 0.85 * progresso + 0.10 * territorios / mapa->quantidade + 0.05 * parteTropas;
+}
+
+/* ---- Tabela de transposição ---- */
+
+static int consultarTabela(const IA* ia, uint64_t chave, int profundidade, double* valor) {
+    EntradaTransposicao* e = &ia->tabela[chave & ia->mascara];
+    uint64_t dados = atomic_load_explicit(&e->dados, memory_order_relaxed);
+    uint64_t verificacao = atomic_load_explicit(&e->verificacao, memory_order_relaxed);
+    if ((verificacao ^ dados) != chave || (int) (dados >> 32) < profundidade) {
+        return 0;
+    }
+    uint32_t bits = (uint32_t) dados;
+    float v;
+    memcpy(&v, &bits, sizeof(v));
+    *valor = v;
+    return 1;
+}
+
+static void gravarTabela(IA* ia, uint64_t chave, int profundidade, double valor) {
+    EntradaTransposicao* e = &ia->tabela[chave & ia->mascara];
+    float v = (float) valor;
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    uint64_t dados = bits | ((uint64_t) profundidade << 32);
+    atomic_store_explicit(&e->verificacao, chave ^ dados, memory_order_relaxed);
+    atomic_store_explicit(&e->dados, dados, memory_order_relaxed);
+}
+
+/* ---- Geração de ataques ---- */
+
+// Tropas limitadas a 10 bits, para compor as chaves de ordenação
+static int tropasChave(int32_t tropas) {
+    return (tropas < 1023) ? tropas : 1023;
+}
+
+/*
+ * Função: chaveMovimento
+ * 
+ * Chave de ordenação: vizinhos já da cor (junta grupos) e tropas do
+ * atacante. No grafo completo todos os territórios da cor são vizinhos
+ * do defensor, então a chave passa a ser as tropas do atacante e, no
+ * empate, o defensor mais fraco.
+ */
+static int chaveMovimento(const Mapa* mapa, IdCor cor, int atacante, int defensor) {
+    const Grafo* grafo = mapa->grafo;
+    if (grafo->completo) {
+        return tropasChave(mapa->tropas[atacante]) * 1024 +
+               1023 - tropasChave(mapa->tropas[defensor]);
+    }
+    int proprios = 0;
+    for (int32_t k = grafo->inicio[defensor]; k < grafo->inicio[defensor + 1]; k++) {
+        proprios += (mapa->donos[grafo->vizinhos[k]] == cor);
+    }
+    return proprios * 1024 + tropasChave(mapa->tropas[atacante]);
+}
+
+// Insere o ataque na lista (ordenada por chave decrescente) se estiver entre os `maximo` melhores
+static void inserirCandidato(Movimento* lista, int* chaves, int* total, int maximo,
+                             int atacante, int defensor, int chave) {
+    int pos = *total;
+    if (pos == maximo) {
+        if (chave <= chaves[maximo - 1]) {
+            return;
+        }
+        pos--;
+    } else {
+        (*total)++;
+    }
+    while (pos > 0 && chaves[pos - 1] < chave) {
+        lista[pos] = lista[pos - 1];
+        chaves[pos] = chaves[pos - 1];
+        pos--;
+    }
+    lista[pos].atacante = atacante;
+    lista[pos].defensor = defensor;
+    chaves[pos] = chave;
+}
+
+static void candidatosDe(const Mapa* mapa, IdCor cor, int atacante,
+                         Movimento* lista, int* chaves, int* total, int maximo) {
+    const Grafo* grafo = mapa->grafo;
+    if (mapa->tropas[atacante] < 2) {
+        return;
+    }
+    for (int32_t k = grafo->inicio[atacante]; k < grafo->inicio[atacante + 1]; k++) {
+        int defensor = grafo->vizinhos[k];
+        if (mapa->donos[defensor] != cor) {
+            inserirCandidato(lista, chaves, total, maximo, atacante, defensor,
+                             chaveMovimento(mapa, cor, atacante, defensor));
+        }
+    }
+}
+
+/*
+ * Função: gerarRaizCompleto
+ * 
+ * Raiz no grafo completo: em vez dos n * (n - 1) pares, cruza os
+ * CANDIDATOS_INTERNOS territórios mais fortes da cor com os
+ * CANDIDATOS_INTERNOS inimigos mais fracos, em uma varredura do mapa.
+ */
+static int gerarRaizCompleto(const Mapa* mapa, IdCor cor, Movimento* lista) {
+    Movimento fortes[CANDIDATOS_INTERNOS], fracos[CANDIDATOS_INTERNOS];
+    int chavesFortes[CANDIDATOS_INTERNOS], chavesFracos[CANDIDATOS_INTERNOS];
+    int numFortes = 0, numFracos = 0;
+    for (int i = 0; i < mapa->quantidade; i++) {
+        if (mapa->donos[i] == cor) {
+            if (mapa->tropas[i] >= 2) {
+                inserirCandidato(fortes, chavesFortes, &numFortes, CANDIDATOS_INTERNOS, i, -1,
+                                 tropasChave(mapa->tropas[i]));
+            }
+        } else {
+            inserirCandidato(fracos, chavesFracos, &numFracos, CANDIDATOS_INTERNOS, -1, i,
+                             1023 - tropasChave(mapa->tropas[i]));
+        }
+    }
+
+    int chaves[CANDIDATOS_RAIZ];
+    int total = 0;
+    for (int a = 0; a < numFortes; a++) {
+        for (int d = 0; d < numFracos; d++) {
+            inserirCandidato(lista, chaves, &total, CANDIDATOS_RAIZ, fortes[a].atacante,
+                             fracos[d].defensor,
+                             chaveMovimento(mapa, cor, fortes[a].atacante, fracos[d].defensor));
+        }
+    }
+    return total;
+}
+
+/*
+ * Função: gerarRaiz
+ * 
+ * Os melhores ataques possíveis da cor, percorrendo os territórios dela
+ * pelo conjunto de bits de posse.
+ */
+static int gerarRaiz(const Mapa* mapa, IdCor cor, Movimento* lista) {
+    if (mapa->grafo->completo) {
+        return gerarRaizCompleto(mapa, cor, lista);
+    }
+    int chaves[CANDIDATOS_RAIZ];
+    int total = 0;
+    const uint64_t* posse = mapa->posse[cor];
+    size_t palavras = ((size_t) mapa->quantidade + 63) / 64;
+    for (size_t w = 0; w < palavras; w++) {
+        uint64_t bits = posse[w];
+        while (bits != 0) {
+            int atacante = (int) (w * 64 + __builtin_ctzll(bits));
+            bits &= bits - 1;
+            candidatosDe(mapa, cor, atacante, lista, chaves, &total, CANDIDATOS_RAIZ);
+        }
+    }
+    return total;
+}
+
+/*
+ * Função: gerarInternos
+ * 
+ * Nos nós internos, em vez de varrer o mapa: os ataques da raiz que
+ * continuam válidos mais os que partem do território recém-conquistado
+ * (no grafo completo, contra os defensores da raiz, não contra o mapa
+ * inteiro).
+ */
+static int gerarInternos(const Busca* busca, const Mapa* mapa, int conquistado, Movimento* lista) {
+    int chaves[CANDIDATOS_INTERNOS];
+    int total = 0;
+    for (int i = 0; i < busca->numRaiz; i++) {
+        const Movimento* m = &busca->raiz[i];
+        if (mapa->tropas[m->atacante] >= 2 && mapa->donos[m->defensor] != busca->cor) {
+            inserirCandidato(lista, chaves, &total, CANDIDATOS_INTERNOS, m->atacante, m->defensor,
+                             chaveMovimento(mapa, busca->cor, m->atacante, m->defensor));
+        }
+    }
+    if (conquistado >= 0 && mapa->grafo->completo) {
+        for (int i = 0; i < busca->numRaiz && mapa->tropas[conquistado] >= 2; i++) {
+            int defensor = busca->raiz[i].defensor;
+            if (mapa->donos[defensor] != busca->cor) {
+                inserirCandidato(lista, chaves, &total, CANDIDATOS_INTERNOS, conquistado, defensor,
+                                 chaveMovimento(mapa, busca->cor, conquistado, defensor));
+            }
+        }
+    } else if (conquistado >= 0) {
+        candidatosDe(mapa, busca->cor, conquistado, lista, chaves, &total, CANDIDATOS_INTERNOS);
+    }
+    return total;
+}
+
+/* ---- Busca ---- */
+
+typedef struct {
+    int32_t tropasAtacante;
+    int32_t tropasDefensor;
+    IdCor donoDefensor;
+    uint64_t hash;
+} Desfazer;
+
+// Um resultado possível de um ataque e a sua probabilidade
+typedef struct {
+    double chance;
+    ResultadoAtaque resultado;
+} Desfecho;
+
+/*
+ * Função: desfechos
+ * 
+ * Resultados possíveis de um ataque na regra da busca. Na regra simples
+ * são dois (conquista com 15/36, perda de uma tropa com 21/36); na
+ * clássica, um por quantidade de tropas perdidas pelo defensor, com as
+ * chances de tabelaDistribuicaoPerdas. Cada desfecho é resolvido pelas
+ * próprias regras do jogo com uma rolagem que o produz: pares vencidos
+ * pelo atacante com 6 contra 5, os demais com 1 contra 1.
+ * 
+ * Retorno: quantidade de desfechos gravados em `lista` (até MAX_DADOS + 1)
+ */
+static int desfechos(const Busca* busca, int32_t tropasAtacante, int32_t tropasDefensor,
+                     Desfecho* lista) {
+    if (busca->regra != REGRA_CLASSICA) {
+        lista[0].chance = CHANCE_CONQUISTA;
+        aplicarRegraAtaque(tropasAtacante, tropasDefensor, 2, 1, &lista[0].resultado);
+        lista[1].chance = 1.0 - CHANCE_CONQUISTA;
+        aplicarRegraAtaque(tropasAtacante, tropasDefensor, 1, 1, &lista[1].resultado);
+        return 2;
+    }
+
+    int nA = dadosDoAtacante(REGRA_CLASSICA, tropasAtacante);
+    int nD = dadosDoDefensor(REGRA_CLASSICA, tropasDefensor);
+    int pares = (nA < nD) ? nA : nD;
+    int total = 0;
+    for (int perdas = 0; perdas <= pares; perdas++) {
+        double chance = busca->ia->perdas[nA][nD][perdas];
+        if (chance <= 0.0) {
+            continue;
+        }
+        uint8_t dadosA[MAX_DADOS], dadosD[MAX_DADOS];
+        for (int k = 0; k < MAX_DADOS; k++) {
+            dadosA[k] = (k < perdas) ? 6 : 1;
+            dadosD[k] = (k < perdas) ? 5 : 1;
+        }
+        lista[total].chance = chance;
+        aplicarRegraClassica(tropasAtacante, tropasDefensor, dadosA, nA, dadosD, nD,
+                             &lista[total].resultado);
+        total++;
+    }
+    return total;
+}
+
+// Aplica um dos resultados do ataque na cópia do trabalhador
+static void aplicar(Trabalhador* t, Movimento m, const ResultadoAtaque* r, Desfazer* d) {
+    Mapa* copia = &t->copia;
+    int a = m.atacante, def = m.defensor;
+    IdCor donoA = copia->donos[a];
+
+    d->tropasAtacante = copia->tropas[a];
+    d->tropasDefensor = copia->tropas[def];
+    d->donoDefensor = copia->donos[def];
+    d->hash = t->hash;
+
+    IdCor novoDono = r->conquista ? donoA : d->donoDefensor;
+    t->hash ^= chaveTerritorio(a, donoA, d->tropasAtacante) ^
+               chaveTerritorio(a, donoA, r->tropasAtacante) ^
+               chaveTerritorio(def, d->donoDefensor, d->tropasDefensor) ^
+               chaveTerritorio(def, novoDono, r->tropasDefensor);
+
+    if (r->conquista) {
+        mapaDefinirDono(copia, def, donoA);
+    }
+    mapaDefinirTropas(copia, a, r->tropasAtacante);
+    mapaDefinirTropas(copia, def, r->tropasDefensor);
+}
+
+// Desfaz na ordem inversa (tropas antes do dono, para as estatísticas)
+static void desfazer(Trabalhador* t, Movimento m, const Desfazer* d) {
+    Mapa* copia = &t->copia;
+    mapaDefinirTropas(copia, m.defensor, d->tropasDefensor);
+    mapaDefinirTropas(copia, m.atacante, d->tropasAtacante);
+    mapaDefinirDono(copia, m.defensor, d->donoDefensor);
+    t->hash = d->hash;
+}
+
+static double expectimax(Busca* busca, Trabalhador* t, int profundidade, int conquistado);
+
+// Valor esperado de um ataque: média dos resultados possíveis, pesada pelas chances
+static double valorAtaque(Busca* busca, Trabalhador* t, Movimento m, int profundidade) {
+    Desfecho lista[MAX_DADOS + 1];
+    int total = desfechos(busca, t->copia.tropas[m.atacante], t->copia.tropas[m.defensor], lista);
+    double valor = 0.0;
+    for (int k = 0; k < total; k++) {
+        Desfazer d;
+        aplicar(t, m, &lista[k].resultado, &d);
+        valor += lista[k].chance *
+                 expectimax(busca, t, profundidade, lista[k].resultado.conquista ? m.defensor : -1);
+        desfazer(t, m, &d);
+    }
+    return valor;
+}
+
+/*
+ * Função: expectimax
+ * 
+ * Valor da posição da cópia com até `profundidade` ataques pela frente.
+ * Parar de atacar é sempre permitido, então o valor nunca fica abaixo da
+ * avaliação estática. Vitórias mais próximas valem um pouco mais.
+ */
+static double expectimax(Busca* busca, Trabalhador* t, int profundidade, int conquistado) {
+    if ((++t->nos % NOS_POR_CONSULTA) == 0 && agora() > busca->prazo) {
+        atomic_store_explicit(&busca->abortar, 1, memory_order_relaxed);
+    }
+    if (atomic_load_explicit(&busca->abortar, memory_order_relaxed)) {
+        return 0.0;
+    }
+
+    double estatico = iaAvaliar(&t->copia, busca->missao, busca->cor);
+    if (estatico >= VALOR_VITORIA) {
+        return VALOR_VITORIA + 1e-3 * profundidade;
+    }
+    if (profundidade == 0) {
+        return estatico;
+    }
+
+    uint64_t chave = t->hash ^ busca->sal;
+    double valor;
+    if (consultarTabela(busca->ia, chave, profundidade, &valor)) {
+        return valor;
+    }
+
+    Movimento lista[CANDIDATOS_INTERNOS];
+    int total = gerarInternos(busca, &t->copia, conquistado, lista);
+    double melhor = estatico;
+    for (int i = 0; i < total; i++) {
+        double v = valorAtaque(busca, t, lista[i], profundidade - 1);
+        if (v > melhor) {
+            melhor = v;
+        }
+    }
+
+    if (!atomic_load_explicit(&busca->abortar, memory_order_relaxed)) {
+        gravarTabela(busca->ia, chave, profundidade, melhor);
+    }
+    return melhor;
+}
+
+// Tarefa do pool: valor de um ataque da raiz na profundidade da iteração
+static void tarefaRaiz(void* contexto, int tarefa, int trabalhador) {
+    Busca* busca = (Busca*) contexto;
+    Trabalhador* t = &busca->ia->trabalhadores[trabalhador];
+    busca->valores[tarefa] = valorAtaque(busca, t, busca->raiz[tarefa], busca->profundidade - 1);
+}
+
+/*
+ * Função: sincronizar
+ * 
+ * Copia o estado inteiro do mapa real para a cópia de cada trabalhador
+ * e recalcula o hash Zobrist.
+ */
+static int sincronizar(IA* ia, const Mapa* mapa) {
+    uint64_t hash = 0;
+    for (int i = 0; i < mapa->quantidade; i++) {
+        hash ^= chaveTerritorio(i, mapa->donos[i], mapa->tropas[i]);
+    }
+    ia->sincronizada = 0;
+    for (int i = 0; i < ia->numTrabalhadores; i++) {
+        Trabalhador* t = &ia->trabalhadores[i];
+        if (!mapaCopiarEstado(&t->copia, mapa) || !mapaAtivarPosse(&t->copia)) {
+            return 0;
+        }
+        if (t->copia.estatisticas == NULL) {
+            t->copia.estatisticas = estatisticasCriar(&t->copia);
+            if (t->copia.estatisticas == NULL) {
+                return 0;
+            }
+        }
+        t->hash = hash;
+    }
+    ia->origem = mapa;
+    ia->sincronizada = (mapa->historico != NULL);
+    if (ia->sincronizada) {
+        ia->versao = historicoVersao(mapa->historico);
+    }
+    return 1;
+}
+
+/*
+ * Função: sincronizarAlterados
+ * 
+ * Atualiza as cópias só nos territórios alterados desde a última
+ * sincronização, pela lista do histórico do mapa. O hash Zobrist é
+ * corrigido pelos mesmos territórios, então a jogada custa O(alterados)
+ * em vez de O(territórios).
+ * 
+ * Retorno: 1 se as cópias foram atualizadas, 0 se é preciso copiar tudo
+ */
+static int sincronizarAlterados(IA* ia, const Mapa* mapa) {
+    const Mapa* copia = &ia->trabalhadores[0].copia;
+    if (!ia->sincronizada || ia->origem != mapa || mapa->historico == NULL ||
+        copia->quantidade != mapa->quantidade || copia->numCores != mapa->numCores) {
+        return 0;
+    }
+    const int32_t* alterados;
+    long n = historicoAlteradosDesde(mapa->historico, ia->versao, &alterados);
+    if (n < 0 || n > mapa->quantidade / 4) {
+        return 0;
+    }
+
+    uint64_t hash = ia->trabalhadores[0].hash;
+    for (long k = 0; k < n; k++) {
+        int i = alterados[k];
+        IdCor dono = mapa->donos[i];
+        int32_t tropas = mapa->tropas[i];
+        if (copia->donos[i] == dono && copia->tropas[i] == tropas) {
+            continue;   // Repetido na lista ou alterado e depois desfeito
+        }
+        hash ^= chaveTerritorio(i, copia->donos[i], copia->tropas[i]) ^
+                chaveTerritorio(i, dono, tropas);
+        for (int w = 0; w < ia->numTrabalhadores; w++) {
+            mapaDefinirDono(&ia->trabalhadores[w].copia, i, dono);
+            mapaDefinirTropas(&ia->trabalhadores[w].copia, i, tropas);
+        }
+    }
+    for (int w = 0; w < ia->numTrabalhadores; w++) {
+        ia->trabalhadores[w].hash = hash;
+    }
+    ia->versao = historicoVersao(mapa->historico);
+    return 1;
+}
+
+/*
+ * Função: iaEscolherAtaque
+ * 
+ * Escolhe o ataque da cor por expectimax com aprofundamento iterativo até
+ * acabar o orçamento de tempo. A primeira profundidade sempre termina,
+ * então há uma resposta mesmo com orçamento zero.
+ * 
+ * Parâmetros:
+ *   ia - estado criado por iaCriar
+ *   mapa - mapa da partida (com grafo anexado)
+ *   missao - missão do jogador do computador
+ *   cor - cor do jogador
+ *   regra - regra de batalha da partida (define os resultados de cada ataque)
+ *   orcamentoMs - tempo máximo de busca, em milissegundos
+ *   jogada - recebe o ataque escolhido e os dados da busca
+ * 
+ * Retorno: 1 em caso de sucesso, 0 em caso de falha de alocação
+ */
+int iaEscolherAtaque(IA* ia, const Mapa* mapa, const Missao* missao, IdCor cor,
+                     RegraBatalha regra, int orcamentoMs, JogadaIA* jogada) {
+    PERFIL_ESCOPO(PERFIL_BUSCA_IA);
+    double inicio = agora();
+    memset(jogada, 0, sizeof(JogadaIA));
+    jogada->atacante = -1;
+    jogada->defensor = -1;
+
+    if (mapa->grafo == NULL || (!sincronizarAlterados(ia, mapa) && !sincronizar(ia, mapa))) {
+        return 0;
+    }
+    for (int i = 0; i < ia->numTrabalhadores; i++) {
+        ia->trabalhadores[i].copia.grafo = mapa->grafo;
+        ia->trabalhadores[i].nos = 0;
+    }
+
+    Busca* busca = (Busca*) calloc(1, sizeof(Busca));
+    if (busca == NULL) {
+        return 0;
+    }
+    busca->ia = ia;
+    busca->missao = missao;
+    busca->cor = cor;
+    busca->regra = regra;
+    busca->sal = misturar(((uint64_t) regra << 56) ^ ((uint64_t) cor << 48) ^
+                          ((uint64_t) missao->tipo << 32) ^ (uint32_t) missao->parametro);
+    atomic_init(&busca->abortar, 0);
+
+    Trabalhador* principal = &ia->trabalhadores[0];
+    double estatico = iaAvaliar(&principal->copia, missao, cor);
+    jogada->valor = estatico;
+    busca->numRaiz = gerarRaiz(&principal->copia, cor, busca->raiz);
+
+    double prazo = inicio + orcamentoMs / 1000.0;
+    for (int profundidade = 1;
+         busca->numRaiz > 0 && estatico < VALOR_VITORIA && profundidade <= PROFUNDIDADE_MAXIMA;
+         profundidade++) {
+        busca->profundidade = profundidade;
+        busca->prazo = (profundidade == 1) ? INFINITY : prazo;
+        if (ia->pool != NULL) {
+            poolExecutar(ia->pool, busca->numRaiz, tarefaRaiz, busca);
+        } else {
+            for (int i = 0; i < busca->numRaiz; i++) {
+                tarefaRaiz(busca, i, 0);
+            }
+        }
+        if (atomic_load_explicit(&busca->abortar, memory_order_relaxed)) {
+            break;
+        }
+
+        // Iteração completa: atualiza a escolha (não atacar vence empates)
+        jogada->atacante = -1;
+        jogada->defensor = -1;
+        jogada->valor = estatico;
+        for (int i = 0; i < busca->numRaiz; i++) {
+            if (busca->valores[i] > jogada->valor + 1e-9) {
+                jogada->valor = busca->valores[i];
+                jogada->atacante = busca->raiz[i].atacante;
+                jogada->defensor = busca->raiz[i].defensor;
+            }
+        }
+        jogada->profundidade = profundidade;
+        if (agora() > prazo) {
+            break;
+        }
+    }
+
+    for (int i = 0; i < ia->numTrabalhadores; i++) {
+        jogada->nos += ia->trabalhadores[i].nos;
+        ia->trabalhadores[i].copia.grafo = NULL;
+    }
+    jogada->segundos = agora() - inicio;
+    PERFIL_SOMAR(PERFIL_POSICOES_IA, jogada->nos);
+    free(busca);
+    return 1;
+}
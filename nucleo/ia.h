@@ -0,0 +1,55 @@
+/*
+ * Jogadores controlados pelo computador
+ * 
+ * Escolhe um ataque por expectimax sobre os resultados possíveis de cada
+ * ataque na regra de batalha da partida (na simples, conquista com chance
+ * 15/36 e perda de uma tropa com 21/36; na clássica, cada quantidade de
+ * tropas perdidas pelo defensor, com a chance da rolagem), pontuando as
+ * posições pelo progresso na missão do próprio jogador e tratando como
+ * vitória as posições em que verificarMissao é cumprida.
+ * 
+ * A busca usa aprofundamento iterativo até o orçamento de tempo: a cada
+ * profundidade, os ataques da raiz são repartidos entre os trabalhadores
+ * do Pool, cada um com a sua cópia do mapa (com estatísticas anexadas
+ * para avaliar rápido). Todos compartilham uma tabela de transposição
+ * sem travas, indexada por um hash Zobrist de donos e tropas.
+ */
+
+#ifndef WAR_IA_H
+#define WAR_IA_H
+
+#include <stddef.h>
+#include "batalha.h"
+#include "mapa.h"
+#include "pool.h"
+
+// Orçamento padrão por jogada, em milissegundos
+#define ORCAMENTO_IA_PADRAO 50
+
+// Entradas da tabela de transposição (potência de 2)
+#define ENTRADAS_TRANSPOSICAO (1u << 20)
+
+typedef struct IA IA;
+
+/*
+ * Struct JogadaIA
+ * 
+ * Ataque escolhido pela busca. atacante == -1 indica que não atacar é a
+ * melhor opção (ou que não há ataque possível).
+ */
+typedef struct {
+    int atacante;
+    int defensor;
+    double valor;          // Valor esperado da posição (1.0 = missão cumprida)
+    int profundidade;      // Última profundidade concluída
+    long long nos;         // Posições visitadas
+    double segundos;       // Tempo gasto
+} JogadaIA;
+
+IA* iaCriar(Pool* pool, size_t entradasTabela);
+void iaDestruir(IA* ia);
+int iaEscolherAtaque(IA* ia, const Mapa* mapa, const Missao* missao, IdCor cor,
+                     RegraBatalha regra, int orcamentoMs, JogadaIA* jogada);
+double iaAvaliar(const Mapa* mapa, const Missao* missao, IdCor cor);
+
+#endif
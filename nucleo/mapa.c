@@ -0,0 +1,483 @@
+/*
+ * Mapa de territórios em estrutura de vetores (SoA)
+ * 
+ * Implementa o cadastro, a internação de cores e as varreduras de posse
+ * sobre os vetores de donos e tropas.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "continente.h"
+#include "estatisticas.h"
+#include "grafo.h"
+#include "historico.h"
+#include "mapa.h"
+#include "perfil.h"
+
+/*
+ * Função: mapaIniciar
+ * 
+ * Prepara um mapa vazio com espaço para `capacidade` territórios.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 em caso de falha de alocação
+ */
+int mapaIniciar(Mapa* mapa, int capacidade) {
+    memset(mapa, 0, sizeof(Mapa));
+    return mapaReservar(mapa, capacidade);
+}
+
+/*
+ * Função: mapaLiberar
+ * 
+ * Libera os vetores do mapa (e o grafo, os continentes e o histórico
+ * anexados) e o deixa vazio.
+ */
+void mapaLiberar(Mapa* mapa) {
+    estatisticasDestruir(mapa->estatisticas);
+    historicoDestruir(mapa->historico);
+    if (mapa->continentes != NULL) {
+        continentesLiberar(mapa->continentes);
+        free(mapa->continentes);
+    }
+    if (mapa->grafo != NULL) {
+        grafoLiberar(mapa->grafo);
+        free(mapa->grafo);
+    }
+    for (int c = 0; c < MAX_CORES; c++) {
+        free(mapa->posse[c]);
+    }
+    if (!mapa->vetoresExternos) {
+        free(mapa->donos);
+        free(mapa->tropas);
+        free(mapa->nomes);
+    }
+    if (mapa->regiao != NULL) {
+        munmap(mapa->regiao, mapa->tamanhoRegiao);
+    }
+    memset(mapa, 0, sizeof(Mapa));
+}
+
+/*
+ * Função: mapaReservar
+ * 
+ * Garante espaço para pelo menos `capacidade` territórios.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 em caso de falha de alocação
+ */
+int mapaReservar(Mapa* mapa, int capacidade) {
+    if (capacidade <= mapa->capacidade) {
+        return 1;
+    }
+
+    // Vetores de um snapshot mapeado ou de uma arena são copiados para o heap antes de crescer
+    if (mapa->vetoresExternos) {
+        IdCor* donos = (IdCor*) malloc(capacidade * sizeof(IdCor));
+        int32_t* tropas = (int32_t*) malloc(capacidade * sizeof(int32_t));
+        char (*nomes)[TAM_NOME] = malloc(capacidade * sizeof(*nomes));
+        if (donos == NULL || tropas == NULL || nomes == NULL) {
+            free(donos);
+            free(tropas);
+            free(nomes);
+            return 0;
+        }
+        memcpy(donos, mapa->donos, mapa->quantidade * sizeof(IdCor));
+        memcpy(tropas, mapa->tropas, mapa->quantidade * sizeof(int32_t));
+        memcpy(nomes, mapa->nomes, mapa->quantidade * sizeof(*nomes));
+        mapa->donos = donos;
+        mapa->tropas = tropas;
+        mapa->nomes = nomes;
+        mapa->vetoresExternos = 0;
+    }
+
+    IdCor* donos = (IdCor*) realloc(mapa->donos, capacidade * sizeof(IdCor));
+    if (donos == NULL) {
+        return 0;
+    }
+    mapa->donos = donos;
+
+    int32_t* tropas = (int32_t*) realloc(mapa->tropas, capacidade * sizeof(int32_t));
+    if (tropas == NULL) {
+        return 0;
+    }
+    mapa->tropas = tropas;
+
+    char (*nomes)[TAM_NOME] = realloc(mapa->nomes, capacidade * sizeof(*nomes));
+    if (nomes == NULL) {
+        return 0;
+    }
+    mapa->nomes = nomes;
+
+    // Os conjuntos de posse acompanham a capacidade, com as palavras novas zeradas
+    if (mapa->posseAtiva) {
+        size_t antigas = ((size_t) mapa->capacidade + 63) / 64;
+        size_t palavras = ((size_t) capacidade + 63) / 64;
+        for (int c = 0; c < mapa->numCores; c++) {
+            uint64_t* bits = (uint64_t*) realloc(mapa->posse[c], palavras * sizeof(uint64_t));
+            if (bits == NULL) {
+                return 0;
+            }
+            memset(bits + antigas, 0, (palavras - antigas) * sizeof(uint64_t));
+            mapa->posse[c] = bits;
+        }
+    }
+
+    mapa->capacidade = capacidade;
+    return 1;
+}
+
+/*
+ * Função: mapaReservarEm
+ * 
+ * Como mapaReservar, mas os vetores novos de donos, tropas e nomes vêm
+ * da arena da partida (os antigos são copiados e, se eram do heap,
+ * liberados). Assim os territórios saem do mesmo bloco que os jogadores
+ * e são devolvidos com ele; a arena deve durar tanto quanto o mapa.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 em caso de falha de alocação
+ */
+int mapaReservarEm(Mapa* mapa, Arena* arena, int capacidade) {
+    if (capacidade <= mapa->capacidade) {
+        return 1;
+    }
+    IdCor* donos = (IdCor*) arenaAlocar(arena, capacidade * sizeof(IdCor));
+    int32_t* tropas = (int32_t*) arenaAlocar(arena, capacidade * sizeof(int32_t));
+    char (*nomes)[TAM_NOME] = arenaAlocar(arena, capacidade * sizeof(*nomes));
+    if (donos == NULL || tropas == NULL || nomes == NULL) {
+        return 0;
+    }
+
+    // Os conjuntos de posse crescem antes, para o mapa não mudar se faltar memória
+    if (mapa->posseAtiva) {
+        size_t antigas = ((size_t) mapa->capacidade + 63) / 64;
+        size_t palavras = ((size_t) capacidade + 63) / 64;
+        for (int c = 0; c < mapa->numCores; c++) {
+            uint64_t* bits = (uint64_t*) realloc(mapa->posse[c], palavras * sizeof(uint64_t));
+            if (bits == NULL) {
+                return 0;
+            }
+            memset(bits + antigas, 0, (palavras - antigas) * sizeof(uint64_t));
+            mapa->posse[c] = bits;
+        }
+    }
+
+    if (mapa->quantidade > 0) {
+        memcpy(donos, mapa->donos, mapa->quantidade * sizeof(IdCor));
+        memcpy(tropas, mapa->tropas, mapa->quantidade * sizeof(int32_t));
+        memcpy(nomes, mapa->nomes, mapa->quantidade * sizeof(*nomes));
+    }
+    if (!mapa->vetoresExternos) {
+        free(mapa->donos);
+        free(mapa->tropas);
+        free(mapa->nomes);
+    }
+    mapa->donos = donos;
+    mapa->tropas = tropas;
+    mapa->nomes = nomes;
+    mapa->vetoresExternos = 1;
+    mapa->capacidade = capacidade;
+    return 1;
+}
+
+/*
+ * Função: mapaBuscarCor
+ * 
+ * Procura uma cor já internada.
+ * 
+ * Retorno: identificador da cor, ou COR_INVALIDA se não existir
+ */
+IdCor mapaBuscarCor(const Mapa* mapa, const char* cor) {
+    for (int i = 0; i < mapa->numCores; i++) {
+        PERFIL_CONTAR(PERFIL_COMPARACOES_COR);
+        if (strncmp(mapa->cores[i], cor, TAM_COR) == 0) {
+            return (IdCor) i;
+        }
+    }
+    return COR_INVALIDA;
+}
+
+/*
+ * Função: mapaInternarCor
+ * 
+ * Devolve o identificador da cor, cadastrando-a se for nova. Cores com
+ * mais de TAM_COR - 1 caracteres são truncadas.
+ * 
+ * Retorno: identificador da cor, ou COR_INVALIDA se a tabela estiver cheia
+ */
+IdCor mapaInternarCor(Mapa* mapa, const char* cor) {
+    char normalizada[TAM_COR];
+    strncpy(normalizada, cor, TAM_COR - 1);
+    normalizada[TAM_COR - 1] = '\0';
+
+    IdCor id = mapaBuscarCor(mapa, normalizada);
+    if (id != COR_INVALIDA) {
+        return id;
+    }
+    if (mapa->numCores >= MAX_CORES) {
+        return COR_INVALIDA;
+    }
+
+    if (mapa->posseAtiva) {
+        size_t palavras = ((size_t) mapa->capacidade + 63) / 64;
+        mapa->posse[mapa->numCores] = (uint64_t*) calloc(palavras ? palavras : 1, sizeof(uint64_t));
+        if (mapa->posse[mapa->numCores] == NULL) {
+            return COR_INVALIDA;
+        }
+    }
+
+    memcpy(mapa->cores[mapa->numCores], normalizada, TAM_COR);
+    return (IdCor) mapa->numCores++;
+}
+
+/*
+ * Função: mapaAdicionar
+ * 
+ * Acrescenta um território ao final do mapa, aumentando os vetores se
+ * necessário.
+ * 
+ * Parâmetros:
+ *   mapa - mapa de destino
+ *   nome - nome do território (truncado em TAM_NOME - 1 caracteres)
+ *   dono - cor internada que ocupa o território
+ *   tropas - quantidade inicial de tropas
+ * 
+ * Retorno: índice do novo território, ou -1 em caso de falha
+ */
+int mapaAdicionar(Mapa* mapa, const char* nome, IdCor dono, int tropas) {
+    if (mapa->quantidade == mapa->capacidade) {
+        int nova = (mapa->capacidade > 0) ? mapa->capacidade * 2 : 16;
+        if (!mapaReservar(mapa, nova)) {
+            return -1;
+        }
+    }
+
+    int i = mapa->quantidade++;
+    strncpy(mapa->nomes[i], nome, TAM_NOME - 1);
+    mapa->nomes[i][TAM_NOME - 1] = '\0';
+    mapa->donos[i] = dono;
+    mapa->tropas[i] = tropas;
+    if (mapa->posseAtiva) {
+        mapa->posse[dono][i >> 6] |= 1ULL << (i & 63);
+    }
+
+    // Estatísticas anexadas antes do fim do cadastro são refeitas
+    if (mapa->estatisticas != NULL && !estatisticasRecalcular(mapa->estatisticas, mapa)) {
+        mapa->quantidade--;
+        return -1;
+    }
+    return i;
+}
+
+/*
+ * Função: mapaObterTerritorio
+ * 
+ * Copia os dados de um território para uma struct Territorio.
+ */
+void mapaObterTerritorio(const Mapa* mapa, int indice, Territorio* territorio) {
+    memcpy(territorio->nome, mapa->nomes[indice], TAM_NOME);
+    memcpy(territorio->cor, mapa->cores[mapa->donos[indice]], TAM_COR);
+    territorio->tropas = mapa->tropas[indice];
+}
+
+/*
+ * Função: mapaAtivarPosse
+ * 
+ * Passa a manter um conjunto de bits por cor com os territórios que ela
+ * ocupa. Depois de ativado, os conjuntos acompanham mapaAdicionar,
+ * mapaInternarCor e mapaDefinirDono.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 em caso de falha de alocação
+ */
+int mapaAtivarPosse(Mapa* mapa) {
+    if (mapa->posseAtiva) {
+        return 1;
+    }
+    size_t palavras = ((size_t) mapa->capacidade + 63) / 64;
+    for (int c = 0; c < mapa->numCores; c++) {
+        mapa->posse[c] = (uint64_t*) calloc(palavras ? palavras : 1, sizeof(uint64_t));
+        if (mapa->posse[c] == NULL) {
+            for (int k = 0; k <= c; k++) {
+                free(mapa->posse[k]);
+                mapa->posse[k] = NULL;
+            }
+            return 0;
+        }
+    }
+    for (int i = 0; i < mapa->quantidade; i++) {
+        mapa->posse[mapa->donos[i]][i >> 6] |= 1ULL << (i & 63);
+    }
+    mapa->posseAtiva = 1;
+    return 1;
+}
+
+/*
+ * Função: mapaDefinirGrafo
+ * 
+ * Anexa ao mapa um grafo de fronteiras alocado com malloc. O mapa passa a
+ * ser dono do grafo e o libera em mapaLiberar.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 se o grafo não tiver um vértice por território
+ */
+int mapaDefinirGrafo(Mapa* mapa, Grafo* grafo) {
+    if (grafo != NULL && grafo->numVertices != mapa->quantidade) {
+        return 0;
+    }
+    if (mapa->grafo != NULL) {
+        grafoLiberar(mapa->grafo);
+        free(mapa->grafo);
+    }
+    mapa->grafo = grafo;
+    return 1;
+}
+
+/*
+ * Função: mapaDefinirContinentes
+ * 
+ * Anexa ao mapa continentes alocados com malloc, já com todos os
+ * territórios cadastrados, e calcula a posse de cada um. O mapa passa a
+ * ser dono dos continentes e os libera em mapaLiberar.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 se os continentes não cobrirem o mapa
+ */
+int mapaDefinirContinentes(Mapa* mapa, Continentes* continentes) {
+    if (continentes != NULL && !continentesRecalcular(continentes, mapa)) {
+        return 0;
+    }
+    if (mapa->continentes != NULL) {
+        continentesLiberar(mapa->continentes);
+        free(mapa->continentes);
+    }
+    mapa->continentes = continentes;
+    return 1;
+}
+
+/*
+ * Função: mapaCopiarEstado
+ * 
+ * Copia cores, donos e tropas de `origem` para `destino` e refaz os
+ * índices anexados ao destino (posse, estatísticas e continentes). Os
+ * nomes, o grafo e as definições dos continentes não são copiados: serve
+ * para cópias de trabalho, como as da busca dos jogadores do computador,
+ * reaproveitadas de uma jogada para outra.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 em caso de falha de alocação
+ */
+int mapaCopiarEstado(Mapa* destino, const Mapa* origem) {
+    if (!mapaReservar(destino, origem->quantidade)) {
+        return 0;
+    }
+    size_t palavras = ((size_t) destino->capacidade + 63) / 64;
+    if (destino->posseAtiva) {
+        for (int c = destino->numCores; c < origem->numCores; c++) {
+            destino->posse[c] = (uint64_t*) calloc(palavras ? palavras : 1, sizeof(uint64_t));
+            if (destino->posse[c] == NULL) {
+                return 0;
+            }
+            destino->numCores = c + 1;
+        }
+    }
+
+    memcpy(destino->cores, origem->cores, sizeof(origem->cores));
+    destino->numCores = origem->numCores;
+    destino->quantidade = origem->quantidade;
+    memcpy(destino->donos, origem->donos, origem->quantidade * sizeof(IdCor));
+    memcpy(destino->tropas, origem->tropas, origem->quantidade * sizeof(int32_t));
+
+    if (destino->posseAtiva) {
+        for (int c = 0; c < destino->numCores; c++) {
+            memset(destino->posse[c], 0, palavras * sizeof(uint64_t));
+        }
+        for (int i = 0; i < destino->quantidade; i++) {
+            destino->posse[destino->donos[i]][i >> 6] |= 1ULL << (i & 63);
+        }
+    }
+    if (destino->continentes != NULL && !continentesRecalcular(destino->continentes, destino)) {
+        return 0;
+    }
+    if (destino->estatisticas != NULL) {
+        return estatisticasRecalcular(destino->estatisticas, destino);
+    }
+    return 1;
+}
+
+/*
+ * Função: mapaContarPorDono
+ * 
+ * Conta quantos territórios pertencem a uma cor.
+ * 
+ * Retorno: número de territórios da cor
+ */
+int mapaContarPorDono(const Mapa* mapa, IdCor dono) {
+    PERFIL_CONTAR(PERFIL_VARREDURAS);
+    PERFIL_SOMAR(PERFIL_TERRITORIOS_VARRIDOS, mapa->quantidade);
+    const IdCor* donos = mapa->donos;
+    int contador = 0;
+    for (int i = 0; i < mapa->quantidade; i++) {
+        contador += (donos[i] == dono);
+    }
+    return contador;
+}
+
+/*
+ * Função: mapaSomarTropas
+ * 
+ * Soma as tropas de todos os territórios de uma cor.
+ * 
+ * Retorno: total de tropas da cor
+ */
+long long mapaSomarTropas(const Mapa* mapa, IdCor dono) {
+    PERFIL_CONTAR(PERFIL_VARREDURAS);
+    PERFIL_SOMAR(PERFIL_TERRITORIOS_VARRIDOS, mapa->quantidade);
+    const IdCor* donos = mapa->donos;
+    const int32_t* tropas = mapa->tropas;
+    long long total = 0;
+    for (int i = 0; i < mapa->quantidade; i++) {
+        total += (donos[i] == dono) ? tropas[i] : 0;
+    }
+    return total;
+}
+
+/*
+ * Função: mapaVerificarConsecutivos
+ * 
+ * Verifica se uma cor ocupa `quantidade` territórios em posições
+ * adjacentes do vetor.
+ * 
+ * Retorno: 1 se encontrou a sequência, 0 caso contrário
+ */
+int mapaVerificarConsecutivos(const Mapa* mapa, IdCor dono, int quantidade) {
+    PERFIL_CONTAR(PERFIL_VARREDURAS);
+    PERFIL_SOMAR(PERFIL_TERRITORIOS_VARRIDOS, mapa->quantidade);
+    int consecutivos = 0;
+    for (int i = 0; i < mapa->quantidade; i++) {
+        if (mapa->donos[i] == dono) {
+            if (++consecutivos >= quantidade) {
+                return 1;
+            }
+        } else {
+            consecutivos = 0;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Função: mapaMaiorSequencia
+ * 
+ * Calcula, varrendo o mapa, o tamanho da maior sequência de territórios
+ * consecutivos de uma cor.
+ * 
+ * Retorno: tamanho da maior sequência (0 se a cor não tiver territórios)
+ */
+int mapaMaiorSequencia(const Mapa* mapa, IdCor dono) {
+    PERFIL_CONTAR(PERFIL_VARREDURAS);
+    PERFIL_SOMAR(PERFIL_TERRITORIOS_VARRIDOS, mapa->quantidade);
+    int maior = 0, atual = 0;
+    for (int i = 0; i < mapa->quantidade; i++) {
+        atual = (mapa->donos[i] == dono) ? atual + 1 : 0;
+        if (atual > maior) {
+            maior = atual;
+        }
+    }
+    return maior;
+}
@@ -0,0 +1,143 @@
+/*
+ * Mapa de territórios em estrutura de vetores (SoA)
+ * 
+ * Guarda donos, tropas e nomes em vetores contíguos separados e interna
+ * as cores em identificadores pequenos (IdCor). Assim as varreduras de
+ * posse viram laços de inteiros que o compilador consegue vetorizar, em
+ * vez de um strcmp por território.
+ */
+
+#ifndef WAR_MAPA_H
+#define WAR_MAPA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "arena.h"
+#include "tipos.h"
+
+// Quantidade máxima de cores distintas em um mapa
+#define MAX_CORES 64
+
+// Valor devolvido quando uma cor não existe ou não cabe na tabela
+#define COR_INVALIDA 0xFF
+
+// Estatísticas incrementais opcionais (ver estatisticas.h)
+typedef struct Estatisticas Estatisticas;
+
+// Grafo de fronteiras opcional (ver grafo.h)
+typedef struct Grafo Grafo;
+
+// Histórico de versões opcional (ver historico.h)
+typedef struct Historico Historico;
+
+// Continentes com bônus de reforço opcionais (ver continente.h)
+typedef struct Continentes Continentes;
+
+/*
+ * Struct Mapa
+ * 
+ * O território i é descrito por donos[i], tropas[i] e nomes[i].
+ * As alterações de dono e de tropas devem passar por mapaDefinirDono e
+ * mapaDefinirTropas, que mantêm as estatísticas anexadas, os conjuntos
+ * de bits de posse, a posse dos continentes e o histórico de versões
+ * (se houver).
+ */
+typedef struct {
+    int quantidade;              // Territórios cadastrados
+    int capacidade;              // Territórios que cabem nos vetores
+    IdCor* donos;                // Cor que ocupa cada território
+    int32_t* tropas;             // Tropas de cada território
+    char (*nomes)[TAM_NOME];     // Nome de cada território
+    int numCores;                // Cores internadas
+    char cores[MAX_CORES][TAM_COR];
+    Estatisticas* estatisticas;  // Contadores por cor (NULL se desativados)
+    Grafo* grafo;                // Fronteiras (NULL: qualquer par é vizinho)
+    Historico* historico;        // Diário para desfazer (NULL se desativado)
+    Continentes* continentes;    // Continentes com bônus (NULL se o mapa não tiver)
+    int posseAtiva;              // 1 se os conjuntos de bits abaixo são mantidos
+    uint64_t* posse[MAX_CORES];  // Bit i ligado se a cor ocupa o território i
+    void* regiao;                // Snapshot mapeado em memória (NULL se não houver)
+    size_t tamanhoRegiao;
+    int vetoresExternos;         // 1 se donos, tropas e nomes estão na região ou em uma arena
+} Mapa;
+
+int mapaIniciar(Mapa* mapa, int capacidade);
+void mapaLiberar(Mapa* mapa);
+int mapaReservar(Mapa* mapa, int capacidade);
+int mapaReservarEm(Mapa* mapa, Arena* arena, int capacidade);
+IdCor mapaBuscarCor(const Mapa* mapa, const char* cor);
+IdCor mapaInternarCor(Mapa* mapa, const char* cor);
+int mapaAdicionar(Mapa* mapa, const char* nome, IdCor dono, int tropas);
+void mapaObterTerritorio(const Mapa* mapa, int indice, Territorio* territorio);
+int mapaAtivarPosse(Mapa* mapa);
+int mapaDefinirGrafo(Mapa* mapa, Grafo* grafo);
+int mapaDefinirContinentes(Mapa* mapa, Continentes* continentes);
+int mapaCopiarEstado(Mapa* destino, const Mapa* origem);
+
+int mapaContarPorDono(const Mapa* mapa, IdCor dono);
+long long mapaSomarTropas(const Mapa* mapa, IdCor dono);
+int mapaVerificarConsecutivos(const Mapa* mapa, IdCor dono, int quantidade);
+int mapaMaiorSequencia(const Mapa* mapa, IdCor dono);
+
+// Ganchos chamados pelos setters abaixo (implementados em estatisticas.c)
+int estatisticasTrocarDono(Estatisticas* est, const Mapa* mapa, int indice, IdCor antigo);
+void estatisticasAjustarTropas(Estatisticas* est, IdCor dono, int diferenca);
+void historicoAnotar(Historico* hist, const Mapa* mapa, int indice);
+void continentesTrocarDono(Continentes* cont, int indice, IdCor antigo, IdCor novo);
+
+/*
+ * Função: mapaNomeCor
+ * 
+ * Retorno: texto da cor internada com o identificador `cor`
+ */
+static inline const char* mapaNomeCor(const Mapa* mapa, IdCor cor) {
+    return mapa->cores[cor];
+}
+
+/*
+ * Função: mapaDefinirDono
+ * 
+ * Troca a cor que ocupa o território `indice`.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 se as estatísticas anexadas não
+ * conseguiram memória (o dono é trocado mesmo assim, e as sequências são
+ * refeitas na próxima consulta)
+ */
+static inline int mapaDefinirDono(Mapa* mapa, int indice, IdCor dono) {
+    IdCor antigo = mapa->donos[indice];
+    if (mapa->historico != NULL && antigo != dono) {
+        historicoAnotar(mapa->historico, mapa, indice);
+    }
+    mapa->donos[indice] = dono;
+    if (mapa->posseAtiva) {
+        uint64_t bit = 1ULL << (indice & 63);
+        mapa->posse[antigo][indice >> 6] &= ~bit;
+        mapa->posse[dono][indice >> 6] |= bit;
+    }
+    int ok = 1;
+    if (mapa->estatisticas != NULL && antigo != dono) {
+        ok = estatisticasTrocarDono(mapa->estatisticas, mapa, indice, antigo);
+    }
+    if (mapa->continentes != NULL && antigo != dono) {
+        continentesTrocarDono(mapa->continentes, indice, antigo, dono);
+    }
+    return ok;
+}
+
+/*
+ * Função: mapaDefinirTropas
+ * 
+ * Altera a quantidade de tropas do território `indice`.
+ */
+static inline void mapaDefinirTropas(Mapa* mapa, int indice, int tropas) {
+    int diferenca = tropas - mapa->tropas[indice];
+    if (mapa->historico != NULL && diferenca != 0) {
+        historicoAnotar(mapa->historico, mapa, indice);
+    }
+    mapa->tropas[indice] = tropas;
+    if (mapa->estatisticas != NULL && diferenca != 0) {
+        estatisticasAjustarTropas(mapa->estatisticas, mapa->donos[indice], diferenca);
+    }
+}
+
+#endif
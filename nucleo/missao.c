@@ -0,0 +1,225 @@
+/*
+ * Missões estratégicas compiladas
+ * 
+ * Tabela de missões padrão, leitura do arquivo de missões e avaliação
+ * por tipo usando as consultas de estatisticas.h.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "estatisticas.h"
+#include "grafo.h"
+#include "missao.h"
+#include "perfil.h"
+
+// Missões do jogo quando nenhum arquivo de missões é informado
+const Missao MISSOES_PADRAO[] = {
+    {MISSAO_CONSECUTIVOS, 3, "Conquistar 3 territorios consecutivos no mapa"},
+    {MISSAO_TERRITORIOS, 5, "Conquistar pelo menos 5 territorios de qualquer posicao"},
+    {MISSAO_PERCENTUAL, 50, "Dominar 50% do mapa (metade dos territorios)"},
+    {MISSAO_ELIMINAR, 0, "Eliminar todas as tropas de pelo menos uma cor inimiga"},
+    {MISSAO_TROPAS, 20, "Acumular 20 tropas ou mais em seus territorios controlados"}
+};
+const int NUM_MISSOES_PADRAO = sizeof(MISSOES_PADRAO) / sizeof(MISSOES_PADRAO[0]);
+
+// Nomes dos tipos no arquivo de missões, na ordem de TipoMissao
+static const char* const NOMES_TIPOS[NUM_TIPOS_MISSAO] = {
+    "consecutivos", "territorios", "percentual", "eliminar", "tropas"
+};
+
+/* ---- Avaliadores, um por tipo de missão ---- */
+
+// Em mapas com fronteiras declaradas, "consecutivos" passa a ser "conectados"
+static int cumpriuConsecutivos(const Missao* missao, const Mapa* mapa, IdCor cor) {
+    if (mapa->grafo != NULL && !mapa->grafo->linear && !mapa->grafo->completo) {
+        return mapaConectados(mapa, cor, missao->parametro);
+    }
+    return maiorSequenciaDaCor(mapa, cor) >= missao->parametro;
+}
+
+static int cumpriuTerritorios(const Missao* missao, const Mapa* mapa, IdCor cor) {
+    return contarTerritoriosDaCor(mapa, cor) >= missao->parametro;
+}
+
+static int cumpriuPercentual(const Missao* missao, const Mapa* mapa, IdCor cor) {
+    long long necessario = (long long) mapa->quantidade * missao->parametro / 100;
+    return contarTerritoriosDaCor(mapa, cor) >= necessario;
+}
+
+static int cumpriuEliminar(const Missao* missao, const Mapa* mapa, IdCor cor) {
+    // Lógica simplificada: o jogador precisa ocupar todos os territórios
+    (void) missao;
+    return contarTerritoriosDaCor(mapa, cor) == mapa->quantidade;
+}
+
+static int cumpriuTropas(const Missao* missao, const Mapa* mapa, IdCor cor) {
+    return somarTropasDaCor(mapa, cor) >= missao->parametro;
+}
+
+typedef int (*Avaliador)(const Missao* missao, const Mapa* mapa, IdCor cor);
+
+static const Avaliador AVALIADORES[NUM_TIPOS_MISSAO] = {
+    cumpriuConsecutivos, cumpriuTerritorios, cumpriuPercentual, cumpriuEliminar, cumpriuTropas
+};
+
+/*
+ * Função: verificarMissao
+ * 
+ * Verifica se uma missão foi cumprida, despachando direto para a regra
+ * do seu tipo.
+ * 
+ * Parâmetros:
+ *   missao - missão compilada do jogador
+ *   mapa - mapa de territórios
+ *   corJogador - cor internada do jogador que está sendo verificado
+ * 
+ * Retorno: 1 se a missão foi cumprida, 0 caso contrário
+ */
+int verificarMissao(const Missao* missao, const Mapa* mapa, IdCor corJogador) {
+    PERFIL_ESCOPO(PERFIL_VERIFICAR_MISSAO);
+    if ((unsigned) missao->tipo >= NUM_TIPOS_MISSAO) {
+        return 0; // Missão desconhecida nunca é cumprida
+    }
+    return AVALIADORES[missao->tipo](missao, mapa, corJogador) ? 1 : 0;
+}
+
+/*
+ * Função: jogadorVencedor
+ * 
+ * Confere as missões na ordem dos jogadores, como a verificação de
+ * vitória do jogo a cada jogada.
+ * 
+ * Retorno: índice do primeiro jogador com a missão cumprida, ou -1
+ */
+int jogadorVencedor(const Jogador* jogadores, int numJogadores, const Mapa* mapa) {
+    for (int i = 0; i < numJogadores; i++) {
+        if (verificarMissao(jogadores[i].missao, mapa, jogadores[i].idCor)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Função: nomeTipoMissao
+ * 
+ * Retorno: nome do tipo usado no arquivo de missões
+ */
+const char* nomeTipoMissao(TipoMissao tipo) {
+    return ((unsigned) tipo < NUM_TIPOS_MISSAO) ? NOMES_TIPOS[tipo] : "?";
+}
+
+/*
+ * Função: tipoMissaoPorNome
+ * 
+ * Retorno: 1 e o tipo em *tipo se o nome for conhecido, 0 caso contrário
+ */
+int tipoMissaoPorNome(const char* nome, TipoMissao* tipo) {
+    for (int t = 0; t < NUM_TIPOS_MISSAO; t++) {
+        if (strcmp(nome, NOMES_TIPOS[t]) == 0) {
+            *tipo = (TipoMissao) t;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Função: compilarMissao
+ * 
+ * Converte uma linha "<tipo> <parametro> <texto>" em uma Missao.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 se a linha for inválida
+ */
+int compilarMissao(const char* linha, Missao* destino) {
+    char nomeTipo[32];
+    int parametro, consumidos = 0;
+
+    if (sscanf(linha, "%31s %d %n", nomeTipo, &parametro, &consumidos) < 2 || consumidos == 0) {
+        return 0;
+    }
+    if (!tipoMissaoPorNome(nomeTipo, &destino->tipo) || parametro < 0) {
+        return 0;
+    }
+
+    const char* texto = linha + consumidos;
+    size_t tamanho = strcspn(texto, "\r\n");
+    if (tamanho == 0 || tamanho >= TAM_MISSAO) {
+        return 0;
+    }
+    memcpy(destino->texto, texto, tamanho);
+    destino->texto[tamanho] = '\0';
+    destino->parametro = parametro;
+    return 1;
+}
+
+/*
+ * Função: carregarMissoes
+ * 
+ * Lê as missões de um arquivo de dados (formato descrito em missao.h).
+ * 
+ * Parâmetros:
+ *   caminho - arquivo de missões
+ *   missoes - vetor de destino
+ *   maximo - capacidade do vetor
+ *   erros - onde relatar linhas inválidas (pode ser NULL)
+ * 
+ * Retorno: quantidade de missões lidas, ou -1 se houve algum erro
+ */
+int carregarMissoes(const char* caminho, Missao* missoes, int maximo, FILE* erros) {
+    FILE* arquivo = fopen(caminho, "r");
+    if (arquivo == NULL) {
+        if (erros != NULL) {
+            fprintf(erros, "%s: nao foi possivel abrir o arquivo\n", caminho);
+        }
+        return -1;
+    }
+
+    char linha[TAM_MISSAO + 64];
+    int total = 0, numeroLinha = 0, falhou = 0;
+
+    while (fgets(linha, sizeof(linha), arquivo) != NULL) {
+        numeroLinha++;
+        const char* inicio = linha + strspn(linha, " \t");
+        if (*inicio == '#' || *inicio == '\n' || *inicio == '\r' || *inicio == '\0') {
+            continue;
+        }
+        if (total == maximo) {
+            if (erros != NULL) {
+                fprintf(erros, "%s:%d: mais de %d missoes\n", caminho, numeroLinha, maximo);
+            }
+            falhou = 1;
+            break;
+        }
+        if (!compilarMissao(inicio, &missoes[total])) {
+            if (erros != NULL) {
+                fprintf(erros, "%s:%d: missao invalida\n", caminho, numeroLinha);
+            }
+            falhou = 1;
+            continue;
+        }
+        total++;
+    }
+    fclose(arquivo);
+
+    return falhou ? -1 : total;
+}
+
+/*
+ * Função: sortearMissao
+ * 
+ * Sorteia uma missão do vetor de missões disponíveis. O jogador guarda
+ * só o ponteiro para ela: a tabela é compartilhada e não é copiada.
+ * 
+ * Parâmetros:
+ *   missoes - vetor com as missões disponíveis (deve durar tanto quanto
+ *             os jogadores que apontam para ele)
+ *   totalMissoes - quantidade total de missões disponíveis
+ *   rng - gerador de números aleatórios da partida
+ * 
+ * Retorno: a missão sorteada, dentro de `missoes`
+ */
+const Missao* sortearMissao(const Missao* missoes, int totalMissoes, Aleatorio* rng) {
+    // Sorteia um índice aleatório (sem viés de módulo)
+    return &missoes[aleatorioLimitado(rng, (uint32_t) totalMissoes)];
+}
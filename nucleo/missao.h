@@ -0,0 +1,32 @@
+/*
+ * Missões estratégicas compiladas
+ * 
+ * Cada missão é descrita por um tipo (TipoMissao) e um parâmetro. A
+ * verificação é um despacho direto por tipo em uma tabela de funções,
+ * sem nenhum strstr. Novas missões podem ser definidas em um arquivo de
+ * dados, sem alterar o código.
+ * 
+ * Formato do arquivo (uma missão por linha, '#' inicia comentário):
+ *   <tipo> <parametro> <texto da missao>
+ * onde <tipo> é consecutivos, territorios, percentual, eliminar ou tropas.
+ */
+
+#ifndef WAR_MISSAO_H
+#define WAR_MISSAO_H
+
+#include <stdio.h>
+#include "aleatorio.h"
+#include "mapa.h"
+
+extern const Missao MISSOES_PADRAO[];
+extern const int NUM_MISSOES_PADRAO;
+
+const char* nomeTipoMissao(TipoMissao tipo);
+int tipoMissaoPorNome(const char* nome, TipoMissao* tipo);
+int compilarMissao(const char* linha, Missao* destino);
+int carregarMissoes(const char* caminho, Missao* missoes, int maximo, FILE* erros);
+const Missao* sortearMissao(const Missao* missoes, int totalMissoes, Aleatorio* rng);
+int verificarMissao(const Missao* missao, const Mapa* mapa, IdCor corJogador);
+int jogadorVencedor(const Jogador* jogadores, int numJogadores, const Mapa* mapa);
+
+#endif
@@ -0,0 +1,445 @@
+/*
+ * Partidas em andamento, sem entrada/saída
+ * 
+ * O modelo é montado uma vez; cada partida faz uma única alocação de
+ * arena para os vetores do mapa e recalcula posse de continentes e
+ * estatísticas sobre a cópia, de modo que verificar missões e calcular
+ * reforços custa o mesmo que no jogo interativo.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "cenario.h"
+#include "continente.h"
+#include "estatisticas.h"
+#include "grafo.h"
+#include "missao.h"
+#include "partida.h"
+
+// Arena inicial do modelo (jogadores e missões do cenário)
+#define ARENA_MODELO_INICIAL (64 * 1024)
+
+static const char* const MENSAGENS[] = {
+    "ok",
+    "nao e a vez do jogador",
+    "jogada nao permitida nesta fase",
+    "a partida ja terminou",
+    "territorio invalido",
+    "quantidade de tropas invalida",
+    "o territorio ja e do jogador",
+    "o atacante precisa de pelo menos 2 tropas",
+    "os territorios nao fazem fronteira",
+    "ordens de ataque invalidas"
+};
+
+/*
+ * Função: partidaMensagem
+ * 
+ * Retorno: descrição do código, para mensagens ao usuário
+ */
+const char* partidaMensagem(CodigoJogada codigo) {
+    return ((unsigned) codigo <= JOGADA_ORDENS_INVALIDAS) ? MENSAGENS[codigo] : "?";
+}
+
+/*
+ * Função: concluirModelo
+ * 
+ * Garante as fronteiras do modelo (todos fazem fronteira com todos, se
+ * não houver grafo) e confere a quantidade de jogadores.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 caso contrário
+ */
+static int concluirModelo(ModeloPartida* modelo) {
+    if (modelo->numJogadores < 2 || modelo->numJogadores > MAX_JOGADORES_PARTIDA ||
+        modelo->mapa.quantidade == 0) {
+        return 0;
+    }
+    if (modelo->mapa.grafo == NULL) {
+        Grafo* grafo = (Grafo*) malloc(sizeof(Grafo));
+        if (grafo == NULL || !grafoCriarCompleto(grafo, modelo->mapa.quantidade)) {
+            free(grafo);
+            return 0;
+        }
+        if (!mapaDefinirGrafo(&modelo->mapa, grafo)) {
+            grafoLiberar(grafo);
+            free(grafo);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/*
+ * Função: modeloCarregarCenario
+ * 
+ * Monta o modelo a partir de um arquivo de cenário (ver cenario.h). O
+ * cenário precisa de 2 a MAX_JOGADORES_PARTIDA jogadores; os do
+ * computador ("B") são lugares como os outros.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 caso contrário (o modelo fica vazio)
+ */
+int modeloCarregarCenario(ModeloPartida* modelo, const char* caminho, FILE* erros) {
+    memset(modelo, 0, sizeof(*modelo));
+    if (!arenaIniciar(&modelo->arena, ARENA_MODELO_INICIAL)) {
+        return 0;
+    }
+    if (!mapaIniciar(&modelo->mapa, 0) ||
+        !cenarioCarregar(caminho, &modelo->mapa, &modelo->arena, &modelo->jogadores,
+                         &modelo->numJogadores, erros) ||
+        !concluirModelo(modelo)) {
+        modeloLiberar(modelo);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * Função: modeloGerar
+ * 
+ * Monta um modelo sintético, como o do torneio: `territorios`
+ * territórios, todos fazendo fronteira entre si, repartidos
+ * igualmente, em ordem sorteada, entre `jogadores` jogadores sem
+ * missão, com 1 a 3 tropas.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 caso contrário (o modelo fica vazio)
+ */
+int modeloGerar(ModeloPartida* modelo, int territorios, int jogadores, uint64_t semente) {
+    memset(modelo, 0, sizeof(*modelo));
+    if (territorios < jogadores || jogadores < 2 || jogadores > MAX_JOGADORES_PARTIDA ||
+        !arenaIniciar(&modelo->arena, ARENA_MODELO_INICIAL)) {
+        return 0;
+    }
+    modelo->jogadores = (Jogador*) arenaAlocarZerado(&modelo->arena, jogadores, sizeof(Jogador));
+    if (modelo->jogadores == NULL || !mapaIniciar(&modelo->mapa, 0) ||
+        !mapaReservarEm(&modelo->mapa, &modelo->arena, territorios)) {
+        modeloLiberar(modelo);
+        return 0;
+    }
+    modelo->numJogadores = jogadores;
+    for (int j = 0; j < jogadores; j++) {
+        Jogador* jogador = &modelo->jogadores[j];
+        snprintf(jogador->nome, TAM_NOME, "Jogador %d", j + 1);
+        snprintf(jogador->cor, TAM_COR, "j%d", j + 1);
+        jogador->idCor = mapaInternarCor(&modelo->mapa, jogador->cor);
+    }
+
+    Aleatorio rng;
+    aleatorioSemear(&rng, semente);
+    int32_t* ordem = (int32_t*) arenaAlocar(&modelo->arena, territorios * sizeof(int32_t));
+    if (ordem == NULL) {
+        modeloLiberar(modelo);
+        return 0;
+    }
+    for (int i = 0; i < territorios; i++) {
+        ordem[i] = i;
+    }
+    for (int i = territorios - 1; i > 0; i--) {
+        int j = (int) aleatorioLimitado(&rng, (uint32_t) (i + 1));
+        int32_t troca = ordem[i];
+        ordem[i] = ordem[j];
+        ordem[j] = troca;
+    }
+    char nome[TAM_NOME];
+    for (int i = 0; i < territorios; i++) {
+        snprintf(nome, sizeof(nome), "T%d", i + 1);
+        mapaAdicionar(&modelo->mapa, nome, (IdCor) 0, 1 + (int) aleatorioLimitado(&rng, 3));
+    }
+    for (int i = 0; i < territorios; i++) {
+        modelo->mapa.donos[ordem[i]] = modelo->jogadores[i % jogadores].idCor;
+    }
+
+    if (!concluirModelo(modelo)) {
+        modeloLiberar(modelo);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * Função: modeloLiberar
+ * 
+ * Libera o mapa e a arena do modelo. Nenhuma partida criada a partir
+ * dele pode continuar em uso.
+ */
+void modeloLiberar(ModeloPartida* modelo) {
+    mapaLiberar(&modelo->mapa);
+    arenaLiberar(&modelo->arena);
+    memset(modelo, 0, sizeof(*modelo));
+}
+
+// Encerra a partida se alguma missão foi cumprida pela última jogada
+static void conferirMissoes(Partida* partida) {
+    partida->vencedor = jogadorVencedor(partida->jogadores, partida->numJogadores, &partida->mapa);
+    if (partida->vencedor >= 0) {
+        partida->fase = FASE_ENCERRADA;
+    }
+}
+
+/*
+ * Função: comecarVez
+ * 
+ * Passa a vez ao próximo jogador com territórios, a partir de `jogador`,
+ * e calcula o reforço dele. Sem nenhum jogador no mapa, a partida
+ * termina sem vencedor.
+ */
+static void comecarVez(Partida* partida, int jogador) {
+    for (int k = 0; k < partida->numJogadores; k++, jogador++) {
+        if (jogador == partida->numJogadores) {
+            jogador = 0;
+            partida->rodada++;
+        }
+        partida->vez = jogador;
+        int reforco = reforcoDaCor(&partida->mapa, partida->jogadores[jogador].idCor);
+        if (reforco > 0) {
+            partida->reforco = reforco;
+            partida->fase = FASE_REFORCO;
+            return;
+        }
+    }
+    partida->reforco = 0;
+    partida->fase = FASE_ENCERRADA;
+}
+
+/*
+ * Função: modeloCarregarMissoes
+ * 
+ * Troca as missões sorteadas nas partidas pelas de um arquivo de dados
+ * (ver missao.h). Jogadores com missão fixa no cenário a mantêm.
+ * 
+ * Retorno: quantidade de missões carregadas, ou 0 em caso de erro (o
+ * modelo continua com as missões anteriores)
+ */
+int modeloCarregarMissoes(ModeloPartida* modelo, const char* caminho, FILE* erros) {
+    Missao* missoes = (Missao*) arenaAlocar(&modelo->arena, MAX_MISSOES * sizeof(Missao));
+    if (missoes == NULL) {
+        return 0;
+    }
+    int total = carregarMissoes(caminho, missoes, MAX_MISSOES, erros);
+    if (total <= 0) {
+        return 0;
+    }
+    modelo->missoes = missoes;
+    modelo->numMissoes = total;
+    return total;
+}
+
+/*
+ * Função: partidaIniciar
+ * 
+ * Cria uma partida nova a partir do modelo, que deve durar mais que ela.
+ * A semente decide os dados e as missões sorteadas (para os jogadores
+ * sem missão no modelo).
+ * 
+ * Retorno: 1 em caso de sucesso, 0 em caso de falha de alocação
+ */
+int partidaIniciar(Partida* partida, const ModeloPartida* modelo, RegraBatalha regra,
+                   uint64_t semente) {
+    memset(partida, 0, sizeof(*partida));
+    const Mapa* origem = &modelo->mapa;
+    size_t territorios = (size_t) origem->quantidade;
+    size_t capacidade = territorios * (sizeof(IdCor) + sizeof(int32_t) + TAM_NOME) +
+                        4 * ALINHAMENTO_ARENA;
+    if (!arenaIniciar(&partida->arena, capacidade)) {
+        return 0;
+    }
+    Mapa* mapa = &partida->mapa;
+    if (!mapaIniciar(mapa, 0) || !mapaReservarEm(mapa, &partida->arena, origem->quantidade)) {
+        mapaLiberar(mapa);
+        arenaLiberar(&partida->arena);
+        return 0;
+    }
+    memcpy(mapa->nomes, origem->nomes, territorios * sizeof(*origem->nomes));
+    mapa->grafo = origem->grafo;
+
+    // Continentes próprios, que acompanham a posse desta partida
+    if (origem->continentes != NULL) {
+        Continentes* continentes = (Continentes*) malloc(sizeof(Continentes));
+        if (continentes == NULL || !continentesCopiar(continentes, origem->continentes)) {
+            free(continentes);
+            partidaLiberar(partida);
+            return 0;
+        }
+        mapa->continentes = continentes;
+    }
+    if (!mapaCopiarEstado(mapa, origem) ||
+        (mapa->estatisticas = estatisticasCriar(mapa)) == NULL) {
+        partidaLiberar(partida);
+        return 0;
+    }
+
+    partida->regra = regra;
+    aleatorioSemear(&partida->rng, semente);
+    partida->numJogadores = modelo->numJogadores;
+    memset(partida->jogadorDaCor, 0xFF, sizeof(partida->jogadorDaCor));
+    for (int j = 0; j < partida->numJogadores; j++) {
+        Jogador* jogador = &partida->jogadores[j];
+        *jogador = modelo->jogadores[j];
+        if (jogador->missao == NULL) {
+            jogador->missao = (modelo->missoes != NULL)
+                ? sortearMissao(modelo->missoes, modelo->numMissoes, &partida->rng)
+                : sortearMissao(MISSOES_PADRAO, NUM_MISSOES_PADRAO, &partida->rng);
+        }
+        partida->jogadorDaCor[jogador->idCor] = (uint8_t) j;
+    }
+
+    partida->rodada = 1;
+    comecarVez(partida, 0);
+    conferirMissoes(partida);
+    return 1;
+}
+
+/*
+ * Função: partidaLiberar
+ * 
+ * Libera o mapa e a arena da partida (o grafo é do modelo).
+ */
+void partidaLiberar(Partida* partida) {
+    partida->mapa.grafo = NULL;
+    mapaLiberar(&partida->mapa);
+    arenaLiberar(&partida->arena);
+}
+
+// Conferências comuns a todas as jogadas
+static CodigoJogada conferirVez(const Partida* partida, int jogador, FasePartida fase) {
+    if (partida->fase == FASE_ENCERRADA) {
+        return JOGADA_ENCERRADA;
+    }
+    if (jogador != partida->vez) {
+        return JOGADA_FORA_DA_VEZ;
+    }
+    return (partida->fase == fase) ? JOGADA_OK : JOGADA_FASE_ERRADA;
+}
+
+/*
+ * Função: partidaReforcar
+ * 
+ * Posiciona `tropas` do reforço em um território do jogador da vez.
+ * Quando o reforço acaba, começa a fase de ataque.
+ * 
+ * Retorno: JOGADA_OK ou o motivo da recusa
+ */
+CodigoJogada partidaReforcar(Partida* partida, int jogador, int territorio, int tropas) {
+    CodigoJogada codigo = conferirVez(partida, jogador, FASE_REFORCO);
+    if (codigo != JOGADA_OK) {
+        return codigo;
+    }
+    Mapa* mapa = &partida->mapa;
+    if (territorio < 0 || territorio >= mapa->quantidade ||
+        mapa->donos[territorio] != partida->jogadores[jogador].idCor) {
+        return JOGADA_TERRITORIO_INVALIDO;
+    }
+    if (tropas < 1 || tropas > partida->reforco) {
+        return JOGADA_TROPAS_INVALIDAS;
+    }
+    mapaDefinirTropas(mapa, territorio, mapa->tropas[territorio] + tropas);
+    partida->reforco -= tropas;
+    if (partida->reforco == 0) {
+        partida->fase = FASE_ATAQUE;
+    }
+    conferirMissoes(partida);
+    return JOGADA_OK;
+}
+
+/*
+ * Função: partidaAtacar
+ * 
+ * Resolve um ataque do jogador da vez na regra da partida.
+ * 
+ * Retorno: JOGADA_OK (com `resultado`, obrigatório, preenchido) ou o
+ *          motivo da recusa
+ */
+CodigoJogada partidaAtacar(Partida* partida, int jogador, int atacante, int defensor,
+                           ResultadoAtaque* resultado) {
+    CodigoJogada codigo = conferirVez(partida, jogador, FASE_ATAQUE);
+    if (codigo != JOGADA_OK) {
+        return codigo;
+    }
+    Mapa* mapa = &partida->mapa;
+    if (atacante < 0 || atacante >= mapa->quantidade ||
+        mapa->donos[atacante] != partida->jogadores[jogador].idCor) {
+        return JOGADA_TERRITORIO_INVALIDO;
+    }
+    switch (validarAtaque(mapa, atacante, defensor)) {
+        case ATAQUE_OK:
+            break;
+        case ATAQUE_INDICE_INVALIDO:
+            return JOGADA_TERRITORIO_INVALIDO;
+        case ATAQUE_MESMO_TERRITORIO:
+        case ATAQUE_MESMA_COR:
+            return JOGADA_MESMA_COR;
+        case ATAQUE_TROPAS_INSUFICIENTES:
+            return JOGADA_TROPAS_INSUFICIENTES;
+        case ATAQUE_NAO_ADJACENTE:
+            return JOGADA_NAO_ADJACENTE;
+    }
+    rolarAtaque(mapa, partida->regra, atacante, defensor, &partida->rng, resultado);
+    if (resultado->conquista) {
+        conferirMissoes(partida);
+    }
+    return JOGADA_OK;
+}
+
+/*
+ * Função: partidaAtacarLote
+ * 
+ * Resolve um turno de ordens de ataque do jogador da vez (ver turno.h)
+ * e confere as missões uma única vez, depois da última ordem. Se alguma
+ * ordem for recusada por conferirTurno, nenhuma é executada.
+ * 
+ * Parâmetros:
+ *   partida - partida em andamento
+ *   jogador - jogador que mandou as ordens
+ *   ordens, numOrdens - ordens do turno, na ordem de execução
+ *   resultados - recebe o resultado de cada ordem (obrigatório)
+ *   ordemRecusada - recebe o índice da ordem recusada, ou -1 (pode ser NULL)
+ * 
+ * Retorno: JOGADA_OK ou o motivo da recusa
+ */
+CodigoJogada partidaAtacarLote(Partida* partida, int jogador, const OrdemTurno* ordens,
+                               int numOrdens, ResultadoOrdem* resultados, int* ordemRecusada) {
+    if (ordemRecusada != NULL) {
+        *ordemRecusada = -1;
+    }
+    CodigoJogada codigo = conferirVez(partida, jogador, FASE_ATAQUE);
+    if (codigo != JOGADA_OK) {
+        return codigo;
+    }
+    IdCor cor = partida->jogadores[jogador].idCor;
+    switch (conferirTurno(&partida->mapa, cor, ordens, numOrdens, ordemRecusada)) {
+        case TURNO_OK:
+            break;
+        case TURNO_INDICE_INVALIDO:
+        case TURNO_ATACANTE_ALHEIO:
+            return JOGADA_TERRITORIO_INVALIDO;
+        case TURNO_DEFENSOR_PROPRIO:
+            return JOGADA_MESMA_COR;
+        case TURNO_TROPAS_INSUFICIENTES:
+            return JOGADA_TROPAS_INSUFICIENTES;
+        case TURNO_NAO_ADJACENTE:
+            return JOGADA_NAO_ADJACENTE;
+        default:
+            return JOGADA_ORDENS_INVALIDAS;
+    }
+    if (executarTurno(&partida->mapa, partida->regra, cor, ordens, numOrdens, &partida->rng,
+                      resultados, NULL, NULL) > 0) {
+        conferirMissoes(partida);
+    }
+    return JOGADA_OK;
+}
+
+/*
+ * Função: partidaPassar
+ * 
+ * Encerra os ataques do jogador da vez e começa a vez do próximo, com
+ * o reforço dele.
+ * 
+ * Retorno: JOGADA_OK ou o motivo da recusa
+ */
+CodigoJogada partidaPassar(Partida* partida, int jogador) {
+    CodigoJogada codigo = conferirVez(partida, jogador, FASE_ATAQUE);
+    if (codigo != JOGADA_OK) {
+        return codigo;
+    }
+    comecarVez(partida, jogador + 1);
+    return JOGADA_OK;
+}
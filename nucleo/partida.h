@@ -0,0 +1,128 @@
+/*
+ * Partidas em andamento, sem entrada/saída
+ * 
+ * Uma Partida guarda o estado completo de um jogo (mapa, jogadores, vez
+ * e fase do turno) e aplica as jogadas de qualquer jogador sem ler nem
+ * escrever nada, para que um único processo (o servidor, servidor.h)
+ * mantenha milhares delas ao mesmo tempo.
+ * 
+ * Todas as partidas de um servidor partem do mesmo ModeloPartida, um
+ * cenário carregado (cenario.h) ou um mapa gerado: cada partida copia
+ * donos, tropas, nomes e continentes para a sua própria arena e só
+ * empresta o grafo do modelo, que não muda.
+ * 
+ * Turno: o jogador da vez recebe reforcoDaCor tropas (FASE_REFORCO) e,
+ * depois de posicioná-las, ataca quantas vezes quiser (FASE_ATAQUE) até
+ * passar a vez. Jogadores sem territórios são pulados. Depois de cada
+ * jogada as missões são conferidas na ordem dos jogadores, como no jogo
+ * interativo, e a primeira cumprida encerra a partida. Os ataques também
+ * podem vir em lote (partidaAtacarLote, ver turno.h), com as missões
+ * conferidas uma vez só, depois da última ordem.
+ */
+
+#ifndef WAR_PARTIDA_H
+#define WAR_PARTIDA_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "aleatorio.h"
+#include "batalha.h"
+#include "mapa.h"
+#include "turno.h"
+
+// Jogadores por partida
+#define MAX_JOGADORES_PARTIDA 8
+
+/*
+ * Struct ModeloPartida
+ * 
+ * Mapa e jogadores de onde as partidas são copiadas. O mapa sempre tem
+ * grafo (completo, se o cenário não tiver fronteiras), e todo jogador
+ * tem cor internada; a missão pode ser NULL (sorteada a cada partida
+ * entre `missoes`, ou entre MISSOES_PADRAO se `missoes` for NULL).
+ */
+typedef struct {
+    Mapa mapa;
+    Arena arena;              // Jogadores, missões e vetores do mapa
+    Jogador* jogadores;
+    int numJogadores;
+    const Missao* missoes;    // Missões sorteadas (NULL: MISSOES_PADRAO)
+    int numMissoes;
+} ModeloPartida;
+
+/*
+ * Enum FasePartida
+ * 
+ * Momento do turno do jogador da vez.
+ */
+typedef enum {
+    FASE_REFORCO = 0,         // Posicionando as tropas de reforço
+    FASE_ATAQUE,              // Atacando, até passar a vez
+    FASE_ENCERRADA            // Algum jogador cumpriu a missão
+} FasePartida;
+
+/*
+ * Enum CodigoJogada
+ * 
+ * Resultado de uma jogada. Jogadas recusadas não alteram a partida.
+ */
+typedef enum {
+    JOGADA_OK = 0,
+    JOGADA_FORA_DA_VEZ,          // Não é a vez do jogador
+    JOGADA_FASE_ERRADA,          // Jogada não permitida na fase atual
+    JOGADA_ENCERRADA,            // A partida já tem vencedor
+    JOGADA_TERRITORIO_INVALIDO,  // Território fora do mapa ou de outro jogador
+    JOGADA_TROPAS_INVALIDAS,     // Reforço fora de 1..tropas restantes
+    JOGADA_MESMA_COR,            // Ataque contra território do próprio jogador
+    JOGADA_TROPAS_INSUFICIENTES, // Atacante com menos de 2 tropas
+    JOGADA_NAO_ADJACENTE,        // Os territórios não fazem fronteira
+    JOGADA_ORDENS_INVALIDAS      // Lote com ordens demais ou política inválida
+} CodigoJogada;
+
+/*
+ * Struct Partida
+ * 
+ * Jogadores são numerados de 0 a numJogadores - 1, na ordem de jogada.
+ */
+typedef struct {
+    Mapa mapa;
+    Arena arena;                 // Vetores do mapa
+    Jogador jogadores[MAX_JOGADORES_PARTIDA];
+    int numJogadores;
+    uint8_t jogadorDaCor[MAX_CORES]; // Jogador de cada cor (0xFF: nenhum)
+    RegraBatalha regra;
+    Aleatorio rng;
+    FasePartida fase;
+    int vez;                     // Jogador da vez
+    int reforco;                 // Tropas de reforço ainda a posicionar
+    int rodada;                  // Rodadas completas (começa em 1)
+    int vencedor;                // Jogador vencedor (-1 enquanto não houver)
+} Partida;
+
+int modeloCarregarCenario(ModeloPartida* modelo, const char* caminho, FILE* erros);
+int modeloGerar(ModeloPartida* modelo, int territorios, int jogadores, uint64_t semente);
+int modeloCarregarMissoes(ModeloPartida* modelo, const char* caminho, FILE* erros);
+void modeloLiberar(ModeloPartida* modelo);
+
+int partidaIniciar(Partida* partida, const ModeloPartida* modelo, RegraBatalha regra,
+                   uint64_t semente);
+void partidaLiberar(Partida* partida);
+const char* partidaMensagem(CodigoJogada codigo);
+CodigoJogada partidaReforcar(Partida* partida, int jogador, int territorio, int tropas);
+CodigoJogada partidaAtacar(Partida* partida, int jogador, int atacante, int defensor,
+                           ResultadoAtaque* resultado);
+CodigoJogada partidaAtacarLote(Partida* partida, int jogador, const OrdemTurno* ordens,
+                               int numOrdens, ResultadoOrdem* resultados, int* ordemRecusada);
+CodigoJogada partidaPassar(Partida* partida, int jogador);
+
+/*
+ * Função: partidaDonoDe
+ * 
+ * Retorno: jogador que ocupa o território, ou -1 se for de uma cor sem jogador
+ */
+static inline int partidaDonoDe(const Partida* partida, int territorio) {
+    uint8_t jogador = partida->jogadorDaCor[partida->mapa.donos[territorio]];
+    return (jogador == 0xFF) ? -1 : jogador;
+}
+
+#endif
@@ -0,0 +1,279 @@
+/*
+ * Perfil de desempenho embutido
+ * 
+ * Registro dos buffers por thread, calibração de ciclos por segundo e
+ * relatórios (histograma em texto ou JSON).
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "perfil.h"
+
+_Thread_local BufferPerfil* perfilLocal = NULL;
+
+// Buffers de todas as threads que já contaram algo (nunca são liberados)
+static BufferPerfil* buffers = NULL;
+static pthread_mutex_t travaBuffers = PTHREAD_MUTEX_INITIALIZER;
+
+// Referência para converter ciclos em segundos
+static pthread_once_t calibracao = PTHREAD_ONCE_INIT;
+static uint64_t ciclosReferencia;
+static double segundosReferencia;
+
+static const char* const NOMES_CONTADORES[NUM_CONTADORES_PERFIL] = {
+    "turnos", "ataques", "conquistas", "comparacoes_cor",
+    "varreduras", "territorios_varridos", "posicoes_ia"
+};
+
+static const char* const NOMES_TRECHOS[NUM_TRECHOS_PERFIL] = {
+    "turno", "atacar", "verificarVitoria", "verificarMissao", "buscaIA"
+};
+
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void calibrar(void) {
+    ciclosReferencia = perfilCiclos();
+    segundosReferencia = agora();
+}
+
+static void zerarBuffer(BufferPerfil* buffer) {
+    for (int c = 0; c < NUM_CONTADORES_PERFIL; c++) {
+        atomic_store_explicit(&buffer->contadores[c], 0, memory_order_relaxed);
+    }
+    for (int t = 0; t < NUM_TRECHOS_PERFIL; t++) {
+        TempoPerfil* tempo = &buffer->trechos[t];
+        atomic_store_explicit(&tempo->chamadas, 0, memory_order_relaxed);
+        atomic_store_explicit(&tempo->ciclos, 0, memory_order_relaxed);
+        atomic_store_explicit(&tempo->minimo, UINT64_MAX, memory_order_relaxed);
+        atomic_store_explicit(&tempo->maximo, 0, memory_order_relaxed);
+        for (int k = 0; k < FAIXAS_PERFIL; k++) {
+            atomic_store_explicit(&tempo->faixas[k], 0, memory_order_relaxed);
+        }
+    }
+}
+
+/*
+ * Função: perfilRegistrarThread
+ * 
+ * Cria o buffer da thread atual na primeira contagem dela.
+ * 
+ * Retorno: o buffer, ou NULL em caso de falha de alocação (a contagem é
+ *          perdida, o programa segue)
+ */
+BufferPerfil* perfilRegistrarThread(void) {
+    pthread_once(&calibracao, calibrar);
+    BufferPerfil* buffer = (BufferPerfil*) calloc(1, sizeof(BufferPerfil));
+    if (buffer == NULL) {
+        return NULL;
+    }
+    zerarBuffer(buffer);
+    pthread_mutex_lock(&travaBuffers);
+    buffer->proximo = buffers;
+    buffers = buffer;
+    pthread_mutex_unlock(&travaBuffers);
+    perfilLocal = buffer;
+    return buffer;
+}
+
+// Incremento feito só pela thread dona: carga e escrita relaxadas, sem trava
+static inline void somarRelaxado(_Atomic uint64_t* valor, uint64_t quantidade) {
+    atomic_store_explicit(valor, atomic_load_explicit(valor, memory_order_relaxed) + quantidade,
+                          memory_order_relaxed);
+}
+
+/*
+ * Função: perfilFecharEscopo
+ * 
+ * Chamada ao sair do bloco de um PERFIL_ESCOPO: soma a duração ao trecho.
+ */
+void perfilFecharEscopo(EscopoPerfil* escopo) {
+    uint64_t ciclos = perfilCiclos() - escopo->inicio;
+    BufferPerfil* buffer = (perfilLocal != NULL) ? perfilLocal : perfilRegistrarThread();
+    if (buffer == NULL) {
+        return;
+    }
+    TempoPerfil* tempo = &buffer->trechos[escopo->trecho];
+    somarRelaxado(&tempo->chamadas, 1);
+    somarRelaxado(&tempo->ciclos, ciclos);
+    if (ciclos < atomic_load_explicit(&tempo->minimo, memory_order_relaxed)) {
+        atomic_store_explicit(&tempo->minimo, ciclos, memory_order_relaxed);
+    }
+    if (ciclos > atomic_load_explicit(&tempo->maximo, memory_order_relaxed)) {
+        atomic_store_explicit(&tempo->maximo, ciclos, memory_order_relaxed);
+    }
+    int faixa = (ciclos > 0) ? 63 - __builtin_clzll(ciclos) : 0;
+    somarRelaxado(&tempo->faixas[faixa], 1);
+}
+
+/*
+ * Função: perfilAtivo
+ * 
+ * Retorno: 1 se o programa foi compilado com -DWAR_PERFIL
+ */
+int perfilAtivo(void) {
+#ifdef WAR_PERFIL
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+/*
+ * Função: perfilZerar
+ * 
+ * Zera os contadores de todas as threads (as contagens feitas durante a
+ * chamada podem se perder).
+ */
+void perfilZerar(void) {
+    pthread_mutex_lock(&travaBuffers);
+    for (BufferPerfil* b = buffers; b != NULL; b = b->proximo) {
+        zerarBuffer(b);
+    }
+    pthread_mutex_unlock(&travaBuffers);
+}
+
+// Soma os buffers de todas as threads em `total` (não atômico)
+typedef struct {
+    uint64_t contadores[NUM_CONTADORES_PERFIL];
+    struct {
+        uint64_t chamadas, ciclos, minimo, maximo;
+        uint64_t faixas[FAIXAS_PERFIL];
+    } trechos[NUM_TRECHOS_PERFIL];
+    int threads;
+} TotalPerfil;
+
+static void combinar(TotalPerfil* total) {
+    memset(total, 0, sizeof(TotalPerfil));
+    for (int t = 0; t < NUM_TRECHOS_PERFIL; t++) {
+        total->trechos[t].minimo = UINT64_MAX;
+    }
+    pthread_mutex_lock(&travaBuffers);
+    for (const BufferPerfil* b = buffers; b != NULL; b = b->proximo) {
+        total->threads++;
+        for (int c = 0; c < NUM_CONTADORES_PERFIL; c++) {
+            total->contadores[c] += atomic_load_explicit(&b->contadores[c], memory_order_relaxed);
+        }
+        for (int t = 0; t < NUM_TRECHOS_PERFIL; t++) {
+            const TempoPerfil* tempo = &b->trechos[t];
+            uint64_t minimo = atomic_load_explicit(&tempo->minimo, memory_order_relaxed);
+            uint64_t maximo = atomic_load_explicit(&tempo->maximo, memory_order_relaxed);
+            total->trechos[t].chamadas += atomic_load_explicit(&tempo->chamadas, memory_order_relaxed);
+            total->trechos[t].ciclos += atomic_load_explicit(&tempo->ciclos, memory_order_relaxed);
+            if (minimo < total->trechos[t].minimo) {
+                total->trechos[t].minimo = minimo;
+            }
+            if (maximo > total->trechos[t].maximo) {
+                total->trechos[t].maximo = maximo;
+            }
+            for (int k = 0; k < FAIXAS_PERFIL; k++) {
+                total->trechos[t].faixas[k] +=
+                    atomic_load_explicit(&tempo->faixas[k], memory_order_relaxed);
+            }
+        }
+    }
+    pthread_mutex_unlock(&travaBuffers);
+}
+
+// Ciclos por segundo medidos desde o primeiro registro de thread
+static double ciclosPorSegundo(void) {
+    pthread_once(&calibracao, calibrar);
+    double segundos = agora() - segundosReferencia;
+    uint64_t ciclos = perfilCiclos() - ciclosReferencia;
+    return (segundos > 1e-3 && ciclos > 0) ? ciclos / segundos : 1e9;
+}
+
+/*
+ * Função: perfilEscreverTexto
+ * 
+ * Escreve os contadores e, para cada trecho cronometrado, o resumo e o
+ * histograma das durações (uma barra por faixa de potência de 2).
+ */
+void perfilEscreverTexto(FILE* arquivo) {
+    if (!perfilAtivo()) {
+        fprintf(arquivo, "Perfil desativado nesta compilacao (compile com -DWAR_PERFIL).\n");
+        return;
+    }
+    TotalPerfil total;
+    combinar(&total);
+    double frequencia = ciclosPorSegundo();
+
+    fprintf(arquivo, "\n=== PERFIL (%d threads, %.2f GHz) ===\n", total.threads, frequencia / 1e9);
+    for (int c = 0; c < NUM_CONTADORES_PERFIL; c++) {
+        fprintf(arquivo, "%-22s %15llu\n", NOMES_CONTADORES[c],
+                (unsigned long long) total.contadores[c]);
+    }
+    for (int t = 0; t < NUM_TRECHOS_PERFIL; t++) {
+        uint64_t chamadas = total.trechos[t].chamadas;
+        if (chamadas == 0) {
+            continue;
+        }
+        uint64_t maisFrequente = 0;
+        for (int k = 0; k < FAIXAS_PERFIL; k++) {
+            if (total.trechos[t].faixas[k] > maisFrequente) {
+                maisFrequente = total.trechos[t].faixas[k];
+            }
+        }
+        fprintf(arquivo, "\n%s: %llu chamadas, %.3f ms no total, media %.0f ciclos "
+                         "(min %llu, max %llu)\n",
+                NOMES_TRECHOS[t], (unsigned long long) chamadas,
+                total.trechos[t].ciclos / frequencia * 1e3,
+                (double) total.trechos[t].ciclos / chamadas,
+                (unsigned long long) total.trechos[t].minimo,
+                (unsigned long long) total.trechos[t].maximo);
+        for (int k = 0; k < FAIXAS_PERFIL; k++) {
+            uint64_t n = total.trechos[t].faixas[k];
+            if (n == 0) {
+                continue;
+            }
+            char barra[41];
+            int largura = (int) (40 * n / maisFrequente);
+            memset(barra, '#', (size_t) largura);
+            barra[largura] = '\0';
+            fprintf(arquivo, "  >= 2^%-2d ciclos %10llu %s\n", k, (unsigned long long) n, barra);
+        }
+    }
+}
+
+/*
+ * Função: perfilEscreverJson
+ * 
+ * Escreve o mesmo relatório em JSON: contadores, e por trecho as somas e
+ * o histograma como pares [faixa, quantidade] das faixas não vazias.
+ */
+void perfilEscreverJson(FILE* arquivo) {
+    TotalPerfil total;
+    combinar(&total);
+    fprintf(arquivo, "{\"ativo\": %s, \"threads\": %d, \"ciclosPorSegundo\": %.0f,\n",
+            perfilAtivo() ? "true" : "false", total.threads, ciclosPorSegundo());
+    fprintf(arquivo, " \"contadores\": {");
+    for (int c = 0; c < NUM_CONTADORES_PERFIL; c++) {
+        fprintf(arquivo, "%s\"%s\": %llu", c ? ", " : "", NOMES_CONTADORES[c],
+                (unsigned long long) total.contadores[c]);
+    }
+    fprintf(arquivo, "},\n \"trechos\": {");
+    for (int t = 0; t < NUM_TRECHOS_PERFIL; t++) {
+        uint64_t chamadas = total.trechos[t].chamadas;
+        fprintf(arquivo, "%s\n  \"%s\": {\"chamadas\": %llu, \"ciclos\": %llu, "
+                         "\"minimo\": %llu, \"maximo\": %llu, \"histograma\": [",
+                t ? "," : "", NOMES_TRECHOS[t], (unsigned long long) chamadas,
+                (unsigned long long) total.trechos[t].ciclos,
+                (unsigned long long) (chamadas ? total.trechos[t].minimo : 0),
+                (unsigned long long) total.trechos[t].maximo);
+        int primeira = 1;
+        for (int k = 0; k < FAIXAS_PERFIL; k++) {
+            if (total.trechos[t].faixas[k] > 0) {
+                fprintf(arquivo, "%s[%d, %llu]", primeira ? "" : ", ", k,
+                        (unsigned long long) total.trechos[t].faixas[k]);
+                primeira = 0;
+            }
+        }
+        fprintf(arquivo, "]}");
+    }
+    fprintf(arquivo, "\n }\n}\n");
+}
@@ -0,0 +1,151 @@
+/*
+ * Perfil de desempenho embutido
+ * 
+ * Contadores de eventos (ataques, conquistas, comparações de cor,
+ * varreduras do mapa) e cronômetros de trechos em ciclos, com histograma
+ * em potências de 2. Cada thread acumula no seu próprio buffer, sem
+ * travas; perfilEscreverTexto e perfilEscreverJson somam os buffers de
+ * todas as threads na hora da consulta.
+ * 
+ * Só existe quando compilado com -DWAR_PERFIL. Sem a definição, as
+ * macros PERFIL_* viram ((void) 0) e não custam nada: podem ficar no
+ * código de produção.
+ */
+
+#ifndef WAR_PERFIL_H
+#define WAR_PERFIL_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * Enum ContadorPerfil
+ * 
+ * Eventos contados (a ordem é a dos relatórios).
+ */
+typedef enum {
+    PERFIL_TURNOS = 0,           // Opções executadas no laço do menu
+    PERFIL_ATAQUES,              // Ataques resolvidos
+    PERFIL_CONQUISTAS,           // Ataques que trocaram o dono do defensor
+    PERFIL_COMPARACOES_COR,      // strcmp/strncmp entre nomes de cores
+    PERFIL_VARREDURAS,           // Laços sobre o mapa inteiro
+    PERFIL_TERRITORIOS_VARRIDOS, // Territórios visitados por esses laços
+    PERFIL_POSICOES_IA,          // Posições visitadas pela busca da IA
+    NUM_CONTADORES_PERFIL
+} ContadorPerfil;
+
+/*
+ * Enum TrechoPerfil
+ * 
+ * Trechos cronometrados.
+ */
+typedef enum {
+    PERFIL_TURNO = 0,            // Uma opção do menu (sem a espera pela entrada)
+    PERFIL_ATACAR,               // atacar
+    PERFIL_VERIFICAR_VITORIA,    // verificarVitoria
+    PERFIL_VERIFICAR_MISSAO,     // verificarMissao
+    PERFIL_BUSCA_IA,             // iaEscolherAtaque
+    NUM_TRECHOS_PERFIL
+} TrechoPerfil;
+
+// Faixas do histograma: a faixa k conta durações em [2^k, 2^(k+1)) ciclos
+#define FAIXAS_PERFIL 64
+
+/*
+ * Struct TempoPerfil
+ * 
+ * Acumulado de um trecho em uma thread.
+ */
+typedef struct {
+    _Atomic uint64_t chamadas;
+    _Atomic uint64_t ciclos;
+    _Atomic uint64_t minimo;
+    _Atomic uint64_t maximo;
+    _Atomic uint64_t faixas[FAIXAS_PERFIL];
+} TempoPerfil;
+
+/*
+ * Struct BufferPerfil
+ * 
+ * Contadores de uma thread. Só a dona escreve (com operações relaxadas,
+ * sem instruções de trava); a consulta lê de qualquer thread.
+ */
+typedef struct BufferPerfil {
+    _Atomic uint64_t contadores[NUM_CONTADORES_PERFIL];
+    TempoPerfil trechos[NUM_TRECHOS_PERFIL];
+    struct BufferPerfil* proximo;
+} BufferPerfil;
+
+/*
+ * Struct EscopoPerfil
+ * 
+ * Cronômetro aberto por PERFIL_ESCOPO.
+ */
+typedef struct {
+    TrechoPerfil trecho;
+    uint64_t inicio;
+} EscopoPerfil;
+
+extern _Thread_local BufferPerfil* perfilLocal;
+
+BufferPerfil* perfilRegistrarThread(void);
+void perfilFecharEscopo(EscopoPerfil* escopo);
+int perfilAtivo(void);
+void perfilZerar(void);
+void perfilEscreverTexto(FILE* arquivo);
+void perfilEscreverJson(FILE* arquivo);
+
+/*
+ * Função: perfilCiclos
+ * 
+ * Retorno: contador de ciclos do processador (nanossegundos do relógio
+ *          monotônico fora do x86)
+ */
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline uint64_t perfilCiclos(void) {
+    return __rdtsc();
+}
+#else
+#include <time.h>
+static inline uint64_t perfilCiclos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+#endif
+
+/*
+ * Função: perfilSomar
+ * 
+ * Soma `quantidade` ao contador no buffer da thread atual.
+ */
+static inline void perfilSomar(ContadorPerfil contador, uint64_t quantidade) {
+    BufferPerfil* buffer = (perfilLocal != NULL) ? perfilLocal : perfilRegistrarThread();
+    if (buffer == NULL) {
+        return;
+    }
+    _Atomic uint64_t* c = &buffer->contadores[contador];
+    atomic_store_explicit(c, atomic_load_explicit(c, memory_order_relaxed) + quantidade,
+                          memory_order_relaxed);
+}
+
+#ifdef WAR_PERFIL
+#define PERFIL_JUNTAR_(a, b) a##b
+#define PERFIL_JUNTAR(a, b) PERFIL_JUNTAR_(a, b)
+// Conta um evento
+#define PERFIL_CONTAR(contador) perfilSomar((contador), 1)
+// Soma uma quantidade a um contador
+#define PERFIL_SOMAR(contador, quantidade) perfilSomar((contador), (uint64_t) (quantidade))
+// Cronometra do ponto da macro até o fim do bloco (qualquer saída)
+#define PERFIL_ESCOPO(trecho)                                                              \
+    EscopoPerfil PERFIL_JUNTAR(escopoPerfil, __LINE__)                                     \
+        __attribute__((cleanup(perfilFecharEscopo))) = {(trecho), perfilCiclos()}
+#else
+#define PERFIL_CONTAR(contador) ((void) 0)
+#define PERFIL_SOMAR(contador, quantidade) ((void) 0)
+#define PERFIL_ESCOPO(trecho) ((void) 0)
+#endif
+
+#endif
@@ -0,0 +1,276 @@
+/*
+ * Pool de threads com roubo de trabalho
+ * 
+ * O trabalhador 0 é a própria thread que chama poolExecutar; os demais
+ * ficam bloqueados entre uma execução e outra. Cada trabalhador guarda a
+ * sua faixa [inicio, fim) protegida por um mutex próprio: o dono retira
+ * tarefas do início e os ladrões levam a metade final.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "pool.h"
+
+/*
+ * Struct Faixa
+ * 
+ * Tarefas pendentes de um trabalhador, alinhada em linha de cache para
+ * evitar falso compartilhamento entre threads.
+ */
+typedef struct {
+    pthread_mutex_t trava;
+    int inicio;
+    int fim;
+} __attribute__((aligned(64))) Faixa;
+
+struct Pool {
+    int tamanho;
+    pthread_t* threads;
+    Faixa* faixas;
+
+    pthread_mutex_t trava;
+    pthread_cond_t inicioRodada;
+    pthread_cond_t fimRodada;
+    unsigned long rodada;   // Incrementada a cada poolExecutar
+    int ativos;             // Trabalhadores auxiliares ainda na rodada
+    int encerrar;
+
+    FuncaoTarefa funcao;
+    void* contexto;
+};
+
+typedef struct {
+    Pool* pool;
+    int indice;
+} ArgumentoThread;
+
+/*
+ * Função: pegarTarefa
+ * 
+ * Retira a próxima tarefa da faixa do próprio trabalhador.
+ * 
+ * Retorno: índice da tarefa, ou -1 se a faixa estiver vazia
+ */
+static int pegarTarefa(Faixa* faixa) {
+    int tarefa = -1;
+    pthread_mutex_lock(&faixa->trava);
+    if (faixa->inicio < faixa->fim) {
+        tarefa = faixa->inicio++;
+    }
+    pthread_mutex_unlock(&faixa->trava);
+    return tarefa;
+}
+
+/*
+ * Função: roubarTarefas
+ * 
+ * Procura outro trabalhador com tarefas pendentes e move a metade final
+ * da faixa dele para a faixa do ladrão.
+ * 
+ * Retorno: 1 se conseguiu roubar, 0 se não há mais trabalho
+ */
+static int roubarTarefas(Pool* pool, int ladrao) {
+    for (int passo = 1; passo < pool->tamanho; passo++) {
+        Faixa* vitima = &pool->faixas[(ladrao + passo) % pool->tamanho];
+        int inicio = 0, fim = 0;
+
+        pthread_mutex_lock(&vitima->trava);
+        int restantes = vitima->fim - vitima->inicio;
+        if (restantes > 0) {
+            int levar = (restantes + 1) / 2;
+            fim = vitima->fim;
+            inicio = fim - levar;
+            vitima->fim = inicio;
+        }
+        pthread_mutex_unlock(&vitima->trava);
+
+        if (fim > inicio) {
+            Faixa* propria = &pool->faixas[ladrao];
+            pthread_mutex_lock(&propria->trava);
+            propria->inicio = inicio;
+            propria->fim = fim;
+            pthread_mutex_unlock(&propria->trava);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Função: trabalhar
+ * 
+ * Executa tarefas da própria faixa e rouba das outras até acabar tudo.
+ */
+static void trabalhar(Pool* pool, int indice) {
+    do {
+        int tarefa;
+        while ((tarefa = pegarTarefa(&pool->faixas[indice])) >= 0) {
+            pool->funcao(pool->contexto, tarefa, indice);
+        }
+    } while (roubarTarefas(pool, indice));
+}
+
+static void* lacoTrabalhador(void* arg) {
+    Pool* pool = ((ArgumentoThread*) arg)->pool;
+    int indice = ((ArgumentoThread*) arg)->indice;
+    unsigned long vista = 0;
+    free(arg);
+
+    for (;;) {
+        pthread_mutex_lock(&pool->trava);
+        while (pool->rodada == vista && !pool->encerrar) {
+            pthread_cond_wait(&pool->inicioRodada, &pool->trava);
+        }
+        if (pool->encerrar) {
+            pthread_mutex_unlock(&pool->trava);
+            return NULL;
+        }
+        vista = pool->rodada;
+        pthread_mutex_unlock(&pool->trava);
+
+        trabalhar(pool, indice);
+
+        pthread_mutex_lock(&pool->trava);
+        if (--pool->ativos == 0) {
+            pthread_cond_signal(&pool->fimRodada);
+        }
+        pthread_mutex_unlock(&pool->trava);
+    }
+}
+
+/*
+ * Função: poolCriar
+ * 
+ * Cria um pool com o número de trabalhadores pedido (incluindo a thread
+ * que chamará poolExecutar). Valores <= 0 usam todos os núcleos.
+ * 
+ * Retorno: ponteiro para o pool, ou NULL em caso de falha
+ */
+Pool* poolCriar(int numTrabalhadores) {
+    if (numTrabalhadores <= 0) {
+        numTrabalhadores = numeroNucleos();
+    }
+
+    Pool* pool = (Pool*) calloc(1, sizeof(Pool));
+    if (pool == NULL) {
+        return NULL;
+    }
+    pool->tamanho = numTrabalhadores;
+    pool->faixas = (Faixa*) aligned_alloc(64, numTrabalhadores * sizeof(Faixa));
+    pool->threads = (pthread_t*) calloc(numTrabalhadores, sizeof(pthread_t));
+    if (pool->faixas == NULL || pool->threads == NULL) {
+        free(pool->faixas);
+        free(pool->threads);
+        free(pool);
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->trava, NULL);
+    pthread_cond_init(&pool->inicioRodada, NULL);
+    pthread_cond_init(&pool->fimRodada, NULL);
+    for (int i = 0; i < numTrabalhadores; i++) {
+        pthread_mutex_init(&pool->faixas[i].trava, NULL);
+        pool->faixas[i].inicio = pool->faixas[i].fim = 0;
+    }
+
+    for (int i = 1; i < numTrabalhadores; i++) {
+        ArgumentoThread* arg = (ArgumentoThread*) malloc(sizeof(ArgumentoThread));
+        if (arg == NULL) {
+            pool->tamanho = i;
+            break;
+        }
+        arg->pool = pool;
+        arg->indice = i;
+        if (pthread_create(&pool->threads[i], NULL, lacoTrabalhador, arg) != 0) {
+            free(arg);
+            pool->tamanho = i;
+            break;
+        }
+    }
+    return pool;
+}
+
+/*
+ * Função: poolDestruir
+ * 
+ * Encerra as threads auxiliares e libera o pool.
+ */
+void poolDestruir(Pool* pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->trava);
+    pool->encerrar = 1;
+    pthread_cond_broadcast(&pool->inicioRodada);
+    pthread_mutex_unlock(&pool->trava);
+
+    for (int i = 1; i < pool->tamanho; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    for (int i = 0; i < pool->tamanho; i++) {
+        pthread_mutex_destroy(&pool->faixas[i].trava);
+    }
+    pthread_mutex_destroy(&pool->trava);
+    pthread_cond_destroy(&pool->inicioRodada);
+    pthread_cond_destroy(&pool->fimRodada);
+    free(pool->faixas);
+    free(pool->threads);
+    free(pool);
+}
+
+/*
+ * Função: poolTamanho
+ * 
+ * Retorno: número de trabalhadores do pool
+ */
+int poolTamanho(const Pool* pool) {
+    return pool->tamanho;
+}
+
+/*
+ * Função: poolExecutar
+ * 
+ * Executa funcao(contexto, t, trabalhador) para t = 0..numTarefas-1 e
+ * só retorna quando todas as tarefas tiverem terminado.
+ * 
+ * Parâmetros:
+ *   pool - pool de threads
+ *   numTarefas - quantidade de tarefas
+ *   funcao - função chamada para cada tarefa
+ *   contexto - ponteiro repassado à função
+ */
+void poolExecutar(Pool* pool, int numTarefas, FuncaoTarefa funcao, void* contexto) {
+    // Divide as tarefas em faixas contíguas, uma por trabalhador
+    for (int i = 0; i < pool->tamanho; i++) {
+        pool->faixas[i].inicio = (int) ((long long) numTarefas * i / pool->tamanho);
+        pool->faixas[i].fim = (int) ((long long) numTarefas * (i + 1) / pool->tamanho);
+    }
+    pool->funcao = funcao;
+    pool->contexto = contexto;
+
+    pthread_mutex_lock(&pool->trava);
+    pool->ativos = pool->tamanho - 1;
+    pool->rodada++;
+    pthread_cond_broadcast(&pool->inicioRodada);
+    pthread_mutex_unlock(&pool->trava);
+
+    trabalhar(pool, 0);
+
+    pthread_mutex_lock(&pool->trava);
+    while (pool->ativos > 0) {
+        pthread_cond_wait(&pool->fimRodada, &pool->trava);
+    }
+    pthread_mutex_unlock(&pool->trava);
+}
+
+/*
+ * Função: numeroNucleos
+ * 
+ * Retorno: quantidade de processadores disponíveis (pelo menos 1)
+ */
+int numeroNucleos(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int) n : 1;
+}
@@ -0,0 +1,28 @@
+/*
+ * Pool de threads com roubo de trabalho
+ * 
+ * Executa um laço paralelo de tarefas numeradas 0..n-1. Cada trabalhador
+ * recebe uma faixa contígua de tarefas e, quando termina a sua, rouba a
+ * metade final da faixa de outro trabalhador ainda ocupado.
+ */
+
+#ifndef WAR_POOL_H
+#define WAR_POOL_H
+
+/*
+ * Tipo FuncaoTarefa
+ * 
+ * Função executada para cada tarefa. `trabalhador` é o índice da thread
+ * (0..tamanho-1) e pode ser usado para acessar dados exclusivos dela.
+ */
+typedef void (*FuncaoTarefa)(void* contexto, int tarefa, int trabalhador);
+
+typedef struct Pool Pool;
+
+Pool* poolCriar(int numTrabalhadores);
+void poolDestruir(Pool* pool);
+int poolTamanho(const Pool* pool);
+void poolExecutar(Pool* pool, int numTarefas, FuncaoTarefa funcao, void* contexto);
+int numeroNucleos(void);
+
+#endif
@@ -0,0 +1,553 @@
+/*
+ * Registro de eventos da partida e reconstrução por replay
+ * 
+ * Gravação em blocos com O_APPEND, checkpoints por snapshotSalvar e
+ * leitura dos eventos por mmap no replay.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "registro.h"
+#include "snapshot.h"
+
+// Valor gravado em ordemBytes para detectar arquivos de outra arquitetura
+#define MARCA_ORDEM_BYTES 0x01020304u
+
+// Espaço para "<caminho>.<turno>.snp"
+#define FOLGA_NOME_CHECKPOINT 32
+
+_Static_assert(sizeof(Evento) == 20, "Evento deve ter 20 bytes sem preenchimento");
+
+/*
+ * Struct Registro
+ * 
+ * Registro aberto para gravação. Os jogadores são só referenciados: os
+ * checkpoints gravam as missões de cada um.
+ */
+struct Registro {
+    int fd;
+    char* caminho;
+    int intervalo;
+    long long turno;             // Eventos já registrados
+    int noBuffer;                // Eventos ainda não escritos
+    const Jogador* jogadores;
+    int numJogadores;
+    Evento buffer[EVENTOS_POR_BLOCO];
+};
+
+static const char* const MENSAGENS[] = {
+    "ok",
+    "nao foi possivel acessar o arquivo",
+    "o registro ja existe",
+    "arquivo de registro invalido",
+    "versao de registro nao suportada",
+    "checkpoint ausente ou invalido",
+    "evento incoerente com o estado da partida",
+    "falha de alocacao de memoria"
+};
+
+/*
+ * Função: registroMensagem
+ * 
+ * Retorno: descrição do código, para mensagens ao usuário
+ */
+const char* registroMensagem(CodigoRegistro codigo) {
+    return ((unsigned) codigo <= REGISTRO_ERRO_MEMORIA) ? MENSAGENS[codigo] : "?";
+}
+
+/*
+ * Função: nomeCheckpoint
+ * 
+ * Monta o nome do checkpoint do turno `turno` de um registro.
+ */
+void nomeCheckpoint(char* destino, size_t tamanho, const char* caminho, long long turno) {
+    snprintf(destino, tamanho, "%s.%lld.snp", caminho, turno);
+}
+
+// Escreve tudo, repetindo em escritas parciais e interrupções
+static int escreverTudo(int fd, const void* dados, size_t tamanho) {
+    const char* p = (const char*) dados;
+    while (tamanho > 0) {
+        ssize_t n = write(fd, p, tamanho);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return 0;
+        }
+        p += n;
+        tamanho -= (size_t) n;
+    }
+    return 1;
+}
+
+static CodigoRegistro gravarCheckpoint(Registro* registro, const Mapa* mapa) {
+    size_t tamanho = strlen(registro->caminho) + FOLGA_NOME_CHECKPOINT;
+    char* nome = (char*) malloc(tamanho);
+    if (nome == NULL) {
+        return REGISTRO_ERRO_MEMORIA;
+    }
+    nomeCheckpoint(nome, tamanho, registro->caminho, registro->turno);
+    CodigoSnapshot codigo = snapshotSalvar(nome, mapa, registro->jogadores, registro->numJogadores);
+    free(nome);
+    return (codigo == SNAPSHOT_OK) ? REGISTRO_OK : REGISTRO_ERRO_CHECKPOINT;
+}
+
+/*
+ * Função: registroCriar
+ * 
+ * Cria um registro novo e grava o checkpoint do turno 0 com o estado
+ * atual. Um registro existente nunca é sobrescrito.
+ * 
+ * Parâmetros:
+ *   registro - recebe o registro aberto
+ *   caminho - arquivo do registro (os checkpoints ficam ao lado dele)
+ *   intervalo - eventos entre checkpoints (>= 1)
+ *   regra - regra de batalha da partida (gravada no cabeçalho)
+ *   mapa - estado inicial da partida
+ *   jogadores - jogadores da partida, todos com missão; o vetor deve
+ *               continuar válido enquanto o registro estiver aberto
+ *   numJogadores - quantidade de jogadores
+ * 
+ * Retorno: REGISTRO_OK ou o código do erro (nesse caso nada fica criado)
+ */
+CodigoRegistro registroCriar(Registro** registro, const char* caminho, int intervalo,
+                             RegraBatalha regra, const Mapa* mapa, const Jogador* jogadores,
+                             int numJogadores) {
+    *registro = NULL;
+    if (intervalo < 1 || (unsigned) regra >= NUM_REGRAS) {
+        return REGISTRO_ERRO_FORMATO;
+    }
+    for (int i = 0; i < numJogadores; i++) {
+        if (jogadores[i].missao == NULL) {
+            return REGISTRO_ERRO_FORMATO;
+        }
+    }
+
+    Registro* novo = (Registro*) malloc(sizeof(Registro));
+    char* copia = (char*) malloc(strlen(caminho) + 1);
+    if (novo == NULL || copia == NULL) {
+        free(novo);
+        free(copia);
+        return REGISTRO_ERRO_MEMORIA;
+    }
+    strcpy(copia, caminho);
+    novo->caminho = copia;
+    novo->intervalo = intervalo;
+    novo->turno = 0;
+    novo->noBuffer = 0;
+    novo->jogadores = jogadores;
+    novo->numJogadores = numJogadores;
+
+    novo->fd = open(caminho, O_WRONLY | O_CREAT | O_EXCL | O_APPEND, 0644);
+    if (novo->fd < 0) {
+        CodigoRegistro codigo = (errno == EEXIST) ? REGISTRO_ERRO_EXISTE : REGISTRO_ERRO_ARQUIVO;
+        free(copia);
+        free(novo);
+        return codigo;
+    }
+
+    CabecalhoRegistro cab;
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.assinatura, ASSINATURA_REGISTRO, sizeof(cab.assinatura));
+    cab.versao = VERSAO_REGISTRO;
+    cab.ordemBytes = MARCA_ORDEM_BYTES;
+    cab.tamanhoEvento = sizeof(Evento);
+    cab.intervalo = (uint32_t) intervalo;
+    cab.numTerritorios = (uint32_t) mapa->quantidade;
+    cab.regra = (uint32_t) regra;
+
+    CodigoRegistro codigo = escreverTudo(novo->fd, &cab, sizeof(cab)) ? REGISTRO_OK
+                                                                       : REGISTRO_ERRO_ARQUIVO;
+    if (codigo == REGISTRO_OK) {
+        codigo = gravarCheckpoint(novo, mapa);
+    }
+    if (codigo != REGISTRO_OK) {
+        close(novo->fd);
+        unlink(caminho);
+        free(copia);
+        free(novo);
+        return codigo;
+    }
+    *registro = novo;
+    return REGISTRO_OK;
+}
+
+/*
+ * Função: registroDescarregar
+ * 
+ * Escreve os eventos do buffer no arquivo. Em caso de falha os eventos
+ * do buffer são descartados.
+ * 
+ * Retorno: REGISTRO_OK ou REGISTRO_ERRO_ARQUIVO
+ */
+CodigoRegistro registroDescarregar(Registro* registro) {
+    int ok = escreverTudo(registro->fd, registro->buffer,
+                          (size_t) registro->noBuffer * sizeof(Evento));
+    registro->noBuffer = 0;
+    return ok ? REGISTRO_OK : REGISTRO_ERRO_ARQUIVO;
+}
+
+// Próxima posição livre do buffer (sempre há uma: ele é descarregado ao encher)
+static Evento* novoEvento(Registro* registro) {
+    return &registro->buffer[registro->noBuffer++];
+}
+
+/*
+ * Função: fecharEvento
+ * 
+ * Conta o evento recém-escrito no buffer. Ao completar um intervalo,
+ * descarrega o buffer e grava o checkpoint do novo turno, se `mapa`
+ * (o estado depois do evento) for dado.
+ */
+static CodigoRegistro fecharEvento(Registro* registro, const Mapa* mapa) {
+    registro->turno++;
+    CodigoRegistro codigo = REGISTRO_OK;
+    if (registro->noBuffer == EVENTOS_POR_BLOCO) {
+        codigo = registroDescarregar(registro);
+    }
+    if (registro->turno % registro->intervalo == 0 && mapa != NULL) {
+        // O checkpoint só existe depois que os eventos anteriores a ele estão no arquivo
+        if (registro->noBuffer > 0) {
+            codigo = registroDescarregar(registro);
+        }
+        if (codigo == REGISTRO_OK) {
+            codigo = gravarCheckpoint(registro, mapa);
+        }
+    }
+    return codigo;
+}
+
+/*
+ * Função: registroAtaque
+ * 
+ * Acrescenta um ataque já resolvido (chamar logo depois de
+ * resolverAtaque). Ao completar um intervalo, descarrega o buffer e
+ * grava o checkpoint do novo turno.
+ * 
+ * Parâmetros:
+ *   registro - registro aberto
+ *   mapa - mapa já com o resultado do ataque aplicado
+ *   atacante, defensor - índices dos territórios
+ *   resultado - resultado devolvido por resolverAtaque
+ *               (ou resolverAtaqueComDados, na regra do registro)
+ * 
+ * Retorno: REGISTRO_OK ou o código do erro de escrita
+ */
+CodigoRegistro registroAtaque(Registro* registro, const Mapa* mapa, int atacante, int defensor,
+                              const ResultadoAtaque* resultado) {
+    Evento* evento = novoEvento(registro);
+    evento->tipo = EVENTO_ATAQUE;
+    evento->dadoAtacante = codificarDados(resultado->dadosAtacante, resultado->numDadosAtacante);
+    evento->dadoDefensor = codificarDados(resultado->dadosDefensor, resultado->numDadosDefensor);
+    evento->conquista = (uint8_t) resultado->conquista;
+    evento->atacante = atacante;
+    evento->defensor = defensor;
+    evento->tropasAtacante = resultado->tropasAtacante;
+    evento->tropasDefensor = resultado->tropasDefensor;
+    return fecharEvento(registro, mapa);
+}
+
+/*
+ * Função: registroRestauracao
+ * 
+ * Acrescenta um evento por território alterado ao desfazer ou refazer uma
+ * jogada (chamar depois da restauração, com a lista do histórico). Cada
+ * evento grava o estado final do território, então repetições na lista
+ * não mudam o resultado. O mapa só corresponde ao turno no último evento
+ * da lista: um checkpoint que caia no meio dela não é gravado, e o replay
+ * parte do anterior.
+ * 
+ * Parâmetros:
+ *   registro - registro aberto
+ *   mapa - mapa já restaurado
+ *   indices, quantidade - territórios restaurados
+ * 
+ * Retorno: REGISTRO_OK ou o código do erro de escrita
+ */
+CodigoRegistro registroRestauracao(Registro* registro, const Mapa* mapa,
+                                   const int32_t* indices, long quantidade) {
+    CodigoRegistro codigo = REGISTRO_OK;
+    for (long k = 0; k < quantidade; k++) {
+        int i = indices[k];
+        Evento* evento = novoEvento(registro);
+        memset(evento, 0, sizeof(Evento));
+        evento->tipo = EVENTO_RESTAURAR;
+        evento->atacante = i;
+        evento->defensor = i;
+        evento->tropasAtacante = mapa->tropas[i];
+        evento->tropasDefensor = mapa->donos[i];
+        CodigoRegistro etapa = fecharEvento(registro, (k == quantidade - 1) ? mapa : NULL);
+        if (etapa != REGISTRO_OK) {
+            codigo = etapa;
+        }
+    }
+    return codigo;
+}
+
+/*
+ * Função: registroTurno
+ * 
+ * Retorno: quantidade de eventos registrados (o turno atual)
+ */
+long long registroTurno(const Registro* registro) {
+    return registro->turno;
+}
+
+/*
+ * Função: registroFechar
+ * 
+ * Descarrega os eventos pendentes, fecha o arquivo e libera o registro.
+ * 
+ * Retorno: REGISTRO_OK ou REGISTRO_ERRO_ARQUIVO se alguma escrita falhar
+ */
+CodigoRegistro registroFechar(Registro* registro) {
+    if (registro == NULL) {
+        return REGISTRO_OK;
+    }
+    CodigoRegistro codigo = registroDescarregar(registro);
+    if (close(registro->fd) != 0) {
+        codigo = REGISTRO_ERRO_ARQUIVO;
+    }
+    free(registro->caminho);
+    free(registro);
+    return codigo;
+}
+
+/*
+ * Função: leitorAbrir
+ * 
+ * Mapeia um registro em memória para replay, conferindo o cabeçalho.
+ * 
+ * Retorno: REGISTRO_OK ou o código do erro (nesse caso nada fica aberto)
+ */
+CodigoRegistro leitorAbrir(LeitorRegistro* leitor, const char* caminho) {
+    memset(leitor, 0, sizeof(*leitor));
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) {
+        return REGISTRO_ERRO_ARQUIVO;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return REGISTRO_ERRO_ARQUIVO;
+    }
+    if ((uint64_t) info.st_size < sizeof(CabecalhoRegistro)) {
+        close(fd);
+        return REGISTRO_ERRO_FORMATO;
+    }
+
+    size_t tamanho = (size_t) info.st_size;
+    void* base = mmap(NULL, tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return REGISTRO_ERRO_ARQUIVO;
+    }
+
+    const CabecalhoRegistro* cab = (const CabecalhoRegistro*) base;
+    CodigoRegistro codigo = REGISTRO_OK;
+    if (memcmp(cab->assinatura, ASSINATURA_REGISTRO, sizeof(cab->assinatura)) != 0 ||
+        cab->ordemBytes != MARCA_ORDEM_BYTES) {
+        codigo = REGISTRO_ERRO_FORMATO;
+    } else if (cab->versao != VERSAO_REGISTRO) {
+        codigo = REGISTRO_ERRO_VERSAO;
+    } else if (cab->tamanhoEvento != sizeof(Evento) || cab->intervalo == 0 ||
+               cab->numTerritorios > INT32_MAX || cab->regra >= NUM_REGRAS) {
+        codigo = REGISTRO_ERRO_FORMATO;
+    }
+    if (codigo == REGISTRO_OK) {
+        leitor->caminho = (char*) malloc(strlen(caminho) + 1);
+        if (leitor->caminho == NULL) {
+            codigo = REGISTRO_ERRO_MEMORIA;
+        }
+    }
+    if (codigo != REGISTRO_OK) {
+        munmap(base, tamanho);
+        return codigo;
+    }
+
+    strcpy(leitor->caminho, caminho);
+    leitor->cabecalho = *cab;
+    leitor->eventos = (const Evento*) ((const char*) base + sizeof(CabecalhoRegistro));
+    leitor->numEventos = (long long) ((tamanho - sizeof(CabecalhoRegistro)) / sizeof(Evento));
+    leitor->regiao = base;
+    leitor->tamanhoRegiao = tamanho;
+    return REGISTRO_OK;
+}
+
+/*
+ * Função: leitorFechar
+ * 
+ * Desfaz o mapeamento de um registro aberto por leitorAbrir.
+ */
+void leitorFechar(LeitorRegistro* leitor) {
+    if (leitor->regiao != NULL) {
+        munmap(leitor->regiao, leitor->tamanhoRegiao);
+    }
+    free(leitor->caminho);
+    memset(leitor, 0, sizeof(*leitor));
+}
+
+static int eventoNoMapa(const Mapa* mapa, const Evento* evento) {
+    if (evento->tipo == EVENTO_RESTAURAR) {
+        return evento->atacante >= 0 && evento->atacante < mapa->quantidade &&
+               evento->defensor == evento->atacante && evento->tropasAtacante >= 0 &&
+               evento->tropasDefensor >= 0 && evento->tropasDefensor < mapa->numCores;
+    }
+    return evento->tipo == EVENTO_ATAQUE &&
+           evento->atacante >= 0 && evento->atacante < mapa->quantidade &&
+           evento->defensor >= 0 && evento->defensor < mapa->quantidade;
+}
+
+/*
+ * Função: conferirEvento
+ * 
+ * Confere, antes de aplicar, se o evento é um ataque permitido no estado
+ * atual, se cada lado rolou os dados a que tinha direito e se as tropas
+ * gravadas são as que a regra de batalha produz com esses dados. Uma
+ * restauração só precisa caber no mapa.
+ * 
+ * Retorno: REGISTRO_OK ou REGISTRO_ERRO_EVENTO
+ */
+CodigoRegistro conferirEvento(const Mapa* mapa, RegraBatalha regra, const Evento* evento) {
+    if (evento->tipo == EVENTO_RESTAURAR) {
+        return eventoNoMapa(mapa, evento) ? REGISTRO_OK : REGISTRO_ERRO_EVENTO;
+    }
+    if (!eventoNoMapa(mapa, evento) ||
+        validarAtaque(mapa, evento->atacante, evento->defensor) != ATAQUE_OK) {
+        return REGISTRO_ERRO_EVENTO;
+    }
+    int tropasAtacante = mapa->tropas[evento->atacante];
+    int tropasDefensor = mapa->tropas[evento->defensor];
+    uint8_t dadosAtacante[MAX_DADOS], dadosDefensor[MAX_DADOS];
+    int numAtacante = decodificarDados(evento->dadoAtacante, dadosAtacante);
+    int numDefensor = decodificarDados(evento->dadoDefensor, dadosDefensor);
+    if (numAtacante != dadosDoAtacante(regra, tropasAtacante) ||
+        numDefensor != dadosDoDefensor(regra, tropasDefensor)) {
+        return REGISTRO_ERRO_EVENTO;
+    }
+    ResultadoAtaque esperado;
+    aplicarRegra(regra, tropasAtacante, tropasDefensor, dadosAtacante, dadosDefensor, &esperado);
+    if (esperado.conquista != evento->conquista ||
+        esperado.tropasAtacante != evento->tropasAtacante ||
+        esperado.tropasDefensor != evento->tropasDefensor) {
+        return REGISTRO_ERRO_EVENTO;
+    }
+    return REGISTRO_OK;
+}
+
+/*
+ * Função: aplicarEvento
+ * 
+ * Aplica o efeito gravado de um evento, na mesma ordem de
+ * resolverAtaque (dono antes das tropas) ou do histórico (tropas antes
+ * do dono).
+ * 
+ * Retorno: REGISTRO_OK ou REGISTRO_ERRO_EVENTO se o evento não couber no mapa
+ */
+CodigoRegistro aplicarEvento(Mapa* mapa, const Evento* evento) {
+    if (!eventoNoMapa(mapa, evento)) {
+        return REGISTRO_ERRO_EVENTO;
+    }
+    if (evento->tipo == EVENTO_RESTAURAR) {
+        mapaDefinirTropas(mapa, evento->atacante, evento->tropasAtacante);
+        mapaDefinirDono(mapa, evento->atacante, (IdCor) evento->tropasDefensor);
+        return REGISTRO_OK;
+    }
+    if (evento->conquista) {
+        mapaDefinirDono(mapa, evento->defensor, mapa->donos[evento->atacante]);
+    }
+    mapaDefinirTropas(mapa, evento->atacante, evento->tropasAtacante);
+    mapaDefinirTropas(mapa, evento->defensor, evento->tropasDefensor);
+    return REGISTRO_OK;
+}
+
+// Os jogadores ficam na arena do chamador: só o mapa é liberado
+static void liberarCarga(Mapa* mapa, Jogador** jogadores, int* numJogadores) {
+    *jogadores = NULL;
+    *numJogadores = 0;
+    mapaLiberar(mapa);
+}
+
+/*
+ * Função: reconstruirTurno
+ * 
+ * Reconstrói o estado da partida no turno `turno` (depois dos primeiros
+ * `turno` eventos): carrega o último checkpoint existente até o turno e
+ * aplica os eventos seguintes.
+ * 
+ * Parâmetros:
+ *   leitor - registro aberto
+ *   turno - turno desejado (0..numEventos)
+ *   conferir - 1 para conferir cada evento com conferirEvento, na regra
+ *              gravada no cabeçalho
+ *   mapa - recebe o estado (não iniciado ou já liberado)
+ *   arena - arena de onde saem os jogadores (ver snapshotCarregar)
+ *   jogadores, numJogadores - recebem os jogadores do checkpoint
+ *   checkpoint - recebe o turno do checkpoint usado; em erro de evento,
+ *                recebe o número do evento rejeitado (pode ser NULL)
+ * 
+ * Retorno: REGISTRO_OK ou o código do erro (nesse caso nada fica alocado
+ *          fora da arena)
+ */
+CodigoRegistro reconstruirTurno(const LeitorRegistro* leitor, long long turno, int conferir,
+                                Mapa* mapa, Arena* arena, Jogador** jogadores, int* numJogadores,
+                                long long* checkpoint) {
+    if (turno < 0 || turno > leitor->numEventos) {
+        return REGISTRO_ERRO_EVENTO;
+    }
+    size_t tamanho = strlen(leitor->caminho) + FOLGA_NOME_CHECKPOINT;
+    char* nome = (char*) malloc(tamanho);
+    if (nome == NULL) {
+        return REGISTRO_ERRO_MEMORIA;
+    }
+
+    // Último checkpoint disponível até o turno (algum pode ter sido apagado)
+    long long intervalo = leitor->cabecalho.intervalo;
+    long long inicio = (turno / intervalo) * intervalo;
+    CodigoSnapshot carga;
+    for (;;) {
+        nomeCheckpoint(nome, tamanho, leitor->caminho, inicio);
+        carga = snapshotCarregar(nome, mapa, arena, jogadores, numJogadores);
+        if (carga != SNAPSHOT_ERRO_ARQUIVO || inicio == 0) {
+            break;
+        }
+        inicio -= intervalo;
+    }
+    free(nome);
+    if (carga != SNAPSHOT_OK) {
+        return REGISTRO_ERRO_CHECKPOINT;
+    }
+    if (mapa->quantidade != (int) leitor->cabecalho.numTerritorios) {
+        liberarCarga(mapa, jogadores, numJogadores);
+        return REGISTRO_ERRO_CHECKPOINT;
+    }
+
+    for (long long t = inicio; t < turno; t++) {
+        const Evento* evento = &leitor->eventos[t];
+        CodigoRegistro codigo = REGISTRO_OK;
+        if (conferir) {
+            codigo = conferirEvento(mapa, (RegraBatalha) leitor->cabecalho.regra, evento);
+        }
+        if (codigo == REGISTRO_OK) {
+            codigo = aplicarEvento(mapa, evento);
+        }
+        if (codigo != REGISTRO_OK) {
+            liberarCarga(mapa, jogadores, numJogadores);
+            if (checkpoint != NULL) {
+                *checkpoint = t;
+            }
+            return codigo;
+        }
+    }
+    if (checkpoint != NULL) {
+        *checkpoint = inicio;
+    }
+    return REGISTRO_OK;
+}
@@ -0,0 +1,140 @@
+/*
+ * Registro de eventos da partida e reconstrução por replay
+ * 
+ * Cada ataque resolvido vira um Evento de tamanho fixo, acrescentado a um
+ * arquivo só de escrita no final (O_APPEND) por um buffer em memória: o
+ * caminho quente é uma cópia de 20 bytes, e a escrita em disco acontece
+ * em blocos. O evento de número t (a partir de 0) leva a partida do
+ * "turno" t ao turno t + 1.
+ * 
+ * A cada `intervalo` eventos, e no turno 0, o estado inteiro é gravado
+ * como snapshot (snapshot.h) em "<registro>.<turno>.snp". Para chegar ao
+ * turno t, o replay carrega o último checkpoint até t e aplica só os
+ * eventos seguintes, em vez de repetir a partida desde o início.
+ * 
+ * Layout do registro (inteiros na ordem da máquina, conferida):
+ *   CabecalhoRegistro
+ *   eventos     numEventos x Evento
+ * O número de eventos sai do tamanho do arquivo; um evento final
+ * incompleto (queda no meio de uma escrita) é ignorado.
+ */
+
+#ifndef WAR_REGISTRO_H
+#define WAR_REGISTRO_H
+
+#include <stdint.h>
+#include "batalha.h"
+#include "mapa.h"
+
+#define ASSINATURA_REGISTRO "WARLOG01"
+#define VERSAO_REGISTRO 1
+
+// Eventos entre dois checkpoints
+#define INTERVALO_CHECKPOINT_PADRAO 262144
+
+// Eventos guardados em memória antes de cada escrita
+#define EVENTOS_POR_BLOCO 4096
+
+/*
+ * Struct CabecalhoRegistro
+ * 
+ * Primeiros bytes do registro.
+ */
+typedef struct {
+    char assinatura[8];      // ASSINATURA_REGISTRO
+    uint32_t versao;         // VERSAO_REGISTRO
+    uint32_t ordemBytes;     // 0x01020304 gravado na ordem da máquina
+    uint32_t tamanhoEvento;  // sizeof(Evento)
+    uint32_t intervalo;      // Eventos entre checkpoints
+    uint32_t numTerritorios;
+    uint32_t regra;          // RegraBatalha da partida (0, a simples, nos registros antigos)
+} CabecalhoRegistro;
+
+/*
+ * Enum TipoEvento
+ * 
+ * O que um evento descreve.
+ */
+typedef enum {
+    EVENTO_ATAQUE = 0,       // Ataque resolvido por resolverAtaque
+    EVENTO_RESTAURAR = 1     // Território restaurado ao desfazer ou refazer
+} TipoEvento;
+
+/*
+ * Struct Evento
+ * 
+ * Um ataque: territórios, dados, tropas dos dois lados depois do ataque
+ * e se houve conquista (o defensor passa à cor do atacante). Guardar as
+ * tropas finais torna o replay independente da regra; os dados permitem
+ * conferir a regra em uma auditoria. Os dados de cada lado ficam em um
+ * byte (codificarDados): na regra simples, o próprio valor do dado.
+ * 
+ * Em EVENTO_RESTAURAR, atacante e defensor são o território restaurado,
+ * tropasAtacante as tropas e tropasDefensor o dono que ele volta a ter.
+ */
+typedef struct {
+    uint8_t tipo;            // TipoEvento
+    uint8_t dadoAtacante;    // Código dos dados do atacante
+    uint8_t dadoDefensor;    // Código dos dados do defensor
+    uint8_t conquista;
+    int32_t atacante;
+    int32_t defensor;
+    int32_t tropasAtacante;  // Depois do ataque
+    int32_t tropasDefensor;  // Depois do ataque
+} Evento;
+
+/*
+ * Enum CodigoRegistro
+ * 
+ * Resultado das operações de gravação e de replay.
+ */
+typedef enum {
+    REGISTRO_OK = 0,
+    REGISTRO_ERRO_ARQUIVO,     // Não foi possível criar, gravar ou mapear
+    REGISTRO_ERRO_EXISTE,      // O registro já existe (nunca é sobrescrito)
+    REGISTRO_ERRO_FORMATO,     // Assinatura, ordem de bytes ou tamanhos incoerentes
+    REGISTRO_ERRO_VERSAO,      // Versão do formato desconhecida
+    REGISTRO_ERRO_CHECKPOINT,  // Checkpoint ausente ou inválido
+    REGISTRO_ERRO_EVENTO,      // Evento incoerente com o estado reconstruído
+    REGISTRO_ERRO_MEMORIA
+} CodigoRegistro;
+
+typedef struct Registro Registro;
+
+/*
+ * Struct LeitorRegistro
+ * 
+ * Registro aberto para replay: os eventos são lidos direto do arquivo
+ * mapeado em memória.
+ */
+typedef struct {
+    CabecalhoRegistro cabecalho;
+    const Evento* eventos;
+    long long numEventos;
+    char* caminho;           // Base dos nomes dos checkpoints
+    void* regiao;
+    size_t tamanhoRegiao;
+} LeitorRegistro;
+
+const char* registroMensagem(CodigoRegistro codigo);
+void nomeCheckpoint(char* destino, size_t tamanho, const char* caminho, long long turno);
+
+CodigoRegistro registroCriar(Registro** registro, const char* caminho, int intervalo,
+                             RegraBatalha regra, const Mapa* mapa, const Jogador* jogadores, int numJogadores);
+CodigoRegistro registroAtaque(Registro* registro, const Mapa* mapa, int atacante, int defensor,
+                              const ResultadoAtaque* resultado);
+CodigoRegistro registroRestauracao(Registro* registro, const Mapa* mapa,
+                                   const int32_t* indices, long quantidade);
+CodigoRegistro registroDescarregar(Registro* registro);
+CodigoRegistro registroFechar(Registro* registro);
+long long registroTurno(const Registro* registro);
+
+CodigoRegistro leitorAbrir(LeitorRegistro* leitor, const char* caminho);
+void leitorFechar(LeitorRegistro* leitor);
+CodigoRegistro conferirEvento(const Mapa* mapa, RegraBatalha regra, const Evento* evento);
+CodigoRegistro aplicarEvento(Mapa* mapa, const Evento* evento);
+CodigoRegistro reconstruirTurno(const LeitorRegistro* leitor, long long turno, int conferir,
+                                Mapa* mapa, Arena* arena, Jogador** jogadores, int* numJogadores,
+                                long long* checkpoint);
+
+#endif
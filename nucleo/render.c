@@ -0,0 +1,329 @@
+/*
+ * Renderização do mapa e dos menus
+ * 
+ * Buffer de saída com escrita única por quadro e os modos de exibição do
+ * mapa descritos em render.h.
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "estatisticas.h"
+#include "render.h"
+
+// Capacidade inicial do buffer de saída
+#define CAPACIDADE_INICIAL_SAIDA 16384
+
+/*
+ * Função: saidaIniciar
+ * 
+ * Prepara um buffer vazio que escreverá no descritor `fd`.
+ */
+void saidaIniciar(Saida* saida, int fd) {
+    memset(saida, 0, sizeof(Saida));
+    saida->fd = fd;
+}
+
+/*
+ * Função: saidaLiberar
+ * 
+ * Libera o buffer (o conteúdo pendente é descartado).
+ */
+void saidaLiberar(Saida* saida) {
+    free(saida->dados);
+    saidaIniciar(saida, saida->fd);
+}
+
+// Garante espaço para mais `extra` bytes; em falha, marca o quadro como truncado
+static int saidaGarantir(Saida* saida, size_t extra) {
+    if (saida->tamanho + extra <= saida->capacidade) {
+        return 1;
+    }
+    size_t nova = saida->capacidade ? saida->capacidade : CAPACIDADE_INICIAL_SAIDA;
+    while (nova < saida->tamanho + extra) {
+        nova *= 2;
+    }
+    char* dados = (char*) realloc(saida->dados, nova);
+    if (dados == NULL) {
+        saida->falhou = 1;
+        return 0;
+    }
+    saida->dados = dados;
+    saida->capacidade = nova;
+    return 1;
+}
+
+/*
+ * Função: saidaTexto
+ * 
+ * Acrescenta `tamanho` bytes de texto ao quadro atual.
+ */
+void saidaTexto(Saida* saida, const char* texto, size_t tamanho) {
+    if (saidaGarantir(saida, tamanho)) {
+        memcpy(saida->dados + saida->tamanho, texto, tamanho);
+        saida->tamanho += tamanho;
+    }
+}
+
+/*
+ * Função: saidaFormatar
+ * 
+ * Acrescenta texto formatado (como printf) ao quadro atual.
+ */
+void saidaFormatar(Saida* saida, const char* formato, ...) {
+    va_list argumentos;
+    // Tentativa direta no espaço livre; só realoca se não couber
+    if (!saidaGarantir(saida, 256)) {
+        return;
+    }
+    size_t livre = saida->capacidade - saida->tamanho;
+    va_start(argumentos, formato);
+    int escritos = vsnprintf(saida->dados + saida->tamanho, livre, formato, argumentos);
+    va_end(argumentos);
+    if (escritos < 0) {
+        return;
+    }
+    if ((size_t) escritos >= livre) {
+        if (!saidaGarantir(saida, (size_t) escritos + 1)) {
+            return;
+        }
+        va_start(argumentos, formato);
+        vsnprintf(saida->dados + saida->tamanho, (size_t) escritos + 1, formato, argumentos);
+        va_end(argumentos);
+    }
+    saida->tamanho += (size_t) escritos;
+}
+
+/*
+ * Função: saidaDescarregar
+ * 
+ * Envia o quadro com uma chamada write (repetida só se o descritor
+ * aceitar uma escrita parcial) e esvazia o buffer. O stdout é
+ * descarregado antes, para manter a ordem com os printf do jogo.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 se a escrita falhar
+ */
+int saidaDescarregar(Saida* saida) {
+    fflush(stdout);
+    size_t enviado = 0;
+    while (enviado < saida->tamanho) {
+        ssize_t n = write(saida->fd, saida->dados + enviado, saida->tamanho - enviado);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            saida->tamanho = 0;
+            return 0;
+        }
+        enviado += (size_t) n;
+    }
+    saida->tamanho = 0;
+    saida->falhou = 0;
+    return 1;
+}
+
+/*
+ * Função: filtroPadrao
+ * 
+ * Filtro que aceita todos os territórios, sem paginação.
+ */
+void filtroPadrao(FiltroMapa* filtro) {
+    filtro->cor = COR_INVALIDA;
+    filtro->tropasMinimo = INT_MIN;
+    filtro->tropasMaximo = INT_MAX;
+    filtro->pagina = 0;
+    filtro->porPagina = 0;
+}
+
+/*
+ * Função: filtroAceita
+ * 
+ * Retorno: 1 se o território passa pelo filtro de cor e de tropas
+ */
+int filtroAceita(const FiltroMapa* filtro, const Mapa* mapa, int indice) {
+    return (filtro->cor == COR_INVALIDA || mapa->donos[indice] == filtro->cor) &&
+           mapa->tropas[indice] >= filtro->tropasMinimo &&
+           mapa->tropas[indice] <= filtro->tropasMaximo;
+}
+
+static int filtroVazio(const FiltroMapa* filtro) {
+    return filtro->cor == COR_INVALIDA && filtro->tropasMinimo == INT_MIN &&
+           filtro->tropasMaximo == INT_MAX;
+}
+
+static void renderizarDetalhado(Saida* saida, const Mapa* mapa, int i) {
+    saidaFormatar(saida, "[%d] %s\n    Cor.........: %s\n    Tropas......: %d\n"
+                         "---------------------------\n",
+                  i + 1, mapa->nomes[i], mapaNomeCor(mapa, mapa->donos[i]), mapa->tropas[i]);
+}
+
+static void renderizarLinha(Saida* saida, const Mapa* mapa, int i) {
+    saidaFormatar(saida, "%8d  %-29s %-9s %8d\n",
+                  i + 1, mapa->nomes[i], mapaNomeCor(mapa, mapa->donos[i]), mapa->tropas[i]);
+}
+
+/*
+ * Função: renderizarResumo
+ * 
+ * Totais por cor (das estatísticas anexadas ou de uma única varredura) e
+ * os TOP_RESUMO territórios com mais tropas entre os aceitos pelo filtro,
+ * escolhidos com um heap mínimo de tamanho fixo.
+ */
+static void renderizarResumo(Saida* saida, const Mapa* mapa, const FiltroMapa* filtro) {
+    int contagem[MAX_CORES] = {0};
+    long long tropas[MAX_CORES] = {0};
+    int melhores[TOP_RESUMO];
+    int numMelhores = 0, aceitos = 0;
+
+    for (int i = 0; i < mapa->quantidade; i++) {
+        if (mapa->estatisticas == NULL) {
+            contagem[mapa->donos[i]]++;
+            tropas[mapa->donos[i]] += mapa->tropas[i];
+        }
+        if (!filtroAceita(filtro, mapa, i)) {
+            continue;
+        }
+        aceitos++;
+
+        // Heap mínimo por tropas: a raiz é o mais fraco dos melhores
+        int32_t valor = mapa->tropas[i];
+        int pos;
+        if (numMelhores < TOP_RESUMO) {
+            pos = numMelhores++;
+            while (pos > 0 && mapa->tropas[melhores[(pos - 1) / 2]] > valor) {
+                melhores[pos] = melhores[(pos - 1) / 2];
+                pos = (pos - 1) / 2;
+            }
+            melhores[pos] = i;
+        } else if (valor > mapa->tropas[melhores[0]]) {
+            pos = 0;
+            for (;;) {
+                int filho = 2 * pos + 1;
+                if (filho >= numMelhores) {
+                    break;
+                }
+                if (filho + 1 < numMelhores &&
+                    mapa->tropas[melhores[filho + 1]] < mapa->tropas[melhores[filho]]) {
+                    filho++;
+                }
+                if (mapa->tropas[melhores[filho]] >= valor) {
+                    break;
+                }
+                melhores[pos] = melhores[filho];
+                pos = filho;
+            }
+            melhores[pos] = i;
+        }
+    }
+    if (mapa->estatisticas != NULL) {
+        for (int c = 0; c < mapa->numCores; c++) {
+            contagem[c] = estatisticasTerritorios(mapa->estatisticas, (IdCor) c);
+            tropas[c] = estatisticasTropas(mapa->estatisticas, (IdCor) c);
+        }
+    }
+
+    saidaFormatar(saida, "Resumo de %d territorios (%d aceitos pelo filtro)\n\n",
+                  mapa->quantidade, aceitos);
+    saidaFormatar(saida, "%-9s %12s %8s %14s\n", "Cor", "Territorios", "%", "Tropas");
+    for (int c = 0; c < mapa->numCores; c++) {
+        if (contagem[c] == 0) {
+            continue;
+        }
+        saidaFormatar(saida, "%-9s %12d %7.1f%% %14lld\n", mapaNomeCor(mapa, (IdCor) c),
+                      contagem[c], 100.0 * contagem[c] / mapa->quantidade, tropas[c]);
+    }
+
+    // Ordena os melhores em ordem decrescente de tropas (extração do heap)
+    int ordenados[TOP_RESUMO];
+    int total = numMelhores;
+    for (int k = total - 1; k >= 0; k--) {
+        ordenados[k] = melhores[0];
+        int ultimo = melhores[--numMelhores];
+        int pos = 0;
+        for (;;) {
+            int filho = 2 * pos + 1;
+            if (filho >= numMelhores) {
+                break;
+            }
+            if (filho + 1 < numMelhores &&
+                mapa->tropas[melhores[filho + 1]] < mapa->tropas[melhores[filho]]) {
+                filho++;
+            }
+            if (mapa->tropas[melhores[filho]] >= mapa->tropas[ultimo]) {
+                break;
+            }
+            melhores[pos] = melhores[filho];
+            pos = filho;
+        }
+        melhores[pos] = ultimo;
+    }
+
+    saidaFormatar(saida, "\nTerritorios com mais tropas:\n");
+    saidaFormatar(saida, "%8s  %-29s %-9s %8s\n", "#", "Nome", "Cor", "Tropas");
+    for (int k = 0; k < total; k++) {
+        renderizarLinha(saida, mapa, ordenados[k]);
+    }
+}
+
+/*
+ * Função: renderizarMapa
+ * 
+ * Formata o mapa no buffer de saída (sem descarregá-lo).
+ * 
+ * Parâmetros:
+ *   saida - buffer de destino
+ *   mapa - mapa de territórios
+ *   filtro - territórios e página a exibir
+ *   modo - forma de exibição; RENDER_AUTOMATICO usa o resumo quando o
+ *          mapa passa de LIMITE_MAPA_COMPLETO territórios sem filtro nem página
+ */
+void renderizarMapa(Saida* saida, const Mapa* mapa, const FiltroMapa* filtro, ModoRender modo) {
+    if (modo == RENDER_AUTOMATICO) {
+        modo = (mapa->quantidade > LIMITE_MAPA_COMPLETO && filtroVazio(filtro) &&
+                filtro->porPagina <= 0) ? RENDER_RESUMO : RENDER_DETALHADO;
+    }
+
+    saidaFormatar(saida, "\n=== MAPA DE TERRITORIOS ===\n");
+    saidaFormatar(saida, "===========================\n\n");
+
+    if (modo == RENDER_RESUMO) {
+        renderizarResumo(saida, mapa, filtro);
+        return;
+    }
+
+    long long primeiro = 0, ultimo = LLONG_MAX;
+    if (filtro->porPagina > 0) {
+        primeiro = (long long) filtro->pagina * filtro->porPagina;
+        ultimo = primeiro + filtro->porPagina;
+    }
+    if (modo == RENDER_TABELA) {
+        saidaFormatar(saida, "%8s  %-29s %-9s %8s\n", "#", "Nome", "Cor", "Tropas");
+    }
+
+    long long aceitos = 0;
+    for (int i = 0; i < mapa->quantidade; i++) {
+        if (!filtroAceita(filtro, mapa, i)) {
+            continue;
+        }
+        if (aceitos >= primeiro && aceitos < ultimo) {
+            if (modo == RENDER_TABELA) {
+                renderizarLinha(saida, mapa, i);
+            } else {
+                renderizarDetalhado(saida, mapa, i);
+            }
+        }
+        aceitos++;
+    }
+
+    if (filtro->porPagina > 0) {
+        long long paginas = (aceitos + filtro->porPagina - 1) / filtro->porPagina;
+        saidaFormatar(saida, "Pagina %d de %lld (%lld territorios aceitos pelo filtro)\n",
+                      filtro->pagina + 1, paginas > 0 ? paginas : 1, aceitos);
+    } else if (!filtroVazio(filtro)) {
+        saidaFormatar(saida, "%lld territorios aceitos pelo filtro\n", aceitos);
+    }
+}
@@ -0,0 +1,73 @@
+/*
+ * Renderização do mapa e dos menus
+ * 
+ * Todo o texto de uma tela é formatado em um buffer reutilizável (Saida)
+ * e enviado ao terminal com uma única chamada write por quadro, em vez de
+ * um printf por linha. A exibição do mapa aceita filtro por cor e por
+ * faixa de tropas, paginação, uma tabela compacta e, para mapas muito
+ * grandes, um resumo (totais por cor e os territórios mais fortes).
+ */
+
+#ifndef WAR_RENDER_H
+#define WAR_RENDER_H
+
+#include <stddef.h>
+#include "mapa.h"
+
+// Acima disso o modo automático mostra o resumo em vez do mapa inteiro
+#define LIMITE_MAPA_COMPLETO 200
+
+// Territórios listados no resumo
+#define TOP_RESUMO 10
+
+/*
+ * Struct Saida
+ * 
+ * Buffer de saída que cresce sob demanda e é reaproveitado entre quadros.
+ */
+typedef struct {
+    char* dados;
+    size_t tamanho;
+    size_t capacidade;
+    int fd;            // Descritor de destino (normalmente 1, a saída padrão)
+    int falhou;        // 1 se alguma alocação falhou (o quadro sai truncado)
+} Saida;
+
+/*
+ * Enum ModoRender
+ * 
+ * Forma de exibir o mapa.
+ */
+typedef enum {
+    RENDER_AUTOMATICO = 0, // Detalhado em mapas pequenos, resumo nos grandes
+    RENDER_DETALHADO,      // Um bloco por território (formato original)
+    RENDER_TABELA,         // Uma linha por território
+    RENDER_RESUMO          // Totais por cor e os territórios mais fortes
+} ModoRender;
+
+/*
+ * Struct FiltroMapa
+ * 
+ * Seleção de territórios a exibir. Páginas começam em 0; porPagina <= 0
+ * desliga a paginação.
+ */
+typedef struct {
+    IdCor cor;           // COR_INVALIDA para todas as cores
+    int tropasMinimo;
+    int tropasMaximo;
+    int pagina;
+    int porPagina;
+} FiltroMapa;
+
+void saidaIniciar(Saida* saida, int fd);
+void saidaLiberar(Saida* saida);
+void saidaTexto(Saida* saida, const char* texto, size_t tamanho);
+void saidaFormatar(Saida* saida, const char* formato, ...)
+    __attribute__((format(printf, 2, 3)));
+int saidaDescarregar(Saida* saida);
+
+void filtroPadrao(FiltroMapa* filtro);
+int filtroAceita(const FiltroMapa* filtro, const Mapa* mapa, int indice);
+void renderizarMapa(Saida* saida, const Mapa* mapa, const FiltroMapa* filtro, ModoRender modo);
+
+#endif
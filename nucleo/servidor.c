@@ -0,0 +1,1313 @@
+/*
+ * Servidor de partidas em rede
+ * 
+ * Cada laço guarda as suas salas (a partida e as conexões sentadas nela)
+ * em um vetor. O número público de uma partida junta o laço (8 bits
+ * baixos), a posição no vetor (24 bits) e uma geração, que muda quando a
+ * posição é reaproveitada, para que um número antigo não caia em outra
+ * partida.
+ * 
+ * Uma conexão sem lugar que pede ENTRAR em uma partida de outro laço é
+ * transferida para ele: sai do epoll de origem, entra na fila de
+ * chegadas do destino (a única estrutura compartilhada entre os laços,
+ * protegida por trava) e o destino relê a linha do ENTRAR, que ficou no
+ * buffer de entrada.
+ * 
+ * As respostas são acumuladas no buffer de saída de cada conexão e
+ * enviadas no fim da rodada do epoll. Conexões fechadas no meio de uma
+ * rodada só são liberadas no fim dela, porque ainda pode haver eventos
+ * da rodada apontando para elas.
+ */
+
+#define _GNU_SOURCE   // accept4
+#include <errno.h>
+#include <limits.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "servidor.h"
+
+// Maior linha de comando aceita (com o '\n'); um TURNO leva dezenas de ordens
+#define TAM_ENTRADA 1024
+
+// Maior resposta de TURNO: o cabeçalho e seis inteiros por ordem
+#define TAM_RESPOSTA_TURNO (64 + MAX_ORDENS_TURNO * 6 * 12)
+
+// Saída acumulada em uma conexão antes de desistir de um cliente que não lê
+#define LIMITE_SAIDA (1 << 20)
+
+// Maior par dono:tropas de ESTADO: ' ', 3 dígitos, ':' e 11 caracteres de int
+#define TAM_PAR_ESTADO 16
+
+// Maior mapa que cabe em uma resposta de ESTADO (o cabeçalho ocupa menos de 128 bytes)
+#define MAX_TERRITORIOS_ESTADO ((LIMITE_SAIDA - 128) / TAM_PAR_ESTADO)
+
+// Eventos tratados por chamada de epoll_wait
+#define EVENTOS_POR_RODADA 256
+
+// Conexões aguardando accept no socket de escuta
+#define FILA_ESCUTA 4096
+
+// Partidas por laço (a posição ocupa 24 bits do número da partida)
+#define MAX_SALAS_POR_LACO (1 << 24)
+
+typedef struct Laco Laco;
+typedef struct Sala Sala;
+
+/*
+ * Struct Conexao
+ * 
+ * Um cliente. Pertence a um único laço por vez.
+ */
+typedef struct Conexao {
+    int fd;
+    Laco* laco;
+    Sala* sala;                  // Partida em que a conexão tem lugar (NULL: nenhuma)
+    uint32_t lugares;            // Bit j ligado: ocupa o lugar do jogador j
+    int transferirPara;          // Laço de destino pedido por ENTRAR (-1: nenhum)
+    int fecharAposEnvio;         // SAIR: fecha quando a saída acabar
+    int excedeu;                 // Passou de LIMITE_SAIDA: fecha no fim da rodada
+    int morta;                   // Fechada; liberada no fim da rodada
+    int esperandoEscrita;        // EPOLLOUT registrado (socket cheio)
+    int posicaoPendente;         // Posição em Laco.pendentes (-1: fora)
+    int lidos;                   // Bytes em `entrada`
+    char entrada[TAM_ENTRADA];
+    char* saida;
+    size_t tamanhoSaida;
+    size_t capacidadeSaida;
+    size_t enviados;             // Bytes de `saida` já enviados
+    struct Conexao* anterior;    // Lista de conexões do laço
+    struct Conexao* seguinte;    // (também encadeia mortas e chegadas)
+} Conexao;
+
+/*
+ * Struct Sala
+ * 
+ * Uma partida e quem está sentado nela.
+ */
+struct Sala {
+    Partida partida;
+    uint64_t id;
+    int posicao;                 // Posição em Laco.salas
+    int ocupados;                // Lugares com conexão
+    Conexao* lugares[MAX_JOGADORES_PARTIDA];
+};
+
+/*
+ * Struct Laco
+ * 
+ * Laço de eventos de uma thread. Só `trava` e `chegadas` são acessados
+ * por outras threads.
+ */
+struct Laco {
+    Servidor* servidor;
+    int indice;
+    int epoll;
+    int aviso;                   // eventfd: chegadas de outros laços e pedido de parada
+    pthread_t thread;
+    Sala** salas;                // Por posição (NULL: livre)
+    uint32_t* geracoes;          // Geração de cada posição
+    int* livres;                 // Posições livres para reaproveitar
+    int numSalas;                // Posições já usadas do vetor
+    int numLivres;
+    int capacidadeSalas;
+    Conexao** pendentes;         // Conexões com saída a enviar nesta rodada
+    int numPendentes;
+    int capacidadePendentes;
+    Conexao* conexoes;           // Todas as conexões do laço
+    Conexao* mortas;             // Fechadas nesta rodada
+    pthread_mutex_t trava;
+    Conexao* chegadas;           // Transferidas por outro laço
+    ResumoServidor resumo;
+} __attribute__((aligned(64)));
+
+struct Servidor {
+    const ModeloPartida* modelo;
+    ConfigServidor config;
+    int escuta;
+    int tcp;                     // 1: TCP (liga TCP_NODELAY nas conexões)
+    int porta;                   // Porta TCP efetiva
+    char caminhoUnix[sizeof(((struct sockaddr_un*) 0)->sun_path)];
+    atomic_int parar;
+    int numLacos;
+    Laco* lacos;
+};
+
+static const char* const NOMES_FASES[] = {"reforco", "ataque", "fim"};
+
+/* ---- Saída ---- */
+
+// Põe a conexão na lista das que têm saída a enviar no fim da rodada
+static void marcarPendente(Laco* laco, Conexao* c) {
+    if (c->posicaoPendente >= 0) {
+        return;
+    }
+    if (laco->numPendentes == laco->capacidadePendentes) {
+        int nova = (laco->capacidadePendentes > 0) ? laco->capacidadePendentes * 2 : 64;
+        Conexao** pendentes = (Conexao**) realloc(laco->pendentes, nova * sizeof(Conexao*));
+        if (pendentes == NULL) {
+            // Sem memória: a saída fica para a próxima vez que a conexão for marcada
+            return;
+        }
+        laco->pendentes = pendentes;
+        laco->capacidadePendentes = nova;
+    }
+    c->posicaoPendente = laco->numPendentes;
+    laco->pendentes[laco->numPendentes++] = c;
+}
+
+// Garante espaço para mais `tamanho` bytes de saída
+static int reservarSaida(Conexao* c, size_t tamanho) {
+    if (c->tamanhoSaida - c->enviados + tamanho > LIMITE_SAIDA) {
+        c->excedeu = 1;
+        return 0;
+    }
+    if (c->tamanhoSaida + tamanho <= c->capacidadeSaida) {
+        return 1;
+    }
+    // Descarta o que já foi enviado antes de crescer
+    if (c->enviados > 0) {
+        memmove(c->saida, c->saida + c->enviados, c->tamanhoSaida - c->enviados);
+        c->tamanhoSaida -= c->enviados;
+        c->enviados = 0;
+        if (c->tamanhoSaida + tamanho <= c->capacidadeSaida) {
+            return 1;
+        }
+    }
+    size_t nova = (c->capacidadeSaida > 0) ? c->capacidadeSaida : 512;
+    while (nova < c->tamanhoSaida + tamanho) {
+        nova *= 2;
+    }
+    char* saida = (char*) realloc(c->saida, nova);
+    if (saida == NULL) {
+        c->excedeu = 1;
+        return 0;
+    }
+    c->saida = saida;
+    c->capacidadeSaida = nova;
+    return 1;
+}
+
+static void escreverTexto(Conexao* c, const char* texto, size_t tamanho) {
+    if (c->morta) {
+        return;
+    }
+    if (!reservarSaida(c, tamanho)) {
+        // A conexão será fechada no fim da rodada
+        marcarPendente(c->laco, c);
+        return;
+    }
+    memcpy(c->saida + c->tamanhoSaida, texto, tamanho);
+    c->tamanhoSaida += tamanho;
+    marcarPendente(c->laco, c);
+}
+
+// Acrescenta uma linha formatada à saída da conexão
+static void escrever(Conexao* c, const char* formato, ...) __attribute__((format(printf, 2, 3)));
+static void escrever(Conexao* c, const char* formato, ...) {
+    char linha[512];
+    va_list args;
+    va_start(args, formato);
+    int tamanho = vsnprintf(linha, sizeof(linha), formato, args);
+    va_end(args);
+    if (tamanho > 0) {
+        size_t limite = sizeof(linha) - 1;
+        escreverTexto(c, linha, ((size_t) tamanho < limite) ? (size_t) tamanho : limite);
+    }
+}
+
+/*
+ * Função: avisar
+ * 
+ * Repassa uma linha, com '*' na frente, a cada conexão sentada na sala
+ * (uma vez só, mesmo com vários lugares), exceto `exceto`.
+ */
+static void avisar(Sala* sala, const Conexao* exceto, const char* linha, size_t tamanho) {
+    for (int j = 0; j < sala->partida.numJogadores; j++) {
+        Conexao* c = sala->lugares[j];
+        if (c == NULL || c == exceto || __builtin_ctz(c->lugares) != j) {
+            continue;
+        }
+        escreverTexto(c, "* ", 2);
+        escreverTexto(c, linha, tamanho);
+    }
+}
+
+/* ---- Conexões ---- */
+
+static int registrarNoEpoll(Laco* laco, Conexao* c, int operacao, uint32_t eventos) {
+    struct epoll_event evento;
+    evento.events = eventos;
+    evento.data.ptr = c;
+    return epoll_ctl(laco->epoll, operacao, c->fd, &evento) == 0;
+}
+
+// Entra na lista de conexões e no epoll do laço
+static int anexarConexao(Laco* laco, Conexao* c) {
+    c->laco = laco;
+    c->esperandoEscrita = 0;
+    c->posicaoPendente = -1;
+    if (!registrarNoEpoll(laco, c, EPOLL_CTL_ADD, EPOLLIN)) {
+        return 0;
+    }
+    c->anterior = NULL;
+    c->seguinte = laco->conexoes;
+    if (laco->conexoes != NULL) {
+        laco->conexoes->anterior = c;
+    }
+    laco->conexoes = c;
+    return 1;
+}
+
+// Sai da lista de conexões, do epoll e da lista de pendentes do laço
+static void desanexarConexao(Laco* laco, Conexao* c) {
+    epoll_ctl(laco->epoll, EPOLL_CTL_DEL, c->fd, NULL);
+    if (c->anterior != NULL) {
+        c->anterior->seguinte = c->seguinte;
+    } else {
+        laco->conexoes = c->seguinte;
+    }
+    if (c->seguinte != NULL) {
+        c->seguinte->anterior = c->anterior;
+    }
+    c->anterior = c->seguinte = NULL;
+    if (c->posicaoPendente >= 0) {
+        laco->pendentes[c->posicaoPendente] = NULL;
+        c->posicaoPendente = -1;
+    }
+}
+
+static void liberarConexao(Conexao* c) {
+    free(c->saida);
+    free(c);
+}
+
+static void deixarSala(Laco* laco, Conexao* c);
+
+// Fecha a conexão agora e a libera no fim da rodada
+static void fecharConexao(Laco* laco, Conexao* c) {
+    if (c->morta) {
+        return;
+    }
+    if (c->sala != NULL) {
+        deixarSala(laco, c);
+    }
+    desanexarConexao(laco, c);
+    close(c->fd);
+    c->morta = 1;
+    c->seguinte = laco->mortas;
+    laco->mortas = c;
+}
+
+/*
+ * Função: enviar
+ * 
+ * Envia o que couber da saída da conexão. Se o socket encher, espera o
+ * EPOLLOUT para continuar.
+ */
+static void enviar(Laco* laco, Conexao* c) {
+    while (c->enviados < c->tamanhoSaida) {
+        ssize_t n = send(c->fd, c->saida + c->enviados, c->tamanhoSaida - c->enviados,
+                         MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                if (!c->esperandoEscrita) {
+                    registrarNoEpoll(laco, c, EPOLL_CTL_MOD, EPOLLIN | EPOLLOUT);
+                    c->esperandoEscrita = 1;
+                }
+                return;
+            }
+            fecharConexao(laco, c);
+            return;
+        }
+        c->enviados += (size_t) n;
+    }
+    c->tamanhoSaida = c->enviados = 0;
+    if (c->esperandoEscrita) {
+        registrarNoEpoll(laco, c, EPOLL_CTL_MOD, EPOLLIN);
+        c->esperandoEscrita = 0;
+    }
+    if (c->fecharAposEnvio) {
+        fecharConexao(laco, c);
+    }
+}
+
+// Fim da rodada: envia as saídas acumuladas (fechar uma conexão pode acrescentar avisos)
+static void enviarPendentes(Laco* laco) {
+    for (int i = 0; i < laco->numPendentes; i++) {
+        Conexao* c = laco->pendentes[i];
+        if (c == NULL) {
+            continue;
+        }
+        c->posicaoPendente = -1;
+        if (c->excedeu) {
+            fecharConexao(laco, c);
+        } else {
+            enviar(laco, c);
+        }
+    }
+    laco->numPendentes = 0;
+}
+
+static void liberarMortas(Laco* laco) {
+    while (laco->mortas != NULL) {
+        Conexao* c = laco->mortas;
+        laco->mortas = c->seguinte;
+        liberarConexao(c);
+    }
+}
+
+/* ---- Salas ---- */
+
+static Sala* buscarSala(const Laco* laco, uint64_t id) {
+    int posicao = (int) ((id >> 8) & (MAX_SALAS_POR_LACO - 1));
+    if ((int) (id & 0xFF) != laco->indice || posicao >= laco->numSalas) {
+        return NULL;
+    }
+    Sala* sala = laco->salas[posicao];
+    return (sala != NULL && sala->id == id) ? sala : NULL;
+}
+
+// Garante uma posição livre no vetor de salas
+static int posicaoLivre(Laco* laco) {
+    if (laco->numLivres > 0) {
+        return laco->livres[--laco->numLivres];
+    }
+    if (laco->numSalas == laco->capacidadeSalas) {
+        int nova = (laco->capacidadeSalas > 0) ? laco->capacidadeSalas * 2 : 256;
+        if (nova > MAX_SALAS_POR_LACO) {
+            nova = MAX_SALAS_POR_LACO;
+        }
+        if (nova == laco->capacidadeSalas) {
+            return -1;
+        }
+        Sala** salas = (Sala**) realloc(laco->salas, nova * sizeof(Sala*));
+        if (salas != NULL) {
+            laco->salas = salas;
+        }
+        uint32_t* geracoes = (uint32_t*) realloc(laco->geracoes, nova * sizeof(uint32_t));
+        if (geracoes != NULL) {
+            laco->geracoes = geracoes;
+        }
+        int* livres = (int*) realloc(laco->livres, nova * sizeof(int));
+        if (livres != NULL) {
+            laco->livres = livres;
+        }
+        if (salas == NULL || geracoes == NULL || livres == NULL) {
+            return -1;
+        }
+        laco->capacidadeSalas = nova;
+    }
+    laco->geracoes[laco->numSalas] = 0;
+    laco->salas[laco->numSalas] = NULL;
+    return laco->numSalas++;
+}
+
+static Sala* criarSala(Laco* laco) {
+    const Servidor* servidor = laco->servidor;
+    int posicao = posicaoLivre(laco);
+    Sala* sala = (posicao >= 0) ? (Sala*) calloc(1, sizeof(Sala)) : NULL;
+    if (sala == NULL) {
+        if (posicao >= 0) {
+            laco->livres[laco->numLivres++] = posicao;
+        }
+        return NULL;
+    }
+    sala->posicao = posicao;
+    sala->id = ((uint64_t) laco->geracoes[posicao] << 32) | ((uint64_t) posicao << 8) |
+               (uint64_t) laco->indice;
+    uint64_t semente = servidor->config.semente + sala->id * 0x9E3779B97F4A7C15ULL;
+    if (!partidaIniciar(&sala->partida, servidor->modelo, servidor->config.regra, semente)) {
+        free(sala);
+        laco->livres[laco->numLivres++] = posicao;
+        return NULL;
+    }
+    laco->salas[posicao] = sala;
+    laco->resumo.partidas++;
+    return sala;
+}
+
+static void liberarSala(Laco* laco, Sala* sala) {
+    laco->salas[sala->posicao] = NULL;
+    laco->geracoes[sala->posicao]++;
+    laco->livres[laco->numLivres++] = sala->posicao;
+    partidaLiberar(&sala->partida);
+    free(sala);
+}
+
+static void sentar(Sala* sala, Conexao* c, int lugar) {
+    sala->lugares[lugar] = c;
+    sala->ocupados++;
+    c->sala = sala;
+    c->lugares |= 1u << lugar;
+}
+
+// Libera todos os lugares da conexão; a sala vazia é descartada
+static void deixarSala(Laco* laco, Conexao* c) {
+    Sala* sala = c->sala;
+    char linha[32];
+    for (int j = 0; j < sala->partida.numJogadores; j++) {
+        if (c->lugares & (1u << j)) {
+            sala->lugares[j] = NULL;
+            sala->ocupados--;
+        }
+    }
+    for (int j = 0; j < sala->partida.numJogadores; j++) {
+        if (c->lugares & (1u << j)) {
+            int tamanho = snprintf(linha, sizeof(linha), "SAIU %d\n", j + 1);
+            avisar(sala, c, linha, (size_t) tamanho);
+        }
+    }
+    c->sala = NULL;
+    c->lugares = 0;
+    if (sala->ocupados == 0) {
+        liberarSala(laco, sala);
+    }
+}
+
+// Lugar pelo qual a conexão joga: o da vez, se for dela, ou o primeiro dela
+static int lugarDaConexao(const Conexao* c) {
+    int vez = c->sala->partida.vez;
+    return (c->lugares & (1u << vez)) ? vez : __builtin_ctz(c->lugares);
+}
+
+// Sala da conexão, se já puder receber jogadas (senão responde o erro)
+static Sala* salaPronta(Conexao* c) {
+    Sala* sala = c->sala;
+    if (sala == NULL) {
+        escrever(c, "ERRO sem partida (use CRIAR ou ENTRAR)\n");
+        return NULL;
+    }
+    if (sala->ocupados < sala->partida.numJogadores) {
+        escrever(c, "ERRO aguardando jogadores (%d de %d)\n", sala->ocupados,
+                 sala->partida.numJogadores);
+        return NULL;
+    }
+    return sala;
+}
+
+/* ---- Comandos ---- */
+
+/*
+ * Tipo FuncaoComando
+ * 
+ * Executa um comando com os argumentos que seguem o nome. Devolve 0 se
+ * a linha deve ficar no buffer para ser relida por outro laço (ENTRAR
+ * em partida de outro laço), 1 caso contrário.
+ */
+typedef int (*FuncaoComando)(Laco* laco, Conexao* c, const char* argumentos);
+
+// Lê até `maximo` inteiros; devolve a quantidade, ou -1 se sobrar texto
+static int lerInteiros(const char* texto, long long* valores, int maximo) {
+    int quantidade = 0;
+    for (;;) {
+        while (*texto == ' ' || *texto == '\t') {
+            texto++;
+        }
+        if (*texto == '\0') {
+            return quantidade;
+        }
+        char* fim;
+        long long valor = strtoll(texto, &fim, 10);
+        if (fim == texto || quantidade == maximo) {
+            return -1;
+        }
+        valores[quantidade++] = valor;
+        texto = fim;
+    }
+}
+
+/*
+ * Função: lerOrdens
+ * 
+ * Lê as ordens de TURNO: "<a>:<d>" (uma rolagem) ou "<a>:<d>:<r>" (até
+ * conquistar ou restarem r tropas), separadas por espaços. Territórios
+ * fora do mapa viram -1, para conferirTurno recusar.
+ * 
+ * Retorno: quantidade de ordens, ou -1 se a linha for malformada ou
+ *          tiver mais de `maximo` ordens
+ */
+static int lerOrdens(const char* texto, int quantidade, OrdemTurno* ordens, int maximo) {
+    int numOrdens = 0;
+    for (;;) {
+        while (*texto == ' ' || *texto == '\t') {
+            texto++;
+        }
+        if (*texto == '\0') {
+            return numOrdens;
+        }
+        long long valores[3];
+        int lidos = 0;
+        for (char* fim; lidos < 3; texto = fim + 1) {
+            valores[lidos++] = strtoll(texto, &fim, 10);
+            if (fim == texto) {
+                return -1;
+            }
+            if (*fim != ':') {
+                texto = fim;
+                break;
+            }
+        }
+        if (lidos < 2 || (*texto != '\0' && *texto != ' ' && *texto != '\t') ||
+            numOrdens == maximo) {
+            return -1;
+        }
+        OrdemTurno* ordem = &ordens[numOrdens++];
+        ordem->atacante = (valores[0] >= 1 && valores[0] <= quantidade) ? (int) valores[0] - 1 : -1;
+        ordem->defensor = (valores[1] >= 1 && valores[1] <= quantidade) ? (int) valores[1] - 1 : -1;
+        ordem->politica = (lidos == 3) ? POLITICA_ATE_CONQUISTAR : POLITICA_UMA_VEZ;
+        // Reserva fora de 1..INT_MAX vira 0, também recusada
+        ordem->reserva = 1;
+        if (lidos == 3) {
+            ordem->reserva = (valores[2] >= 1 && valores[2] <= INT_MAX) ? (int) valores[2] : 0;
+        }
+    }
+}
+
+// Registra o fim da partida e repassa a linha da jogada aos outros
+static void concluirJogada(Laco* laco, Conexao* c, Sala* sala, const char* linha, int tamanho) {
+    escreverTexto(c, linha, (size_t) tamanho);
+    avisar(sala, c, linha, (size_t) tamanho);
+    if (sala->partida.fase == FASE_ENCERRADA && sala->partida.vencedor >= 0) {
+        laco->resumo.encerradas++;
+    }
+}
+
+static int comandoCriar(Laco* laco, Conexao* c, const char* argumentos) {
+    (void) argumentos;
+    if (c->sala != NULL) {
+        escrever(c, "ERRO a conexao ja esta em uma partida (use DEIXAR)\n");
+        return 1;
+    }
+    Sala* sala = criarSala(laco);
+    if (sala == NULL) {
+        escrever(c, "ERRO falha de memoria\n");
+        return 1;
+    }
+    sentar(sala, c, 0);
+    escrever(c, "OK %llu 1\n", (unsigned long long) sala->id);
+    return 1;
+}
+
+static int comandoEntrar(Laco* laco, Conexao* c, const char* argumentos) {
+    char* fim;
+    unsigned long long id = strtoull(argumentos, &fim, 10);
+    if (fim == argumentos) {
+        escrever(c, "ERRO uso: ENTRAR <partida>\n");
+        return 1;
+    }
+    int destino = (int) (id & 0xFF);
+    if (c->sala != NULL && c->sala->id != id) {
+        escrever(c, "ERRO a conexao ja esta em outra partida (use DEIXAR)\n");
+        return 1;
+    }
+    if (destino != laco->indice && destino < laco->servidor->numLacos) {
+        // A partida é de outro laço: a conexão (ainda sem lugar) vai para ele
+        c->transferirPara = destino;
+        return 0;
+    }
+    Sala* sala = buscarSala(laco, id);
+    if (sala == NULL) {
+        escrever(c, "ERRO partida inexistente\n");
+        return 1;
+    }
+    int lugar = 0;
+    while (lugar < sala->partida.numJogadores && sala->lugares[lugar] != NULL) {
+        lugar++;
+    }
+    if (lugar == sala->partida.numJogadores) {
+        escrever(c, "ERRO partida completa\n");
+        return 1;
+    }
+    sentar(sala, c, lugar);
+    escrever(c, "OK %llu %d\n", id, lugar + 1);
+    char linha[32];
+    int tamanho = snprintf(linha, sizeof(linha), "ENTROU %d\n", lugar + 1);
+    avisar(sala, c, linha, (size_t) tamanho);
+    return 1;
+}
+
+static int comandoDeixar(Laco* laco, Conexao* c, const char* argumentos) {
+    (void) argumentos;
+    if (c->sala == NULL) {
+        escrever(c, "ERRO sem partida\n");
+        return 1;
+    }
+    deixarSala(laco, c);
+    escrever(c, "OK\n");
+    return 1;
+}
+
+static int comandoEstado(Laco* laco, Conexao* c, const char* argumentos) {
+    (void) laco;
+    (void) argumentos;
+    if (c->sala == NULL) {
+        escrever(c, "ERRO sem partida (use CRIAR ou ENTRAR)\n");
+        return 1;
+    }
+    const Partida* partida = &c->sala->partida;
+    const Mapa* mapa = &partida->mapa;
+    if (mapa->quantidade > MAX_TERRITORIOS_ESTADO) {
+        // A resposta passaria de LIMITE_SAIDA e derrubaria a conexão
+        escrever(c, "ERRO mapa grande demais para ESTADO (%d territorios, maximo %d)\n",
+                 mapa->quantidade, MAX_TERRITORIOS_ESTADO);
+        return 1;
+    }
+    escrever(c, "ESTADO %llu %d %s %d %d %d", (unsigned long long) c->sala->id,
+             partida->vez + 1, NOMES_FASES[partida->fase], partida->reforco,
+             partida->rodada, partida->vencedor + 1);
+    if (!reservarSaida(c, (size_t) mapa->quantidade * TAM_PAR_ESTADO + 1)) {
+        return 1;
+    }
+    char* p = c->saida + c->tamanhoSaida;
+    for (int i = 0; i < mapa->quantidade; i++) {
+        p += sprintf(p, " %d:%d", partidaDonoDe(partida, i) + 1, mapa->tropas[i]);
+    }
+    *p++ = '\n';
+    c->tamanhoSaida = (size_t) (p - c->saida);
+    return 1;
+}
+
+static int comandoMissao(Laco* laco, Conexao* c, const char* argumentos) {
+    (void) laco;
+    if (c->sala == NULL) {
+        escrever(c, "ERRO sem partida (use CRIAR ou ENTRAR)\n");
+        return 1;
+    }
+    long long valores[1];
+    int n = lerInteiros(argumentos, valores, 1);
+    int jogador = (n == 1) ? (int) valores[0] - 1 : lugarDaConexao(c);
+    if (n < 0 || jogador < 0 || jogador >= MAX_JOGADORES_PARTIDA ||
+        !(c->lugares & (1u << jogador))) {
+        escrever(c, "ERRO so a missao dos proprios lugares pode ser vista\n");
+        return 1;
+    }
+    escrever(c, "MISSAO %d %s\n", jogador + 1, c->sala->partida.jogadores[jogador].missao->texto);
+    return 1;
+}
+
+static int comandoReforcar(Laco* laco, Conexao* c, const char* argumentos) {
+    long long valores[2];
+    if (lerInteiros(argumentos, valores, 2) != 2) {
+        escrever(c, "ERRO uso: REFORCAR <territorio> <tropas>\n");
+        return 1;
+    }
+    Sala* sala = salaPronta(c);
+    if (sala == NULL) {
+        return 1;
+    }
+    Partida* partida = &sala->partida;
+    int jogador = lugarDaConexao(c);
+    int territorio = (valores[0] >= 1 && valores[0] <= partida->mapa.quantidade)
+                   ? (int) valores[0] - 1 : -1;
+    int tropas = (valores[1] >= 1 && valores[1] <= partida->reforco) ? (int) valores[1] : 0;
+    CodigoJogada codigo = partidaReforcar(partida, jogador, territorio, tropas);
+    if (codigo != JOGADA_OK) {
+        escrever(c, "ERRO %s\n", partidaMensagem(codigo));
+        return 1;
+    }
+    char linha[96];
+    int tamanho = snprintf(linha, sizeof(linha), "REFORCO %d %d %d %d %d\n", jogador + 1,
+                           territorio + 1, partida->mapa.tropas[territorio], partida->reforco,
+                           partida->vencedor + 1);
+    concluirJogada(laco, c, sala, linha, tamanho);
+    return 1;
+}
+
+static int comandoAtacar(Laco* laco, Conexao* c, const char* argumentos) {
+    long long valores[2];
+    if (lerInteiros(argumentos, valores, 2) != 2) {
+        escrever(c, "ERRO uso: ATACAR <atacante> <defensor>\n");
+        return 1;
+    }
+    Sala* sala = salaPronta(c);
+    if (sala == NULL) {
+        return 1;
+    }
+    Partida* partida = &sala->partida;
+    int jogador = lugarDaConexao(c);
+    int quantidade = partida->mapa.quantidade;
+    int atacante = (valores[0] >= 1 && valores[0] <= quantidade) ? (int) valores[0] - 1 : -1;
+    int defensor = (valores[1] >= 1 && valores[1] <= quantidade) ? (int) valores[1] - 1 : -1;
+    ResultadoAtaque resultado;
+    CodigoJogada codigo = partidaAtacar(partida, jogador, atacante, defensor, &resultado);
+    if (codigo != JOGADA_OK) {
+        escrever(c, "ERRO %s\n", partidaMensagem(codigo));
+        return 1;
+    }
+    char linha[128];
+    int tamanho = snprintf(linha, sizeof(linha), "ATAQUE %d %d %d %d %d %d %d %d %d\n",
+                           jogador + 1, atacante + 1, defensor + 1, resultado.perdasAtacante,
+                           resultado.perdasDefensor, resultado.conquista,
+                           resultado.tropasAtacante, resultado.tropasDefensor,
+                           partida->vencedor + 1);
+    concluirJogada(laco, c, sala, linha, tamanho);
+    return 1;
+}
+
+static int comandoTurno(Laco* laco, Conexao* c, const char* argumentos) {
+    Sala* sala = salaPronta(c);
+    if (sala == NULL) {
+        return 1;
+    }
+    Partida* partida = &sala->partida;
+    OrdemTurno ordens[MAX_ORDENS_TURNO];
+    int numOrdens = lerOrdens(argumentos, partida->mapa.quantidade, ordens, MAX_ORDENS_TURNO);
+    if (numOrdens <= 0) {
+        escrever(c, "ERRO uso: TURNO <a>:<d>[:<reserva>] ... (ate %d ordens)\n",
+                 MAX_ORDENS_TURNO);
+        return 1;
+    }
+    int jogador = lugarDaConexao(c);
+    ResultadoOrdem resultados[MAX_ORDENS_TURNO];
+    int recusada;
+    CodigoJogada codigo = partidaAtacarLote(partida, jogador, ordens, numOrdens, resultados,
+                                            &recusada);
+    if (codigo != JOGADA_OK) {
+        if (recusada >= 0) {
+            escrever(c, "ERRO ordem %d: %s\n", recusada + 1, partidaMensagem(codigo));
+        } else {
+            escrever(c, "ERRO %s\n", partidaMensagem(codigo));
+        }
+        return 1;
+    }
+    // Uma linha para o turno inteiro (as missões só foram conferidas no fim)
+    char linha[TAM_RESPOSTA_TURNO];
+    int conquistas = 0;
+    for (int i = 0; i < numOrdens; i++) {
+        conquistas += resultados[i].conquista;
+    }
+    int tamanho = snprintf(linha, sizeof(linha), "TURNO %d %d %d %d", jogador + 1, numOrdens,
+                           conquistas, partida->vencedor + 1);
+    for (int i = 0; i < numOrdens; i++) {
+        const ResultadoOrdem* r = &resultados[i];
+        tamanho += snprintf(linha + tamanho, sizeof(linha) - (size_t) tamanho,
+                            " %d:%d:%d:%d:%d:%d", ordens[i].atacante + 1, ordens[i].defensor + 1,
+                            r->rolagens, r->conquista, r->tropasAtacante, r->tropasDefensor);
+    }
+    linha[tamanho++] = '\n';
+    concluirJogada(laco, c, sala, linha, tamanho);
+    return 1;
+}
+
+static int comandoPassar(Laco* laco, Conexao* c, const char* argumentos) {
+    (void) argumentos;
+    Sala* sala = salaPronta(c);
+    if (sala == NULL) {
+        return 1;
+    }
+    Partida* partida = &sala->partida;
+    CodigoJogada codigo = partidaPassar(partida, lugarDaConexao(c));
+    if (codigo != JOGADA_OK) {
+        escrever(c, "ERRO %s\n", partidaMensagem(codigo));
+        return 1;
+    }
+    char linha[64];
+    int tamanho = snprintf(linha, sizeof(linha), "VEZ %d %d %d\n", partida->vez + 1,
+                           partida->reforco, partida->rodada);
+    concluirJogada(laco, c, sala, linha, tamanho);
+    return 1;
+}
+
+static int comandoSair(Laco* laco, Conexao* c, const char* argumentos) {
+    (void) laco;
+    (void) argumentos;
+    escrever(c, "OK\n");
+    c->fecharAposEnvio = 1;
+    return 1;
+}
+
+static const struct {
+    const char* nome;
+    FuncaoComando executar;
+} COMANDOS[] = {
+    {"ATACAR", comandoAtacar},
+    {"TURNO", comandoTurno},
+    {"REFORCAR", comandoReforcar},
+    {"PASSAR", comandoPassar},
+    {"ESTADO", comandoEstado},
+    {"MISSAO", comandoMissao},
+    {"CRIAR", comandoCriar},
+    {"ENTRAR", comandoEntrar},
+    {"DEIXAR", comandoDeixar},
+    {"SAIR", comandoSair}
+};
+
+/*
+ * Função: executarLinha
+ * 
+ * Separa o nome do comando e despacha pela tabela (linhas vazias são
+ * ignoradas).
+ * 
+ * Retorno: 0 se a linha deve ser relida por outro laço, 1 caso contrário
+ */
+static int executarLinha(Laco* laco, Conexao* c, const char* linha) {
+    while (*linha == ' ' || *linha == '\t') {
+        linha++;
+    }
+    size_t tamanho = strcspn(linha, " \t");
+    if (tamanho == 0) {
+        return 1;
+    }
+    laco->resumo.comandos++;
+    for (size_t k = 0; k < sizeof(COMANDOS) / sizeof(COMANDOS[0]); k++) {
+        if (strlen(COMANDOS[k].nome) == tamanho && memcmp(COMANDOS[k].nome, linha, tamanho) == 0) {
+            return COMANDOS[k].executar(laco, c, linha + tamanho);
+        }
+    }
+    escrever(c, "ERRO comando desconhecido: %.*s\n", (int) tamanho, linha);
+    return 1;
+}
+
+/* ---- Laço de eventos ---- */
+
+// Passa a conexão ao laço `destino`, que relê a linha pendente
+static void transferir(Laco* laco, Conexao* c, int destino) {
+    Laco* alvo = &laco->servidor->lacos[destino];
+    desanexarConexao(laco, c);
+    laco->resumo.transferencias++;
+    pthread_mutex_lock(&alvo->trava);
+    c->seguinte = alvo->chegadas;
+    alvo->chegadas = c;
+    pthread_mutex_unlock(&alvo->trava);
+    uint64_t um = 1;
+    if (write(alvo->aviso, &um, sizeof(um)) < 0) {
+        // O contador do eventfd já está acordando o destino
+    }
+}
+
+/*
+ * Função: processarEntrada
+ * 
+ * Executa as linhas completas do buffer de entrada. Para na primeira
+ * linha que pede transferência, que fica no buffer para o outro laço.
+ */
+static void processarEntrada(Laco* laco, Conexao* c) {
+    char linha[TAM_ENTRADA];
+    int inicio = 0;
+    while (!c->morta && !c->fecharAposEnvio) {
+        char* quebra = memchr(c->entrada + inicio, '\n', (size_t) (c->lidos - inicio));
+        if (quebra == NULL) {
+            break;
+        }
+        int tamanho = (int) (quebra - (c->entrada + inicio));
+        memcpy(linha, c->entrada + inicio, (size_t) tamanho);
+        if (tamanho > 0 && linha[tamanho - 1] == '\r') {
+            tamanho--;
+        }
+        linha[tamanho] = '\0';
+        if (!executarLinha(laco, c, linha)) {
+            break;
+        }
+        inicio = (int) (quebra - c->entrada) + 1;
+    }
+    if (c->morta) {
+        return;
+    }
+    memmove(c->entrada, c->entrada + inicio, (size_t) (c->lidos - inicio));
+    c->lidos -= inicio;
+    if (c->transferirPara >= 0) {
+        int destino = c->transferirPara;
+        c->transferirPara = -1;
+        transferir(laco, c, destino);
+        return;
+    }
+    if (c->lidos == TAM_ENTRADA) {
+        escrever(c, "ERRO linha muito longa\n");
+        c->fecharAposEnvio = 1;
+    }
+}
+
+static void lerConexao(Laco* laco, Conexao* c) {
+    ssize_t n = recv(c->fd, c->entrada + c->lidos, (size_t) (TAM_ENTRADA - c->lidos), 0);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        fecharConexao(laco, c);
+        return;
+    }
+    if (n > 0) {
+        c->lidos += (int) n;
+        processarEntrada(laco, c);
+    }
+}
+
+static void aceitar(Laco* laco) {
+    const Servidor* servidor = laco->servidor;
+    for (;;) {
+        int fd = accept4(servidor->escuta, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            // EAGAIN: outro laço levou a conexão ou a fila acabou
+            return;
+        }
+        if (servidor->tcp) {
+            int um = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &um, sizeof(um));
+        }
+        Conexao* c = (Conexao*) calloc(1, sizeof(Conexao));
+        if (c == NULL) {
+            close(fd);
+            continue;
+        }
+        c->fd = fd;
+        c->transferirPara = -1;
+        if (!anexarConexao(laco, c)) {
+            close(fd);
+            free(c);
+            continue;
+        }
+        laco->resumo.conexoes++;
+    }
+}
+
+// Adota as conexões transferidas por outros laços e executa as linhas pendentes delas
+static void receberChegadas(Laco* laco) {
+    uint64_t contador;
+    if (read(laco->aviso, &contador, sizeof(contador)) < 0) {
+        // Nada a ler: a chegada já foi tratada em uma rodada anterior
+    }
+    pthread_mutex_lock(&laco->trava);
+    Conexao* lista = laco->chegadas;
+    laco->chegadas = NULL;
+    pthread_mutex_unlock(&laco->trava);
+    while (lista != NULL) {
+        Conexao* c = lista;
+        lista = c->seguinte;
+        if (!anexarConexao(laco, c)) {
+            close(c->fd);
+            liberarConexao(c);
+            continue;
+        }
+        if (c->tamanhoSaida > c->enviados) {
+            marcarPendente(laco, c);
+        }
+        processarEntrada(laco, c);
+    }
+}
+
+static void* executarLaco(void* argumento) {
+    Laco* laco = (Laco*) argumento;
+    Servidor* servidor = laco->servidor;
+    struct epoll_event eventos[EVENTOS_POR_RODADA];
+
+    while (!atomic_load_explicit(&servidor->parar, memory_order_relaxed)) {
+        int n = epoll_wait(laco->epoll, eventos, EVENTOS_POR_RODADA, -1);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        for (int k = 0; k < n; k++) {
+            void* alvo = eventos[k].data.ptr;
+            if (alvo == NULL) {
+                aceitar(laco);
+            } else if (alvo == (void*) laco) {
+                receberChegadas(laco);
+            } else {
+                Conexao* c = (Conexao*) alvo;
+                if (!c->morta && (eventos[k].events & EPOLLOUT)) {
+                    marcarPendente(laco, c);
+                }
+                if (!c->morta && (eventos[k].events & (EPOLLIN | EPOLLHUP | EPOLLERR))) {
+                    lerConexao(laco, c);
+                }
+            }
+        }
+        enviarPendentes(laco);
+        liberarMortas(laco);
+    }
+    return NULL;
+}
+
+/* ---- Criação e destruição ---- */
+
+// Socket Unix em `caminho` (um arquivo antigo no caminho é removido)
+static int escutarUnix(Servidor* servidor, const char* caminho, FILE* erros) {
+    struct sockaddr_un endereco;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    if (strlen(caminho) >= sizeof(endereco.sun_path)) {
+        fprintf(erros, "%s: caminho muito longo para um socket Unix\n", caminho);
+        return -1;
+    }
+    strcpy(endereco.sun_path, caminho);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    unlink(caminho);
+    if (bind(fd, (struct sockaddr*) &endereco, sizeof(endereco)) != 0) {
+        fprintf(erros, "%s: %s\n", caminho, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    strcpy(servidor->caminhoUnix, caminho);
+    return fd;
+}
+
+// Socket TCP em "host:porta" (host vazio ou "*": todas as interfaces)
+static int escutarTcp(Servidor* servidor, const char* texto, FILE* erros) {
+    const char* separador = strrchr(texto, ':');
+    if (separador == NULL) {
+        fprintf(erros, "%s: endereco deve ser host:porta ou unix:caminho\n", texto);
+        return -1;
+    }
+    char host[256];
+    size_t tamanhoHost = (size_t) (separador - texto);
+    if (tamanhoHost >= sizeof(host)) {
+        fprintf(erros, "%s: host muito longo\n", texto);
+        return -1;
+    }
+    memcpy(host, texto, tamanhoHost);
+    host[tamanhoHost] = '\0';
+    // [::1]:porta
+    char* nomeHost = host;
+    if (tamanhoHost >= 2 && host[0] == '[' && host[tamanhoHost - 1] == ']') {
+        host[tamanhoHost - 1] = '\0';
+        nomeHost++;
+    }
+
+    struct addrinfo dicas, *lista;
+    memset(&dicas, 0, sizeof(dicas));
+    dicas.ai_family = AF_UNSPEC;
+    dicas.ai_socktype = SOCK_STREAM;
+    dicas.ai_flags = AI_PASSIVE;
+    int todas = (nomeHost[0] == '\0' || strcmp(nomeHost, "*") == 0);
+    int erro = getaddrinfo(todas ? NULL : nomeHost, separador + 1, &dicas, &lista);
+    if (erro != 0) {
+        fprintf(erros, "%s: %s\n", texto, gai_strerror(erro));
+        return -1;
+    }
+    int fd = -1;
+    for (struct addrinfo* a = lista; a != NULL && fd < 0; a = a->ai_next) {
+        fd = socket(a->ai_family, a->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, a->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        int um = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &um, sizeof(um));
+        if (bind(fd, a->ai_addr, a->ai_addrlen) != 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(lista);
+    if (fd < 0) {
+        fprintf(erros, "%s: %s\n", texto, strerror(errno));
+        return -1;
+    }
+
+    struct sockaddr_storage local;
+    socklen_t tamanho = sizeof(local);
+    if (getsockname(fd, (struct sockaddr*) &local, &tamanho) == 0) {
+        servidor->porta = (local.ss_family == AF_INET6)
+                        ? ntohs(((struct sockaddr_in6*) &local)->sin6_port)
+                        : ntohs(((struct sockaddr_in*) &local)->sin_port);
+    }
+    servidor->tcp = 1;
+    return fd;
+}
+
+static int iniciarLaco(Servidor* servidor, Laco* laco, int indice) {
+    memset(laco, 0, sizeof(*laco));
+    laco->servidor = servidor;
+    laco->indice = indice;
+    laco->epoll = epoll_create1(EPOLL_CLOEXEC);
+    laco->aviso = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    pthread_mutex_init(&laco->trava, NULL);
+    if (laco->epoll < 0 || laco->aviso < 0) {
+        return 0;
+    }
+    // Todos os laços esperam no mesmo socket de escuta; cada conexão acorda um só
+    struct epoll_event evento;
+    evento.events = EPOLLIN | EPOLLEXCLUSIVE;
+    evento.data.ptr = NULL;
+    if (epoll_ctl(laco->epoll, EPOLL_CTL_ADD, servidor->escuta, &evento) != 0) {
+        return 0;
+    }
+    evento.events = EPOLLIN;
+    evento.data.ptr = laco;
+    return epoll_ctl(laco->epoll, EPOLL_CTL_ADD, laco->aviso, &evento) == 0;
+}
+
+/*
+ * Função: servidorCriar
+ * 
+ * Abre o socket de escuta e prepara os laços (as threads só começam em
+ * servidorExecutar). O modelo deve durar mais que o servidor.
+ * 
+ * Retorno: servidor criado, ou NULL (com o motivo escrito em `erros`)
+ */
+Servidor* servidorCriar(const ModeloPartida* modelo, const ConfigServidor* config, FILE* erros) {
+    if (config->lacos < 1 || config->lacos > MAX_LACOS ||
+        (unsigned) config->regra >= NUM_REGRAS || modelo->numJogadores < 2) {
+        fprintf(erros, "configuracao do servidor invalida\n");
+        return NULL;
+    }
+    Servidor* servidor = (Servidor*) calloc(1, sizeof(Servidor));
+    if (servidor == NULL) {
+        return NULL;
+    }
+    servidor->modelo = modelo;
+    servidor->config = *config;
+    servidor->escuta = (strncmp(config->endereco, "unix:", 5) == 0)
+                     ? escutarUnix(servidor, config->endereco + 5, erros)
+                     : escutarTcp(servidor, config->endereco, erros);
+    if (servidor->escuta < 0) {
+        free(servidor);
+        return NULL;
+    }
+    if (listen(servidor->escuta, FILA_ESCUTA) != 0) {
+        fprintf(erros, "%s: %s\n", config->endereco, strerror(errno));
+        servidorDestruir(servidor);
+        return NULL;
+    }
+
+    servidor->lacos = (Laco*) aligned_alloc(64, sizeof(Laco) * config->lacos);
+    if (servidor->lacos == NULL) {
+        servidorDestruir(servidor);
+        return NULL;
+    }
+    for (int i = 0; i < config->lacos; i++) {
+        servidor->numLacos = i + 1;
+        if (!iniciarLaco(servidor, &servidor->lacos[i], i)) {
+            fprintf(erros, "falha ao criar o laco de eventos %d: %s\n", i, strerror(errno));
+            servidorDestruir(servidor);
+            return NULL;
+        }
+    }
+    return servidor;
+}
+
+/*
+ * Função: servidorPorta
+ * 
+ * Retorno: porta TCP em que o servidor escuta (0 em socket Unix)
+ */
+int servidorPorta(const Servidor* servidor) {
+    return servidor->porta;
+}
+
+/*
+ * Função: servidorExecutar
+ * 
+ * Roda os laços (o primeiro na thread que chama) até servidorParar.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 se não foi possível criar as threads
+ */
+int servidorExecutar(Servidor* servidor) {
+    int criadas = 1;
+    for (; criadas < servidor->numLacos; criadas++) {
+        Laco* laco = &servidor->lacos[criadas];
+        if (pthread_create(&laco->thread, NULL, executarLaco, laco) != 0) {
+            servidorParar(servidor);
+            break;
+        }
+    }
+    if (criadas == servidor->numLacos) {
+        executarLaco(&servidor->lacos[0]);
+    }
+    for (int i = 1; i < criadas; i++) {
+        pthread_join(servidor->lacos[i].thread, NULL);
+    }
+    return criadas == servidor->numLacos;
+}
+
+/*
+ * Função: servidorParar
+ * 
+ * Pede que todos os laços terminem. Pode ser chamada de outra thread ou
+ * de um tratador de sinal.
+ */
+void servidorParar(Servidor* servidor) {
+    atomic_store(&servidor->parar, 1);
+    uint64_t um = 1;
+    for (int i = 0; i < servidor->numLacos; i++) {
+        if (write(servidor->lacos[i].aviso, &um, sizeof(um)) < 0) {
+            // O laço já tem um aviso pendente
+        }
+    }
+}
+
+/*
+ * Função: servidorResumo
+ * 
+ * Soma os totais dos laços. Só é exata depois que servidorExecutar
+ * retornou.
+ */
+void servidorResumo(const Servidor* servidor, ResumoServidor* resumo) {
+    memset(resumo, 0, sizeof(*resumo));
+    for (int i = 0; i < servidor->numLacos; i++) {
+        const ResumoServidor* parcial = &servidor->lacos[i].resumo;
+        resumo->conexoes += parcial->conexoes;
+        resumo->partidas += parcial->partidas;
+        resumo->encerradas += parcial->encerradas;
+        resumo->comandos += parcial->comandos;
+        resumo->transferencias += parcial->transferencias;
+    }
+}
+
+static void liberarLaco(Laco* laco) {
+    Conexao* listas[2] = {laco->conexoes, laco->chegadas};
+    for (int k = 0; k < 2; k++) {
+        while (listas[k] != NULL) {
+            Conexao* c = listas[k];
+            listas[k] = c->seguinte;
+            close(c->fd);
+            liberarConexao(c);
+        }
+    }
+    liberarMortas(laco);
+    for (int i = 0; i < laco->numSalas; i++) {
+        if (laco->salas[i] != NULL) {
+            partidaLiberar(&laco->salas[i]->partida);
+            free(laco->salas[i]);
+        }
+    }
+    free(laco->salas);
+    free(laco->geracoes);
+    free(laco->livres);
+    free(laco->pendentes);
+    if (laco->epoll >= 0) {
+        close(laco->epoll);
+    }
+    if (laco->aviso >= 0) {
+        close(laco->aviso);
+    }
+    pthread_mutex_destroy(&laco->trava);
+}
+
+/*
+ * Função: servidorDestruir
+ * 
+ * Fecha todas as conexões, descarta as partidas e remove o socket Unix.
+ * Os laços já devem ter terminado.
+ */
+void servidorDestruir(Servidor* servidor) {
+    if (servidor == NULL) {
+        return;
+    }
+    for (int i = 0; i < servidor->numLacos; i++) {
+        liberarLaco(&servidor->lacos[i]);
+    }
+    free(servidor->lacos);
+    if (servidor->escuta >= 0) {
+        close(servidor->escuta);
+    }
+    if (servidor->caminhoUnix[0] != '\0') {
+        unlink(servidor->caminhoUnix);
+    }
+    free(servidor);
+}
@@ -0,0 +1,91 @@
+/*
+ * Servidor de partidas em rede
+ * 
+ * Mantém milhares de partidas independentes (partida.h) em um único
+ * processo. Cada laço de eventos é uma thread com o seu próprio epoll e
+ * é dono das partidas criadas nele; todos aceitam conexões do mesmo
+ * socket de escuta (TCP ou Unix). Uma jogada é resolvida inteira na
+ * thread do laço, sem travas, e as respostas de uma rodada do epoll
+ * saem com uma escrita por conexão.
+ * 
+ * Protocolo: linhas de texto terminadas em '\n'. Cada comando recebe
+ * exatamente uma linha de resposta; jogadores e territórios são
+ * numerados a partir de 1.
+ *   CRIAR                -> OK <partida> <jogador>   (cria e ocupa o 1o lugar)
+ *   ENTRAR <partida>     -> OK <partida> <jogador>   (ocupa o próximo lugar livre)
+ *   DEIXAR               -> OK                       (libera os lugares da conexão)
+ *   ESTADO               -> ESTADO <partida> <vez> <fase> <reforco> <rodada> <vencedor>
+ *                           <dono>:<tropas> ... (um par por território; mapas de
+ *                           mais de ~65 mil territórios respondem ERRO)
+ *   MISSAO [<jogador>]   -> MISSAO <jogador> <texto>
+ *   REFORCAR <t> <n>     -> REFORCO <jogador> <t> <tropas> <restante> <vencedor>
+ *   ATACAR <a> <d>       -> ATAQUE <jogador> <a> <d> <perdasA> <perdasD> <conquista>
+ *                           <tropasA> <tropasD> <vencedor>
+ *   TURNO <a>:<d>[:<r>] ...
+ *                        -> TURNO <jogador> <ordens> <conquistas> <vencedor>
+ *                           <a>:<d>:<rolagens>:<conquista>:<tropasA>:<tropasD> ...
+ *   PASSAR               -> VEZ <jogador> <reforco> <rodada>
+ *   SAIR                 -> OK (e a conexão é fechada)
+ * Recusas e erros respondem "ERRO <mensagem>". <fase> é reforco, ataque
+ * ou fim; <vencedor> e <dono> valem 0 quando não há jogador. TURNO
+ * manda várias ordens de ataque de uma vez (turno.h): "<a>:<d>" rola uma
+ * vez, "<a>:<d>:<r>" ataca até conquistar ou restarem r tropas em <a>;
+ * as missões são conferidas só depois da última ordem, e uma ordem
+ * recusada ("ERRO ordem <n>: ...") cancela o turno inteiro.
+ * 
+ * Uma conexão pode ocupar vários lugares da mesma partida (todos no
+ * mesmo computador) e joga pelo lugar da vez. As jogadas só valem com
+ * todos os lugares ocupados. As respostas de REFORCAR, ATACAR, TURNO e PASSAR
+ * são repassadas às demais conexões da partida como avisos, com '*' na
+ * frente ("* ATAQUE ..."), assim como "* ENTROU <jogador>" e
+ * "* SAIU <jogador>"; um aviso nunca responde a um comando.
+ */
+
+#ifndef WAR_SERVIDOR_H
+#define WAR_SERVIDOR_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "batalha.h"
+#include "partida.h"
+
+// Laços de eventos por servidor
+#define MAX_LACOS 64
+
+/*
+ * Struct ConfigServidor
+ * 
+ * Endereço: "host:porta" para TCP (host vazio ou "*": todas as
+ * interfaces; porta 0: escolhida pelo sistema, ver servidorPorta) ou
+ * "unix:<caminho>" para um socket Unix.
+ */
+typedef struct {
+    const char* endereco;
+    int lacos;                 // Threads de eventos (1..MAX_LACOS)
+    RegraBatalha regra;        // Regra de batalha de todas as partidas
+    uint64_t semente;          // A partida de número k usa a semente derivada de (semente, k)
+} ConfigServidor;
+
+/*
+ * Struct ResumoServidor
+ * 
+ * Totais de uma execução, somados entre os laços.
+ */
+typedef struct {
+    long long conexoes;        // Conexões aceitas
+    long long partidas;        // Partidas criadas
+    long long encerradas;      // Partidas que terminaram com vencedor
+    long long comandos;        // Linhas de comando processadas
+    long long transferencias;  // Conexões passadas a outro laço por ENTRAR
+} ResumoServidor;
+
+typedef struct Servidor Servidor;
+
+Servidor* servidorCriar(const ModeloPartida* modelo, const ConfigServidor* config, FILE* erros);
+int servidorPorta(const Servidor* servidor);
+int servidorExecutar(Servidor* servidor);
+void servidorParar(Servidor* servidor);
+void servidorResumo(const Servidor* servidor, ResumoServidor* resumo);
+void servidorDestruir(Servidor* servidor);
+
+#endif
@@ -0,0 +1,549 @@
+/*
+ * Snapshot binário da partida
+ * 
+ * Gravação e carga por mmap do formato descrito em snapshot.h, mais a
+ * exportação para o formato de cenário.
+ */
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "continente.h"
+#include "grafo.h"
+#include "missao.h"
+#include "snapshot.h"
+
+// Valor gravado em ordemBytes para detectar arquivos de outra arquitetura
+#define MARCA_ORDEM_BYTES 0x01020304u
+
+static const char* const MENSAGENS[] = {
+    "ok",
+    "nao foi possivel acessar o arquivo",
+    "arquivo de snapshot invalido",
+    "versao de snapshot nao suportada",
+    "soma de verificacao nao confere",
+    "falha de alocacao de memoria"
+};
+
+/*
+ * Função: snapshotMensagem
+ * 
+ * Retorno: descrição do código, para mensagens ao usuário
+ */
+const char* snapshotMensagem(CodigoSnapshot codigo) {
+    return ((unsigned) codigo <= SNAPSHOT_ERRO_MEMORIA) ? MENSAGENS[codigo] : "?";
+}
+
+static uint64_t alinhar8(uint64_t valor) {
+    return (valor + 7) & ~(uint64_t) 7;
+}
+
+/*
+ * Função: somaVerificacao
+ * 
+ * Hash de 64 bits em quatro pistas independentes de 8 bytes (multiplica e
+ * rotaciona), para que mesmo snapshots grandes sejam conferidos na
+ * velocidade da memória. Detecta corrupção, não adulteração.
+ */
+static uint64_t somaVerificacao(const unsigned char* dados, size_t tamanho) {
+    const uint64_t primo1 = 0x9E3779B185EBCA87ULL;
+    const uint64_t primo2 = 0xC2B2AE3D27D4EB4FULL;
+    uint64_t pistas[4] = {primo1, primo2, ~primo1, ~primo2};
+    size_t i = 0;
+
+    for (; i + 32 <= tamanho; i += 32) {
+        for (int p = 0; p < 4; p++) {
+            uint64_t palavra;
+            memcpy(&palavra, dados + i + 8 * p, sizeof(palavra));
+            pistas[p] += palavra * primo2;
+            pistas[p] = ((pistas[p] << 31) | (pistas[p] >> 33)) * primo1;
+        }
+    }
+
+    uint64_t h = (uint64_t) tamanho;
+    for (int p = 0; p < 4; p++) {
+        h = (h ^ pistas[p]) * primo1;
+        h ^= h >> 29;
+    }
+    for (; i < tamanho; i++) {
+        h = (h ^ dados[i]) * 0x100000001B3ULL;
+    }
+    h ^= h >> 32;
+    return h;
+}
+
+/*
+ * Função: montarCabecalho
+ * 
+ * Calcula os deslocamentos das seções e o tamanho total do arquivo.
+ */
+static void montarCabecalho(CabecalhoSnapshot* cab, const Mapa* mapa, int numJogadores) {
+    memset(cab, 0, sizeof(CabecalhoSnapshot));
+    memcpy(cab->assinatura, ASSINATURA_SNAPSHOT, sizeof(cab->assinatura));
+    cab->versao = VERSAO_SNAPSHOT;
+    cab->ordemBytes = MARCA_ORDEM_BYTES;
+    cab->numTerritorios = (uint32_t) mapa->quantidade;
+    cab->numCores = (uint32_t) mapa->numCores;
+    cab->numJogadores = (uint32_t) numJogadores;
+    // O grafo completo é o padrão de um mapa sem fronteiras: não é gravado
+    if (mapa->grafo != NULL && !mapa->grafo->completo) {
+        cab->temGrafo = 1;
+        cab->grafoLinear = (uint32_t) mapa->grafo->linear;
+        cab->numVizinhos = (uint32_t) mapa->grafo->numEntradas;
+    }
+    if (mapa->continentes != NULL) {
+        cab->numContinentes = (uint32_t) mapa->continentes->numContinentes;
+    }
+
+    uint64_t n = cab->numTerritorios;
+    uint64_t pos = alinhar8(sizeof(CabecalhoSnapshot));
+    cab->deslocCores = pos;
+    pos = alinhar8(pos + (uint64_t) cab->numCores * TAM_COR);
+    cab->deslocJogadores = pos;
+    pos = alinhar8(pos + (uint64_t) cab->numJogadores * sizeof(RegistroJogador));
+    cab->deslocTropas = pos;
+    pos = alinhar8(pos + n * sizeof(int32_t));
+    cab->deslocDonos = pos;
+    pos = alinhar8(pos + n * sizeof(IdCor));
+    cab->deslocNomes = pos;
+    pos = alinhar8(pos + n * TAM_NOME);
+    cab->deslocInicio = pos;
+    if (cab->temGrafo) {
+        pos = alinhar8(pos + (n + 1) * sizeof(int32_t));
+    }
+    cab->deslocVizinhos = pos;
+    if (cab->temGrafo) {
+        pos = alinhar8(pos + (uint64_t) cab->numVizinhos * sizeof(int32_t));
+    }
+    cab->deslocContinentes = pos;
+    pos = alinhar8(pos + (uint64_t) cab->numContinentes * sizeof(RegistroContinente));
+    cab->deslocContinenteDe = pos;
+    if (cab->numContinentes > 0) {
+        pos = alinhar8(pos + n * sizeof(int32_t));
+    }
+    cab->tamanho = pos;
+}
+
+/*
+ * Função: snapshotSalvar
+ * 
+ * Grava o estado da partida. O arquivo é montado em um temporário mapeado
+ * em memória e renomeado no fim, então um snapshot anterior com o mesmo
+ * nome só é substituído se a gravação terminar.
+ * 
+ * Parâmetros:
+ *   caminho - arquivo de destino
+ *   mapa - mapa de territórios (com ou sem grafo e continentes)
+ *   jogadores - jogadores da partida, com suas missões
+ *   numJogadores - quantidade de jogadores
+ * 
+ * Retorno: SNAPSHOT_OK ou o código do erro
+ */
+CodigoSnapshot snapshotSalvar(const char* caminho, const Mapa* mapa,
+                              const Jogador* jogadores, int numJogadores) {
+    CabecalhoSnapshot cab;
+    montarCabecalho(&cab, mapa, numJogadores);
+
+    size_t tamanhoCaminho = strlen(caminho);
+    char* temporario = (char*) malloc(tamanhoCaminho + 5);
+    if (temporario == NULL) {
+        return SNAPSHOT_ERRO_MEMORIA;
+    }
+    memcpy(temporario, caminho, tamanhoCaminho);
+    memcpy(temporario + tamanhoCaminho, ".tmp", 5);
+
+    int fd = open(temporario, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        free(temporario);
+        return SNAPSHOT_ERRO_ARQUIVO;
+    }
+    unsigned char* base = NULL;
+    if (ftruncate(fd, (off_t) cab.tamanho) != 0 ||
+        (base = mmap(NULL, cab.tamanho, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED) {
+        close(fd);
+        unlink(temporario);
+        free(temporario);
+        return SNAPSHOT_ERRO_ARQUIVO;
+    }
+
+    uint64_t n = cab.numTerritorios;
+    memcpy(base + cab.deslocCores, mapa->cores, (size_t) cab.numCores * TAM_COR);
+
+    RegistroJogador* registros = (RegistroJogador*) (base + cab.deslocJogadores);
+    for (int i = 0; i < numJogadores; i++) {
+        memcpy(registros[i].nome, jogadores[i].nome, TAM_NOME);
+        memcpy(registros[i].cor, jogadores[i].cor, TAM_COR);
+        registros[i].idCor = jogadores[i].idCor;
+        registros[i].bot = (uint8_t) (jogadores[i].bot != 0);
+        registros[i].tipoMissao = (int32_t) jogadores[i].missao->tipo;
+        registros[i].parametro = jogadores[i].missao->parametro;
+        memcpy(registros[i].texto, jogadores[i].missao->texto, TAM_MISSAO);
+    }
+
+    memcpy(base + cab.deslocTropas, mapa->tropas, n * sizeof(int32_t));
+    memcpy(base + cab.deslocDonos, mapa->donos, n * sizeof(IdCor));
+    memcpy(base + cab.deslocNomes, mapa->nomes, n * TAM_NOME);
+    if (cab.temGrafo) {
+        memcpy(base + cab.deslocInicio, mapa->grafo->inicio, (n + 1) * sizeof(int32_t));
+        memcpy(base + cab.deslocVizinhos, mapa->grafo->vizinhos,
+               (size_t) cab.numVizinhos * sizeof(int32_t));
+    }
+    if (cab.numContinentes > 0) {
+        const Continentes* cont = mapa->continentes;
+        RegistroContinente* continentes = (RegistroContinente*) (base + cab.deslocContinentes);
+        for (uint32_t c = 0; c < cab.numContinentes; c++) {
+            memcpy(continentes[c].nome, cont->lista[c].nome, TAM_NOME);
+            continentes[c].bonus = cont->lista[c].bonus;
+        }
+        memcpy(base + cab.deslocContinenteDe, cont->continenteDe, n * sizeof(int32_t));
+    }
+
+    size_t inicioDados = sizeof(CabecalhoSnapshot);
+    cab.soma = somaVerificacao(base + inicioDados, cab.tamanho - inicioDados);
+    memcpy(base, &cab, sizeof(CabecalhoSnapshot));
+
+    int ok = msync(base, cab.tamanho, MS_SYNC) == 0;
+    munmap(base, cab.tamanho);
+    ok = (close(fd) == 0) && ok && rename(temporario, caminho) == 0;
+    if (!ok) {
+        unlink(temporario);
+    }
+    free(temporario);
+    return ok ? SNAPSHOT_OK : SNAPSHOT_ERRO_ARQUIVO;
+}
+
+/*
+ * Função: cabecalhoCoerente
+ * 
+ * Confere se os deslocamentos do cabeçalho batem com os contadores e com
+ * o tamanho real do arquivo, para que nenhuma seção aponte para fora dele.
+ */
+static int cabecalhoCoerente(const CabecalhoSnapshot* cab, uint64_t tamanhoArquivo) {
+    if (cab->numCores > MAX_CORES || cab->numTerritorios > INT32_MAX ||
+        cab->numVizinhos > INT32_MAX || cab->numContinentes > INT32_MAX ||
+        cab->tamanho != tamanhoArquivo) {
+        return 0;
+    }
+    Mapa modelo;
+    memset(&modelo, 0, sizeof(Mapa));
+    modelo.quantidade = (int) cab->numTerritorios;
+    modelo.numCores = (int) cab->numCores;
+
+    CabecalhoSnapshot esperado;
+    Grafo grafo = {0};
+    if (cab->temGrafo) {
+        grafo.numEntradas = (int) cab->numVizinhos;
+        grafo.linear = (int) cab->grafoLinear;
+        modelo.grafo = &grafo;
+    }
+    Continentes continentes;
+    memset(&continentes, 0, sizeof(Continentes));
+    if (cab->numContinentes > 0) {
+        continentes.numContinentes = (int) cab->numContinentes;
+        modelo.continentes = &continentes;
+    }
+    montarCabecalho(&esperado, &modelo, (int) cab->numJogadores);
+    return esperado.deslocCores == cab->deslocCores &&
+           esperado.deslocJogadores == cab->deslocJogadores &&
+           esperado.deslocTropas == cab->deslocTropas &&
+           esperado.deslocDonos == cab->deslocDonos &&
+           esperado.deslocNomes == cab->deslocNomes &&
+           esperado.deslocInicio == cab->deslocInicio &&
+           esperado.deslocVizinhos == cab->deslocVizinhos &&
+           esperado.deslocContinentes == cab->deslocContinentes &&
+           esperado.deslocContinenteDe == cab->deslocContinenteDe &&
+           esperado.tamanho == cab->tamanho;
+}
+
+/*
+ * Função: secoesCoerentes
+ * 
+ * Confere os valores das seções que o mapa usa diretamente, em uma
+ * passada: donos abaixo de numCores, tropas não negativas e, com grafo,
+ * o CSR bem formado (inicio começando em 0, não decrescente e terminando
+ * em numVizinhos; cada lista de vizinhos dentro do mapa, em ordem
+ * estritamente crescente e sem o próprio território). A soma de
+ * verificação só pega danos acidentais, não um arquivo gravado com
+ * valores inválidos.
+ */
+static int secoesCoerentes(const CabecalhoSnapshot* cab, const unsigned char* base) {
+    const IdCor* donos = (const IdCor*) (base + cab->deslocDonos);
+    const int32_t* tropas = (const int32_t*) (base + cab->deslocTropas);
+    for (uint64_t i = 0; i < cab->numTerritorios; i++) {
+        if (donos[i] >= cab->numCores || tropas[i] < 0) {
+            return 0;
+        }
+    }
+    if (!cab->temGrafo) {
+        return 1;
+    }
+    const int32_t* inicio = (const int32_t*) (base + cab->deslocInicio);
+    const int32_t* vizinhos = (const int32_t*) (base + cab->deslocVizinhos);
+    if (inicio[0] != 0 || (uint64_t) inicio[cab->numTerritorios] != cab->numVizinhos) {
+        return 0;
+    }
+    for (uint64_t i = 0; i < cab->numTerritorios; i++) {
+        if (inicio[i + 1] < inicio[i]) {
+            return 0;
+        }
+    }
+    // Cada lista em ordem estritamente crescente (grafoAdjacentes faz busca binária), sem laços
+    for (uint64_t i = 0; i < cab->numTerritorios; i++) {
+        for (int32_t k = inicio[i]; k < inicio[i + 1]; k++) {
+            if (vizinhos[k] < 0 || (uint64_t) vizinhos[k] >= cab->numTerritorios ||
+                (uint64_t) vizinhos[k] == i || (k > inicio[i] && vizinhos[k] <= vizinhos[k - 1])) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/*
+ * Função: lerContinentes
+ * 
+ * Monta os continentes (no heap, pois a posse muda durante a partida) a
+ * partir das seções do arquivo.
+ * 
+ * Retorno: SNAPSHOT_OK, ou o código do erro (nada fica alocado)
+ */
+static CodigoSnapshot lerContinentes(const CabecalhoSnapshot* cab, const unsigned char* base,
+                                     Continentes** destino) {
+    Continentes* cont = (Continentes*) malloc(sizeof(Continentes));
+    if (cont == NULL || !continentesIniciar(cont, (int) cab->numTerritorios)) {
+        free(cont);
+        return SNAPSHOT_ERRO_MEMORIA;
+    }
+    CodigoSnapshot codigo = SNAPSHOT_OK;
+    const RegistroContinente* registros = (const RegistroContinente*) (base + cab->deslocContinentes);
+    for (uint32_t c = 0; codigo == SNAPSHOT_OK && c < cab->numContinentes; c++) {
+        char nome[TAM_NOME];
+        memcpy(nome, registros[c].nome, TAM_NOME);
+        nome[TAM_NOME - 1] = '\0';
+        if (continentesAdicionar(cont, nome, registros[c].bonus) < 0) {
+            codigo = (registros[c].bonus < 0) ? SNAPSHOT_ERRO_FORMATO : SNAPSHOT_ERRO_MEMORIA;
+        }
+    }
+    const int32_t* continenteDe = (const int32_t*) (base + cab->deslocContinenteDe);
+    for (uint32_t i = 0; codigo == SNAPSHOT_OK && i < cab->numTerritorios; i++) {
+        if (continenteDe[i] != SEM_CONTINENTE &&
+            !continentesIncluir(cont, continenteDe[i], (int) i)) {
+            codigo = SNAPSHOT_ERRO_FORMATO;
+        }
+    }
+    if (codigo != SNAPSHOT_OK) {
+        continentesLiberar(cont);
+        free(cont);
+        return codigo;
+    }
+    *destino = cont;
+    return SNAPSHOT_OK;
+}
+
+/*
+ * Função: snapshotCarregar
+ * 
+ * Mapeia um snapshot e monta o mapa sobre as páginas do arquivo. Os
+ * jogadores (poucos) e suas missões são copiados para a arena da
+ * partida, em um único pedido. O mapa resultante deve ser liberado com
+ * mapaLiberar, que desfaz o mapeamento.
+ * 
+ * Parâmetros:
+ *   caminho - arquivo gravado por snapshotSalvar
+ *   mapa - mapa a preencher (não iniciado ou já liberado)
+ *   arena - arena da partida, de onde saem os jogadores e as missões
+ *   jogadores - recebe o vetor de jogadores (na arena)
+ *   numJogadores - recebe a quantidade de jogadores
+ * 
+ * Retorno: SNAPSHOT_OK ou o código do erro (nesse caso nada fica alocado
+ *          fora da arena)
+ */
+CodigoSnapshot snapshotCarregar(const char* caminho, Mapa* mapa, Arena* arena,
+                                Jogador** jogadores, int* numJogadores) {
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) {
+        return SNAPSHOT_ERRO_ARQUIVO;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return SNAPSHOT_ERRO_ARQUIVO;
+    }
+    if ((uint64_t) info.st_size < sizeof(CabecalhoSnapshot)) {
+        close(fd);
+        return SNAPSHOT_ERRO_FORMATO;
+    }
+
+    size_t tamanho = (size_t) info.st_size;
+    unsigned char* base = mmap(NULL, tamanho, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return SNAPSHOT_ERRO_ARQUIVO;
+    }
+
+    CodigoSnapshot codigo = SNAPSHOT_OK;
+    const CabecalhoSnapshot* cab = (const CabecalhoSnapshot*) base;
+    if (memcmp(cab->assinatura, ASSINATURA_SNAPSHOT, sizeof(cab->assinatura)) != 0 ||
+        cab->ordemBytes != MARCA_ORDEM_BYTES) {
+        codigo = SNAPSHOT_ERRO_FORMATO;
+    } else if (cab->versao != VERSAO_SNAPSHOT) {
+        codigo = SNAPSHOT_ERRO_VERSAO;
+    } else if (!cabecalhoCoerente(cab, tamanho)) {
+        codigo = SNAPSHOT_ERRO_FORMATO;
+    } else if (somaVerificacao(base + sizeof(CabecalhoSnapshot),
+                               tamanho - sizeof(CabecalhoSnapshot)) != cab->soma) {
+        codigo = SNAPSHOT_ERRO_SOMA;
+    } else if (!secoesCoerentes(cab, base)) {
+        codigo = SNAPSHOT_ERRO_FORMATO;
+    }
+
+    // Jogadores e missões copiados para a arena (missões logo depois dos jogadores)
+    int totalJogadores = (codigo == SNAPSHOT_OK) ? (int) cab->numJogadores : 0;
+    Jogador* lidos = NULL;
+    Missao* missoes = NULL;
+    if (codigo == SNAPSHOT_OK && totalJogadores > 0) {
+        lidos = (Jogador*) arenaAlocar(arena, totalJogadores * (sizeof(Jogador) + sizeof(Missao)));
+        missoes = (Missao*) (lidos + totalJogadores);
+        codigo = (lidos != NULL) ? SNAPSHOT_OK : SNAPSHOT_ERRO_MEMORIA;
+    }
+    const RegistroJogador* registros = (const RegistroJogador*) (base + cab->deslocJogadores);
+    for (int i = 0; codigo == SNAPSHOT_OK && i < totalJogadores; i++) {
+        memcpy(lidos[i].nome, registros[i].nome, TAM_NOME);
+        memcpy(lidos[i].cor, registros[i].cor, TAM_COR);
+        lidos[i].nome[TAM_NOME - 1] = '\0';
+        lidos[i].cor[TAM_COR - 1] = '\0';
+        lidos[i].idCor = registros[i].idCor;
+        lidos[i].bot = registros[i].bot;
+        missoes[i].tipo = (TipoMissao) registros[i].tipoMissao;
+        missoes[i].parametro = registros[i].parametro;
+        memcpy(missoes[i].texto, registros[i].texto, TAM_MISSAO);
+        missoes[i].texto[TAM_MISSAO - 1] = '\0';
+        lidos[i].missao = &missoes[i];
+        if (registros[i].idCor >= cab->numCores ||
+            (unsigned) registros[i].tipoMissao >= NUM_TIPOS_MISSAO) {
+            codigo = SNAPSHOT_ERRO_FORMATO;
+        }
+    }
+
+    Grafo* grafo = NULL;
+    if (codigo == SNAPSHOT_OK && cab->temGrafo) {
+        grafo = (Grafo*) calloc(1, sizeof(Grafo));
+        if (grafo == NULL) {
+            codigo = SNAPSHOT_ERRO_MEMORIA;
+        }
+    }
+    Continentes* continentes = NULL;
+    if (codigo == SNAPSHOT_OK && cab->numContinentes > 0) {
+        codigo = lerContinentes(cab, base, &continentes);
+    }
+
+    if (codigo != SNAPSHOT_OK) {
+        free(grafo);
+        munmap(base, tamanho);
+        return codigo;
+    }
+
+    // O mapa usa as seções do arquivo diretamente
+    memset(mapa, 0, sizeof(Mapa));
+    mapa->quantidade = (int) cab->numTerritorios;
+    mapa->capacidade = mapa->quantidade;
+    mapa->numCores = (int) cab->numCores;
+    memcpy(mapa->cores, base + cab->deslocCores, (size_t) cab->numCores * TAM_COR);
+    mapa->tropas = (int32_t*) (base + cab->deslocTropas);
+    mapa->donos = (IdCor*) (base + cab->deslocDonos);
+    mapa->nomes = (char (*)[TAM_NOME]) (base + cab->deslocNomes);
+    mapa->regiao = base;
+    mapa->tamanhoRegiao = tamanho;
+    mapa->vetoresExternos = 1;
+    if (grafo != NULL) {
+        grafo->numVertices = mapa->quantidade;
+        grafo->numEntradas = (int) cab->numVizinhos;
+        grafo->inicio = (int32_t*) (base + cab->deslocInicio);
+        grafo->vizinhos = (int32_t*) (base + cab->deslocVizinhos);
+        grafo->linear = (int) cab->grafoLinear;
+        grafo->externo = 1;
+        mapa->grafo = grafo;
+    }
+    if (continentes != NULL) {
+        mapaDefinirContinentes(mapa, continentes);
+    }
+
+    *jogadores = lidos;
+    *numJogadores = totalJogadores;
+    return SNAPSHOT_OK;
+}
+
+/*
+ * Função: snapshotExportarTexto
+ * 
+ * Escreve o estado da partida no formato de cenário (cenario.h), que
+ * cenarioCarregar lê de volta. Fronteiras completas não são listadas
+ * (são o padrão quando o cenário não traz linhas A). Cada continente vira
+ * uma linha C com a lista dos seus territórios.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 se a escrita falhar ou faltar memória
+ */
+int snapshotExportarTexto(FILE* saida, const Mapa* mapa,
+                          const Jogador* jogadores, int numJogadores) {
+    fprintf(saida, "# Partida de War: %d jogadores, %d territorios\n",
+            numJogadores, mapa->quantidade);
+    for (int i = 0; i < numJogadores; i++) {
+        const Missao* missao = jogadores[i].missao;
+        fprintf(saida, "%c %s %s %s %d %s\n", jogadores[i].bot ? 'B' : 'J',
+                jogadores[i].nome, jogadores[i].cor,
+                nomeTipoMissao(missao->tipo), missao->parametro, missao->texto);
+    }
+    for (int i = 0; i < mapa->quantidade; i++) {
+        fprintf(saida, "T %s %s %d\n", mapa->nomes[i],
+                mapaNomeCor(mapa, mapa->donos[i]), mapa->tropas[i]);
+    }
+    const Grafo* grafo = mapa->grafo;
+    if (grafo != NULL && !grafo->completo) {
+        for (int v = 0; v < grafo->numVertices; v++) {
+            for (int32_t k = grafo->inicio[v]; k < grafo->inicio[v + 1]; k++) {
+                if (grafo->vizinhos[k] > v) {
+                    fprintf(saida, "A %d %d\n", v + 1, grafo->vizinhos[k] + 1);
+                }
+            }
+        }
+    }
+    const Continentes* cont = mapa->continentes;
+    if (cont != NULL && cont->numContinentes > 0) {
+        // Territórios agrupados por continente em uma passada (sem varrer o mapa por continente)
+        int32_t* inicio = (int32_t*) calloc((size_t) cont->numContinentes + 1, sizeof(int32_t));
+        int32_t* membros = (int32_t*) malloc(((size_t) cont->numTerritorios + 1) * sizeof(int32_t));
+        if (inicio == NULL || membros == NULL) {
+            free(inicio);
+            free(membros);
+            return 0;
+        }
+        for (int i = 0; i < cont->numTerritorios; i++) {
+            if (cont->continenteDe[i] != SEM_CONTINENTE) {
+                inicio[cont->continenteDe[i] + 1]++;
+            }
+        }
+        for (int c = 0; c < cont->numContinentes; c++) {
+            inicio[c + 1] += inicio[c];
+        }
+        for (int i = 0; i < cont->numTerritorios; i++) {
+            if (cont->continenteDe[i] != SEM_CONTINENTE) {
+                membros[inicio[cont->continenteDe[i]]++] = i;
+            }
+        }
+        // Cada início avançou até o fim do seu grupo, que é o começo do próximo
+        for (int c = 0, primeiro = 0; c < cont->numContinentes; c++) {
+            fprintf(saida, "C %s %d", cont->lista[c].nome, cont->lista[c].bonus);
+            for (int k = primeiro; k < inicio[c]; k++) {
+                fprintf(saida, " %d", membros[k] + 1);
+            }
+            fprintf(saida, "\n");
+            primeiro = inicio[c];
+        }
+        free(inicio);
+        free(membros);
+    }
+    return !ferror(saida);
+}
@@ -0,0 +1,118 @@
+/*
+ * Snapshot binário da partida
+ * 
+ * Grava mapa, jogadores, missões e fronteiras em um arquivo de layout
+ * fixo, que é mapeado em memória (mmap) na carga e usado diretamente:
+ * os vetores de donos, tropas, nomes e o grafo do Mapa apontam para as
+ * páginas do arquivo, sem nenhuma etapa de leitura campo a campo. As
+ * páginas são privadas, então a partida pode alterá-las sem mexer no
+ * arquivo. Uma soma de verificação cobre tudo após o cabeçalho.
+ * 
+ * Layout (inteiros little-endian, seções alinhadas em 8 bytes):
+ *   CabecalhoSnapshot
+ *   cores       numCores x char[TAM_COR]
+ *   jogadores   numJogadores x RegistroJogador
+ *   tropas      numTerritorios x int32
+ *   donos       numTerritorios x uint8
+ *   nomes       numTerritorios x char[TAM_NOME]
+ *   inicio      numTerritorios + 1 x int32   (só com grafo)
+ *   vizinhos    numVizinhos x int32          (só com grafo)
+ *   continentes numContinentes x RegistroContinente
+ *   continenteDe numTerritorios x int32       (só com continentes)
+ * 
+ * A forma textual equivalente é o formato de cenário (cenario.h).
+ */
+
+#ifndef WAR_SNAPSHOT_H
+#define WAR_SNAPSHOT_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "mapa.h"
+
+#define ASSINATURA_SNAPSHOT "WARSNP01"
+#define VERSAO_SNAPSHOT 2
+
+/*
+ * Struct CabecalhoSnapshot
+ * 
+ * Primeiros bytes do arquivo. Os deslocamentos são contados a partir do
+ * início do arquivo.
+ */
+typedef struct {
+    char assinatura[8];      // ASSINATURA_SNAPSHOT
+    uint32_t versao;         // VERSAO_SNAPSHOT
+    uint32_t ordemBytes;     // 0x01020304 gravado na ordem da máquina
+    uint32_t numTerritorios;
+    uint32_t numCores;
+    uint32_t numJogadores;
+    uint32_t numVizinhos;    // Entradas do CSR (0 sem grafo)
+    uint32_t temGrafo;
+    uint32_t grafoLinear;
+    uint32_t numContinentes; // 0 se o mapa não tiver continentes
+    uint32_t reservado;
+    uint64_t tamanho;        // Tamanho total do arquivo
+    uint64_t soma;           // Soma de verificação dos bytes após o cabeçalho
+    uint64_t deslocCores;
+    uint64_t deslocJogadores;
+    uint64_t deslocTropas;
+    uint64_t deslocDonos;
+    uint64_t deslocNomes;
+    uint64_t deslocInicio;
+    uint64_t deslocVizinhos;
+    uint64_t deslocContinentes;
+    uint64_t deslocContinenteDe;
+} CabecalhoSnapshot;
+
+/*
+ * Struct RegistroJogador
+ * 
+ * Jogador com a missão embutida (no jogo ela é alocada à parte).
+ */
+typedef struct {
+    char nome[TAM_NOME];
+    char cor[TAM_COR];
+    uint8_t idCor;
+    uint8_t bot;             // 1 se controlado pelo computador
+    uint8_t reservado[2];
+    int32_t tipoMissao;
+    int32_t parametro;
+    char texto[TAM_MISSAO];
+    char reservado2[2];
+} RegistroJogador;
+
+/*
+ * Struct RegistroContinente
+ * 
+ * Definição de um continente; a posse é recalculada na carga.
+ */
+typedef struct {
+    char nome[TAM_NOME];
+    char reservado[2];
+    int32_t bonus;
+} RegistroContinente;
+
+/*
+ * Enum CodigoSnapshot
+ * 
+ * Resultado da gravação ou da carga de um snapshot.
+ */
+typedef enum {
+    SNAPSHOT_OK = 0,
+    SNAPSHOT_ERRO_ARQUIVO,   // Não foi possível abrir, gravar ou mapear
+    SNAPSHOT_ERRO_FORMATO,   // Assinatura, ordem de bytes ou tamanhos incoerentes
+    SNAPSHOT_ERRO_VERSAO,    // Versão do formato desconhecida
+    SNAPSHOT_ERRO_SOMA,      // Soma de verificação não confere
+    SNAPSHOT_ERRO_MEMORIA
+} CodigoSnapshot;
+
+const char* snapshotMensagem(CodigoSnapshot codigo);
+CodigoSnapshot snapshotSalvar(const char* caminho, const Mapa* mapa,
+                              const Jogador* jogadores, int numJogadores);
+CodigoSnapshot snapshotCarregar(const char* caminho, Mapa* mapa, Arena* arena,
+                                Jogador** jogadores, int* numJogadores);
+
+int snapshotExportarTexto(FILE* saida, const Mapa* mapa,
+                          const Jogador* jogadores, int numJogadores);
+
+#endif
@@ -0,0 +1,236 @@
+/*
+ * Tabela exata de resultados de batalha
+ * 
+ * As transições de cada estado são obtidas enumerando todas as rolagens
+ * possíveis através de aplicarRegraAtaque (ou, na regra clássica, de
+ * aplicarRegraClassica, uma vez por combinação de quantidades de dados),
+ * então a tabela segue exatamente as mesmas regras do jogo. Toda rolagem
+ * reduz as tropas de algum lado ou termina a batalha, logo cada estado
+ * depende apenas de estados já calculados na ordem de linha.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "batalha.h"
+#include "tabela.h"
+
+// Identificação do arquivo binário da tabela
+static const char ASSINATURA_TABELA[8] = {'W', 'A', 'R', 'T', 'A', 'B', '0', '2'};
+
+/*
+ * Função: tabelaDistribuicaoPerdas
+ * 
+ * Distribuição das perdas do defensor em uma única rolagem da regra
+ * clássica, enumerando as 6^(nA+nD) rolagens de cada combinação de
+ * quantidades de dados.
+ */
+void tabelaDistribuicaoPerdas(DistribuicaoPerdas distribuicao) {
+    memset(distribuicao, 0, sizeof(DistribuicaoPerdas));
+    ResultadoAtaque resultado;
+    for (int nA = 1; nA <= MAX_DADOS; nA++) {
+        // Defensor vazio não rola: é conquistado sem perdas
+        distribuicao[nA][0][0] = 1.0;
+        for (int nD = 1; nD <= MAX_DADOS; nD++) {
+            int dados = nA + nD, rolagens = 1;
+            for (int k = 0; k < dados; k++) {
+                rolagens *= 6;
+            }
+            for (int r = 0; r < rolagens; r++) {
+                uint8_t valores[2 * MAX_DADOS];
+                for (int k = 0, resto = r; k < dados; k++, resto /= 6) {
+                    valores[k] = (uint8_t) (resto % 6 + 1);
+                }
+                // Tropas de sobra dos dois lados: só as perdas interessam
+                aplicarRegraClassica(MAX_DADOS + 2, MAX_DADOS + 2, valores, nA,
+                                     valores + nA, nD, &resultado);
+                distribuicao[nA][nD][resultado.perdasDefensor] += 1.0 / rolagens;
+            }
+        }
+    }
+}
+
+// Estado (a, d) na regra simples: média sobre as 36 rolagens equiprováveis
+static void calcularSimples(ResultadoExato* entradas, int lado, int a, int d) {
+    ResultadoAtaque resultado;
+    double prob = 0.0, tropasA = 0.0, tropasD = 0.0;
+    for (int dadoA = 1; dadoA <= 6; dadoA++) {
+        for (int dadoD = 1; dadoD <= 6; dadoD++) {
+            aplicarRegraAtaque(a, d, dadoA, dadoD, &resultado);
+
+            if (resultado.conquista) {
+                prob += 1.0;
+                tropasA += resultado.tropasAtacante + resultado.tropasDefensor;
+            } else {
+                const ResultadoExato* seguinte =
+                    &entradas[resultado.tropasAtacante * lado + resultado.tropasDefensor];
+                prob += seguinte->probConquista;
+                tropasA += seguinte->tropasAtacante;
+                tropasD += seguinte->tropasDefensor;
+            }
+        }
+    }
+    ResultadoExato* atual = &entradas[a * lado + d];
+    atual->probConquista = (float) (prob / 36.0);
+    atual->tropasAtacante = (float) (tropasA / 36.0);
+    atual->tropasDefensor = (float) (tropasD / 36.0);
+}
+
+// Estado (a, d) na regra clássica: média sobre as perdas possíveis do defensor
+static void calcularClassica(ResultadoExato* entradas, int lado, int a, int d,
+                             const DistribuicaoPerdas distribuicao) {
+    int nA = dadosDoAtacante(REGRA_CLASSICA, a);
+    int nD = dadosDoDefensor(REGRA_CLASSICA, d);
+    int pares = (nA < nD) ? nA : nD;
+    double prob = 0.0, tropasA = 0.0, tropasD = 0.0;
+    for (int perdasD = 0; perdasD <= pares; perdasD++) {
+        double p = distribuicao[nA][nD][perdasD];
+        int restantes = a - (pares - perdasD);
+        if (d - perdasD <= 0) {
+            // Conquista: as tropas do atacante ficam divididas entre origem e destino
+            prob += p;
+            tropasA += p * restantes;
+        } else {
+            const ResultadoExato* seguinte = &entradas[restantes * lado + d - perdasD];
+            prob += p * seguinte->probConquista;
+            tropasA += p * seguinte->tropasAtacante;
+            tropasD += p * seguinte->tropasDefensor;
+        }
+    }
+    ResultadoExato* atual = &entradas[a * lado + d];
+    atual->probConquista = (float) prob;
+    atual->tropasAtacante = (float) tropasA;
+    atual->tropasDefensor = (float) tropasD;
+}
+
+/*
+ * Função: tabelaCalcular
+ * 
+ * Preenche a tabela para todos os pares com até `limite` tropas de cada lado.
+ * 
+ * Parâmetros:
+ *   tabela - tabela a ser preenchida (a memória anterior é liberada)
+ *   limite - maior quantidade de tropas considerada
+ *   regra - regra de batalha
+ * 
+ * Retorno: 1 em caso de sucesso, 0 em caso de falha de alocação
+ */
+int tabelaCalcular(TabelaBatalha* tabela, int limite, RegraBatalha regra) {
+    int lado = limite + 1;
+    ResultadoExato* entradas = (ResultadoExato*) malloc((size_t) lado * lado * sizeof(ResultadoExato));
+    if (limite < 0 || entradas == NULL) {
+        free(entradas);
+        return 0;
+    }
+
+    DistribuicaoPerdas distribuicao;
+    if (regra == REGRA_CLASSICA) {
+        tabelaDistribuicaoPerdas(distribuicao);
+    }
+
+    for (int a = 0; a < lado; a++) {
+        for (int d = 0; d < lado; d++) {
+            ResultadoExato* atual = &entradas[a * lado + d];
+
+            // Atacante sem tropas para atacar: a batalha termina aqui
+            if (a < 2) {
+                atual->probConquista = 0.0f;
+                atual->tropasAtacante = (float) a;
+                atual->tropasDefensor = (float) d;
+            } else if (regra == REGRA_CLASSICA) {
+                calcularClassica(entradas, lado, a, d, distribuicao);
+            } else {
+                calcularSimples(entradas, lado, a, d);
+            }
+        }
+    }
+
+    tabelaLiberar(tabela);
+    tabela->limite = limite;
+    tabela->regra = regra;
+    tabela->entradas = entradas;
+    return 1;
+}
+
+/*
+ * Função: tabelaSalvar
+ * 
+ * Grava a tabela em formato binário (assinatura, limite, regra e entradas).
+ * 
+ * Retorno: 1 em caso de sucesso, 0 caso contrário
+ */
+int tabelaSalvar(const TabelaBatalha* tabela, const char* caminho) {
+    FILE* arquivo = fopen(caminho, "wb");
+    if (arquivo == NULL) {
+        return 0;
+    }
+
+    size_t total = (size_t) (tabela->limite + 1) * (tabela->limite + 1);
+    int32_t limite = tabela->limite;
+    int32_t regra = tabela->regra;
+    int ok = fwrite(ASSINATURA_TABELA, sizeof(ASSINATURA_TABELA), 1, arquivo) == 1 &&
+             fwrite(&limite, sizeof(limite), 1, arquivo) == 1 &&
+             fwrite(&regra, sizeof(regra), 1, arquivo) == 1 &&
+             fwrite(tabela->entradas, sizeof(ResultadoExato), total, arquivo) == total;
+
+    if (fclose(arquivo) != 0) {
+        ok = 0;
+    }
+    return ok;
+}
+
+/*
+ * Função: tabelaCarregar
+ * 
+ * Lê uma tabela gravada por tabelaSalvar.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 se o arquivo não existir ou for inválido
+ */
+int tabelaCarregar(TabelaBatalha* tabela, const char* caminho) {
+    FILE* arquivo = fopen(caminho, "rb");
+    if (arquivo == NULL) {
+        return 0;
+    }
+
+    char assinatura[sizeof(ASSINATURA_TABELA)];
+    int32_t limite, regra;
+    ResultadoExato* entradas = NULL;
+    int ok = fread(assinatura, sizeof(assinatura), 1, arquivo) == 1 &&
+             memcmp(assinatura, ASSINATURA_TABELA, sizeof(assinatura)) == 0 &&
+             fread(&limite, sizeof(limite), 1, arquivo) == 1 &&
+             limite >= 0 && limite <= 100000 &&
+             fread(&regra, sizeof(regra), 1, arquivo) == 1 &&
+             regra >= 0 && regra < NUM_REGRAS;
+
+    if (ok) {
+        size_t total = (size_t) (limite + 1) * (limite + 1);
+        entradas = (ResultadoExato*) malloc(total * sizeof(ResultadoExato));
+        ok = entradas != NULL &&
+             fread(entradas, sizeof(ResultadoExato), total, arquivo) == total &&
+             fgetc(arquivo) == EOF;
+    }
+    fclose(arquivo);
+
+    if (!ok) {
+        free(entradas);
+        return 0;
+    }
+
+    tabelaLiberar(tabela);
+    tabela->limite = limite;
+    tabela->regra = (RegraBatalha) regra;
+    tabela->entradas = entradas;
+    return 1;
+}
+
+/*
+ * Função: tabelaLiberar
+ * 
+ * Libera a memória da tabela e a deixa vazia.
+ */
+void tabelaLiberar(TabelaBatalha* tabela) {
+    free(tabela->entradas);
+    tabela->entradas = NULL;
+    tabela->limite = -1;
+}
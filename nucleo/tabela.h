@@ -0,0 +1,63 @@
+/*
+ * Tabela exata de resultados de batalha
+ * 
+ * Calcula por programação dinâmica, para cada par (tropas do atacante,
+ * tropas do defensor) até um limite, a distribuição do resultado de uma
+ * batalha completa (ataques repetidos até a conquista ou até o atacante
+ * ficar com menos de 2 tropas), na regra de batalha escolhida. Depois de
+ * calculada, ou carregada do disco, cada consulta custa O(1).
+ */
+
+#ifndef WAR_TABELA_H
+#define WAR_TABELA_H
+
+#include "batalha.h"
+
+/*
+ * Struct ResultadoExato
+ * 
+ * Valores exatos (não estimados) de uma batalha completa.
+ */
+typedef struct {
+    float probConquista;   // Probabilidade de o defensor ser conquistado
+    float tropasAtacante;  // Tropas esperadas do atacante ao final (origem + ocupação)
+    float tropasDefensor;  // Tropas esperadas do defensor ao final
+} ResultadoExato;
+
+/*
+ * Struct TabelaBatalha
+ * 
+ * Matriz (limite+1) x (limite+1) em ordem de linha: a entrada de
+ * (atacante, defensor) fica em atacante * (limite + 1) + defensor.
+ */
+typedef struct {
+    int limite;
+    RegraBatalha regra;      // Regra com que a tabela foi calculada
+    ResultadoExato* entradas;
+} TabelaBatalha;
+
+// Probabilidade de o defensor perder k tropas em um ataque com nA x nD dados: [nA][nD][k]
+typedef double DistribuicaoPerdas[MAX_DADOS + 1][MAX_DADOS + 1][MAX_DADOS + 1];
+
+void tabelaDistribuicaoPerdas(DistribuicaoPerdas distribuicao);
+int tabelaCalcular(TabelaBatalha* tabela, int limite, RegraBatalha regra);
+int tabelaSalvar(const TabelaBatalha* tabela, const char* caminho);
+int tabelaCarregar(TabelaBatalha* tabela, const char* caminho);
+void tabelaLiberar(TabelaBatalha* tabela);
+
+/*
+ * Função: tabelaConsultar
+ * 
+ * Retorno: resultado exato para o par, ou NULL se estiver fora do limite
+ */
+static inline const ResultadoExato* tabelaConsultar(const TabelaBatalha* tabela,
+                                                    int tropasAtacante, int tropasDefensor) {
+    if (tabela->entradas == NULL ||
+        tropasAtacante < 0 || tropasAtacante > tabela->limite ||
+        tropasDefensor < 0 || tropasDefensor > tabela->limite) {
+        return NULL;
+    }
+    return &tabela->entradas[tropasAtacante * (tabela->limite + 1) + tropasDefensor];
+}
+
+#endif
@@ -0,0 +1,88 @@
+/*
+ * Operações sobre vetores de Territorio
+ * 
+ * Varreduras de posse no layout original, com um strcmp por território.
+ */
+
+#include <string.h>
+#include "perfil.h"
+#include "territorio.h"
+
+/*
+ * Função: contarTerritoriosPorCor
+ * 
+ * Conta quantos territórios pertencem a uma determinada cor.
+ * 
+ * Parâmetros:
+ *   mapa - ponteiro para o vetor de territórios
+ *   tamanho - quantidade de territórios
+ *   cor - cor a ser contada
+ * 
+ * Retorno: número de territórios da cor especificada
+ */
+int contarTerritoriosPorCor(const Territorio* mapa, int tamanho, const char* cor) {
+    PERFIL_CONTAR(PERFIL_VARREDURAS);
+    PERFIL_SOMAR(PERFIL_COMPARACOES_COR, tamanho);
+    int contador = 0;
+    for (int i = 0; i < tamanho; i++) {
+        if (strcmp((mapa + i)->cor, cor) == 0) {
+            contador++;
+        }
+    }
+    return contador;
+}
+
+/*
+ * Função: somarTropasPorCor
+ * 
+ * Soma as tropas de todos os territórios de uma determinada cor.
+ * 
+ * Parâmetros:
+ *   mapa - ponteiro para o vetor de territórios
+ *   tamanho - quantidade de territórios
+ *   cor - cor a ser somada
+ * 
+ * Retorno: total de tropas da cor especificada
+ */
+long long somarTropasPorCor(const Territorio* mapa, int tamanho, const char* cor) {
+    PERFIL_CONTAR(PERFIL_VARREDURAS);
+    PERFIL_SOMAR(PERFIL_COMPARACOES_COR, tamanho);
+    long long totalTropas = 0;
+    for (int i = 0; i < tamanho; i++) {
+        if (strcmp((mapa + i)->cor, cor) == 0) {
+            totalTropas += (mapa + i)->tropas;
+        }
+    }
+    return totalTropas;
+}
+
+/*
+ * Função: verificarTerritoriosConsecutivos
+ * 
+ * Verifica se uma cor possui territórios cadastrados em sequência.
+ * (Simplificação: verifica se há N territórios da mesma cor em posições adjacentes)
+ * 
+ * Parâmetros:
+ *   mapa - ponteiro para o vetor de territórios
+ *   tamanho - quantidade de territórios
+ *   cor - cor a ser verificada
+ *   quantidade - quantidade mínima de territórios consecutivos
+ * 
+ * Retorno: 1 se encontrou a sequência, 0 caso contrário
+ */
+int verificarTerritoriosConsecutivos(const Territorio* mapa, int tamanho, const char* cor, int quantidade) {
+    PERFIL_CONTAR(PERFIL_VARREDURAS);
+    int consecutivos = 0, encontrou = 0, i = 0;
+    
+    for (; i < tamanho && !encontrou; i++) {
+        if (strcmp((mapa + i)->cor, cor) == 0) {
+            consecutivos++;
+            encontrou = (consecutivos >= quantidade);
+        } else {
+            consecutivos = 0;
+        }
+    }
+    // Comparações feitas até achar a sequência (ou o vetor inteiro)
+    PERFIL_SOMAR(PERFIL_COMPARACOES_COR, i);
+    return encontrou;
+}
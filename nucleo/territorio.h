@@ -0,0 +1,18 @@
+/*
+ * Operações sobre vetores de Territorio
+ * 
+ * Layout original do jogo (vetor de structs, cor comparada com strcmp).
+ * Mantido como referência para os benchmarks e para código que ainda
+ * trabalha com vetores de Territorio; o jogo usa o Mapa de mapa.h.
+ */
+
+#ifndef WAR_TERRITORIO_H
+#define WAR_TERRITORIO_H
+
+#include "tipos.h"
+
+int contarTerritoriosPorCor(const Territorio* mapa, int tamanho, const char* cor);
+long long somarTropasPorCor(const Territorio* mapa, int tamanho, const char* cor);
+int verificarTerritoriosConsecutivos(const Territorio* mapa, int tamanho, const char* cor, int quantidade);
+
+#endif
@@ -0,0 +1,84 @@
+/*
+ * Tipos compartilhados do Jogo War
+ * 
+ * Define as constantes e estruturas básicas (Territorio e Jogador) usadas
+ * pelo programa interativo, pelos módulos do núcleo e pelos benchmarks.
+ */
+
+#ifndef WAR_TIPOS_H
+#define WAR_TIPOS_H
+
+// Definições de constantes
+#define MAX_MISSOES 32
+#define TAM_MISSAO 150
+#define TAM_NOME 30
+#define TAM_COR 10
+
+#include <stdint.h>
+
+/*
+ * Tipo IdCor
+ * 
+ * Cor de exército internada como um inteiro pequeno (índice na tabela de
+ * cores do Mapa), para que as verificações de dono sejam comparações de
+ * inteiros em vez de strcmp.
+ */
+typedef uint8_t IdCor;
+
+/*
+ * Struct Territorio
+ * 
+ * Estrutura de dados que representa um território no jogo War.
+ * Contém as informações essenciais de cada território:
+ * - nome: identificação do território (até 29 caracteres + '\0')
+ * - cor: cor do exército que ocupa o território (até 9 caracteres + '\0')
+ * - tropas: quantidade de tropas posicionadas no território
+ */
+typedef struct {
+    char nome[TAM_NOME];   // Nome do território
+    char cor[TAM_COR];     // Cor do exército
+    int tropas;            // Quantidade de tropas
+} Territorio;
+
+/*
+ * Enum TipoMissao
+ * 
+ * Regra de vitória de uma missão. O significado de `parametro` em Missao
+ * depende do tipo.
+ */
+typedef enum {
+    MISSAO_CONSECUTIVOS = 0,  // Pelo menos `parametro` territórios consecutivos
+    MISSAO_TERRITORIOS,       // Pelo menos `parametro` territórios
+    MISSAO_PERCENTUAL,        // Pelo menos `parametro`% dos territórios do mapa
+    MISSAO_ELIMINAR,          // Todos os territórios do mapa (eliminar os inimigos)
+    MISSAO_TROPAS,            // Pelo menos `parametro` tropas somadas
+    NUM_TIPOS_MISSAO
+} TipoMissao;
+
+/*
+ * Struct Missao
+ * 
+ * Missão já compilada: o tipo decide a regra e o texto é só para exibição,
+ * então verificar a missão não envolve nenhuma busca em strings.
+ */
+typedef struct {
+    TipoMissao tipo;          // Regra de vitória
+    int parametro;            // Quantidade, percentual ou limite de tropas
+    char texto[TAM_MISSAO];   // Descrição exibida ao jogador
+} Missao;
+
+/*
+ * Struct Jogador
+ * 
+ * Estrutura que representa um jogador no jogo War.
+ * Contém informações sobre nome, cor e sua missão estratégica.
+ */
+typedef struct {
+    char nome[TAM_NOME];  // Nome do jogador
+    char cor[TAM_COR];    // Cor do exército do jogador
+    IdCor idCor;          // Cor internada na tabela de cores do mapa
+    const Missao* missao; // Missão na tabela compartilhada ou na arena da partida
+    int bot;              // 1 se as jogadas são escolhidas pelo computador (ver ia.h)
+} Jogador;
+
+#endif
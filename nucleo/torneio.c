@@ -0,0 +1,605 @@
+/*
+ * Torneio de partidas automáticas
+ * 
+ * Cada trabalhador do Pool tem uma Mesa: um mapa com posse e
+ * estatísticas anexadas, criado uma única vez e redistribuído a cada
+ * partida. As curvas de tropas são acumuladas por trabalhador e somadas
+ * só no final; os demais totais saem do vetor de resultados.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "aleatorio.h"
+#include "batalha.h"
+#include "continente.h"
+#include "estatisticas.h"
+#include "missao.h"
+#include "torneio.h"
+
+/*
+ * Struct Mesa
+ * 
+ * Estado reaproveitado entre as partidas de um trabalhador.
+ */
+typedef struct {
+    Mapa mapa;
+    Arena arena;                 // Vetores do mapa e os auxiliares abaixo, em um bloco só
+    int32_t* ordem;              // Permutação dos territórios na distribuição
+    long long* historico;        // Tropas por rodada e jogador da partida atual
+    long long* partidasNaRodada; // Acumuladores das curvas
+    double* tropasVencedor;
+    double* tropasOutros;
+    int grafoEmprestado;         // 1 se mapa.grafo pertence às regras
+    int pronta;
+} __attribute__((aligned(64))) Mesa;
+
+typedef struct {
+    const RegrasTorneio* regras;
+    ResultadoPartida* resultados;
+    Mesa* mesas;
+    int falhou;
+} ContextoTorneio;
+
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+ * Função: regrasPadrao
+ * 
+ * Preenche as regras com um mapa de 42 territórios, 4 jogadores e as
+ * missões padrão.
+ */
+void regrasPadrao(RegrasTorneio* regras) {
+    memset(regras, 0, sizeof(*regras));
+    regras->territorios = 42;
+    regras->jogadores = 4;
+    regras->maxRodadas = 500;
+    regras->ataquesPorVez = 64;
+    regras->reforco = 1;
+    regras->regra = REGRA_SIMPLES;
+    regras->semente = 2025;
+    regras->missoes = MISSOES_PADRAO;
+    regras->numMissoes = NUM_MISSOES_PADRAO;
+    regras->grafo = NULL;
+    regras->continentes = NULL;
+}
+
+static int regrasValidas(const RegrasTorneio* regras) {
+    return regras->jogadores >= 2 && regras->jogadores <= MAX_JOGADORES_TORNEIO &&
+           regras->territorios >= regras->jogadores && regras->maxRodadas >= 1 &&
+           regras->ataquesPorVez >= 1 && (unsigned) regras->regra < NUM_REGRAS &&
+           regras->missoes != NULL &&
+           regras->numMissoes >= 1 && regras->numMissoes <= MAX_MISSOES &&
+           (regras->grafo == NULL || regras->grafo->numVertices == regras->territorios) &&
+           (regras->continentes == NULL ||
+            regras->continentes->numTerritorios == regras->territorios);
+}
+
+static void liberarMesa(Mesa* mesa) {
+    if (!mesa->pronta) {
+        return;
+    }
+    // O grafo compartilhado das regras é só emprestado
+    if (mesa->grafoEmprestado) {
+        mesa->mapa.grafo = NULL;
+    }
+    mapaLiberar(&mesa->mapa);
+    arenaLiberar(&mesa->arena);
+    mesa->pronta = 0;
+}
+
+/*
+ * Função: prepararMesa
+ * 
+ * Cria o mapa de trabalho (territórios, cores dos jogadores, fronteiras,
+ * continentes, posse e estatísticas) e os vetores auxiliares. Territórios
+ * e vetores auxiliares saem de uma arena dimensionada para eles: um
+ * único malloc, e um único free em liberarMesa.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 em falha de memória
+ */
+static int prepararMesa(Mesa* mesa, const RegrasTorneio* regras) {
+    memset(mesa, 0, sizeof(*mesa));
+    size_t pontos = (size_t) regras->maxRodadas + 1;
+    size_t territorios = (size_t) regras->territorios;
+    size_t capacidade = territorios * (sizeof(IdCor) + 2 * sizeof(int32_t) + TAM_NOME) +
+                        pontos * (sizeof(long long) * (regras->jogadores + 1) + 2 * sizeof(double)) +
+                        8 * ALINHAMENTO_ARENA;
+    if (!arenaIniciar(&mesa->arena, capacidade)) {
+        return 0;
+    }
+    if (!mapaIniciar(&mesa->mapa, 0) ||
+        !mapaReservarEm(&mesa->mapa, &mesa->arena, regras->territorios)) {
+        mapaLiberar(&mesa->mapa);
+        arenaLiberar(&mesa->arena);
+        return 0;
+    }
+    mesa->pronta = 1;
+
+    char cor[3] = "j0";
+    for (int j = 0; j < regras->jogadores; j++) {
+        cor[1] = (char) ('0' + j);
+        mapaInternarCor(&mesa->mapa, cor);
+    }
+    for (int i = 0; i < regras->territorios; i++) {
+        mapaAdicionar(&mesa->mapa, "T", (IdCor) (i % regras->jogadores), 1);
+    }
+
+    if (regras->grafo != NULL) {
+        mesa->mapa.grafo = (Grafo*) regras->grafo;
+        mesa->grafoEmprestado = 1;
+    } else {
+        Grafo* grafo = (Grafo*) malloc(sizeof(Grafo));
+        if (grafo == NULL || !grafoCriarCompleto(grafo, regras->territorios)) {
+            free(grafo);
+            liberarMesa(mesa);
+            return 0;
+        }
+        if (!mapaDefinirGrafo(&mesa->mapa, grafo)) {
+            grafoLiberar(grafo);
+            free(grafo);
+            liberarMesa(mesa);
+            return 0;
+        }
+    }
+
+    // Cada mesa tem a própria cópia dos continentes, que acompanha a posse
+    if (regras->continentes != NULL) {
+        Continentes* continentes = (Continentes*) malloc(sizeof(Continentes));
+        if (continentes == NULL || !continentesCopiar(continentes, regras->continentes)) {
+            free(continentes);
+            liberarMesa(mesa);
+            return 0;
+        }
+        mapaDefinirContinentes(&mesa->mapa, continentes);
+    }
+
+    mesa->ordem = (int32_t*) arenaAlocar(&mesa->arena, sizeof(int32_t) * territorios);
+    mesa->historico = (long long*) arenaAlocar(&mesa->arena,
+                                               sizeof(long long) * pontos * regras->jogadores);
+    mesa->partidasNaRodada = (long long*) arenaAlocarZerado(&mesa->arena, pontos, sizeof(long long));
+    mesa->tropasVencedor = (double*) arenaAlocarZerado(&mesa->arena, pontos, sizeof(double));
+    mesa->tropasOutros = (double*) arenaAlocarZerado(&mesa->arena, pontos, sizeof(double));
+    if (!mapaAtivarPosse(&mesa->mapa) || mesa->ordem == NULL || mesa->historico == NULL ||
+        mesa->partidasNaRodada == NULL || mesa->tropasVencedor == NULL ||
+        mesa->tropasOutros == NULL) {
+        liberarMesa(mesa);
+        return 0;
+    }
+    mesa->mapa.estatisticas = estatisticasCriar(&mesa->mapa);
+    if (mesa->mapa.estatisticas == NULL) {
+        liberarMesa(mesa);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * Função: distribuir
+ * 
+ * Reparte os territórios igualmente entre os jogadores em ordem sorteada
+ * (Fisher-Yates), com 1 a 3 tropas cada. As estatísticas são desligadas
+ * durante a distribuição e recalculadas de uma vez no final.
+ */
+static void distribuir(Mesa* mesa, const RegrasTorneio* regras, Aleatorio* rng) {
+    Mapa* mapa = &mesa->mapa;
+    Estatisticas* est = mapa->estatisticas;
+    mapa->estatisticas = NULL;
+
+    int n = regras->territorios;
+    for (int i = 0; i < n; i++) {
+        mesa->ordem[i] = i;
+    }
+    for (int i = n - 1; i > 0; i--) {
+        int j = (int) aleatorioLimitado(rng, (uint32_t) (i + 1));
+        int32_t troca = mesa->ordem[i];
+        mesa->ordem[i] = mesa->ordem[j];
+        mesa->ordem[j] = troca;
+    }
+    for (int i = 0; i < n; i++) {
+        int territorio = mesa->ordem[i];
+        mapaDefinirDono(mapa, territorio, (IdCor) (i % regras->jogadores));
+        mapaDefinirTropas(mapa, territorio, 1 + (int) aleatorioLimitado(rng, 3));
+    }
+
+    mapa->estatisticas = est;
+    estatisticasRecalcular(est, mapa);
+}
+
+/*
+ * Função: escolherAtaque
+ * 
+ * Política gulosa: ataca a partir do território próprio com mais tropas
+ * que faz fronteira com um inimigo. Na regra simples a chance de
+ * conquista não depende do defensor, então o alvo é o vizinho inimigo
+ * com mais tropas, o que mais enfraquece os adversários; na clássica o
+ * defensor rola um dado por tropa (até 3), então o alvo é o vizinho
+ * inimigo com menos tropas, o mais fácil de conquistar.
+ * 
+ * Retorno: 1 se há ataque possível (preenche `atacante` e `defensor`)
+ */
+static int escolherAtaque(const Mapa* mapa, RegraBatalha regra, IdCor cor, int tropasMinimas,
+                          int* atacante, int* defensor) {
+    const Grafo* grafo = mapa->grafo;
+    const uint64_t* bits = mapa->posse[cor];
+    int palavras = (mapa->quantidade + 63) >> 6;
+    int melhorTropas = tropasMinimas - 1;
+    *atacante = -1;
+
+    if (grafo->completo) {
+        // Todos fazem fronteira: o alvo é o mesmo para qualquer atacante
+        int alvo = -1;
+        for (int v = 0; v < mapa->quantidade; v++) {
+            if (mapa->donos[v] != cor &&
+                (alvo < 0 || (regra == REGRA_CLASSICA ? mapa->tropas[v] < mapa->tropas[alvo]
+                                                      : mapa->tropas[v] > mapa->tropas[alvo]))) {
+                alvo = v;
+            }
+        }
+        if (alvo < 0) {
+            return 0;
+        }
+        *defensor = alvo;
+    }
+
+    for (int w = 0; w < palavras; w++) {
+        uint64_t restante = bits[w];
+        while (restante != 0) {
+            int i = (w << 6) + __builtin_ctzll(restante);
+            restante &= restante - 1;
+            if (mapa->tropas[i] <= melhorTropas) {
+                continue;
+            }
+            if (grafo->completo) {
+                melhorTropas = mapa->tropas[i];
+                *atacante = i;
+                continue;
+            }
+            int alvo = -1;
+            for (int32_t k = grafo->inicio[i]; k < grafo->inicio[i + 1]; k++) {
+                int v = grafo->vizinhos[k];
+                if (mapa->donos[v] == cor) {
+                    continue;
+                }
+                if (alvo < 0 || (regra == REGRA_CLASSICA ? mapa->tropas[v] < mapa->tropas[alvo]
+                                                         : mapa->tropas[v] > mapa->tropas[alvo])) {
+                    alvo = v;
+                }
+            }
+            if (alvo >= 0) {
+                melhorTropas = mapa->tropas[i];
+                *atacante = i;
+                *defensor = alvo;
+            }
+        }
+    }
+    return *atacante >= 0;
+}
+
+// Primeiro jogador (na ordem de jogada) com a missão cumprida, ou -1
+static int procurarVencedor(const Mapa* mapa, const RegrasTorneio* regras,
+                            const ResultadoPartida* resultado) {
+    for (int j = 0; j < regras->jogadores; j++) {
+        if (verificarMissao(&regras->missoes[resultado->missoes[j]], mapa, (IdCor) j)) {
+            return j;
+        }
+    }
+    return -1;
+}
+
+static void registrarRodada(Mesa* mesa, const RegrasTorneio* regras, int rodada) {
+    long long* linha = &mesa->historico[(size_t) rodada * regras->jogadores];
+    for (int j = 0; j < regras->jogadores; j++) {
+        linha[j] = estatisticasTropas(mesa->mapa.estatisticas, (IdCor) j);
+    }
+}
+
+/*
+ * Função: jogarNaMesa
+ * 
+ * Joga a partida `indice` do torneio na mesa de um trabalhador e, se
+ * houver vencedor, soma o histórico de tropas às curvas da mesa.
+ */
+static void jogarNaMesa(Mesa* mesa, const RegrasTorneio* regras, long long indice,
+                        ResultadoPartida* resultado) {
+    Mapa* mapa = &mesa->mapa;
+    Aleatorio rng;
+    aleatorioSemear(&rng, regras->semente + (uint64_t) indice * 0x9E3779B97F4A7C15ULL);
+
+    memset(resultado, 0, sizeof(*resultado));
+    resultado->vencedor = -1;
+    for (int j = 0; j < regras->jogadores; j++) {
+        resultado->missoes[j] = (uint8_t) aleatorioLimitado(&rng, (uint32_t) regras->numMissoes);
+    }
+    distribuir(mesa, regras, &rng);
+    registrarRodada(mesa, regras, 0);
+
+    int vencedor = procurarVencedor(mapa, regras, resultado);
+    int rodada = 0;
+    ResultadoAtaque ataque;
+
+    while (vencedor < 0 && rodada < regras->maxRodadas) {
+        rodada++;
+        for (int j = 0; j < regras->jogadores && vencedor < 0; j++) {
+            IdCor cor = (IdCor) j;
+            int possuidos = estatisticasTerritorios(mapa->estatisticas, cor);
+            if (possuidos == 0) {
+                continue;
+            }
+
+            int atacante = -1, defensor = -1;
+            if (regras->reforco && escolherAtaque(mapa, regras->regra, cor, 1, &atacante, &defensor)) {
+                int novas = reforcoDaCor(mapa, cor);
+                mapaDefinirTropas(mapa, atacante, mapa->tropas[atacante] + novas);
+                if (verificarMissao(&regras->missoes[resultado->missoes[j]], mapa, cor)) {
+                    vencedor = j;
+                    break;
+                }
+            }
+
+            // Insiste com o mesmo atacante enquanto ele puder atacar
+            int ataques = 0;
+            while (ataques < regras->ataquesPorVez &&
+                   escolherAtaque(mapa, regras->regra, cor, 2, &atacante, &defensor)) {
+                while (ataques < regras->ataquesPorVez && mapa->tropas[atacante] >= 2) {
+                    rolarAtaque(mapa, regras->regra, atacante, defensor, &rng, &ataque);
+                    ataques++;
+                    if (ataque.conquista) {
+                        resultado->conquistas++;
+                        vencedor = procurarVencedor(mapa, regras, resultado);
+                        break;
+                    }
+                }
+                if (vencedor >= 0) {
+                    break;
+                }
+            }
+            resultado->ataques += ataques;
+        }
+        registrarRodada(mesa, regras, rodada);
+    }
+
+    resultado->vencedor = vencedor;
+    resultado->rodadas = rodada;
+    if (vencedor < 0) {
+        return;
+    }
+    resultado->tropasFinais = estatisticasTropas(mapa->estatisticas, (IdCor) vencedor);
+
+    for (int r = 0; r <= rodada; r++) {
+        const long long* linha = &mesa->historico[(size_t) r * regras->jogadores];
+        long long outros = 0;
+        for (int j = 0; j < regras->jogadores; j++) {
+            if (j != vencedor) {
+                outros += linha[j];
+            }
+        }
+        mesa->partidasNaRodada[r]++;
+        mesa->tropasVencedor[r] += (double) linha[vencedor];
+        mesa->tropasOutros[r] += (double) outros / (regras->jogadores - 1);
+    }
+}
+
+/*
+ * Função: jogarPartida
+ * 
+ * Joga isoladamente a partida `indice` de um torneio; o resultado é o
+ * mesmo obtido por executarTorneio para esse índice.
+ * 
+ * Retorno: 1 em caso de sucesso, 0 se as regras forem inválidas ou faltar memória
+ */
+int jogarPartida(const RegrasTorneio* regras, long long indice, ResultadoPartida* resultado) {
+    if (!regrasValidas(regras)) {
+        return 0;
+    }
+    Mesa mesa;
+    if (!prepararMesa(&mesa, regras)) {
+        return 0;
+    }
+    jogarNaMesa(&mesa, regras, indice, resultado);
+    liberarMesa(&mesa);
+    return 1;
+}
+
+// Tarefa do pool: uma partida completa
+static void tarefaPartida(void* contexto, int tarefa, int trabalhador) {
+    ContextoTorneio* ctx = (ContextoTorneio*) contexto;
+    Mesa* mesa = &ctx->mesas[trabalhador];
+    if (!mesa->pronta) {
+        if (ctx->falhou || !prepararMesa(mesa, ctx->regras)) {
+            ctx->falhou = 1;
+            ctx->resultados[tarefa].vencedor = -1;
+            ctx->resultados[tarefa].rodadas = -1;
+            return;
+        }
+    }
+    jogarNaMesa(mesa, ctx->regras, tarefa, &ctx->resultados[tarefa]);
+}
+
+/*
+ * Função: executarTorneio
+ * 
+ * Joga as partidas 0..numPartidas-1 em paralelo e resume os resultados.
+ * 
+ * Parâmetros:
+ *   regras - configuração das partidas
+ *   numPartidas - quantidade de partidas
+ *   pool - pool de threads (NULL joga tudo na thread atual)
+ *   resultados - vetor com numPartidas posições, preenchido por partida
+ *   resumo - totais por missão, por posição e curvas de tropas
+ *            (liberar com liberarResumo)
+ * 
+ * Retorno: 1 em caso de sucesso, 0 se as regras forem inválidas ou faltar memória
+ */
+int executarTorneio(const RegrasTorneio* regras, long long numPartidas, Pool* pool,
+                    ResultadoPartida* resultados, ResumoTorneio* resumo) {
+    memset(resumo, 0, sizeof(*resumo));
+    if (!regrasValidas(regras) || numPartidas <= 0 || numPartidas > 0x7FFFFFFF) {
+        return 0;
+    }
+
+    int trabalhadores = (pool != NULL) ? poolTamanho(pool) : 1;
+    Mesa* mesas = (Mesa*) aligned_alloc(64, sizeof(Mesa) * trabalhadores);
+    size_t pontos = (size_t) regras->maxRodadas + 1;
+    resumo->numRodadasCurva = (int) pontos;
+    resumo->partidasNaRodada = (long long*) calloc(pontos, sizeof(long long));
+    resumo->tropasVencedor = (double*) calloc(pontos, sizeof(double));
+    resumo->tropasOutros = (double*) calloc(pontos, sizeof(double));
+    if (mesas == NULL || resumo->partidasNaRodada == NULL ||
+        resumo->tropasVencedor == NULL || resumo->tropasOutros == NULL) {
+        free(mesas);
+        liberarResumo(resumo);
+        return 0;
+    }
+    memset(mesas, 0, sizeof(Mesa) * trabalhadores);
+
+    ContextoTorneio ctx = {regras, resultados, mesas, 0};
+    double inicio = agora();
+    if (pool != NULL) {
+        poolExecutar(pool, (int) numPartidas, tarefaPartida, &ctx);
+    } else {
+        for (long long p = 0; p < numPartidas; p++) {
+            tarefaPartida(&ctx, (int) p, 0);
+        }
+    }
+    resumo->segundos = agora() - inicio;
+
+    // Redução das curvas das mesas
+    for (int t = 0; t < trabalhadores; t++) {
+        if (!mesas[t].pronta) {
+            continue;
+        }
+        for (size_t r = 0; r < pontos; r++) {
+            resumo->partidasNaRodada[r] += mesas[t].partidasNaRodada[r];
+            resumo->tropasVencedor[r] += mesas[t].tropasVencedor[r];
+            resumo->tropasOutros[r] += mesas[t].tropasOutros[r];
+        }
+        liberarMesa(&mesas[t]);
+    }
+    free(mesas);
+    if (ctx.falhou) {
+        liberarResumo(resumo);
+        return 0;
+    }
+    for (size_t r = 0; r < pontos; r++) {
+        if (resumo->partidasNaRodada[r] > 0) {
+            resumo->tropasVencedor[r] /= (double) resumo->partidasNaRodada[r];
+            resumo->tropasOutros[r] /= (double) resumo->partidasNaRodada[r];
+        }
+    }
+
+    // Totais por missão e por posição
+    resumo->partidas = numPartidas;
+    for (long long p = 0; p < numPartidas; p++) {
+        const ResultadoPartida* r = &resultados[p];
+        resumo->rodadas += r->rodadas;
+        resumo->ataques += r->ataques;
+        for (int j = 0; j < regras->jogadores; j++) {
+            resumo->atribuidas[r->missoes[j]]++;
+        }
+        if (r->vencedor < 0) {
+            resumo->empates++;
+        } else {
+            int missao = r->missoes[r->vencedor];
+            resumo->vitorias[missao]++;
+            resumo->rodadasVitoria[missao] += r->rodadas;
+            resumo->vitoriasPosicao[r->vencedor]++;
+        }
+    }
+    return 1;
+}
+
+/*
+ * Função: liberarResumo
+ * 
+ * Libera as curvas de um resumo preenchido por executarTorneio.
+ */
+void liberarResumo(ResumoTorneio* resumo) {
+    free(resumo->partidasNaRodada);
+    free(resumo->tropasVencedor);
+    free(resumo->tropasOutros);
+    resumo->partidasNaRodada = NULL;
+    resumo->tropasVencedor = NULL;
+    resumo->tropasOutros = NULL;
+    resumo->numRodadasCurva = 0;
+}
+
+/*
+ * Função: escreverCsvPartidas
+ * 
+ * Uma linha por partida: índice, tamanho, vencedor (-1 no empate), missão
+ * do vencedor, rodadas, ataques, conquistas, tropas finais do vencedor e
+ * as missões de todos os jogadores separadas por '|'. A linha de
+ * cabeçalho só é escrita se `cabecalho` for 1 (varreduras acrescentam
+ * linhas ao mesmo arquivo).
+ */
+void escreverCsvPartidas(FILE* saida, const RegrasTorneio* regras,
+                         const ResultadoPartida* resultados, long long numPartidas,
+                         int cabecalho) {
+    if (cabecalho) {
+        fprintf(saida, "partida,semente,territorios,jogadores,vencedor,missao_vencedor,"
+                       "rodadas,ataques,conquistas,tropas_vencedor,missoes\n");
+    }
+    for (long long p = 0; p < numPartidas; p++) {
+        const ResultadoPartida* r = &resultados[p];
+        const char* missao = "empate";
+        if (r->vencedor >= 0) {
+            missao = nomeTipoMissao(regras->missoes[r->missoes[r->vencedor]].tipo);
+        }
+        fprintf(saida, "%lld,%llu,%d,%d,%d,%s,%d,%lld,%lld,%lld,", p,
+                (unsigned long long) regras->semente, regras->territorios, regras->jogadores,
+                r->vencedor, missao, r->rodadas, r->ataques, r->conquistas, r->tropasFinais);
+        for (int j = 0; j < regras->jogadores; j++) {
+            const Missao* m = &regras->missoes[r->missoes[j]];
+            fprintf(saida, "%s%s:%d", j > 0 ? "|" : "", nomeTipoMissao(m->tipo), m->parametro);
+        }
+        fputc('\n', saida);
+    }
+}
+
+/*
+ * Função: escreverCsvMissoes
+ * 
+ * Uma linha por missão da lista: vezes sorteada, vitórias, taxa de
+ * vitória e média de rodadas até vencer.
+ */
+void escreverCsvMissoes(FILE* saida, const RegrasTorneio* regras, const ResumoTorneio* resumo,
+                        int cabecalho) {
+    if (cabecalho) {
+        fprintf(saida, "territorios,jogadores,missao,parametro,sorteada,vitorias,taxa,rodadas_media\n");
+    }
+    for (int m = 0; m < regras->numMissoes; m++) {
+        long long sorteada = resumo->atribuidas[m];
+        long long vitorias = resumo->vitorias[m];
+        fprintf(saida, "%d,%d,%s,%d,%lld,%lld,%.4f,%.2f\n", regras->territorios,
+                regras->jogadores, nomeTipoMissao(regras->missoes[m].tipo),
+                regras->missoes[m].parametro, sorteada, vitorias,
+                sorteada > 0 ? (double) vitorias / sorteada : 0.0,
+                vitorias > 0 ? (double) resumo->rodadasVitoria[m] / vitorias : 0.0);
+    }
+}
+
+/*
+ * Função: escreverCsvCurvas
+ * 
+ * Uma linha por rodada com partidas em andamento: quantas partidas com
+ * vencedor ainda não tinham terminado e as tropas médias do futuro
+ * vencedor e de cada adversário.
+ */
+void escreverCsvCurvas(FILE* saida, const RegrasTorneio* regras, const ResumoTorneio* resumo,
+                       int cabecalho) {
+    if (cabecalho) {
+        fprintf(saida, "territorios,jogadores,rodada,partidas,tropas_vencedor,tropas_adversario\n");
+    }
+    for (int r = 0; r < resumo->numRodadasCurva; r++) {
+        if (resumo->partidasNaRodada[r] == 0) {
+            break;
+        }
+        fprintf(saida, "%d,%d,%d,%lld,%.2f,%.2f\n", regras->territorios, regras->jogadores, r,
+                resumo->partidasNaRodada[r], resumo->tropasVencedor[r], resumo->tropasOutros[r]);
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * Torneio de partidas automáticas
+ * 
+ * Joga muitas partidas completas sem interação, com uma política simples
+ * embutida, para medir o equilíbrio das missões. Cada partida é uma
+ * tarefa do Pool e depende só da semente do torneio e do seu índice,
+ * então qualquer partida pode ser repetida isoladamente.
+ * 
+ * Regras de uma partida:
+ *   - os territórios são repartidos igualmente entre os jogadores, em
+ *     ordem sorteada, com 1 a 3 tropas cada;
+ *   - cada jogador recebe uma missão sorteada da lista;
+ *   - em cada rodada, os jogadores jogam na ordem 0..n-1: recebem o
+ *     reforço (se ativado) e atacam até não haver mais ataque possível
+ *     ou até o limite de ataques por vez;
+ *   - vence o primeiro jogador com a missão cumprida; sem vencedor até
+ *     o limite de rodadas, a partida termina empatada.
+ */
+
+#ifndef WAR_TORNEIO_H
+#define WAR_TORNEIO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "batalha.h"
+#include "grafo.h"
+#include "pool.h"
+
+// Jogadores por partida
+#define MAX_JOGADORES_TORNEIO 8
+
+/*
+ * Struct RegrasTorneio
+ * 
+ * Configuração comum a todas as partidas de um torneio.
+ */
+typedef struct {
+    int territorios;          // Territórios do mapa
+    int jogadores;            // Jogadores por partida (2..MAX_JOGADORES_TORNEIO)
+    int maxRodadas;           // Rodadas até declarar empate
+    int ataquesPorVez;        // Limite de ataques de um jogador em uma vez
+    int reforco;              // 1: cada vez começa com as tropas de reforcoDaCor
+    RegraBatalha regra;       // Regra de batalha dos ataques
+    uint64_t semente;         // A partida i usa a semente derivada de (semente, i)
+    const Missao* missoes;    // Missões sorteadas entre os jogadores
+    int numMissoes;
+    const Grafo* grafo;       // Fronteiras compartilhadas (NULL: todos com todos)
+    const Continentes* continentes; // Continentes com bônus (NULL: nenhum), copiados por mesa
+} RegrasTorneio;
+
+/*
+ * Struct ResultadoPartida
+ * 
+ * Desfecho de uma partida.
+ */
+typedef struct {
+    int vencedor;                          // Jogador vencedor (-1: empate)
+    int rodadas;                           // Rodadas jogadas
+    long long ataques;                     // Ataques resolvidos
+    long long conquistas;                  // Ataques que terminaram em conquista
+    long long tropasFinais;                // Tropas do vencedor ao final (0 no empate)
+    uint8_t missoes[MAX_JOGADORES_TORNEIO]; // Índice da missão de cada jogador
+} ResultadoPartida;
+
+/*
+ * Struct ResumoTorneio
+ * 
+ * Totais do torneio. As curvas de tropas são médias por rodada sobre as
+ * partidas com vencedor que ainda estavam em andamento naquela rodada.
+ */
+typedef struct {
+    long long partidas;
+    long long empates;
+    long long rodadas;                     // Soma das rodadas de todas as partidas
+    long long ataques;
+    long long atribuidas[MAX_MISSOES];     // Vezes em que cada missão foi sorteada
+    long long vitorias[MAX_MISSOES];       // Vitórias de cada missão
+    long long rodadasVitoria[MAX_MISSOES]; // Soma das rodadas até as vitórias
+    long long vitoriasPosicao[MAX_JOGADORES_TORNEIO]; // Vitórias por ordem de jogada
+    int numRodadasCurva;                   // Tamanho das curvas (maxRodadas + 1)
+    long long* partidasNaRodada;           // Partidas com vencedor ainda em andamento
+    double* tropasVencedor;                // Média de tropas do futuro vencedor
+    double* tropasOutros;                  // Média de tropas por adversário
+    double segundos;                       // Tempo de parede do torneio
+} ResumoTorneio;
+
+void regrasPadrao(RegrasTorneio* regras);
+int jogarPartida(const RegrasTorneio* regras, long long indice, ResultadoPartida* resultado);
+int executarTorneio(const RegrasTorneio* regras, long long numPartidas, Pool* pool,
+                    ResultadoPartida* resultados, ResumoTorneio* resumo);
+void liberarResumo(ResumoTorneio* resumo);
+void escreverCsvPartidas(FILE* saida, const RegrasTorneio* regras,
+                         const ResultadoPartida* resultados, long long numPartidas,
+                         int cabecalho);
+void escreverCsvMissoes(FILE* saida, const RegrasTorneio* regras, const ResumoTorneio* resumo,
+                        int cabecalho);
+void escreverCsvCurvas(FILE* saida, const RegrasTorneio* regras, const ResumoTorneio* resumo,
+                       int cabecalho);
+
+#endif
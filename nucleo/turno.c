@@ -0,0 +1,172 @@
+/*
+ * Turnos de ataque em lote
+ * 
+ * A execução rola os dados em blocos, como executarLote, e valida cada
+ * ordem uma única vez antes das suas rolagens: entre duas rolagens da
+ * mesma ordem só as tropas do atacante mudam, e a conquista a encerra.
+ */
+
+#include <string.h>
+#include "grafo.h"
+#include "turno.h"
+
+// Dados rolados de uma vez (o gerador custa menos em blocos)
+#define DADOS_POR_RECARGA 256
+
+static const char* const NOMES_POLITICAS[NUM_POLITICAS] = {"uma-vez", "ate-conquistar"};
+
+static const char* const MENSAGENS[] = {
+    "ok",
+    "ordens demais no turno",
+    "territorio invalido",
+    "o atacante nao e do jogador nem e atacado por uma ordem anterior",
+    "o defensor ja e do jogador",
+    "o atacante precisa de pelo menos 2 tropas",
+    "os territorios nao fazem fronteira",
+    "politica de ataque invalida"
+};
+
+const char* nomePolitica(PoliticaAtaque politica) {
+    return ((unsigned) politica < NUM_POLITICAS) ? NOMES_POLITICAS[politica] : "?";
+}
+
+/*
+ * Função: turnoMensagem
+ * 
+ * Retorno: descrição do código, para mensagens ao usuário
+ */
+const char* turnoMensagem(CodigoTurno codigo) {
+    return ((unsigned) codigo <= TURNO_POLITICA_INVALIDA) ? MENSAGENS[codigo] : "?";
+}
+
+// Uma ordem anterior (0 .. ate - 1) ataca o território?
+static int atacadoAntes(const OrdemTurno* ordens, int ate, int territorio) {
+    for (int j = 0; j < ate; j++) {
+        if (ordens[j].defensor == territorio) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Função: conferirTurno
+ * 
+ * Confere uma lista de ordens da cor `cor` contra o mapa antes de
+ * qualquer rolagem. O atacante de cada ordem precisa ser da cor (com
+ * pelo menos 2 tropas, que durante o turno só diminuem) ou o defensor
+ * de uma ordem anterior; o defensor não pode ser da cor.
+ * 
+ * Parâmetros:
+ *   mapa - mapa de territórios
+ *   cor - cor do jogador que mandou as ordens
+ *   ordens - ordens do turno, na ordem de execução
+ *   numOrdens - quantidade de ordens
+ *   ordemRecusada - recebe o índice da primeira ordem recusada (pode ser NULL)
+ * 
+ * Retorno: TURNO_OK ou o motivo da recusa da primeira ordem com problema
+ */
+CodigoTurno conferirTurno(const Mapa* mapa, IdCor cor, const OrdemTurno* ordens, int numOrdens,
+                          int* ordemRecusada) {
+    if (ordemRecusada != NULL) {
+        *ordemRecusada = -1;
+    }
+    if (numOrdens > MAX_ORDENS_TURNO) {
+        return TURNO_ORDENS_DEMAIS;
+    }
+    for (int i = 0; i < numOrdens; i++) {
+        const OrdemTurno* ordem = &ordens[i];
+        int a = ordem->atacante, d = ordem->defensor;
+        CodigoTurno codigo = TURNO_OK;
+        if (a < 0 || a >= mapa->quantidade || d < 0 || d >= mapa->quantidade) {
+            codigo = TURNO_INDICE_INVALIDO;
+        } else if ((unsigned) ordem->politica >= NUM_POLITICAS ||
+                   (ordem->politica == POLITICA_ATE_CONQUISTAR && ordem->reserva < 1)) {
+            codigo = TURNO_POLITICA_INVALIDA;
+        } else if (a == d || mapa->donos[d] == cor) {
+            codigo = TURNO_DEFENSOR_PROPRIO;
+        } else if (mapa->donos[a] != cor && !atacadoAntes(ordens, i, a)) {
+            codigo = TURNO_ATACANTE_ALHEIO;
+        } else if (mapa->donos[a] == cor && mapa->tropas[a] < 2) {
+            codigo = TURNO_TROPAS_INSUFICIENTES;
+        } else if (mapa->grafo != NULL && !grafoAdjacentes(mapa->grafo, a, d)) {
+            codigo = TURNO_NAO_ADJACENTE;
+        }
+        if (codigo != TURNO_OK) {
+            if (ordemRecusada != NULL) {
+                *ordemRecusada = i;
+            }
+            return codigo;
+        }
+    }
+    return TURNO_OK;
+}
+
+/*
+ * Função: executarTurno
+ * 
+ * Resolve as ordens da cor `cor` em sequência, de preferência depois de
+ * conferirTurno. Uma ordem é pulada se, quando chega a vez dela, o
+ * atacante não for da cor, o defensor já for, ou o atacante não tiver
+ * mais tropas que o mínimo da política. Não confere missões.
+ * 
+ * Parâmetros:
+ *   mapa - mapa de territórios (alterado pelas ordens)
+ *   regra - regra de batalha
+ *   cor - cor do jogador da vez
+ *   ordens - ordens do turno
+ *   numOrdens - quantidade de ordens
+ *   rng - gerador usado para rolar os dados
+ *   resultados - recebe o resultado de cada ordem (pode ser NULL)
+ *   aoRolar - chamada depois de cada rolagem (pode ser NULL)
+ *   contexto - repassado a aoRolar
+ * 
+ * Retorno: quantidade de conquistas do turno
+ */
+int executarTurno(Mapa* mapa, RegraBatalha regra, IdCor cor, const OrdemTurno* ordens,
+                  int numOrdens, Aleatorio* rng, ResultadoOrdem* resultados,
+                  FuncaoRolagem aoRolar, void* contexto) {
+    uint8_t dados[DADOS_POR_RECARGA];
+    int proximoDado = DADOS_POR_RECARGA;
+    ResultadoAtaque resultado;
+    int conquistas = 0;
+
+    for (int i = 0; i < numOrdens; i++) {
+        int a = ordens[i].atacante, d = ordens[i].defensor;
+        int minimo = (ordens[i].politica == POLITICA_ATE_CONQUISTAR && ordens[i].reserva > 1)
+                   ? ordens[i].reserva : 1;
+        ResultadoOrdem feito;
+        memset(&feito, 0, sizeof(feito));
+
+        int valida = validarAtaque(mapa, a, d) == ATAQUE_OK && mapa->donos[a] == cor;
+        while (valida && mapa->tropas[a] > minimo) {
+            if (proximoDado + 2 * MAX_DADOS > DADOS_POR_RECARGA) {
+                aleatorioPreencherDados(rng, dados, DADOS_POR_RECARGA);
+                proximoDado = 0;
+            }
+            int numAtacante = dadosDoAtacante(regra, mapa->tropas[a]);
+            resolverAtaqueComDados(mapa, regra, a, d, &dados[proximoDado],
+                                   &dados[proximoDado + numAtacante], &resultado);
+            proximoDado += numAtacante + resultado.numDadosDefensor;
+            if (aoRolar != NULL) {
+                aoRolar(contexto, mapa, a, d, &resultado);
+            }
+            feito.rolagens++;
+            feito.perdasAtacante += resultado.perdasAtacante;
+            feito.perdasDefensor += resultado.perdasDefensor;
+            if (resultado.conquista || ordens[i].politica == POLITICA_UMA_VEZ) {
+                feito.conquista = resultado.conquista;
+                break;
+            }
+        }
+        conquistas += feito.conquista;
+        if (resultados != NULL) {
+            if (a >= 0 && a < mapa->quantidade && d >= 0 && d < mapa->quantidade) {
+                feito.tropasAtacante = mapa->tropas[a];
+                feito.tropasDefensor = mapa->tropas[d];
+            }
+            resultados[i] = feito;
+        }
+    }
+    return conquistas;
+}
@@ -0,0 +1,92 @@
+/*
+ * Turnos de ataque em lote
+ * 
+ * Em vez de um par atacante/defensor por jogada, o jogador manda todas
+ * as ordens do turno de uma vez. conferirTurno recusa a lista inteira
+ * se alguma ordem conflitar com o mapa ou com as ordens anteriores;
+ * executarTurno resolve as ordens em sequência, sem entrada/saída e sem
+ * redesenhar nada entre elas, e quem chama confere as missões uma única
+ * vez no final (jogadorVencedor), não a cada ataque.
+ * 
+ * Cada ordem tem uma política: uma única rolagem, ou atacar até
+ * conquistar ou até o atacante ficar com `reserva` tropas. Uma ordem
+ * pode partir de um território que uma ordem anterior do mesmo lote vai
+ * tentar conquistar; se a conquista não acontecer, ou se o defensor já
+ * tiver caído, a ordem é pulada na execução sem rolar dados.
+ */
+
+#ifndef WAR_TURNO_H
+#define WAR_TURNO_H
+
+#include "batalha.h"
+#include "mapa.h"
+
+// Ordens aceitas em um turno
+#define MAX_ORDENS_TURNO 256
+
+/*
+ * Enum PoliticaAtaque
+ * 
+ * Quantas vezes uma ordem rola os dados.
+ */
+typedef enum {
+    POLITICA_UMA_VEZ = 0,        // Uma única rolagem
+    POLITICA_ATE_CONQUISTAR,     // Até conquistar ou o atacante ficar com `reserva` tropas
+    NUM_POLITICAS
+} PoliticaAtaque;
+
+/*
+ * Struct OrdemTurno
+ * 
+ * Uma ordem de ataque do turno (índices começando em 0).
+ */
+typedef struct {
+    int atacante;
+    int defensor;
+    PoliticaAtaque politica;
+    int reserva;                 // POLITICA_ATE_CONQUISTAR: tropas mínimas no atacante (>= 1)
+} OrdemTurno;
+
+/*
+ * Enum CodigoTurno
+ * 
+ * Motivo da recusa de uma lista de ordens por conferirTurno.
+ */
+typedef enum {
+    TURNO_OK = 0,
+    TURNO_ORDENS_DEMAIS,         // Mais de MAX_ORDENS_TURNO ordens
+    TURNO_INDICE_INVALIDO,       // Território fora do mapa
+    TURNO_ATACANTE_ALHEIO,       // Atacante de outra cor e não atacado por uma ordem anterior
+    TURNO_DEFENSOR_PROPRIO,      // Defensor da cor do jogador (ou o próprio atacante)
+    TURNO_TROPAS_INSUFICIENTES,  // Atacante da cor com menos de 2 tropas
+    TURNO_NAO_ADJACENTE,         // Os territórios não fazem fronteira
+    TURNO_POLITICA_INVALIDA      // Política desconhecida ou reserva menor que 1
+} CodigoTurno;
+
+/*
+ * Struct ResultadoOrdem
+ * 
+ * O que uma ordem fez, somando todas as suas rolagens.
+ */
+typedef struct {
+    int rolagens;                // Ataques resolvidos (0: ordem pulada)
+    int perdasAtacante;
+    int perdasDefensor;
+    int conquista;               // 1 se o defensor foi conquistado
+    int tropasAtacante;          // Tropas dos dois territórios depois da ordem
+    int tropasDefensor;
+} ResultadoOrdem;
+
+// Chamada depois de cada rolagem, com o mapa já atualizado (ex.: registroAtaque)
+typedef void (*FuncaoRolagem)(void* contexto, const Mapa* mapa, int atacante, int defensor,
+                              const ResultadoAtaque* resultado);
+
+const char* nomePolitica(PoliticaAtaque politica);
+const char* turnoMensagem(CodigoTurno codigo);
+CodigoTurno conferirTurno(const Mapa* mapa, IdCor cor, const OrdemTurno* ordens, int numOrdens,
+                          int* ordemRecusada);
+int executarTurno(Mapa* mapa, RegraBatalha regra, IdCor cor, const OrdemTurno* ordens,
+                  int numOrdens, Aleatorio* rng, ResultadoOrdem* resultados,
+                  FuncaoRolagem aoRolar, void* contexto);
+
+#endif
@@ -0,0 +1,219 @@
+/*
+ * Varreduras do mapa para todas as cores de uma vez
+ * 
+ * Os resumos parciais só são somados: resumirFaixa acumula em `resumo`
+ * sem zerá-lo, então faixas diferentes podem ser reduzidas em qualquer
+ * ordem e em qualquer thread.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "perfil.h"
+#include "varredura.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Territórios por bloco: 255 passos de 16, o limite dos contadores de 8 bits
+#define TERRITORIOS_POR_BLOCO (255 * 16)
+
+// Territórios por tarefa do pool (blocos inteiros)
+#define TERRITORIOS_POR_TAREFA (16 * TERRITORIOS_POR_BLOCO)
+
+// Tropas abaixo deste valor somam em 32 bits sem estourar dentro de um bloco
+#define LIMITE_TROPAS_VETORIAL (1 << 20)
+
+/*
+ * Função: histogramaFaixa
+ * 
+ * Contagem e tropas por cor em quatro tabelas intercaladas: territórios
+ * vizinhos caem em tabelas diferentes, então uma sequência de mesma cor
+ * não encadeia leituras e escritas no mesmo contador.
+ */
+static void histogramaFaixa(const IdCor* donos, const int32_t* tropas, int quantidade,
+                            int numCores, ResumoCores* resumo) {
+    int32_t contagem[4][MAX_CORES];
+    int64_t soma[4][MAX_CORES];
+    // Só as cores em uso: em faixas curtas zerar as tabelas inteiras custaria mais que a faixa
+    for (int k = 0; k < 4; k++) {
+        memset(contagem[k], 0, (size_t) numCores * sizeof(int32_t));
+        memset(soma[k], 0, (size_t) numCores * sizeof(int64_t));
+    }
+    int i = 0;
+    for (; i + 4 <= quantidade; i += 4) {
+        for (int k = 0; k < 4; k++) {
+            contagem[k][donos[i + k]]++;
+            soma[k][donos[i + k]] += tropas[i + k];
+        }
+    }
+    for (; i < quantidade; i++) {
+        contagem[0][donos[i]]++;
+        soma[0][donos[i]] += tropas[i];
+    }
+    for (int c = 0; c < numCores; c++) {
+        resumo->territorios[c] += contagem[0][c] + contagem[1][c] + contagem[2][c] + contagem[3][c];
+        resumo->tropas[c] += soma[0][c] + soma[1][c] + soma[2][c] + soma[3][c];
+    }
+}
+
+#if defined(__SSE2__)
+// Soma das quatro faixas de 32 bits
+static inline int64_t somarFaixas32(__m128i v) {
+    int32_t faixas[4];
+    _mm_storeu_si128((__m128i*) faixas, v);
+    return (int64_t) faixas[0] + faixas[1] + faixas[2] + faixas[3];
+}
+
+/*
+ * Função: resumirBlocoVetorial
+ * 
+ * Um bloco de até TERRITORIOS_POR_BLOCO territórios (múltiplo de 16) com
+ * numCores <= MAX_CORES_VETORIAL. Uma primeira passada confere que
+ * nenhuma tropa passa de LIMITE_TROPAS_VETORIAL (então as somas de 32
+ * bits não estouram) e soma o total; depois, para cada cor menos a
+ * última, a comparação dos donos vira uma máscara de 16 bytes que conta
+ * os territórios (subtraindo -1) e, alargada para 32 bits, seleciona as
+ * tropas. A última cor recebe o que sobra do bloco.
+ * 
+ * Retorno: 1 se o bloco foi resumido, 0 se há tropas grandes demais (ou
+ * negativas) e o chamador deve usar o histograma
+ */
+static int resumirBlocoVetorial(const IdCor* donos, const int32_t* tropas, int quantidade,
+                                int numCores, ResumoCores* resumo) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i ou = zero, total = zero;
+    for (int i = 0; i < quantidade; i += 16) {
+        __m128i t0 = _mm_loadu_si128((const __m128i*) (tropas + i));
+        __m128i t1 = _mm_loadu_si128((const __m128i*) (tropas + i + 4));
+        __m128i t2 = _mm_loadu_si128((const __m128i*) (tropas + i + 8));
+        __m128i t3 = _mm_loadu_si128((const __m128i*) (tropas + i + 12));
+        ou = _mm_or_si128(ou, _mm_or_si128(_mm_or_si128(t0, t1), _mm_or_si128(t2, t3)));
+        total = _mm_add_epi32(total, _mm_add_epi32(_mm_add_epi32(t0, t1), _mm_add_epi32(t2, t3)));
+    }
+    int32_t faixas[4];
+    _mm_storeu_si128((__m128i*) faixas, ou);
+    if ((uint32_t) (faixas[0] | faixas[1] | faixas[2] | faixas[3]) >= LIMITE_TROPAS_VETORIAL) {
+        return 0;
+    }
+
+    int32_t restantes = quantidade;
+    int64_t tropasRestantes = somarFaixas32(total);
+    for (int c = 0; c < numCores - 1; c++) {
+        const __m128i cor = _mm_set1_epi8((char) c);
+        __m128i contagem = zero, soma = zero;
+        for (int i = 0; i < quantidade; i += 16) {
+            __m128i mascara = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) (donos + i)), cor);
+            contagem = _mm_sub_epi8(contagem, mascara);
+            // Alarga a máscara de bytes para as quatro faixas de 32 bits das tropas
+            __m128i baixa = _mm_unpacklo_epi8(mascara, mascara);
+            __m128i alta = _mm_unpackhi_epi8(mascara, mascara);
+            __m128i t0 = _mm_and_si128(_mm_loadu_si128((const __m128i*) (tropas + i)),
+                                       _mm_unpacklo_epi16(baixa, baixa));
+            __m128i t1 = _mm_and_si128(_mm_loadu_si128((const __m128i*) (tropas + i + 4)),
+                                       _mm_unpackhi_epi16(baixa, baixa));
+            __m128i t2 = _mm_and_si128(_mm_loadu_si128((const __m128i*) (tropas + i + 8)),
+                                       _mm_unpacklo_epi16(alta, alta));
+            __m128i t3 = _mm_and_si128(_mm_loadu_si128((const __m128i*) (tropas + i + 12)),
+                                       _mm_unpackhi_epi16(alta, alta));
+            soma = _mm_add_epi32(soma, _mm_add_epi32(_mm_add_epi32(t0, t1), _mm_add_epi32(t2, t3)));
+        }
+        // Soma horizontal dos contadores de 8 bits (duas metades de 64 bits)
+        __m128i parcial = _mm_sad_epu8(contagem, zero);
+        int32_t territorios = _mm_cvtsi128_si32(parcial) +
+                              _mm_cvtsi128_si32(_mm_srli_si128(parcial, 8));
+        int64_t somaCor = somarFaixas32(soma);
+        resumo->territorios[c] += territorios;
+        resumo->tropas[c] += somaCor;
+        restantes -= territorios;
+        tropasRestantes -= somaCor;
+    }
+    resumo->territorios[numCores - 1] += restantes;
+    resumo->tropas[numCores - 1] += tropasRestantes;
+    return 1;
+}
+#endif
+
+/*
+ * Função: resumirFaixa
+ * 
+ * Acumula em `resumo` a contagem e as tropas de cada cor dos territórios
+ * donos[0 .. quantidade - 1]. Todos os donos devem ser menores que
+ * numCores.
+ */
+void resumirFaixa(const IdCor* donos, const int32_t* tropas, int quantidade, int numCores,
+                  ResumoCores* resumo) {
+    for (int base = 0; base < quantidade; base += TERRITORIOS_POR_BLOCO) {
+        int bloco = (quantidade - base < TERRITORIOS_POR_BLOCO) ? quantidade - base
+                                                                : TERRITORIOS_POR_BLOCO;
+        int vetorial = 0;
+#if defined(__SSE2__)
+        if (numCores <= MAX_CORES_VETORIAL) {
+            vetorial = bloco & ~15;
+            if (vetorial > 0 &&
+                !resumirBlocoVetorial(donos + base, tropas + base, vetorial, numCores, resumo)) {
+                vetorial = 0;
+            }
+        }
+#endif
+        // Restante do bloco (ou tudo, sem SSE2, com muitas cores ou com tropas grandes)
+        histogramaFaixa(donos + base + vetorial, tropas + base + vetorial, bloco - vetorial,
+                        numCores, resumo);
+    }
+}
+
+typedef struct {
+    const Mapa* mapa;
+    ResumoCores* parciais;    // Um resumo por trabalhador
+} ContextoVarredura;
+
+static void resumirTarefa(void* contexto, int tarefa, int trabalhador) {
+    ContextoVarredura* ctx = (ContextoVarredura*) contexto;
+    const Mapa* mapa = ctx->mapa;
+    int inicio = tarefa * TERRITORIOS_POR_TAREFA;
+    int quantidade = (mapa->quantidade - inicio < TERRITORIOS_POR_TAREFA)
+        ? mapa->quantidade - inicio : TERRITORIOS_POR_TAREFA;
+    resumirFaixa(mapa->donos + inicio, mapa->tropas + inicio, quantidade, mapa->numCores,
+                 &ctx->parciais[trabalhador]);
+}
+
+/*
+ * Função: mapaResumirCores
+ * 
+ * Conta os territórios e soma as tropas de todas as cores em uma única
+ * varredura do mapa.
+ * 
+ * Parâmetros:
+ *   mapa - mapa a varrer
+ *   pool - pool de threads (NULL, ou mapa abaixo de LIMIAR_VARREDURA_PARALELA:
+ *          tudo na thread atual)
+ *   resumo - recebe os totais (cores sem territórios ficam com zero)
+ */
+void mapaResumirCores(const Mapa* mapa, Pool* pool, ResumoCores* resumo) {
+    PERFIL_CONTAR(PERFIL_VARREDURAS);
+    PERFIL_SOMAR(PERFIL_TERRITORIOS_VARRIDOS, mapa->quantidade);
+    memset(resumo, 0, sizeof(*resumo));
+    int trabalhadores = (pool != NULL) ? poolTamanho(pool) : 1;
+    ResumoCores* parciais = NULL;
+    if (mapa->quantidade >= LIMIAR_VARREDURA_PARALELA && trabalhadores > 1) {
+        parciais = (ResumoCores*) aligned_alloc(64, trabalhadores * sizeof(ResumoCores));
+    }
+    if (parciais == NULL) {
+        resumirFaixa(mapa->donos, mapa->tropas, mapa->quantidade, mapa->numCores, resumo);
+        return;
+    }
+
+    memset(parciais, 0, trabalhadores * sizeof(ResumoCores));
+    ContextoVarredura ctx = {mapa, parciais};
+    int numTarefas = (mapa->quantidade + TERRITORIOS_POR_TAREFA - 1) / TERRITORIOS_POR_TAREFA;
+    poolExecutar(pool, numTarefas, resumirTarefa, &ctx);
+
+    // Redução dos resumos parciais
+    for (int t = 0; t < trabalhadores; t++) {
+        for (int c = 0; c < mapa->numCores; c++) {
+            resumo->territorios[c] += parciais[t].territorios[c];
+            resumo->tropas[c] += parciais[t].tropas[c];
+        }
+    }
+    free(parciais);
+}
@@ -0,0 +1,47 @@
+/*
+ * Varreduras do mapa para todas as cores de uma vez
+ * 
+ * mapaContarPorDono e mapaSomarTropas varrem o mapa inteiro para uma
+ * única cor; telas que mostram todos os jogadores pagariam uma varredura
+ * por jogador. mapaResumirCores lê donos e tropas uma única vez e
+ * devolve a contagem e a soma de tropas de todas as cores.
+ * 
+ * O mapa é percorrido em blocos que cabem no cache L1. Com poucas cores
+ * (até MAX_CORES_VETORIAL), cada bloco é reduzido por máscaras SSE2 de
+ * 16 territórios, uma passada por cor sobre o bloco já em cache, e a
+ * última cor sai por diferença do total; com mais cores, por um
+ * histograma escalar em quatro tabelas intercaladas (sem dependência
+ * entre territórios vizinhos de mesma cor). Acima de
+ * LIMIAR_VARREDURA_PARALELA territórios, os blocos são repartidos entre
+ * as threads de um Pool, cada uma com o seu resumo parcial, somados no
+ * final.
+ */
+
+#ifndef WAR_VARREDURA_H
+#define WAR_VARREDURA_H
+
+#include <stdint.h>
+#include "mapa.h"
+#include "pool.h"
+
+// Territórios a partir dos quais a varredura é dividida entre as threads do pool
+#define LIMIAR_VARREDURA_PARALELA (1 << 18)
+
+// Cores até as quais os blocos são reduzidos por máscaras SSE2, uma passada por cor
+#define MAX_CORES_VETORIAL 4
+
+/*
+ * Struct ResumoCores
+ * 
+ * Territórios e tropas somadas de cada cor (índice: IdCor).
+ */
+typedef struct {
+    int32_t territorios[MAX_CORES];
+    int64_t tropas[MAX_CORES];
+} ResumoCores;
+
+void resumirFaixa(const IdCor* donos, const int32_t* tropas, int quantidade, int numCores,
+                  ResumoCores* resumo);
+void mapaResumirCores(const Mapa* mapa, Pool* pool, ResumoCores* resumo);
+
+#endif
@@ -11,41 +11,43 @@
  * Data: 2025
  */
 
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
+#include <unistd.h>
+#include "nucleo/tipos.h"
+#include "nucleo/aleatorio.h"
+#include "nucleo/batalha.h"
+#include "nucleo/cenario.h"
+#include "nucleo/continente.h"
+#include "nucleo/estatisticas.h"
+#include "nucleo/estimador.h"
+#include "nucleo/grafo.h"
+#include "nucleo/historico.h"
+#include "nucleo/ia.h"
+#include "nucleo/mapa.h"
+#include "nucleo/missao.h"
+#include "nucleo/perfil.h"
+#include "nucleo/pool.h"
+#include "nucleo/registro.h"
+#include "nucleo/render.h"
+#include "nucleo/snapshot.h"
+#include "nucleo/tabela.h"
+#include "nucleo/turno.h"
+#include "nucleo/varredura.h"
 
-// Definições de constantes
-#define MAX_MISSOES 5
-#define TAM_MISSAO 150
+// Batalhas simuladas para exibir as chances antes de um ataque
+#define SIMULACOES_ESTIMATIVA 200000
 
-/*
- * Struct Territorio
- * 
- * Estrutura de dados que representa um território no jogo War.
- * Contém as informações essenciais de cada território:
- * - nome: identificação do território (até 29 caracteres + '\0')
- * - cor: cor do exército que ocupa o território (até 9 caracteres + '\0')
- * - tropas: quantidade de tropas posicionadas no território
- */
-typedef struct {
-    char nome[30];   // Nome do território
-    char cor[10];    // Cor do exército
-    int tropas;      // Quantidade de tropas
-} Territorio;
+// Maior quantidade de tropas coberta pela tabela exata de batalhas
+#define LIMITE_TABELA 200
 
-/*
- * Struct Jogador
- * 
- * Estrutura que representa um jogador no jogo War.
- * Contém informações sobre nome, cor e sua missão estratégica.
- */
-typedef struct {
-    char nome[30];        // Nome do jogador
-    char cor[10];         // Cor do exército do jogador
-    char* missao;         // Ponteiro para a missão alocada dinamicamente
-} Jogador;
+// Ataques possíveis listados no status das missões
+#define MAX_ATAQUES_LISTADOS 30
+
+// Primeiro bloco da arena da partida (jogadores, missões e territórios)
+#define ARENA_PARTIDA_INICIAL (64 * 1024)
 
 /*
  * Função: limparBuffer
@@ -62,12 +64,17 @@ void limparBuffer() {
  * 
  * Realiza o cadastro de todos os territórios, solicitando ao usuário
  * que informe nome, cor do exército e quantidade de tropas.
+ * A cor é internada no mapa e o território é acrescentado ao final dele.
  * 
  * Parâmetros:
- *   territorios - ponteiro para o vetor de structs alocado dinamicamente
+ *   mapa - mapa que receberá os territórios
  *   quantidade - número de territórios a serem cadastrados
+ * 
+ * Retorno: 1 em caso de sucesso, 0 em caso de falha de alocação
  */
-void cadastrarTerritorios(Territorio* territorios, int quantidade) {
+int cadastrarTerritorios(Mapa* mapa, int quantidade) {
+    Territorio novo;
+    
     printf("\n=== CADASTRO DE TERRITORIOS - JOGO WAR ===\n");
     printf("=========================================\n\n");
     
@@ -75,51 +82,123 @@ void cadastrarTerritorios(Territorio* territorios, int quantidade) {
         printf("--- Territorio %d de %d ---\n", i + 1, quantidade);
         
         printf("Digite o nome do territorio: ");
-        scanf("%29s", (territorios + i)->nome);
+        scanf("%29s", novo.nome);
         limparBuffer();
         
         printf("Digite a cor do exercito: ");
-        scanf("%9s", (territorios + i)->cor);
+        scanf("%9s", novo.cor);
         limparBuffer();
         
         printf("Digite o numero de tropas: ");
-        scanf("%d", &(territorios + i)->tropas);
+        scanf("%d", &novo.tropas);
         limparBuffer();
         
+        IdCor cor = mapaInternarCor(mapa, novo.cor);
+        if (cor == COR_INVALIDA) {
+            printf("ERRO: Limite de %d cores atingido! Use uma cor ja cadastrada.\n\n", MAX_CORES);
+            i--;
+            continue;
+        }
+        if (mapaAdicionar(mapa, novo.nome, cor, novo.tropas) < 0) {
+            return 0;
+        }
+        
         printf("\n");
     }
+    return 1;
 }
 
 /*
  * Função: exibirTerritorios
  * 
- * Exibe todos os territórios cadastrados com suas informações.
+ * Exibe os territórios cadastrados com suas informações. Mapas com mais
+ * de LIMITE_MAPA_COMPLETO territórios são exibidos como resumo (a opção
+ * de consulta permite filtrar e paginar).
  * 
  * Parâmetros:
- *   territorios - ponteiro para o vetor de structs
- *   quantidade - número de territórios a serem exibidos
+ *   mapa - mapa de territórios a ser exibido
+ *   saida - buffer de saída da partida
  */
-void exibirTerritorios(Territorio* territorios, int quantidade) {
-    printf("\n=== MAPA DE TERRITORIOS ===\n");
-    printf("===========================\n\n");
+void exibirTerritorios(const Mapa* mapa, Saida* saida) {
+    FiltroMapa filtro;
+    filtroPadrao(&filtro);
+    renderizarMapa(saida, mapa, &filtro, RENDER_AUTOMATICO);
+    saidaDescarregar(saida);
+}
+
+/*
+ * Função: lerInteiro
+ * 
+ * Lê um inteiro com uma mensagem, usando `padrao` se a entrada for
+ * vazia ou inválida.
+ */
+int lerInteiro(const char* pergunta, int padrao) {
+    char linha[64];
+    int valor;
     
-    for (int i = 0; i < quantidade; i++) {
-        printf("[%d] %s\n", i + 1, (territorios + i)->nome);
-        printf("    Cor.........: %s\n", (territorios + i)->cor);
-        printf("    Tropas......: %d\n", (territorios + i)->tropas);
-        printf("---------------------------\n");
+    printf("%s", pergunta);
+    if (fgets(linha, sizeof(linha), stdin) == NULL || sscanf(linha, "%d", &valor) != 1) {
+        return padrao;
     }
+    return valor;
 }
 
 /*
- * Função: rolarDado
+ * Função: consultarMapa
  * 
- * Simula a rolagem de um dado de 6 faces.
+ * Consulta interativa do mapa: escolhe o modo de exibição, filtra por
+ * cor e por faixa de tropas e navega pelas páginas.
  * 
- * Retorno: número inteiro entre 1 e 6
+ * Parâmetros:
+ *   mapa - mapa de territórios
+ *   saida - buffer de saída da partida
  */
-int rolarDado() {
-    return (rand() % 6) + 1;
+void consultarMapa(const Mapa* mapa, Saida* saida) {
+    FiltroMapa filtro;
+    char linha[64], cor[TAM_COR + 1];
+    
+    filtroPadrao(&filtro);
+    printf("\n=== CONSULTAR MAPA ===\n");
+    int modo = lerInteiro("Modo (1 detalhado, 2 tabela, 3 resumo) [2]: ", 2);
+    if (modo < RENDER_DETALHADO || modo > RENDER_RESUMO) {
+        modo = RENDER_TABELA;
+    }
+    
+    printf("Cor (vazio para todas): ");
+    if (fgets(linha, sizeof(linha), stdin) != NULL && sscanf(linha, "%10s", cor) == 1) {
+        filtro.cor = mapaBuscarCor(mapa, cor);
+        if (filtro.cor == COR_INVALIDA) {
+            printf("Cor %s nao existe no mapa.\n", cor);
+            return;
+        }
+    }
+    filtro.tropasMinimo = lerInteiro("Tropas minimas (vazio para nenhuma): ", filtro.tropasMinimo);
+    filtro.tropasMaximo = lerInteiro("Tropas maximas (vazio para nenhuma): ", filtro.tropasMaximo);
+    if (modo != RENDER_RESUMO) {
+        filtro.porPagina = lerInteiro("Territorios por pagina [20]: ", 20);
+    }
+    
+    for (;;) {
+        renderizarMapa(saida, mapa, &filtro, (ModoRender) modo);
+        saidaDescarregar(saida);
+        if (filtro.porPagina <= 0) {
+            return;
+        }
+        printf("(n) proxima, (p) anterior, numero da pagina ou (s) sair: ");
+        if (fgets(linha, sizeof(linha), stdin) == NULL) {
+            return;
+        }
+        int pagina;
+        if (linha[0] == 'n') {
+            filtro.pagina++;
+        } else if (linha[0] == 'p' && filtro.pagina > 0) {
+            filtro.pagina--;
+        } else if (sscanf(linha, "%d", &pagina) == 1 && pagina >= 1) {
+            filtro.pagina = pagina - 1;
+        } else if (linha[0] != 'p') {
+            return;
+        }
+    }
 }
 
 /*
@@ -129,78 +208,80 @@ int rolarDado() {
  * Implementa as regras de batalha do jogo War.
  * 
  * Parâmetros:
- *   atacante - ponteiro para o território atacante (passagem por referência)
- *   defensor - ponteiro para o território defensor (passagem por referência)
+ *   mapa - mapa de territórios (alterado pelo ataque)
+ *   regra - regra de batalha da partida
+ *   atacante - índice do território atacante
+ *   defensor - índice do território defensor
+ *   rng - gerador de números aleatórios da partida
+ *   registro - registro de eventos da partida (NULL se desativado)
  */
-void atacar(Territorio* atacante, Territorio* defensor) {
+void atacar(Mapa* mapa, RegraBatalha regra, int atacante, int defensor, Aleatorio* rng,
+            Registro* registro) {
+    PERFIL_ESCOPO(PERFIL_ATACAR);
     printf("\n=== SIMULACAO DE BATALHA ===\n");
-    printf("Atacante: %s (%s) com %d tropas\n", 
-           atacante->nome, atacante->cor, atacante->tropas);
-    printf("Defensor: %s (%s) com %d tropas\n", 
-           defensor->nome, defensor->cor, defensor->tropas);
+    printf("Atacante: %s (%s) com %d tropas\n", mapa->nomes[atacante],
+           mapaNomeCor(mapa, mapa->donos[atacante]), mapa->tropas[atacante]);
+    printf("Defensor: %s (%s) com %d tropas\n", mapa->nomes[defensor],
+           mapaNomeCor(mapa, mapa->donos[defensor]), mapa->tropas[defensor]);
     printf("\n");
     
     // Valida se o atacante tem tropas suficientes
-    if (atacante->tropas < 2) {
+    if (mapa->tropas[atacante] < 2) {
         printf("ATAQUE INVALIDO! O atacante precisa de pelo menos 2 tropas.\n");
         return;
     }
     
-    // Rolagem de dados para batalha
-    int dadoAtacante = rolarDado();
-    int dadoDefensor = rolarDado();
+    // Cada ataque é uma jogada do histórico (desfeita de uma vez pela opção 8)
+    if (mapa->historico != NULL) {
+        historicoIniciarJogada(mapa->historico);
+    }
+    
+    // Rolagem de dados e aplicação das regras (compartilhadas com o modo em lote)
+    ResultadoAtaque resultado;
+    rolarAtaque(mapa, regra, atacante, defensor, rng, &resultado);
+    if (registro != NULL) {
+        CodigoRegistro codigo = registroAtaque(registro, mapa, atacante, defensor, &resultado);
+        if (codigo != REGISTRO_OK) {
+            printf("AVISO: Falha no registro de eventos: %s\n", registroMensagem(codigo));
+        }
+    }
     
     printf("Rolagem de dados:\n");
-    printf("  Atacante rolou: %d\n", dadoAtacante);
-    printf("  Defensor rolou: %d\n", dadoDefensor);
-    printf("\n");
+    printf("  Atacante rolou:");
+    for (int k = 0; k < resultado.numDadosAtacante; k++) {
+        printf(" %d", resultado.dadosAtacante[k]);
+    }
+    printf("\n  Defensor rolou:");
+    for (int k = 0; k < resultado.numDadosDefensor; k++) {
+        printf(" %d", resultado.dadosDefensor[k]);
+    }
+    printf("\n\n");
     
-    // Determina o vencedor
-    if (dadoAtacante > dadoDefensor) {
+    // Exibe o vencedor
+    if (resultado.conquista) {
         printf(">>> VITORIA DO ATACANTE! <<<\n");
-        printf("O territorio %s foi conquistado!\n", defensor->nome);
-        
-        // Conquista: muda a cor e transfere tropas
-        strcpy(defensor->cor, atacante->cor);
-        int tropasTransferidas = atacante->tropas / 2;
-        defensor->tropas = tropasTransferidas;
-        atacante->tropas -= tropasTransferidas;
-        
-        printf("Tropas transferidas: %d\n", tropasTransferidas);
-        printf("Tropas restantes no atacante: %d\n", atacante->tropas);
-        
+        printf("O territorio %s foi conquistado!\n", mapa->nomes[defensor]);
+        if (resultado.perdasAtacante > 0) {
+            printf("O atacante perdeu %d tropa(s) no combate.\n", resultado.perdasAtacante);
+        }
+        printf("Tropas transferidas: %d\n", resultado.tropasTransferidas);
+        printf("Tropas restantes no atacante: %d\n", resultado.tropasAtacante);
+    } else if (resultado.perdasDefensor > 0) {
+        printf(">>> COMBATE DIVIDIDO! <<<\n");
+        printf("O atacante perdeu %d tropa(s) e o defensor %d.\n",
+               resultado.perdasAtacante, resultado.perdasDefensor);
+        printf("Tropas restantes: atacante %d, defensor %d\n",
+               resultado.tropasAtacante, resultado.tropasDefensor);
     } else {
         printf(">>> VITORIA DO DEFENSOR! <<<\n");
         printf("O ataque foi repelido!\n");
-        
-        // Atacante perde uma tropa
-        atacante->tropas--;
-        printf("O atacante perdeu 1 tropa. Tropas restantes: %d\n", 
-               atacante->tropas);
+        printf("O atacante perdeu %d tropa(s). Tropas restantes: %d\n",
+               resultado.perdasAtacante, resultado.tropasAtacante);
     }
     
     printf("============================\n");
 }
 
-/*
- * Função: atribuirMissao
- * 
- * Sorteia uma missão aleatória do vetor de missões disponíveis
- * e a atribui ao jogador através de cópia de string.
- * 
- * Parâmetros:
- *   destino - ponteiro para onde a missão será copiada (passagem por referência)
- *   missoes - array de strings com as missões disponíveis (passagem por valor)
- *   totalMissoes - quantidade total de missões disponíveis
- */
-void atribuirMissao(char* destino, char* missoes[], int totalMissoes) {
-    // Sorteia um índice aleatório
-    int indiceSorteado = rand() % totalMissoes;
-    
-    // Copia a missão sorteada para o destino
-    strcpy(destino, missoes[indiceSorteado]);
-}
-
 /*
  * Função: exibirMissao
  * 
@@ -211,7 +292,7 @@ void atribuirMissao(char* destino, char* missoes[], int totalMissoes) {
  *   nomeJogador - nome do jogador
  *   missao - string contendo a missão (passagem por valor)
  */
-void exibirMissao(char nomeJogador[], char* missao) {
+void exibirMissao(char nomeJogador[], const char* missao) {
     printf("\n+--------------------------------------------------+\n");
     printf("| MISSAO ESTRATEGICA - %s\n", nomeJogador);
     printf("+--------------------------------------------------+\n");
@@ -220,111 +301,48 @@ void exibirMissao(char nomeJogador[], char* missao) {
 }
 
 /*
- * Função: contarTerritoriosPorCor
+ * Função: confirmar
  * 
- * Conta quantos territórios pertencem a uma determinada cor.
+ * Faz uma pergunta de sim/não ao usuário.
  * 
- * Parâmetros:
- *   mapa - ponteiro para o vetor de territórios
- *   tamanho - quantidade de territórios
- *   cor - cor a ser contada
- * 
- * Retorno: número de territórios da cor especificada
+ * Retorno: 1 se a resposta começar com 's' ou 'S', 0 caso contrário
  */
-int contarTerritoriosPorCor(Territorio* mapa, int tamanho, char* cor) {
-    int contador = 0;
-    for (int i = 0; i < tamanho; i++) {
-        if (strcmp((mapa + i)->cor, cor) == 0) {
-            contador++;
-        }
-    }
-    return contador;
-}
-
-/*
- * Função: verificarTerritoriosConsecutivos
- * 
- * Verifica se uma cor possui territórios cadastrados em sequência.
- * (Simplificação: verifica se há N territórios da mesma cor em posições adjacentes)
- * 
- * Parâmetros:
- *   mapa - ponteiro para o vetor de territórios
- *   tamanho - quantidade de territórios
- *   cor - cor a ser verificada
- *   quantidade - quantidade mínima de territórios consecutivos
- * 
- * Retorno: 1 se encontrou a sequência, 0 caso contrário
- */
-int verificarTerritoriosConsecutivos(Territorio* mapa, int tamanho, char* cor, int quantidade) {
-    int consecutivos = 0;
-    
-    for (int i = 0; i < tamanho; i++) {
-        if (strcmp((mapa + i)->cor, cor) == 0) {
-            consecutivos++;
-            if (consecutivos >= quantidade) {
-                return 1;
-            }
-        } else {
-            consecutivos = 0;
-        }
-    }
-    return 0;
+int confirmar(const char* pergunta) {
+    char resposta[8] = "";
+    printf("%s", pergunta);
+    scanf("%7s", resposta);
+    limparBuffer();
+    return resposta[0] == 's' || resposta[0] == 'S';
 }
 
 /*
- * Função: verificarMissao
+ * Função: exibirChances
  * 
- * Verifica se uma missão específica foi cumprida analisando o estado do mapa.
- * Implementa lógica simplificada para diferentes tipos de missões.
+ * Estima por Monte Carlo as chances de o atacante conquistar o defensor
+ * (atacando até vencer ou ficar sem tropas) e exibe o resultado.
  * 
  * Parâmetros:
- *   missao - string contendo a missão a ser verificada (passagem por referência para leitura)
- *   mapa - ponteiro para o vetor de territórios
- *   tamanho - quantidade de territórios
- *   corJogador - cor do jogador que está sendo verificado
- * 
- * Retorno: 1 se a missão foi cumprida, 0 caso contrário
+ *   mapa - mapa de territórios
+ *   regra - regra de batalha da partida
+ *   atacante - índice do território atacante
+ *   defensor - índice do território defensor
+ *   rng - gerador da partida (fornece a semente da estimativa)
+ *   pool - pool de threads da estimativa
  */
-int verificarMissao(char* missao, Territorio* mapa, int tamanho, char* corJogador) {
-    // Verifica diferentes tipos de missões usando strstr para buscar palavras-chave
-    
-    // Missão: Conquistar 3 territórios consecutivos
-    if (strstr(missao, "3 territorios consecutivos") != NULL) {
-        return verificarTerritoriosConsecutivos(mapa, tamanho, corJogador, 3);
-    }
-    
-    // Missão: Conquistar pelo menos 5 territórios
-    if (strstr(missao, "5 territorios") != NULL) {
-        int total = contarTerritoriosPorCor(mapa, tamanho, corJogador);
-        return (total >= 5) ? 1 : 0;
-    }
-    
-    // Missão: Dominar 50% do mapa
-    if (strstr(missao, "50% do mapa") != NULL) {
-        int total = contarTerritoriosPorCor(mapa, tamanho, corJogador);
-        return (total >= tamanho / 2) ? 1 : 0;
-    }
-    
-    // Missão: Eliminar todas as tropas de uma cor específica
-    if (strstr(missao, "Eliminar") != NULL) {
-        // Verifica se existe alguma cor completamente eliminada
-        // (lógica simplificada: verifica se o jogador conquistou todos os territórios)
-        int total = contarTerritoriosPorCor(mapa, tamanho, corJogador);
-        return (total == tamanho) ? 1 : 0;
-    }
-    
-    // Missão: Acumular 20 tropas em territórios controlados
-    if (strstr(missao, "20 tropas") != NULL) {
-        int totalTropas = 0;
-        for (int i = 0; i < tamanho; i++) {
-            if (strcmp((mapa + i)->cor, corJogador) == 0) {
-                totalTropas += (mapa + i)->tropas;
-            }
-        }
-        return (totalTropas >= 20) ? 1 : 0;
+void exibirChances(const Mapa* mapa, RegraBatalha regra, int atacante, int defensor,
+                   Aleatorio* rng, Pool* pool) {
+    Estimativa e;
+    if (!estimarConquista(regra, mapa->tropas[atacante], mapa->tropas[defensor],
+                          SIMULACOES_ESTIMATIVA, aleatorioProximo(rng), pool, &e)) {
+        return;
     }
     
-    return 0; // Missão não cumprida por padrão
+    printf("\n--- Chances estimadas (%lld batalhas simuladas) ---\n", e.simulacoes);
+    printf("Conquista atacando ate o fim: %.1f%% (IC 95%%: %.1f%% a %.1f%%)\n",
+           100.0 * e.probabilidade, 100.0 * e.limiteInferior, 100.0 * e.limiteSuperior);
+    printf("Tropas esperadas do atacante ao final: %.1f\n", e.tropasAtacante);
+    printf("Tropas esperadas do defensor ao final: %.1f\n", e.tropasDefensor);
+    printf("-----------------------------------------------\n");
 }
 
 /*
@@ -333,14 +351,28 @@ int verificarMissao(char* missao, Territorio* mapa, int tamanho, char* corJogado
  * Coordena o processo de ataque, com validações e execução da batalha.
  * 
  * Parâmetros:
- *   territorios - ponteiro para o vetor de territórios
- *   quantidade - número total de territórios
+ *   mapa - mapa de territórios
+ *   regra - regra de batalha da partida
+ *   rng - gerador de números aleatórios da partida
+ *   pool - pool de threads usado na estimativa das chances
+ *   saida - buffer de saída da partida
+ *   registro - registro de eventos da partida (NULL se desativado)
  */
-void realizarAtaque(Territorio* territorios, int quantidade) {
+void realizarAtaque(Mapa* mapa, RegraBatalha regra, Aleatorio* rng, Pool* pool, Saida* saida,
+                    Registro* registro) {
     int indiceAtacante, indiceDefensor;
+    int quantidade = mapa->quantidade;
     
     printf("\n=== INICIAR ATAQUE ===\n");
-    exibirTerritorios(territorios, quantidade);
+    // Mapas pequenos aparecem como tabela compacta; os grandes não são redesenhados
+    if (quantidade <= LIMITE_MAPA_COMPLETO) {
+        FiltroMapa filtro;
+        filtroPadrao(&filtro);
+        renderizarMapa(saida, mapa, &filtro, RENDER_TABELA);
+        saidaDescarregar(saida);
+    } else {
+        printf("Mapa com %d territorios: use a opcao 6 para consulta-lo.\n", quantidade);
+    }
     
     printf("\nEscolha o numero do territorio ATACANTE: ");
     scanf("%d", &indiceAtacante);
@@ -364,20 +396,198 @@ void realizarAtaque(Territorio* territorios, int quantidade) {
     indiceAtacante--;
     indiceDefensor--;
     
-    // Validações
-    if (indiceAtacante == indiceDefensor) {
-        printf("ERRO: Nao e possivel atacar o proprio territorio!\n");
-        return;
+    // Validações (as mesmas usadas pelo simulador em lote)
+    switch (validarAtaque(mapa, indiceAtacante, indiceDefensor)) {
+        case ATAQUE_MESMO_TERRITORIO:
+            printf("ERRO: Nao e possivel atacar o proprio territorio!\n");
+            return;
+        case ATAQUE_MESMA_COR:
+            printf("ERRO: Nao e possivel atacar um territorio da mesma cor!\n");
+            return;
+        case ATAQUE_NAO_ADJACENTE:
+            printf("ERRO: Os territorios nao fazem fronteira!\n");
+            return;
+        case ATAQUE_OK:
+            exibirChances(mapa, regra, indiceAtacante, indiceDefensor, rng, pool);
+            if (!confirmar("Confirmar ataque? (s/n): ")) {
+                printf("Ataque cancelado.\n");
+                return;
+            }
+            break;
+        default:
+            // Tropas insuficientes são informadas por atacar
+            break;
     }
     
-    if (strcmp((territorios + indiceAtacante)->cor, 
-               (territorios + indiceDefensor)->cor) == 0) {
-        printf("ERRO: Nao e possivel atacar um territorio da mesma cor!\n");
-        return;
+    // Executa o ataque
+    atacar(mapa, regra, indiceAtacante, indiceDefensor, rng, registro);
+}
+
+// Grava cada rolagem do turno no registro de eventos (contexto: o Registro)
+static void registrarRolagem(void* contexto, const Mapa* mapa, int atacante, int defensor,
+                             const ResultadoAtaque* resultado) {
+    CodigoRegistro codigo = registroAtaque((Registro*) contexto, mapa, atacante, defensor,
+                                           resultado);
+    if (codigo != REGISTRO_OK) {
+        printf("AVISO: Falha no registro de eventos: %s\n", registroMensagem(codigo));
     }
+}
+
+/*
+ * Função: realizarTurno
+ * 
+ * Lê todas as ordens de ataque de um jogador e as resolve de uma vez
+ * (turno.h), sem redesenhar o mapa entre elas. A cor do turno é a do
+ * atacante da primeira ordem; se alguma ordem for recusada, nenhuma é
+ * executada. O turno inteiro é uma única jogada do histórico, e as
+ * missões ficam para quem chama, uma vez só.
+ * 
+ * Parâmetros:
+ *   mapa - mapa de territórios
+ *   regra - regra de batalha da partida
+ *   rng - gerador de números aleatórios da partida
+ *   registro - registro de eventos da partida (NULL se desativado)
+ * 
+ * Retorno: quantidade de ordens executadas (0 se nenhuma)
+ */
+int realizarTurno(Mapa* mapa, RegraBatalha regra, Aleatorio* rng, Registro* registro) {
+    OrdemTurno ordens[MAX_ORDENS_TURNO];
+    int numOrdens = 0;
+    char linha[128];
     
-    // Executa o ataque
-    atacar(territorios + indiceAtacante, territorios + indiceDefensor);
+    printf("\n=== TURNO EM LOTE ===\n");
+    printf("Uma ordem por linha: <atacante> <defensor> [reserva]\n");
+    printf("  sem reserva: uma rolagem\n");
+    printf("  com reserva r: ataca ate conquistar ou restarem r tropas no atacante\n");
+    printf("  linha vazia ou 0 encerra a lista\n");
+    while (numOrdens < MAX_ORDENS_TURNO) {
+        printf("Ordem %d: ", numOrdens + 1);
+        int a, d, reserva;
+        if (fgets(linha, sizeof(linha), stdin) == NULL) {
+            break;
+        }
+        int lidos = sscanf(linha, "%d %d %d", &a, &d, &reserva);
+        if (lidos < 1 || a == 0) {
+            break;
+        }
+        if (lidos < 2) {
+            printf("Informe atacante e defensor.\n");
+            continue;
+        }
+        ordens[numOrdens].atacante = a - 1;
+        ordens[numOrdens].defensor = d - 1;
+        ordens[numOrdens].politica = (lidos == 3) ? POLITICA_ATE_CONQUISTAR : POLITICA_UMA_VEZ;
+        ordens[numOrdens].reserva = (lidos == 3) ? reserva : 1;
+        numOrdens++;
+    }
+    if (numOrdens == 0) {
+        printf("Nenhuma ordem.\n");
+        return 0;
+    }
+    
+    int primeiro = ordens[0].atacante;
+    if (primeiro < 0 || primeiro >= mapa->quantidade) {
+        printf("ERRO na ordem 1: %s\n", turnoMensagem(TURNO_INDICE_INVALIDO));
+        return 0;
+    }
+    IdCor cor = mapa->donos[primeiro];
+    int recusada;
+    CodigoTurno codigo = conferirTurno(mapa, cor, ordens, numOrdens, &recusada);
+    if (codigo != TURNO_OK) {
+        printf("ERRO na ordem %d: %s. Nenhum ataque foi feito.\n", recusada + 1,
+               turnoMensagem(codigo));
+        return 0;
+    }
+    
+    if (mapa->historico != NULL) {
+        historicoIniciarJogada(mapa->historico);
+    }
+    ResultadoOrdem resultados[MAX_ORDENS_TURNO];
+    int conquistas = executarTurno(mapa, regra, cor, ordens, numOrdens, rng, resultados,
+                                   (registro != NULL) ? registrarRolagem : NULL, registro);
+    
+    printf("\nTurno de %s: %d ordens, %d conquistas\n", mapaNomeCor(mapa, cor), numOrdens,
+           conquistas);
+    for (int i = 0; i < numOrdens; i++) {
+        const ResultadoOrdem* r = &resultados[i];
+        int a = ordens[i].atacante, d = ordens[i].defensor;
+        printf("%3d. [%d] %s -> [%d] %s: ", i + 1, a + 1, mapa->nomes[a], d + 1, mapa->nomes[d]);
+        if (r->rolagens == 0) {
+            printf("pulada\n");
+            continue;
+        }
+        printf("%d rolagem(ns), perdas %d x %d, %s; tropas %d x %d\n", r->rolagens,
+               r->perdasAtacante, r->perdasDefensor, r->conquista ? "CONQUISTADO" : "resistiu",
+               r->tropasAtacante, r->tropasDefensor);
+    }
+    return numOrdens;
+}
+
+/*
+ * Função: exibirAtaquesPossiveis
+ * 
+ * Lista os ataques permitidos no estado atual do mapa com a chance exata
+ * de conquista de cada um, consultada na tabela pré-calculada. Percorre
+ * apenas as fronteiras do grafo do mapa.
+ * 
+ * Parâmetros:
+ *   mapa - mapa de territórios
+ *   tabela - tabela exata de resultados de batalha
+ */
+void exibirAtaquesPossiveis(const Mapa* mapa, const TabelaBatalha* tabela) {
+    const Grafo* grafo = mapa->grafo;
+    long long listados = 0, total = 0;
+    
+    // No grafo completo cada atacante enfrenta todos os inimigos: o total sai das contagens
+    if (grafo->completo) {
+        for (int i = 0; i < mapa->quantidade; i++) {
+            if (mapa->tropas[i] >= 2) {
+                total += mapa->quantidade - contarTerritoriosDaCor(mapa, mapa->donos[i]);
+            }
+        }
+    }
+    
+    printf("\n=== ATAQUES POSSIVEIS (chance exata de conquista) ===\n");
+    for (int i = 0; i < mapa->quantidade; i++) {
+        if (grafo->completo && listados >= MAX_ATAQUES_LISTADOS) {
+            break;
+        }
+        // Só os vizinhos de i podem ser atacados
+        int grau = grafoGrau(grafo, i);
+        for (int k = 0; k < grau; k++) {
+            int j = grafoVizinho(grafo, i, k);
+            if (validarAtaque(mapa, i, j) != ATAQUE_OK) {
+                continue;
+            }
+            if (!grafo->completo) {
+                total++;
+            }
+            if (listados >= MAX_ATAQUES_LISTADOS) {
+                if (grafo->completo) {
+                    break;
+                }
+                continue;
+            }
+            listados++;
+            
+            const ResultadoExato* r = tabelaConsultar(tabela, mapa->tropas[i], mapa->tropas[j]);
+            printf("[%d] %s (%s) -> [%d] %s (%s): ", i + 1, mapa->nomes[i],
+                   mapaNomeCor(mapa, mapa->donos[i]), j + 1, mapa->nomes[j],
+                   mapaNomeCor(mapa, mapa->donos[j]));
+            if (r != NULL) {
+                printf("%.1f%%, tropas finais esperadas %.1f\n",
+                       100.0 * r->probConquista, r->tropasAtacante);
+            } else {
+                printf("fora do limite da tabela\n");
+            }
+        }
+    }
+    
+    if (total == 0) {
+        printf("Nenhum ataque possivel no momento.\n");
+    } else if (total > listados) {
+        printf("... e mais %lld ataques possiveis.\n", total - listados);
+    }
 }
 
 /*
@@ -388,140 +598,424 @@ void realizarAtaque(Territorio* territorios, int quantidade) {
  * Parâmetros:
  *   jogadores - array de jogadores
  *   numJogadores - quantidade de jogadores
- *   mapa - ponteiro para o vetor de territórios
- *   tamanhoMapa - quantidade de territórios
+ *   mapa - mapa de territórios
  * 
  * Retorno: 1 se algum jogador venceu, 0 caso contrário
  */
-int verificarVitoria(Jogador* jogadores, int numJogadores, Territorio* mapa, int tamanhoMapa) {
+int verificarVitoria(Jogador* jogadores, int numJogadores, const Mapa* mapa) {
+    PERFIL_ESCOPO(PERFIL_VERIFICAR_VITORIA);
+    int i = jogadorVencedor(jogadores, numJogadores, mapa);
+    if (i >= 0) {
+        printf("\n");
+        printf("*************************************************\n");
+        printf("*                                               *\n");
+        printf("*          >>> TEMOS UM VENCEDOR! <<<          *\n");
+        printf("*                                               *\n");
+        printf("*************************************************\n");
+        printf("\n");
+        printf("Jogador: %s (%s)\n", jogadores[i].nome, jogadores[i].cor);
+        printf("Missao cumprida: %s\n", jogadores[i].missao->texto);
+        printf("\n");
+        printf("*************************************************\n");
+        return 1;
+    }
+    return 0;
+}
+
+/*
+ * Função: jogarComputadores
+ * 
+ * Cada jogador do computador ainda no mapa escolhe um ataque pela busca
+ * da IA (ou decide não atacar) e o executa.
+ * 
+ * Parâmetros:
+ *   mapa - mapa de territórios
+ *   jogadores - array de jogadores
+ *   numJogadores - quantidade de jogadores
+ *   regra - regra de batalha da partida
+ *   ia - estado da busca
+ *   orcamentoMs - tempo de busca por jogada
+ *   rng - gerador da partida
+ *   registro - registro de eventos da partida (NULL se desativado)
+ * 
+ * Retorno: 1 se algum jogador venceu, 0 caso contrário
+ */
+int jogarComputadores(Mapa* mapa, Jogador* jogadores, int numJogadores, RegraBatalha regra,
+                      IA* ia, int orcamentoMs, Aleatorio* rng, Registro* registro) {
+    int algum = 0;
+    
     for (int i = 0; i < numJogadores; i++) {
-        if (verificarMissao(jogadores[i].missao, mapa, tamanhoMapa, jogadores[i].cor)) {
-            printf("\n");
-            printf("*************************************************\n");
-            printf("*                                               *\n");
-            printf("*          >>> TEMOS UM VENCEDOR! <<<          *\n");
-            printf("*                                               *\n");
-            printf("*************************************************\n");
-            printf("\n");
-            printf("Jogador: %s (%s)\n", jogadores[i].nome, jogadores[i].cor);
-            printf("Missao cumprida: %s\n", jogadores[i].missao);
-            printf("\n");
-            printf("*************************************************\n");
+        Jogador* jogador = &jogadores[i];
+        if (!jogador->bot) {
+            continue;
+        }
+        algum = 1;
+        if (contarTerritoriosDaCor(mapa, jogador->idCor) == 0) {
+            printf("\n%s (%s) nao tem mais territorios.\n", jogador->nome, jogador->cor);
+            continue;
+        }
+        
+        JogadaIA jogada;
+        if (!iaEscolherAtaque(ia, mapa, jogador->missao, jogador->idCor, regra, orcamentoMs,
+                              &jogada)) {
+            printf("ERRO: Falha na alocacao de memoria para a busca!\n");
+            return 0;
+        }
+        printf("\n>>> %s (%s) pensou %.0f ms (profundidade %d, %lld posicoes, valor %.3f)\n",
+               jogador->nome, jogador->cor, jogada.segundos * 1000.0, jogada.profundidade,
+               jogada.nos, jogada.valor);
+        if (jogada.atacante < 0) {
+            printf("%s decide nao atacar.\n", jogador->nome);
+            continue;
+        }
+        printf("%s ataca [%d] %s -> [%d] %s\n", jogador->nome,
+               jogada.atacante + 1, mapa->nomes[jogada.atacante],
+               jogada.defensor + 1, mapa->nomes[jogada.defensor]);
+        atacar(mapa, regra, jogada.atacante, jogada.defensor, rng, registro);
+        assert(estatisticasConferir(mapa->estatisticas, mapa));
+        if (verificarVitoria(jogadores, numJogadores, mapa)) {
             return 1;
         }
     }
+    
+    if (!algum) {
+        printf("\nNenhum jogador e controlado pelo computador.\n");
+    }
     return 0;
 }
 
 /*
- * Função: liberarMemoria
+ * Função: fronteiraMaisForte
  * 
- * Libera toda a memória alocada dinamicamente no programa.
- * Essencial para evitar vazamento de memória.
+ * Retorno: território da cor com mais tropas que faz fronteira com um
+ *          inimigo, o primeiro da cor se nenhum fizer, ou -1 se a cor
+ *          não tiver territórios
+ */
+int fronteiraMaisForte(const Mapa* mapa, IdCor cor) {
+    const Grafo* grafo = mapa->grafo;
+    int melhor = -1, primeiro = -1;
+    for (int i = 0; i < mapa->quantidade; i++) {
+        if (mapa->donos[i] != cor) {
+            continue;
+        }
+        if (primeiro < 0) {
+            primeiro = i;
+        }
+        if (melhor >= 0 && mapa->tropas[i] <= mapa->tropas[melhor]) {
+            continue;
+        }
+        if (grafo->completo) {
+            // Todos fazem fronteira com todos: basta existir um inimigo
+            if (contarTerritoriosDaCor(mapa, cor) < mapa->quantidade) {
+                melhor = i;
+            }
+            continue;
+        }
+        for (int32_t k = grafo->inicio[i]; k < grafo->inicio[i + 1]; k++) {
+            if (mapa->donos[grafo->vizinhos[k]] != cor) {
+                melhor = i;
+                break;
+            }
+        }
+    }
+    return (melhor >= 0) ? melhor : primeiro;
+}
+
+/*
+ * Função: reforcarJogador
+ * 
+ * Fase de reforço de um jogador: mostra de onde vêm as tropas novas
+ * (territórios e continentes inteiros) e as distribui. O jogador humano
+ * escolhe os territórios; o computador põe tudo no território de
+ * fronteira com mais tropas.
+ * 
+ * Parâmetros:
+ *   mapa - mapa de territórios
+ *   jogador - jogador que recebe o reforço
+ */
+void reforcarJogador(Mapa* mapa, const Jogador* jogador) {
+    IdCor cor = jogador->idCor;
+    int restantes = reforcoDaCor(mapa, cor);
+    if (restantes == 0) {
+        printf("\n%s (%s) nao tem mais territorios.\n", jogador->nome, jogador->cor);
+        return;
+    }
+    
+    printf("\n--- Reforco de %s (%s): %d tropas ---\n", jogador->nome, jogador->cor, restantes);
+    printf("Territorios: %d\n", contarTerritoriosDaCor(mapa, cor));
+    const Continentes* cont = mapa->continentes;
+    for (int c = 0; cont != NULL && c < cont->numContinentes; c++) {
+        if (cont->dono[c] == cor) {
+            printf("Continente %s: +%d\n", cont->lista[c].nome, cont->lista[c].bonus);
+        }
+    }
+    
+    while (restantes > 0) {
+        int destino = -1;
+        int quantidade = restantes;
+        if (!jogador->bot) {
+            destino = lerInteiro("Territorio a reforcar (vazio: fronteira mais forte): ", 0) - 1;
+            if (destino >= 0 && (destino >= mapa->quantidade || mapa->donos[destino] != cor)) {
+                printf("ERRO: Escolha um territorio do seu exercito!\n");
+                continue;
+            }
+            if (destino >= 0) {
+                printf("Tropas (1 a %d) [%d]: ", restantes, restantes);
+                quantidade = lerInteiro("", restantes);
+                if (quantidade < 1 || quantidade > restantes) {
+                    quantidade = restantes;
+                }
+            }
+        }
+        if (destino < 0) {
+            destino = fronteiraMaisForte(mapa, cor);
+        }
+        mapaDefinirTropas(mapa, destino, mapa->tropas[destino] + quantidade);
+        restantes -= quantidade;
+        printf("%d tropas em [%d] %s (agora %d).\n", quantidade, destino + 1,
+               mapa->nomes[destino], mapa->tropas[destino]);
+    }
+}
+
+/*
+ * Função: iniciarTurno
+ * 
+ * Fase de reforço do início do turno: cada jogador ainda no mapa recebe
+ * max(REFORCO_MINIMO, territórios / TERRITORIOS_POR_REFORCO) tropas mais
+ * o bônus dos continentes que ocupa inteiros. O reforço de cada jogador
+ * é uma jogada do histórico e entra no registro de eventos como
+ * restauração dos territórios reforçados, para que o replay acompanhe.
  * 
  * Parâmetros:
- *   mapa - ponteiro para o vetor de territórios
+ *   mapa - mapa de territórios
  *   jogadores - array de jogadores
  *   numJogadores - quantidade de jogadores
+ *   turno - número do turno que começa
+ *   registro - registro de eventos da partida (NULL se desativado)
+ * 
+ * Retorno: 1 se algum jogador venceu com o reforço, 0 caso contrário
  */
-void liberarMemoria(Territorio* mapa, Jogador* jogadores, int numJogadores) {
-    // Libera a memória das missões de cada jogador
+int iniciarTurno(Mapa* mapa, Jogador* jogadores, int numJogadores, int turno,
+                 Registro* registro) {
+    printf("\n=== TURNO %d: REFORCOS ===\n", turno);
     for (int i = 0; i < numJogadores; i++) {
-        if (jogadores[i].missao != NULL) {
-            free(jogadores[i].missao);
+        long long versao = historicoVersao(mapa->historico);
+        historicoIniciarJogada(mapa->historico);
+        reforcarJogador(mapa, &jogadores[i]);
+        
+        if (registro != NULL) {
+            const int32_t* alterados;
+            long quantidade = historicoAlteradosDesde(mapa->historico, versao, &alterados);
+            CodigoRegistro codigo = (quantidade >= 0)
+                ? registroRestauracao(registro, mapa, alterados, quantidade) : REGISTRO_ERRO_MEMORIA;
+            if (codigo != REGISTRO_OK) {
+                printf("AVISO: Falha no registro de eventos: %s\n", registroMensagem(codigo));
+            }
         }
     }
+    assert(estatisticasConferir(mapa->estatisticas, mapa));
+    assert(mapa->continentes == NULL || continentesConferir(mapa->continentes, mapa));
+    return verificarVitoria(jogadores, numJogadores, mapa);
+}
+
+/*
+ * Função: exibirMenu
+ * 
+ * Desenha o menu principal com uma única escrita.
+ * 
+ * Parâmetros:
+ *   saida - buffer de saída da partida
+ *   simulando - 1 durante uma simulação "e se?" (mostra um aviso)
+ */
+void exibirMenu(Saida* saida, int simulando) {
+    static const char MENU[] =
+        "\n====================================\n"
+        "           MENU PRINCIPAL\n"
+        "====================================\n"
+        "1 - Exibir mapa de territorios\n"
+        "2 - Exibir missoes dos jogadores\n"
+        "3 - Realizar ataque\n"
+        "4 - Verificar status das missoes\n"
+        "5 - Salvar partida\n"
+        "6 - Consultar mapa (filtros e paginas)\n"
+        "7 - Jogada dos computadores\n"
+        "8 - Desfazer ultima jogada\n"
+        "9 - Refazer jogada desfeita\n"
+        "10 - Simulacao (e se?): entrar/sair\n"
+        "11 - Perfil de desempenho\n"
+        "12 - Novo turno (reforcos)\n"
+        "13 - Turno em lote (varios ataques)\n"
+        "0 - Sair do jogo\n"
+        "====================================\n";
+    static const char SIMULACAO[] =
+        "** SIMULACAO: nada sera registrado; a opcao 10 volta ao jogo real **\n";
+    static const char PERGUNTA[] = "Escolha uma opcao: ";
+    saidaTexto(saida, MENU, sizeof(MENU) - 1);
+    if (simulando) {
+        saidaTexto(saida, SIMULACAO, sizeof(SIMULACAO) - 1);
+    }
+    saidaTexto(saida, PERGUNTA, sizeof(PERGUNTA) - 1);
+    saidaDescarregar(saida);
+}
+
+/*
+ * Função: voltarJogada
+ * 
+ * Desfaz a última jogada (um ataque, um turno em lote ou o reforço de um
+ * jogador) ou refaz a última jogada desfeita, pelo histórico do mapa. Os
+ * territórios restaurados entram no registro de eventos, para que o
+ * replay acompanhe a partida.
+ * 
+ * Parâmetros:
+ *   mapa - mapa com histórico anexado
+ *   refazer - 1 para refazer, 0 para desfazer
+ *   minimo - jogadas que não podem ser desfeitas (início da simulação)
+ *   registro - registro de eventos da partida (NULL se desativado)
+ */
+void voltarJogada(Mapa* mapa, int refazer, int minimo, Registro* registro) {
+    Historico* hist = mapa->historico;
+    long long versao = historicoVersao(hist);
+    int feito;
+    if (refazer) {
+        feito = historicoRefazer(hist, mapa);
+    } else {
+        feito = historicoJogadas(hist) > minimo && historicoDesfazer(hist, mapa);
+    }
+    if (!feito) {
+        printf("\nNao ha jogada para %s.\n", refazer ? "refazer" : "desfazer");
+        return;
+    }
     
-    // Libera o array de jogadores
-    if (jogadores != NULL) {
-        free(jogadores);
+    const int32_t* alterados;
+    long quantidade = historicoAlteradosDesde(hist, versao, &alterados);
+    printf("\nJogada %s: %ld alteracoes em territorios.\n",
+           refazer ? "refeita" : "desfeita", quantidade);
+    if (registro != NULL) {
+        CodigoRegistro codigo = (quantidade >= 0)
+            ? registroRestauracao(registro, mapa, alterados, quantidade) : REGISTRO_ERRO_MEMORIA;
+        if (codigo != REGISTRO_OK) {
+            printf("AVISO: Falha no registro de eventos: %s\n", registroMensagem(codigo));
+        }
     }
+}
+
+/*
+ * Função: salvarPartida
+ * 
+ * Pergunta o nome do arquivo e grava o snapshot da partida, que pode ser
+ * retomada depois com --carregar.
+ * 
+ * Parâmetros:
+ *   mapa - mapa de territórios
+ *   jogadores - array de jogadores
+ *   numJogadores - quantidade de jogadores
+ */
+void salvarPartida(const Mapa* mapa, const Jogador* jogadores, int numJogadores) {
+    char caminho[256];
     
-    // Libera o mapa de territórios
-    if (mapa != NULL) {
-        free(mapa);
+    printf("Arquivo de destino: ");
+    if (scanf("%255s", caminho) != 1) {
+        return;
     }
+    limparBuffer();
     
-    printf("\nMemoria liberada com sucesso!\n");
+    CodigoSnapshot codigo = snapshotSalvar(caminho, mapa, jogadores, numJogadores);
+    if (codigo == SNAPSHOT_OK) {
+        printf("Partida salva em %s (use --carregar %s para continuar).\n", caminho, caminho);
+    } else {
+        printf("ERRO: %s: %s\n", caminho, snapshotMensagem(codigo));
+    }
 }
 
 /*
- * Função: main
+ * Função: liberarMemoria
  * 
- * Função principal que coordena todo o fluxo do jogo War.
- * Implementa:
- * - Inicialização do sistema
- * - Cadastro de jogadores e territórios
- * - Atribuição de missões
- * - Loop principal do jogo
- * - Verificação de vitória
- * - Liberação de memória
+ * Libera toda a memória alocada dinamicamente no programa.
+ * Essencial para evitar vazamento de memória.
  * 
- * Retorno: 0 indica execução bem-sucedida
+ * Parâmetros:
+ *   mapa - mapa de territórios
+ *   arena - arena da partida (jogadores, missões e territórios cadastrados),
+ *           devolvida de uma vez
  */
-int main() {
-    // Inicializa o gerador de números aleatórios
-    srand(time(NULL));
-    
-    int numTerritorios, numJogadores;
-    Territorio* territorios = NULL;
-    Jogador* jogadores = NULL;
+void liberarMemoria(Mapa* mapa, Arena* arena) {
+    // Libera os vetores do mapa de territórios (os da arena ficam para ela)
+    if (mapa != NULL) {
+        mapaLiberar(mapa);
+    }
     
-    // Vetor de missões pré-definidas
-    char* missoes[MAX_MISSOES] = {
-        "Conquistar 3 territorios consecutivos no mapa",
-        "Conquistar pelo menos 5 territorios de qualquer posicao",
-        "Dominar 50% do mapa (metade dos territorios)",
-        "Eliminar todas as tropas de pelo menos uma cor inimiga",
-        "Acumular 20 tropas ou mais em seus territorios controlados"
-    };
+    // Jogadores e missões não são liberados um a um: saem com a arena
+    arenaLiberar(arena);
     
-    printf("====================================\n");
-    printf("   BEM-VINDO AO JOGO WAR - v3.0\n");
-    printf("     EDICAO MISSOES ESTRATEGICAS\n");
-    printf("====================================\n\n");
+    printf("\nMemoria liberada com sucesso!\n");
+}
+
+/*
+ * Função: cadastrarPartida
+ * 
+ * Cadastro interativo de uma partida nova: jogadores (com a missão
+ * sorteada de cada um) e territórios.
+ * 
+ * Parâmetros:
+ *   mapa - mapa iniciado e vazio
+ *   arena - arena da partida, de onde saem jogadores e territórios
+ *   jogadores - recebe o vetor de jogadores alocado
+ *   numJogadores - recebe a quantidade de jogadores já alocados
+ *   missoes - missões disponíveis para o sorteio (os jogadores apontam
+ *             para elas, então devem durar a partida inteira)
+ *   totalMissoes - quantidade de missões disponíveis
+ *   rng - gerador da partida
+ * 
+ * Retorno: 1 em caso de sucesso, 0 em caso de erro (o que já foi alocado
+ *          deve ser liberado com liberarMemoria)
+ */
+int cadastrarPartida(Mapa* mapa, Arena* arena, Jogador** jogadores, int* numJogadores,
+                     const Missao* missoes, int totalMissoes, Aleatorio* rng) {
+    int numTerritorios;
     
     // Cadastro de jogadores
     printf("Digite o numero de jogadores: ");
-    scanf("%d", &numJogadores);
+    scanf("%d", numJogadores);
     limparBuffer();
     
-    if (numJogadores <= 0) {
+    if (*numJogadores <= 0) {
         printf("Numero de jogadores invalido!\n");
-        return 1;
+        return 0;
     }
     
     // Aloca memória para os jogadores
-    jogadores = (Jogador*) malloc(numJogadores * sizeof(Jogador));
-    if (jogadores == NULL) {
+    *jogadores = (Jogador*) arenaAlocar(arena, *numJogadores * sizeof(Jogador));
+    if (*jogadores == NULL) {
         printf("ERRO: Falha na alocacao de memoria para jogadores!\n");
-        return 1;
+        return 0;
     }
     
     // Cadastra cada jogador
-    for (int i = 0; i < numJogadores; i++) {
+    for (int i = 0; i < *numJogadores; i++) {
+        Jogador* jogador = &(*jogadores)[i];
         printf("\n--- Jogador %d ---\n", i + 1);
         printf("Nome: ");
-        scanf("%29s", jogadores[i].nome);
+        scanf("%29s", jogador->nome);
         limparBuffer();
         
         printf("Cor do exercito: ");
-        scanf("%9s", jogadores[i].cor);
+        scanf("%9s", jogador->cor);
         limparBuffer();
         
-        // Aloca memória para a missão do jogador
-        jogadores[i].missao = (char*) malloc(TAM_MISSAO * sizeof(char));
-        if (jogadores[i].missao == NULL) {
-            printf("ERRO: Falha na alocacao de memoria para missao!\n");
-            liberarMemoria(NULL, jogadores, i);
-            return 1;
+        jogador->bot = confirmar("Controlado pelo computador? (s/n): ");
+        
+        jogador->idCor = mapaInternarCor(mapa, jogador->cor);
+        if (jogador->idCor == COR_INVALIDA) {
+            printf("ERRO: Limite de %d cores atingido!\n", MAX_CORES);
+            *numJogadores = i;
+            return 0;
         }
         
-        // Atribui uma missão aleatória
-        atribuirMissao(jogadores[i].missao, missoes, MAX_MISSOES);
+        // Atribui uma missão aleatória (aponta para a tabela, sem cópia)
+        jogador->missao = sortearMissao(missoes, totalMissoes, rng);
         
         // Exibe a missão do jogador
-        exibirMissao(jogadores[i].nome, jogadores[i].missao);
+        exibirMissao(jogador->nome, jogador->missao->texto);
     }
     
     // Cadastro de territórios
@@ -531,74 +1025,417 @@ int main() {
     
     if (numTerritorios <= 0) {
         printf("Numero de territorios invalido!\n");
-        liberarMemoria(NULL, jogadores, numJogadores);
-        return 1;
+        return 0;
     }
     
-    // Aloca memória para os territórios
-    territorios = (Territorio*) calloc(numTerritorios, sizeof(Territorio));
-    if (territorios == NULL) {
+    // Aloca memória para os territórios (na mesma arena dos jogadores)
+    if (!mapaReservarEm(mapa, arena, numTerritorios)) {
         printf("ERRO: Falha na alocacao de memoria para territorios!\n");
-        liberarMemoria(NULL, jogadores, numJogadores);
-        return 1;
+        return 0;
     }
     
     printf("Memoria alocada com sucesso!\n");
     
     // Cadastra os territórios
-    cadastrarTerritorios(territorios, numTerritorios);
+    if (!cadastrarTerritorios(mapa, numTerritorios)) {
+        printf("ERRO: Falha na alocacao de memoria para territorios!\n");
+        return 0;
+    }
+    
+    return 1;
+}
+
+/*
+ * Função: main
+ * 
+ * Função principal que coordena todo o fluxo do jogo War.
+ * Implementa:
+ * - Inicialização do sistema
+ * - Cadastro de jogadores e territórios (ou carga de uma partida salva)
+ * - Atribuição de missões
+ * - Loop principal do jogo
+ * - Verificação de vitória
+ * - Liberação de memória
+ * 
+ * Parâmetros:
+ *   --semente N - fixa a semente do gerador para repetir uma partida
+ *   --tabela ARQ - carrega a tabela exata de batalhas de ARQ (ou a
+ *                  calcula e grava nele, se ainda não existir)
+ *   --missoes ARQ - lê as missões do arquivo de dados ARQ (ver missao.h)
+ *   --carregar ARQ - continua a partida salva no snapshot ARQ (ver snapshot.h)
+ *   --cenario ARQ - lê jogadores e territórios do cenário ARQ, ou da
+ *                   entrada padrão se ARQ for "-" (ver cenario.h)
+ *   --tempo-ia MS - tempo de busca de cada jogada do computador (padrão 50 ms)
+ *   --regra R - regra de batalha: "simples" (um dado de cada lado, padrão)
+ *               ou "classica" (até 3 dados de cada lado, ver batalha.h)
+ *   --registro ARQ - grava cada ataque no registro de eventos ARQ, que não
+ *                    pode existir ainda (ver registro.h e ferramentas/replay.c)
+ *   --stats FORMATO - ao sair, escreve o perfil de desempenho na saída de
+ *                     erros como "texto" (histogramas) ou "json" (ver perfil.h)
+ * 
+ * As opções 8 e 9 do menu desfazem e refazem ataques, e a opção 10 abre
+ * uma simulação "e se?": os ataques seguintes não são registrados e são
+ * todos desfeitos ao sair dela (ver historico.h). A opção 12 começa um
+ * turno novo, com o reforço de cada jogador (ver continente.h).
+ * 
+ * Retorno: 0 indica execução bem-sucedida
+ */
+int main(int argc, char* argv[]) {
+    // Inicializa o gerador de números aleatórios
+    uint64_t semente = aleatorioSementeSistema();
+    const char* arquivoTabela = NULL;
+    const char* arquivoMissoes = NULL;
+    const char* arquivoPartida = NULL;
+    const char* arquivoCenario = NULL;
+    const char* arquivoRegistro = NULL;
+    int orcamentoIA = ORCAMENTO_IA_PADRAO;
+    RegraBatalha regra = REGRA_SIMPLES;
+    const char* formatoPerfil = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--semente") == 0 && i + 1 < argc) {
+            semente = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--tabela") == 0 && i + 1 < argc) {
+            arquivoTabela = argv[++i];
+        } else if (strcmp(argv[i], "--missoes") == 0 && i + 1 < argc) {
+            arquivoMissoes = argv[++i];
+        } else if (strcmp(argv[i], "--carregar") == 0 && i + 1 < argc) {
+            arquivoPartida = argv[++i];
+        } else if (strcmp(argv[i], "--cenario") == 0 && i + 1 < argc) {
+            arquivoCenario = argv[++i];
+        } else if (strcmp(argv[i], "--tempo-ia") == 0 && i + 1 < argc) {
+            orcamentoIA = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--regra") == 0 && i + 1 < argc) {
+            if (!regraPorNome(argv[++i], &regra)) {
+                printf("ERRO: --regra aceita \"simples\" ou \"classica\".\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--registro") == 0 && i + 1 < argc) {
+            arquivoRegistro = argv[++i];
+        } else if (strcmp(argv[i], "--stats") == 0 && i + 1 < argc) {
+            formatoPerfil = argv[++i];
+            if (strcmp(formatoPerfil, "texto") != 0 && strcmp(formatoPerfil, "json") != 0) {
+                printf("ERRO: --stats aceita \"texto\" ou \"json\".\n");
+                return 1;
+            }
+        }
+    }
+    Aleatorio rng;
+    aleatorioSemear(&rng, semente);
+    
+    int numJogadores = 0;
+    Mapa mapa;
+    Arena arena;
+    Jogador* jogadores = NULL;
+    
+    // Vetor de missões: as pré-definidas ou as do arquivo de dados
+    Missao missoes[MAX_MISSOES];
+    int totalMissoes = NUM_MISSOES_PADRAO;
+    memcpy(missoes, MISSOES_PADRAO, sizeof(Missao) * NUM_MISSOES_PADRAO);
+    if (arquivoMissoes != NULL) {
+        totalMissoes = carregarMissoes(arquivoMissoes, missoes, MAX_MISSOES, stdout);
+        if (totalMissoes <= 0) {
+            printf("ERRO: Arquivo de missoes invalido!\n");
+            return 1;
+        }
+    }
+    
+    // Arena da partida: toda a memória dos jogadores sai daqui
+    if (!arenaIniciar(&arena, ARENA_PARTIDA_INICIAL)) {
+        printf("ERRO: Falha na alocacao de memoria!\n");
+        return 1;
+    }
+    
+    printf("====================================\n");
+    printf("   BEM-VINDO AO JOGO WAR - v3.0\n");
+    printf("     EDICAO MISSOES ESTRATEGICAS\n");
+    printf("====================================\n\n");
+    
+    if (arquivoPartida != NULL) {
+        // Partida salva: o mapa passa a usar as páginas do snapshot
+        CodigoSnapshot codigo = snapshotCarregar(arquivoPartida, &mapa, &arena,
+                                                 &jogadores, &numJogadores);
+        if (codigo != SNAPSHOT_OK) {
+            printf("ERRO: %s: %s\n", arquivoPartida, snapshotMensagem(codigo));
+            arenaLiberar(&arena);
+            return 1;
+        }
+        printf("Partida carregada de %s: %d jogadores, %d territorios.\n",
+               arquivoPartida, numJogadores, mapa.quantidade);
+    } else if (arquivoCenario != NULL) {
+        if (!mapaIniciar(&mapa, 0)) {
+            printf("ERRO: Falha na alocacao de memoria para o mapa!\n");
+            arenaLiberar(&arena);
+            return 1;
+        }
+        if (!cenarioCarregar(arquivoCenario, &mapa, &arena, &jogadores, &numJogadores, stdout) ||
+            numJogadores == 0 || mapa.quantidade == 0) {
+            printf("ERRO: Cenario invalido (precisa de jogadores e territorios)!\n");
+            liberarMemoria(&mapa, &arena);
+            return 1;
+        }
+        // Jogadores sem missão no cenário recebem uma sorteada
+        for (int i = 0; i < numJogadores; i++) {
+            if (jogadores[i].missao == NULL) {
+                jogadores[i].missao = sortearMissao(missoes, totalMissoes, &rng);
+            }
+            exibirMissao(jogadores[i].nome, jogadores[i].missao->texto);
+        }
+        printf("Cenario %s carregado: %d jogadores, %d territorios.\n",
+               arquivoCenario, numJogadores, mapa.quantidade);
+    } else {
+        // O mapa começa vazio: as cores dos jogadores são internadas primeiro
+        if (!mapaIniciar(&mapa, 0)) {
+            printf("ERRO: Falha na alocacao de memoria para o mapa!\n");
+            arenaLiberar(&arena);
+            return 1;
+        }
+        if (!cadastrarPartida(&mapa, &arena, &jogadores, &numJogadores, missoes, totalMissoes, &rng)) {
+            liberarMemoria(&mapa, &arena);
+            return 1;
+        }
+    }
+    
+    // Fronteiras: sem um grafo carregado, todos os territórios fazem fronteira
+    // entre si; a missão de consecutivos continua contando pela ordem do mapa
+    if (mapa.grafo == NULL) {
+        Grafo* grafo = (Grafo*) malloc(sizeof(Grafo));
+        int ok = grafo != NULL && grafoCriarCompleto(grafo, mapa.quantidade);
+        if (!ok || !mapaDefinirGrafo(&mapa, grafo)) {
+            printf("ERRO: Falha na alocacao de memoria para o grafo do mapa!\n");
+            if (ok) {
+                grafoLiberar(grafo);
+            }
+            free(grafo);
+            liberarMemoria(&mapa, &arena);
+            return 1;
+        }
+    }
+    if (!mapaAtivarPosse(&mapa)) {
+        printf("ERRO: Falha na alocacao de memoria para o grafo do mapa!\n");
+        liberarMemoria(&mapa, &arena);
+        return 1;
+    }
+    
+    // Estatísticas por cor mantidas a cada ataque (evita varrer o mapa)
+    mapa.estatisticas = estatisticasCriar(&mapa);
+    if (mapa.estatisticas == NULL) {
+        printf("ERRO: Falha na alocacao de memoria para as estatisticas!\n");
+        liberarMemoria(&mapa, &arena);
+        return 1;
+    }
+    
+    // Histórico para desfazer, refazer e simular (custa só os territórios alterados)
+    mapa.historico = historicoCriar();
+    if (mapa.historico == NULL) {
+        printf("ERRO: Falha na alocacao de memoria para o historico!\n");
+        liberarMemoria(&mapa, &arena);
+        return 1;
+    }
+    
+    // Tabela exata de batalhas: carregada do disco ou calculada uma vez
+    TabelaBatalha tabela = {-1, REGRA_SIMPLES, NULL};
+    if (arquivoTabela == NULL || !tabelaCarregar(&tabela, arquivoTabela) ||
+        tabela.limite < LIMITE_TABELA || tabela.regra != regra) {
+        if (!tabelaCalcular(&tabela, LIMITE_TABELA, regra)) {
+            printf("ERRO: Falha na alocacao de memoria para a tabela de batalhas!\n");
+            liberarMemoria(&mapa, &arena);
+            return 1;
+        }
+        if (arquivoTabela != NULL && !tabelaSalvar(&tabela, arquivoTabela)) {
+            printf("AVISO: Nao foi possivel gravar a tabela em %s\n", arquivoTabela);
+        }
+    }
+    
+    // Pool de threads para as estimativas de Monte Carlo
+    Pool* pool = poolCriar(0);
+    if (pool == NULL) {
+        printf("ERRO: Falha ao criar o pool de threads!\n");
+        tabelaLiberar(&tabela);
+        liberarMemoria(&mapa, &arena);
+        return 1;
+    }
+    
+    // Busca dos jogadores do computador (usa o mesmo pool)
+    IA* ia = iaCriar(pool, ENTRADAS_TRANSPOSICAO);
+    if (ia == NULL) {
+        printf("ERRO: Falha na alocacao de memoria para os jogadores do computador!\n");
+        poolDestruir(pool);
+        tabelaLiberar(&tabela);
+        liberarMemoria(&mapa, &arena);
+        return 1;
+    }
+    
+    // Registro de eventos: checkpoint do estado inicial e um evento por ataque
+    Registro* registro = NULL;
+    if (arquivoRegistro != NULL) {
+        CodigoRegistro codigo = registroCriar(&registro, arquivoRegistro, INTERVALO_CHECKPOINT_PADRAO,
+                                              regra, &mapa, jogadores, numJogadores);
+        if (codigo != REGISTRO_OK) {
+            printf("ERRO: %s: %s\n", arquivoRegistro, registroMensagem(codigo));
+            iaDestruir(ia);
+            poolDestruir(pool);
+            tabelaLiberar(&tabela);
+            liberarMemoria(&mapa, &arena);
+            return 1;
+        }
+        printf("Registrando os ataques em %s.\n", arquivoRegistro);
+    }
+    
+    // Buffer reaproveitado por todas as telas (uma escrita por quadro)
+    Saida saida;
+    saidaIniciar(&saida, STDOUT_FILENO);
     
     // Menu principal do jogo
     int opcao;
     int jogoAtivo = 1;
+    int turno = 0;
+    
+    // Simulação "e se?": ponto do histórico e turno onde ela começou
+    int simulando = 0;
+    PontoHistorico inicioSimulacao = {0, 0};
+    int turnoReal = 0;
     
     do {
-        printf("\n====================================\n");
-        printf("           MENU PRINCIPAL\n");
-        printf("====================================\n");
-        printf("1 - Exibir mapa de territorios\n");
-        printf("2 - Exibir missoes dos jogadores\n");
-        printf("3 - Realizar ataque\n");
-        printf("4 - Verificar status das missoes\n");
-        printf("0 - Sair do jogo\n");
-        printf("====================================\n");
-        printf("Escolha uma opcao: ");
-        scanf("%d", &opcao);
+        // Na simulação, nada vai para o registro de eventos
+        Registro* registroAtivo = simulando ? NULL : registro;
+        exibirMenu(&saida, simulando);
+        if (scanf("%d", &opcao) != 1) {
+            // Fim da entrada (ex.: cenário lido da entrada padrão) encerra o jogo
+            opcao = feof(stdin) ? 0 : -1;
+        }
         limparBuffer();
         
+        // Cronometra a opção escolhida, sem a espera pela entrada
+        PERFIL_CONTAR(PERFIL_TURNOS);
+        PERFIL_ESCOPO(PERFIL_TURNO);
+        
         switch (opcao) {
             case 1:
-                exibirTerritorios(territorios, numTerritorios);
+                exibirTerritorios(&mapa, &saida);
                 break;
                 
             case 2:
                 printf("\n=== MISSOES DOS JOGADORES ===\n");
                 for (int i = 0; i < numJogadores; i++) {
-                    exibirMissao(jogadores[i].nome, jogadores[i].missao);
+                    exibirMissao(jogadores[i].nome, jogadores[i].missao->texto);
                 }
                 break;
                 
             case 3:
-                realizarAtaque(territorios, numTerritorios);
+                realizarAtaque(&mapa, regra, &rng, pool, &saida, registroAtivo);
+                // Em depuração, confere os contadores incrementais com uma varredura
+                assert(estatisticasConferir(mapa.estatisticas, &mapa));
                 // Verifica se algum jogador venceu após o ataque
-                if (verificarVitoria(jogadores, numJogadores, territorios, numTerritorios)) {
-                    jogoAtivo = 0;
+                if (verificarVitoria(jogadores, numJogadores, &mapa)) {
+                    if (simulando) {
+                        printf("(Vitoria apenas na simulacao: use a opcao 10 para voltar.)\n");
+                    } else {
+                        jogoAtivo = 0;
+                    }
                 }
                 break;
                 
             case 4:
                 printf("\n=== VERIFICACAO DE MISSOES ===\n");
+                // Territórios e tropas de todos os jogadores em uma única varredura
+                ResumoCores resumo;
+                mapaResumirCores(&mapa, pool, &resumo);
                 for (int i = 0; i < numJogadores; i++) {
                     printf("\nJogador: %s (%s)\n", jogadores[i].nome, jogadores[i].cor);
-                    printf("Missao: %s\n", jogadores[i].missao);
+                    printf("Territorios: %d | Tropas: %lld\n",
+                           resumo.territorios[jogadores[i].idCor],
+                           (long long) resumo.tropas[jogadores[i].idCor]);
+                    printf("Missao: %s\n", jogadores[i].missao->texto);
                     
-                    if (verificarMissao(jogadores[i].missao, territorios, 
-                                       numTerritorios, jogadores[i].cor)) {
+                    if (verificarMissao(jogadores[i].missao, &mapa, jogadores[i].idCor)) {
                         printf("Status: [CUMPRIDA!] \n");
                     } else {
                         printf("Status: [Em andamento]\n");
                     }
                 }
+                exibirAtaquesPossiveis(&mapa, &tabela);
+                break;
+                
+            case 5:
+                if (simulando) {
+                    printf("\nSaia da simulacao (opcao 10) antes de salvar a partida.\n");
+                    break;
+                }
+                salvarPartida(&mapa, jogadores, numJogadores);
+                // O registro em disco acompanha a partida salva
+                if (registro != NULL && registroDescarregar(registro) != REGISTRO_OK) {
+                    printf("AVISO: Falha ao gravar o registro de eventos!\n");
+                }
+                break;
+                
+            case 6:
+                consultarMapa(&mapa, &saida);
+                break;
+                
+            case 7:
+                if (jogarComputadores(&mapa, jogadores, numJogadores, regra, ia, orcamentoIA,
+                                      &rng, registroAtivo)) {
+                    if (simulando) {
+                        printf("(Vitoria apenas na simulacao: use a opcao 10 para voltar.)\n");
+                    } else {
+                        jogoAtivo = 0;
+                    }
+                }
+                break;
+                
+            case 8:
+            case 9:
+                voltarJogada(&mapa, opcao == 9, simulando ? inicioSimulacao.jogadas : 0,
+                             registroAtivo);
+                assert(estatisticasConferir(mapa.estatisticas, &mapa));
+                break;
+                
+            case 10:
+                if (!simulando) {
+                    inicioSimulacao = historicoPonto(mapa.historico);
+                    turnoReal = turno;
+                    simulando = 1;
+                    printf("\nSimulacao iniciada: ataque a vontade; a opcao 10 desfaz tudo.\n");
+                } else if (historicoVoltar(mapa.historico, &mapa, inicioSimulacao)) {
+                    // Os turnos simulados não contam no jogo real
+                    turno = turnoReal;
+                    simulando = 0;
+                    printf("\nSimulacao encerrada: mapa de volta ao jogo real.\n");
+                } else {
+                    // Sem o diário não há como voltar: a simulação vira o jogo real
+                    simulando = 0;
+                    printf("ERRO: Historico da simulacao perdido (falta de memoria)!\n");
+                    printf("O mapa continua no estado simulado.\n");
+                }
+                assert(estatisticasConferir(mapa.estatisticas, &mapa));
+                break;
+                
+            case 11:
+                perfilEscreverTexto(stdout);
+                break;
+                
+            case 12:
+                if (iniciarTurno(&mapa, jogadores, numJogadores, ++turno, registroAtivo)) {
+                    if (simulando) {
+                        printf("(Vitoria apenas na simulacao: use a opcao 10 para voltar.)\n");
+                    } else {
+                        jogoAtivo = 0;
+                    }
+                }
+                break;
+                
+            case 13:
+                // As missões são conferidas uma vez, depois de todas as ordens
+                if (realizarTurno(&mapa, regra, &rng, registroAtivo) > 0) {
+                    assert(estatisticasConferir(mapa.estatisticas, &mapa));
+                    if (verificarVitoria(jogadores, numJogadores, &mapa)) {
+                        if (simulando) {
+                            printf("(Vitoria apenas na simulacao: use a opcao 10 para voltar.)\n");
+                        } else {
+                            jogoAtivo = 0;
+                        }
+                    }
+                }
                 break;
                 
             case 0:
@@ -612,8 +1449,29 @@ int main() {
         
     } while (jogoAtivo);
     
+    if (registro != NULL) {
+        long long turnos = registroTurno(registro);
+        if (registroFechar(registro) != REGISTRO_OK) {
+            printf("AVISO: Falha ao gravar o registro de eventos!\n");
+        } else {
+            printf("Registro %s: %lld ataques gravados.\n", arquivoRegistro, turnos);
+        }
+    }
+    
+    if (formatoPerfil != NULL) {
+        if (strcmp(formatoPerfil, "json") == 0) {
+            perfilEscreverJson(stderr);
+        } else {
+            perfilEscreverTexto(stderr);
+        }
+    }
+    
     // Libera toda a memória alocada
-    liberarMemoria(territorios, jogadores, numJogadores);
+    saidaLiberar(&saida);
+    iaDestruir(ia);
+    poolDestruir(pool);
+    tabelaLiberar(&tabela);
+    liberarMemoria(&mapa, &arena);
     
     printf("\nObrigado por jogar WAR!\n");
     printf("====================================\n");